@@ -15,7 +15,7 @@ if %errorlevel% neq 0 (
 echo Creating result directory...
 if not exist result mkdir result
 
-echo [1/6] Compiling src/wav_io.c...
+echo [1/27] Compiling src/wav_io.c...
 gcc -c src/wav_io.c -o wav_io.o -Iinc -Wall -O2
 if %errorlevel% neq 0 (
     echo ERROR: Failed to compile wav_io.c
@@ -23,7 +23,7 @@ if %errorlevel% neq 0 (
     exit /b 1
 )
 
-echo [2/6] Compiling src/fir_filter.c...
+echo [2/27] Compiling src/fir_filter.c...
 gcc -c src/fir_filter.c -o fir_filter.o -Iinc -Wall -O2
 if %errorlevel% neq 0 (
     echo ERROR: Failed to compile fir_filter.c
@@ -31,7 +31,7 @@ if %errorlevel% neq 0 (
     exit /b 1
 )
 
-echo [3/6] Compiling src/time_domain_sim.c...
+echo [3/27] Compiling src/time_domain_sim.c...
 gcc -c src/time_domain_sim.c -o time_domain_sim.o -Iinc -Wall -O2
 if %errorlevel% neq 0 (
     echo ERROR: Failed to compile time_domain_sim.c
@@ -39,7 +39,7 @@ if %errorlevel% neq 0 (
     exit /b 1
 )
 
-echo [4/6] Compiling src/logger.c...
+echo [4/27] Compiling src/logger.c...
 gcc -c src/logger.c -o logger.o -Iinc -Wall -O2
 if %errorlevel% neq 0 (
     echo ERROR: Failed to compile logger.c
@@ -47,7 +47,175 @@ if %errorlevel% neq 0 (
     exit /b 1
 )
 
-echo [5/6] Compiling src/main.c...
+echo [5/27] Compiling src/eval_grid.c...
+gcc -c src/eval_grid.c -o eval_grid.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile eval_grid.c
+    pause
+    exit /b 1
+)
+
+echo [6/27] Compiling src/spectrum.c...
+gcc -c src/spectrum.c -o spectrum.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile spectrum.c
+    pause
+    exit /b 1
+)
+
+echo [7/27] Compiling src/stability.c...
+gcc -c src/stability.c -o stability.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile stability.c
+    pause
+    exit /b 1
+)
+
+echo [8/27] Compiling src/snapshot.c...
+gcc -c src/snapshot.c -o snapshot.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile snapshot.c
+    pause
+    exit /b 1
+)
+
+echo [9/27] Compiling src/fft.c...
+gcc -c src/fft.c -o fft.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile fft.c
+    pause
+    exit /b 1
+)
+
+echo [10/27] Compiling src/coeffs.c...
+gcc -c src/coeffs.c -o coeffs.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile coeffs.c
+    pause
+    exit /b 1
+)
+
+echo [11/27] Compiling src/params.c...
+gcc -c src/params.c -o params.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile params.c
+    pause
+    exit /b 1
+)
+
+echo [12/27] Compiling src/thread_pool.c...
+gcc -c src/thread_pool.c -o thread_pool.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile thread_pool.c
+    pause
+    exit /b 1
+)
+
+echo [13/27] Compiling src/sweep.c...
+gcc -c src/sweep.c -o sweep.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile sweep.c
+    pause
+    exit /b 1
+)
+
+echo [14/27] Compiling src/dsp_tables.c...
+gcc -c src/dsp_tables.c -o dsp_tables.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile dsp_tables.c
+    pause
+    exit /b 1
+)
+
+echo [15/27] Compiling src/sp_spectrum.c...
+gcc -c src/sp_spectrum.c -o sp_spectrum.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile sp_spectrum.c
+    pause
+    exit /b 1
+)
+
+echo [16/27] Compiling src/shm_ring.c...
+gcc -c src/shm_ring.c -o shm_ring.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile shm_ring.c
+    pause
+    exit /b 1
+)
+
+echo [17/27] Compiling src/scenario.c...
+gcc -c src/scenario.c -o scenario.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile scenario.c
+    pause
+    exit /b 1
+)
+
+echo [18/27] Compiling src/band_analysis.c...
+gcc -c src/band_analysis.c -o band_analysis.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile band_analysis.c
+    pause
+    exit /b 1
+)
+
+echo [19/27] Compiling src/analysis_bins.c...
+gcc -c src/analysis_bins.c -o analysis_bins.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile analysis_bins.c
+    pause
+    exit /b 1
+)
+
+echo [20/27] Compiling src/scheduler.c...
+gcc -c src/scheduler.c -o scheduler.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile scheduler.c
+    pause
+    exit /b 1
+)
+
+echo [21/27] Compiling src/adapt_engine.c...
+gcc -c src/adapt_engine.c -o adapt_engine.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile adapt_engine.c
+    pause
+    exit /b 1
+)
+
+echo [22/27] Compiling src/fxlms.c...
+gcc -c src/fxlms.c -o fxlms.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile fxlms.c
+    pause
+    exit /b 1
+)
+
+echo [23/27] Compiling src/fdaf.c...
+gcc -c src/fdaf.c -o fdaf.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile fdaf.c
+    pause
+    exit /b 1
+)
+
+echo [24/27] Compiling src/eq_fit.c...
+gcc -c src/eq_fit.c -o eq_fit.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile eq_fit.c
+    pause
+    exit /b 1
+)
+
+echo [25/27] Compiling src/resample.c...
+gcc -c src/resample.c -o resample.o -Iinc -Wall -O2
+if %errorlevel% neq 0 (
+    echo ERROR: Failed to compile resample.c
+    pause
+    exit /b 1
+)
+
+echo [26/27] Compiling src/main.c...
 gcc -c src/main.c -o main.o -Iinc -Wall -O2
 if %errorlevel% neq 0 (
     echo ERROR: Failed to compile main.c
@@ -55,8 +223,8 @@ if %errorlevel% neq 0 (
     exit /b 1
 )
 
-echo [6/6] Linking...
-gcc main.o wav_io.o fir_filter.o time_domain_sim.o logger.o -o anc_system.exe -lm
+echo [27/27] Linking...
+gcc main.o wav_io.o fir_filter.o time_domain_sim.o logger.o eval_grid.o spectrum.o stability.o snapshot.o fft.o coeffs.o params.o thread_pool.o sweep.o dsp_tables.o sp_spectrum.o shm_ring.o scenario.o band_analysis.o analysis_bins.o scheduler.o adapt_engine.o fxlms.o fdaf.o eq_fit.o resample.o -o anc_system.exe -lm -lpthread
 if %errorlevel% neq 0 (
     echo ERROR: Failed to link
     pause
@@ -72,6 +240,8 @@ echo.
 echo Output files will be in: result/
 echo   - result/anc_log.txt
 echo   - result/output_comparison.wav
+echo   - result/band_attenuation.csv
+echo   - result/sweep_results.csv (--sweep)
 echo.
 
 pause
@@ -0,0 +1,58 @@
+#ifndef ADAPT_ENGINE_H
+#define ADAPT_ENGINE_H
+
+#include "config.h"
+#include "time_domain_sim.h"
+
+// 自适应引擎（--engine选择）
+// EQ引擎即process_audio_frame状态机：每轮先做DSP分析、拟合Biquad参数，再用新参数重滤波剩余信号；
+// 其余引擎直接在仿真器上闭环运行：读取原始参考麦/误差麦，控制器输出经次级路径与原始误差麦相减
+// 写入simulated_fb，控制器随误差连续更新，不经过状态机
+// 主循环对各引擎按同样的轮长统计每轮降噪量、分频带降噪量、收敛时间和CPU耗时
+
+typedef enum {
+    ENGINE_EQ = 0,          // 分块频域拟合 + Biquad参数搜索（默认）
+    ENGINE_FXLMS,           // 逐样本滤波参考LMS（fxlms.h）
+    ENGINE_FDAF             // 分区频域块LMS（fdaf.h）
+} AdaptEngineType;
+
+typedef struct {
+    AdaptEngineType type;
+    const char *name;
+    void *ctx;              // 引擎私有状态，EQ引擎为NULL
+    /**
+     * 闭环处理 [sim->current_sample, +num_samples)：写入simulated_fb并前移游标
+     * 各次调用须连续；EQ引擎为NULL（由主循环驱动状态机）
+     * @return 处理的样本数
+     */
+    int (*process)(void *ctx, TimeDomainSimulator *sim, int num_samples);
+    void (*destroy)(void *ctx);
+} AdaptEngine;
+
+/**
+ * 解析引擎名（"eq"、"fxlms"、"fdaf"）
+ * @param name 引擎名
+ * @param type 输出引擎类型
+ * @return 0=成功, -1=未知引擎
+ */
+int adapt_engine_parse(const char *name, AdaptEngineType *type);
+
+/**
+ * 创建引擎
+ * 次级路径估计取仿真器的次级路径FIR（与加载的冲击响应相同）
+ * @param engine 输出引擎
+ * @param type 引擎类型
+ * @param params 运行时参数
+ * @param sim 已初始化的仿真器
+ * @return 0=成功, -1=失败
+ */
+int adapt_engine_create(AdaptEngine *engine, AdaptEngineType type, const AncParams *params,
+                        const TimeDomainSimulator *sim);
+
+/**
+ * 释放引擎
+ * @param engine 引擎
+ */
+void adapt_engine_destroy(AdaptEngine *engine);
+
+#endif // ADAPT_ENGINE_H
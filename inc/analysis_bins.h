@@ -0,0 +1,133 @@
+#ifndef ANALYSIS_BINS_H
+#define ANALYSIS_BINS_H
+
+#include "config.h"
+#include "fft.h"
+
+// 分析频点：频谱数组下标k对应的频率及z^-1
+// 全频带模式即FFT_LENGTH点实数FFT的FFT_HALF_LENGTH个频点；细化(zoom)模式只覆盖一个频段，
+// 频点更密、个数更少；稀疏(sparse)模式只取全频带FFT中选定的若干频点。
+// 频点频率升序，[num_bins, SPECTRUM_LENGTH)为补零区；bin_spacing > 0 时频点等间隔:
+// f_k = freq_start + k * bin_spacing，否则（稀疏模式选取单频）间隔不定，bin_spacing为0
+// 细化模式: 以频段中心f_c移频，低通后降采样D倍（D取满足 DSP_SAMPLE_RATE/D >= 频段宽度 *
+// ZOOM_GUARD 的最大整数），对最近ZOOM_FFT_LENGTH个基带样本加窗做复数FFT，
+// 频点间隔 DSP_SAMPLE_RATE / (D * ZOOM_FFT_LENGTH)
+// 稀疏模式: 每个hop对与全频带FFT相同的加窗输入逐频点做Goertzel递推（双精度），
+// 结果与FFT对应频点一致；单频点代价约为FFT_LENGTH次乘加，选取的频点少时比整帧FFT省
+
+#define ZOOM_GUARD              1.6f    // 降采样后带宽 / 频段宽度 的下限（低通过渡带余量）
+
+typedef enum {
+    ANALYSIS_FULL = 0,      // 全频带FFT
+    ANALYSIS_ZOOM,          // 细化FFT
+    ANALYSIS_SPARSE         // 稀疏频点（Goertzel）
+} AnalysisMode;
+
+typedef struct {
+    AnalysisMode mode;
+    int num_bins;                                   // 有效频点数
+    float freq_start;                               // 频点0的频率 (Hz)
+    float bin_spacing;                              // 频点间隔 (Hz)
+    ANC_ALIGN(64) float freq[SPECTRUM_LENGTH];      // 频点k的频率 (Hz)
+    ANC_ALIGN(64) float z_re[SPECTRUM_LENGTH];      // z^-1 = e^(-j2πf/DSP_SAMPLE_RATE)
+    ANC_ALIGN(64) float z_im[SPECTRUM_LENGTH];
+
+    // 细化模式
+    float center_hz;                                // 移频中心（频点间隔的整数倍）
+    int decimation;                                 // 降采样倍数D
+    int num_taps;                                   // 复数带通抽头数
+    int first_bin;                                  // 频点0在复数FFT输出中的下标
+    float scale;                                    // 输出幅度缩放：单频幅度与全频带FFT一致
+    ANC_ALIGN(64) float taps_re[ZOOM_MAX_TAPS];     // 复数带通 h[t]e^(jω_c t)，时间倒序存放
+    ANC_ALIGN(64) float taps_im[ZOOM_MAX_TAPS];
+    ANC_ALIGN(64) float rotate_re[ZOOM_FFT_LENGTH]; // 基带样本j的移频 e^(-jω_c D j)，按j取模查表
+    ANC_ALIGN(64) float rotate_im[ZOOM_FFT_LENGTH];
+    ANC_ALIGN(64) float window[ZOOM_FFT_LENGTH];    // Blackman窗
+    FFTPlan plan;                                   // ZOOM_FFT_LENGTH点复数FFT
+
+    // 稀疏模式
+    double goertzel_coef[SPECTRUM_LENGTH];          // 2cos(ω_k)
+    double goertzel_cos[SPECTRUM_LENGTH];           // cos(ω_k)
+    double goertzel_sin[SPECTRUM_LENGTH];           // sin(ω_k)
+} AnalysisBins;
+
+/**
+ * 全频带分析频点（取自静态表dsp_tables.h）
+ * @param bins 输出频点表
+ */
+void analysis_bins_full(AnalysisBins *bins);
+
+/**
+ * 细化分析频点：设计移频、低通和复数FFT
+ * @param bins 输出频点表
+ * @param freq_low 频段下限 (Hz)
+ * @param freq_high 频段上限 (Hz)
+ * @return 0=成功, -1=频段无效
+ */
+int analysis_bins_zoom(AnalysisBins *bins, float freq_low, float freq_high);
+
+/**
+ * 稀疏分析频点：从全频带FFT频点中选取
+ * spec为 "low:high"（频段内全部频点）或 "f1,f2,..."（各频率最近的频点，去重）
+ * @param bins 输出频点表
+ * @param spec 频点选择
+ * @return 0=成功, -1=格式或频率无效
+ */
+int analysis_bins_sparse(AnalysisBins *bins, const char *spec);
+
+/**
+ * 频率对应的最近频点（限制在有效范围内）
+ * @param bins 频点表
+ * @param freq 频率 (Hz)
+ * @return 频点下标
+ */
+int analysis_bins_nearest(const AnalysisBins *bins, float freq);
+
+/**
+ * 频段 [freq_low, freq_high] 对应的频点范围（限制在有效范围内）
+ * 等间隔频点按间隔向下取整，否则取频段内的首末频点
+ * @param bins 频点表
+ * @param freq_low 频段下限 (Hz)
+ * @param freq_high 频段上限 (Hz)
+ * @param bin_low 输出首个频点
+ * @param bin_high 输出末个频点
+ */
+void analysis_bins_range(const AnalysisBins *bins, float freq_low, float freq_high,
+                         int *bin_low, int *bin_high);
+
+/**
+ * 初始化细化FFT流式状态（全频带模式下也可调用，状态不使用）
+ * @param zoom 流式状态
+ * @param bins 频点表
+ */
+void zoom_init(ZoomState *zoom, const AnalysisBins *bins);
+
+/**
+ * 送入本帧：时域缓冲已写入num_new个新样本，计算其中落在降采样网格上的基带样本
+ * @param zoom 流式状态
+ * @param bins 频点表（细化模式）
+ * @param buffers 各通道时域缓冲（顺序同批量FFT: FF×R, FB×E, SPK）
+ * @param num_new 本帧新样本数
+ */
+void zoom_feed(ZoomState *zoom, const AnalysisBins *bins, const TimeBuffer *const buffers[],
+               int num_new);
+
+/**
+ * 对最近ZOOM_FFT_LENGTH个基带样本做细化FFT，输出频段内各频点
+ * @param zoom 流式状态
+ * @param bins 频点表（细化模式）
+ * @param outputs 各通道输出频谱（[num_bins, SPECTRUM_LENGTH)置0）
+ * @return 1=完成, 0=基带样本尚不足一帧
+ */
+int zoom_transform(const ZoomState *zoom, const AnalysisBins *bins, FreqResponse *const outputs[]);
+
+/**
+ * 稀疏频点变换：对各通道时域缓冲（与全频带FFT相同的装载方式和窗）逐频点Goertzel
+ * @param bins 频点表（稀疏模式）
+ * @param buffers 各通道时域缓冲（顺序同批量FFT: FF×R, FB×E, SPK）
+ * @param outputs 各通道输出频谱（[num_bins, SPECTRUM_LENGTH)置0）
+ */
+void sparse_transform(const AnalysisBins *bins, const TimeBuffer *const buffers[],
+                      FreqResponse *const outputs[]);
+
+#endif // ANALYSIS_BINS_H
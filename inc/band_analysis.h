@@ -0,0 +1,74 @@
+#ifndef BAND_ANALYSIS_H
+#define BAND_ANALYSIS_H
+
+#include "config.h"
+#include "fft.h"
+
+// 误差麦分频带降噪量分析（流式STFT）
+// 原始/降噪后误差麦先经抗混叠低通降采样BAND_DECIMATION倍，再用分析FFT计划（FFT_LENGTH点，
+// Blackman窗，75%重叠）逐帧求各频带能量；每段（一轮迭代）结束时输出各频带
+// 10*log10(Σ原始能量 / Σ降噪后能量)，全部误差麦合计
+
+#define BAND_PER_OCTAVE         3       // 每倍频程频带数（3=1/3倍频程，1=倍频程）
+#define BAND_LOW_HZ             50.0f   // 频带中心频率下限 (Hz)，默认首个频带62.5Hz
+#define BAND_HIGH_HZ            8000.0f // 频带中心频率上限 (Hz)
+#define BAND_MAX_BANDS          64
+#define BAND_DECIMATION         16      // 分析前降采样倍数（375kHz -> 23.4kHz，频点间隔11.4Hz）
+#define BAND_LOWPASS_TAPS       385     // 抗混叠低通抽头数（过渡带约8.9k~14.5kHz，混叠不落入分析频带）
+
+typedef struct {
+    const FFTPlan *plan;
+    int num_bands;
+    float center_hz[BAND_MAX_BANDS];            // 频带中心频率
+    int bin_lo[BAND_MAX_BANDS];                 // 频带覆盖的频点 [bin_lo, bin_hi)
+    int bin_hi[BAND_MAX_BANDS];
+    float lowpass[BAND_LOWPASS_TAPS];           // 抗混叠低通（窗函数法）
+
+    // 流式状态：下一个降采样点对应的输入下标，及降采样后的帧缓冲
+    long long next_input;
+    int fill;
+    float frame[2 * ANC_NUM_ERR][FFT_LENGTH];   // [0, E)原始，[E, 2E)降噪后
+
+    // 本段累积
+    double energy_orig[BAND_MAX_BANDS];
+    double energy_sim[BAND_MAX_BANDS];
+    int frames;
+} BandAnalyzer;
+
+/**
+ * 频带划分（与采样率无关）：BAND_LOW_HZ ~ BAND_HIGH_HZ 内每倍频程BAND_PER_OCTAVE个频带，
+ * 中心频率 1000 * 2^(k/BAND_PER_OCTAVE)
+ * @param center_hz 输出各频带中心频率（至少BAND_MAX_BANDS个）
+ * @return 频带数
+ */
+int band_layout(float *center_hz);
+
+/**
+ * 初始化分析器
+ * @param an 分析器
+ * @param plan 分析FFT计划（长度须为FFT_LENGTH，只读共享）
+ * @param sample_rate 输入采样率 (Hz)
+ */
+void band_analyzer_init(BandAnalyzer *an, const FFTPlan *plan, int sample_rate);
+
+/**
+ * 送入一段信号 [start, start + num_samples)，完成的STFT帧计入本段
+ * 降采样低通向前读取start之前的样本（信号起点之前视为0），各段须按时间顺序送入
+ * @param an 分析器
+ * @param orig 各误差麦原始信号（完整数组）
+ * @param sim 各误差麦降噪后信号（完整数组）
+ * @param start 起始样本
+ * @param num_samples 样本数
+ */
+void band_analyzer_feed(BandAnalyzer *an, const float *const orig[], const float *const sim[],
+                        int start, int num_samples);
+
+/**
+ * 结束本段：输出各频带降噪量并清空累积
+ * @param an 分析器
+ * @param attenuation_db 输出各频带降噪量 (dB)，本段无完整帧时为0
+ * @return 本段帧数
+ */
+int band_analyzer_end_block(BandAnalyzer *an, float *attenuation_db);
+
+#endif // BAND_ANALYSIS_H
@@ -36,9 +36,44 @@
 // Loss判断相关
 #define LOSS_IMPROVEMENT_FACTOR  0.95f   // 新loss必须小于 init_loss * 此因子才接受更新
 
+// ============ 直接拟合初值 ============
+// 每轮梯度下降前在评估网格上把目标直接拟合为NUM_BIQUADS级Biquad（eq_fit.h），
+// 全频点loss低于当前参数时以拟合结果作为本轮起点
+#define EQ_FIT_ITERATIONS       10       // 极点重定位迭代次数，0=关闭
+#define EQ_FIT_OOB_WEIGHT       1.0f     // 网格之外每个分析频点的拟合权重（1=与全频点loss等权），0=只拟合网格
+#define EQ_FIT_REFIT_CHANGE     0.1f     // 拟合被拒后，目标均方变化达到被拒拟合loss的此比例才重新拟合
+
+// 自适应步长μ范围
+#define MU_MIN                  0.0001f  // 步长下限
+#define MU_MAX                  0.1f     // 步长上限（基准步长）
+
+// ============ 迭代时序 ============
+#define ITERATION_TIME_MS       325.0f   // 每轮迭代时长 (ms)
+#define MAX_ITERATIONS          100      // 最大迭代轮数
+#define CONVERGENCE_TOL_DB      1.0f     // 收敛判定：此后各轮降噪量与最终值之差不超过此值 (dB)
+
+// ============ 事件驱动调度 ============
+// 收敛后（上次更新带来的残差下降不足SCHED_CONVERGE_DB）比较本轮与上次自适应时的频带汇总，
+// 均未越限则跳过本轮优化
+#define SCHED_MAX_IDLE_ROUNDS   0        // 连续跳过轮数上限，0=关闭（每轮都自适应）
+#define SCHED_CHANGE_DB         3.0f     // 参考麦频带能量变化门限 (dB)
+#define SCHED_RESIDUAL_RISE_DB  3.0f     // 误差麦频带能量上升门限 (dB)
+#define SCHED_COHERENCE_DELTA   0.2f     // 频带相干度变化门限
+#define SCHED_CONVERGE_DB       0.5f     // 收敛判定：上次更新后总残差下降门限 (dB)
+
+// ============ 优化器评估网格 ============
+// 梯度下降内循环只在网格频点上计算loss，结束后做一次全频点校验决定是否接受
+#define EVAL_GRID_MODE          EVAL_GRID_LOG  // EVAL_GRID_FULL / EVAL_GRID_BAND / EVAL_GRID_LOG
+#define EVAL_GRID_FREQ_LOW      50.0f    // 网格频段下限 (Hz)
+#define EVAL_GRID_FREQ_HIGH     4000.0f  // 网格频段上限 (Hz)
+#define EVAL_GRID_NUM_POINTS    128      // 对数网格目标点数（去重后可能更少）
+
 // 次级路径分母保护
 #define SP_EPSILON              1e-8f    // 次级路径分母最小值，防止除零
 
+// 多参考（ANC_NUM_REF > 1）联合求解的Tikhonov正则，相对各频点 trace(A)/R
+#define JOINT_SOLVE_REG         1e-3f
+
 // ============ 稳定性检测参数 ============
 // 检测频段
 #define STABLE_CHECK_FREQ_LOW   200.0f   // 检测频段下限 (Hz)
@@ -58,6 +93,20 @@
 // 整体偏移检测
 #define MEAN_SHIFT_THR_DB       3.0f     // 平均偏移阈值 (dB)
 
+// ============ 时域滤波参考LMS（--engine fxlms） ============
+// 在仿真器采样率上逐样本闭环：y = W * FF，e = FB - S * y，W += mu * e * (S * FF) / (epsilon + ||S * FF||²)
+#define FXLMS_TAPS              256      // 控制器抽头数（约0.68ms@375kHz）
+#define FXLMS_MU                0.01f    // 归一化步长
+#define FXLMS_EPSILON           1e-8f    // 归一化分母正则项
+
+// ============ 分块频域LMS（--engine fdaf） ============
+// 均匀分区的频域块LMS（重叠保留，2B点FFT），各频点按滤波参考功率归一化，梯度约束逐块轮流施加于一个分区
+#define FDAF_BLOCK_SIZE         256      // 块长B（2的幂）
+#define FDAF_PARTITIONS         1        // 控制器分区数P（控制器长度 P*B）
+#define FDAF_MU                 0.3f     // 归一化步长（已按分区数P归一）
+#define FDAF_POWER_ALPHA        0.9f     // 功率平滑系数
+#define FDAF_EPSILON            0.01f    // 正则项（相对各频点平均功率）
+
 // 数值微分步长（用于计算梯度）
 #define EPSILON_GAIN            0.01f    // Gain数值微分步长 (dB)
 #define EPSILON_Q               0.001f   // Q数值微分步长
@@ -68,14 +117,61 @@
 #define WAV_INPUT_PATH          "input_4ch.wav"     // 输入4通道WAV文件（项目根目录）
 #define SP_IR_PATH              "secondary_path.bin" // 次级路径冲击响应（项目根目录）
 #define LOG_OUTPUT_PATH         "result/anc_log.txt"       // 日志文件（result目录）
-#define WAV_OUTPUT_PATH         "result/output_comparison.wav" // 输出2通道对比WAV（result目录）
+#define WAV_OUTPUT_PATH         "result/output_comparison.wav" // 输出对比WAV: 各原始FF + 各降噪后FB（result目录）
+#define SNAPSHOT_PATH_FORMAT    "result/snapshot_iter%03d.bin" // 引擎快照（按迭代序号命名）
+#define SWEEP_RESULT_PATH       "result/sweep_results.csv"     // 扫参排名表
+#define BAND_RESULT_PATH        "result/band_attenuation.csv"  // 各轮分频带降噪量（迭代 x 频带）
+#define SP_SPECTRUM_CACHE_FORMAT "result/sp_spectrum_%016llx.bin" // 次级路径DSP频响缓存（按冲击响应哈希命名）
+
+// 快照间隔（每N轮迭代保存一次，0=不保存；可用 --snapshot-every N 覆盖）
+#define SNAPSHOT_INTERVAL       0
 
 // WAV通道映射
 #define WAV_CH_FF               0  // 参考麦通道索引
 #define WAV_CH_FB               1  // 误差麦通道索引
 
+// MIMO通道映射：参考麦/误差麦成对交错存放（0=FF0, 1=FB0, 2=FF1, 3=FB1, ...）
+#define WAV_CH_REF(r)           (WAV_CH_FF + 2 * (r))  // 第r个参考麦通道索引
+#define WAV_CH_ERR(e)           (WAV_CH_FB + 2 * (e))  // 第e个误差麦通道索引
+
 // 次级路径参数
 #define SP_IR_LENGTH            4096  // 次级路径FIR长度
+#define SP_TRIM_THRESHOLD_DB    -80.0f  // 加载时去除的首尾能量上限（占总能量，dB；可用 --sp-trim 覆盖）
+
+// ============ 时域仿真分段并行 ============
+// 系数不变的一段375kHz信号切成若干块在线程池上滤波；各块Biquad从零状态滤波后，
+// 按级联状态转移矩阵递推出块间的精确状态并叠加零输入响应，FIR历史取自整段驱动信号
+#define SIM_THREADS             1       // 默认线程数（1=串行；可用 --sim-threads N 覆盖）
+#define SIM_SEGMENT_MIN_LENGTH  131072  // 每块最少样本数（块太短时线程开销占比过高）
+#define SIM_CHECK_THREADS       8       // --sim-check 未指定 --sim-threads 时的并行线程数
+#define SIM_CHECK_TOLERANCE     1e-4f   // --sim-check 相对误差上限（相对抗噪声能量）
+
+// 预卷积模式：加载时算一次S*FF，每次重滤波只跑Biquad级联（可用 --preconv 开启）
+#define SIM_PRECONV             0       // 1=默认开启
+
+// ============ 降速率快速仿真 ============
+// 闭环仿真整体在DSP采样率上运行：输入和次级路径冲击响应重采样到DSP_SAMPLE_RATE（resample.h），
+// Biquad按同一组EQ参数在该采样率下重新设计；结束后只按全速率重渲染一次最终参数作校验
+#define FAST_SIM                0       // 1=默认开启（可用 --fast-sim 开启）
+#define FAST_SIM_MAX_FC_RATIO   0.45f   // 重新设计时fc上限（相对仿真采样率）
+
+// ============ 谱分析通道并行 ============
+// SIGNAL_PROCESS每个hop的加窗、FFT和累积按通道分派到常驻线程池（每线程一个通道），
+// 屏障后再按(误差麦, 参考麦)对分派PP除法累积；每hop耗时取决于最慢的通道而非各通道之和
+#define DSP_THREADS             1       // 线程数（1=调用线程串行批量FFT；可用 --dsp-threads N 覆盖）
+
+// ============ 共享内存流式输入 ============
+// --produce <name>: 按实时节拍把输入WAV写入共享内存环形缓冲区（采集端替身）
+// --stream <name>: 从环形缓冲区逐PROCESS_INTERVAL_MS帧取数据调用process_audio_frame，报告处理超时的帧
+// 每帧交错顺序: FF0..FF(R-1), FB0..FB(E-1)
+#define STREAM_RING_FRAMES      131072  // 环形缓冲区容量（帧，约350ms@375kHz）
+#define STREAM_CONNECT_TIMEOUT_MS 10000 // 消费者等待生产者创建缓冲区的时限 (ms)
+#define STREAM_POLL_MS          0.2     // 消费者等待数据的轮询间隔 (ms)
+
+// ============ 逐帧处理基准 ============
+// --bench-frames N: 对输入的前N帧计时process_audio_frame，分别在热缓存（背靠背）和冷缓存
+// （每帧前扫过BENCH_EVICT_BYTES，模拟帧间其他任务挤出缓存）下运行
+#define BENCH_EVICT_BYTES       (64 * 1024 * 1024)  // 冷缓存扫描量（大于末级缓存）
 
 // Biquad滤波器类型枚举
 #ifndef BIQUAD_TYPE_DEFINED
@@ -104,47 +200,7 @@ typedef struct {
     float total_gain_dB;  // 总增益（dB）
 } EQPreset;
 
-// 次级路径频响（复数形式：实部、虚部交替存储）
-// secondary_path[set][freq_index * 2 + 0] = 实部
-// secondary_path[set][freq_index * 2 + 1] = 虚部
-extern const float secondary_path[NUM_PRESET_SETS][NUM_FREQ_POINTS * 2];
-
 // 预制EQ参数（初值前馈参数）
 extern const EQPreset eq_presets[NUM_PRESET_SETS];
 
-// 实际数据定义（这里给出示例结构，实际数值需要根据测量填充）
-const float secondary_path[NUM_PRESET_SETS][NUM_FREQ_POINTS * 2] = {
-    // Set 0: 示例数据（实部、虚部交替）
-    {
-        1.0f, 0.0f,  // 频点0
-        0.99f, 0.1f, // 频点1
-        // ... 其余频点
-        [NUM_FREQ_POINTS * 2 - 2] = 0.5f,
-        [NUM_FREQ_POINTS * 2 - 1] = 0.0f
-    },
-    // Set 1-9: 其他预制集
-    // ... (类似结构)
-};
-
-const EQPreset eq_presets[NUM_PRESET_SETS] = {
-    // Set 0
-    {
-        .biquads = {
-            {BIQUAD_LOWSHELF, 0.0f, 0.707f, 100.0f},    // Biquad 0: Lowshelf
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 250.0f},       // Biquad 1-8: Peaking
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 500.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 1000.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 2000.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 4000.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 8000.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 12000.0f},
-            {BIQUAD_PEAKING, 0.0f, 1.0f, 14000.0f},
-            {BIQUAD_HIGHSHELF, 0.0f, 0.707f, 15000.0f}  // Biquad 9: Highshelf
-        },
-        .total_gain_dB = 0.0f
-    },
-    // Set 1-9: 其他预制集（类似结构）
-    // ...
-};
-
 #endif // COEFFS_H
@@ -2,8 +2,12 @@
 #define CONFIG_H
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <complex.h>
 #include <math.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
 
 // 前向声明，避免循环依赖
 #ifndef NUM_BIQUADS
@@ -48,11 +52,38 @@ typedef struct {
 #define FFT_HOP_SIZE            ((int)(FFT_LENGTH * (1.0f - FFT_OVERLAP_RATIO)))  // 512
 #define NUM_FFT_AVERAGE         10         // FFT平均次数
 
+// 细化FFT（zoom）参数：只分析一个频段时，移频到基带、低通降采样后做复数FFT
+// 降采样倍数由频段宽度决定（见analysis_bins.h），低通抽头数 = 倍数 × ZOOM_TAPS_PER_DECIMATION + 1
+#define ZOOM_FFT_LENGTH         512        // 复数FFT点数（2的幂，<= FFT_LENGTH / 2）
+#define ZOOM_MAX_DECIMATION     32         // 最大降采样倍数（最细频点间隔 = 32000/32/512 ≈ 1.95Hz）
+#define ZOOM_TAPS_PER_DECIMATION 16
+#define ZOOM_MAX_TAPS           (ZOOM_MAX_DECIMATION * ZOOM_TAPS_PER_DECIMATION + 1)
+
 // 抗混叠降采样参数
 #define DECIMATION_FACTOR       ((REALTIME_SAMPLE_RATE) / (DSP_SAMPLE_RATE))  // 375000/32000 ≈ 11.71875
 
-// 通道数
-#define NUM_CHANNELS            3          // FF, FB, SPK三个通道
+// ============ MIMO通道配置 ============
+// R个参考麦各驱动一路FF滤波器/扬声器，E个误差麦；次级路径和主路径按(误差麦, 参考麦)成对建模
+// 可在编译时覆盖，例如 -DANC_NUM_REF=2 -DANC_NUM_ERR=2
+#ifndef ANC_NUM_REF
+#define ANC_NUM_REF             1          // 参考麦（前馈通道）数
+#endif
+#ifndef ANC_NUM_ERR
+#define ANC_NUM_ERR             1          // 误差麦数
+#endif
+
+// 通道数（每个hop一次批量FFT的通道数）
+#define NUM_CHANNELS            (ANC_NUM_REF + ANC_NUM_ERR + 1)  // FF×R, FB×E, SPK
+
+// SoA频谱长度：FFT_HALF_LENGTH向上取整到16的倍数，尾部补零便于整块向量化
+#define SPECTRUM_LENGTH         (((FFT_HALF_LENGTH) + 15) & ~15)  // 1040
+
+// 内存对齐（SIMD整块访问，64字节 = 一个cache line）
+#define ANC_ALIGN(n)            __attribute__((aligned(n)))
+
+// 完全展开循环提示（n可为宏，展开后须为常量），用于级数、长度为编译期常量的内核
+#define ANC_PRAGMA(x)           _Pragma(#x)
+#define ANC_UNROLL(n)           ANC_PRAGMA(GCC unroll n)
 
 // ============ 复数结构体 ============
 typedef struct {
@@ -61,29 +92,191 @@ typedef struct {
 } Complex;
 
 // ============ 时域Buffer结构体 ============
+// 写指针和计数在前，数据从下一个cache line开始，每帧的写入和FFT装载都是整行顺序访问
 typedef struct {
-    float data[FFT_LENGTH];
     int write_index;
     int sample_count;
+    ANC_ALIGN(64) float data[FFT_LENGTH];
 } TimeBuffer;
 
-// ============ 频域复数向量结构体 ============
+// ============ 细化FFT流式状态 ============
+// 细化模式下每帧把时域缓冲中的新样本移频、低通降采样为复数基带序列，存入环形缓冲区；
+// 低通向前读取的历史样本直接取自时域缓冲
+typedef struct {
+    int num_bins;                       // 初始化时的分析配置（恢复快照时校验）
+    int decimation;
+    long long samples_in;               // 已写入时域缓冲的DSP样本数
+    long long next_output;              // 下一个基带样本对应的DSP样本下标（decimation的倍数）
+    int write_index;                    // 基带环形缓冲区写指针
+    int count;                          // 已有基带样本数（达到ZOOM_FFT_LENGTH后方可变换）
+    ANC_ALIGN(64) float base_re[NUM_CHANNELS][ZOOM_FFT_LENGTH];
+    ANC_ALIGN(64) float base_im[NUM_CHANNELS][ZOOM_FFT_LENGTH];
+} ZoomState;
+
+// ============ 频域复数向量结构体（SoA） ============
+// 实部、虚部分开存储并按64字节对齐，供spectrum.h中的向量化内核使用
+// [FFT_HALF_LENGTH, SPECTRUM_LENGTH)为补零区，所有内核保持其为0
 typedef struct {
-    Complex bins[FFT_HALF_LENGTH];  // 存储FFT结果（仅正频率部分）
+    ANC_ALIGN(64) float re[SPECTRUM_LENGTH];  // 实部（仅正频率部分）
+    ANC_ALIGN(64) float im[SPECTRUM_LENGTH];  // 虚部
 } FreqResponse;
 
 // ============ 多通道FFT累积结构体 ============
 typedef struct {
-    FreqResponse ff_accum;   // FF通道累积
-    FreqResponse fb_accum;   // FB通道累积
-    FreqResponse spk_accum;  // SPK通道累积
+    FreqResponse ff_accum[ANC_NUM_REF];   // FF通道累积（各参考麦）
+    FreqResponse fb_accum[ANC_NUM_ERR];   // FB通道累积（各误差麦）
+    FreqResponse spk_accum;               // SPK通道累积
+    
+    // 主路径传函累积: PP[e][r] = Sre/Srr (误差麦e/参考麦r)
+    FreqResponse pp_accum[ANC_NUM_ERR][ANC_NUM_REF];
     
-    // 主路径传函累积: PP = Sre/Srr (误差麦/参考麦)
-    Complex pp_accum[FFT_HALF_LENGTH];  // 主路径传函累积
+#if ANC_NUM_REF > 1
+    // 多参考联合求解的互谱累积: XX[r][q] = Σ conj(X_r)·X_q，XE[r][e] = Σ conj(X_r)·E_e
+    FreqResponse xx_accum[ANC_NUM_REF][ANC_NUM_REF];
+    FreqResponse xe_accum[ANC_NUM_REF][ANC_NUM_ERR];
+#endif
     
     int accum_count;         // 当前累积次数
 } FFTAccumulator;
 
+// ============ 评估频点网格 ============
+// 优化器内循环只在网格频点上计算频响和loss，最终接受与否仍由全频点校验决定
+typedef enum {
+    EVAL_GRID_FULL = 0,     // 全部分析频点（全频带为FFT_HALF_LENGTH个），等权
+    EVAL_GRID_BAND,         // 频段内全部频点，等权
+    EVAL_GRID_LOG           // 频段内对数间隔频点，按覆盖的频点数加权
+} EvalGridMode;
+
+typedef struct {
+    EvalGridMode mode;
+    int num_bins;                       // 网格频点数
+    int padded_bins;                    // 向上取整到4的倍数，补齐部分权重为0
+    int bins[FFT_HALF_LENGTH];          // 频点索引（升序，无重复）
+    float weight_sum;                   // 权重和（loss归一化用）
+    
+    // 网格频点上的紧凑SoA数据，供向量化加权loss使用
+    ANC_ALIGN(64) float weights[SPECTRUM_LENGTH];     // 各网格频点权重
+    ANC_ALIGN(64) float target_re[SPECTRUM_LENGTH];   // 本轮目标频响（每轮收集一次）
+    ANC_ALIGN(64) float target_im[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float resp_re[SPECTRUM_LENGTH];     // 试探参数下的FF频响
+    ANC_ALIGN(64) float resp_im[SPECTRUM_LENGTH];
+    
+    // 试探时只重算被修改的一级：网格频点上的z^-1、z^-2表，各级频响缓存，其余各级之积
+    ANC_ALIGN(64) float z1_re[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float z1_im[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float z2_re[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float z2_im[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float stage_re[NUM_BIQUADS][SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float stage_im[NUM_BIQUADS][SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float rest_re[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float rest_im[SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float trial_re[SPECTRUM_LENGTH];    // 最近一次试探的单级频响
+    ANC_ALIGN(64) float trial_im[SPECTRUM_LENGTH];
+} EvalGrid;
+
+// ============ 目标频响稳定性检测 ============
+// 所有指标在一次融合遍历中按块累积，新增指标只需在stability.c的指标表中登记
+typedef enum {
+    STABILITY_METRIC_BOUNDS = 0,    // 绝对幅度界限
+    STABILITY_METRIC_SPIKES,        // 局部尖峰
+    STABILITY_METRIC_SHIFT,         // 整体偏移
+    STABILITY_METRIC_SMOOTHNESS,    // 平滑度（二阶差分均方）
+    STABILITY_NUM_METRICS
+} StabilityMetricId;
+
+typedef struct {
+    float smooth_alpha;             // 平滑度阈值倍数
+    float spike_delta_db;           // 单点变化阈值 (dB)
+    float spike_ratio_thr;          // 尖峰频点比例上限
+    float response_low_db;          // 频响下限 (dB)
+    float response_high_db;         // 频响上限 (dB)
+    float mean_shift_thr_db;        // 平均偏移阈值 (dB)
+} StabilityThresholds;
+
+typedef struct {
+    float sum;                      // 累加量
+    float min_val;                  // 最小值
+    float max_val;                  // 最大值
+    int count;                      // 计数
+} StabilityMetricAcc;
+
+typedef struct {
+    int bin_low;                    // 检测频段起始频点
+    int band_len;                   // 检测频段频点数
+    StabilityThresholds thr;        // 检测阈值
+    float prev_smoothness;          // 上一次通过检测时的平滑度
+    
+    int order[STABILITY_NUM_METRICS];               // 按代价升序的判定顺序
+    StabilityMetricAcc acc[STABILITY_NUM_METRICS];  // 各指标累积量
+    
+    ANC_ALIGN(64) float curr_db[SPECTRUM_LENGTH];   // 本次目标频响dB（频段内）
+    ANC_ALIGN(64) float prev_db[SPECTRUM_LENGTH];   // 上次通过检测的目标频响dB（缓存）
+} StabilityChecker;
+
+// ============ 事件驱动自适应调度 ============
+// 每个hop顺带累积参考/误差麦功率谱和互谱，一轮FFT平均结束时按频带汇总为能量和相干度，
+// 与上次自适应时的汇总比较；噪声场、相干度和残差都没有明显变化时跳过本轮CAL_MU及之后的计算
+#define SCHED_NUM_BANDS         8          // 汇总频带数（评估网格频段内对数等分）
+#define SCHED_BAND_NONE         0xFF       // 频点不参与汇总
+
+typedef struct {
+    int max_idle_rounds;            // 连续跳过的轮数上限，0=不跳过（每轮都自适应）
+    float change_db;                // 参考麦频带能量变化门限 (dB)
+    float residual_rise_db;         // 误差麦频带能量上升门限 (dB)
+    float coherence_delta;          // 参考-误差麦频带相干度变化门限
+    float converge_db;              // 上次自适应后残差下降超过此值视为仍在收敛 (dB)
+} SchedulerThresholds;
+
+typedef struct {
+    int num_bands;
+    int bin_low;                                    // 参与汇总的频点范围 [bin_low, bin_high)
+    int bin_high;
+    unsigned char band_of[SPECTRUM_LENGTH];         // 分析频点所属频带
+    
+    // 本轮逐hop累积（各频点）
+    int hops;
+    ANC_ALIGN(64) float ref_power[ANC_NUM_REF][SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float err_power[ANC_NUM_ERR][SPECTRUM_LENGTH];
+    ANC_ALIGN(64) float cross_re[ANC_NUM_ERR][ANC_NUM_REF][SPECTRUM_LENGTH];  // Σ FB_e · conj(FF_r)
+    ANC_ALIGN(64) float cross_im[ANC_NUM_ERR][ANC_NUM_REF][SPECTRUM_LENGTH];
+    
+    // 本轮汇总，及上次自适应时的汇总（比较基准）
+    float ref_db[ANC_NUM_REF][SCHED_NUM_BANDS];
+    float err_db[ANC_NUM_ERR][SCHED_NUM_BANDS];
+    float coherence[ANC_NUM_ERR][ANC_NUM_REF][SCHED_NUM_BANDS];
+    float err_total_db;             // 全部误差麦、全部频带的总能量
+    float base_ref_db[ANC_NUM_REF][SCHED_NUM_BANDS];
+    float base_err_db[ANC_NUM_ERR][SCHED_NUM_BANDS];
+    float base_coherence[ANC_NUM_ERR][ANC_NUM_REF][SCHED_NUM_BANDS];
+    float base_err_total_db;
+    int has_base;
+    
+    int last_updated;               // 上次自适应接受了更新
+    int idle_rounds;                // 已连续跳过的轮数
+    int rounds;                     // 统计: 完成FFT平均的轮数
+    int adapted_rounds;             // 统计: 其中执行自适应的轮数
+} AdaptScheduler;
+
+// ============ 时域滤波参考LMS（FxLMS引擎） ============
+#define FXLMS_MAX_TAPS          4096       // 控制器最大抽头数
+
+typedef struct {
+    int num_taps;                   // 自适应FIR控制器抽头数
+    float mu;                       // 归一化步长（0~2，按滤波参考能量归一化）
+    float epsilon;                  // 归一化分母正则项（防止静音段步长过大）
+} FxlmsParams;
+
+// ============ 分块频域LMS（FDAF引擎） ============
+#define FDAF_MAX_PARTITIONS     64         // 控制器最大分区数
+
+typedef struct {
+    int block_size;                 // 块长B（2的幂，FFT长度2B <= FFT_LENGTH）
+    int num_partitions;             // 控制器分区数P（控制器长度 P*B）
+    float mu;                       // 归一化步长（已除以P）
+    float power_alpha;              // 各频点滤波参考功率的平滑系数
+    float epsilon;                  // 正则项（相对各频点平均功率）
+} FdafParams;
+
 // ============ Biquad滤波器系数结构体 ============
 typedef struct {
     float b0, b1, b2;  // 分子系数
@@ -117,10 +310,72 @@ typedef struct {
     BiquadGradient gradients[NUM_BIQUADS];  // 各Biquad梯度
     float total_gain_gradient;        // 总增益梯度
     float init_loss;                  // 初始loss（当前FF参数与目标的拟合误差）
-    float current_loss;               // 当前损失值
+    float current_loss;               // 当前损失值（全频点）
+    float grid_loss;                  // 评估网格上的当前损失值（优化器内循环使用）
     int update_accepted;              // 更新是否被接受
 } EQUpdateState;
 
+// ============ 运行时调参配置 ============
+// 默认值取自coeffs.h中的同名宏，可用 --set name=value 或扫参模式在运行时修改（名称表见params.c）
+// FFT_LENGTH决定所有频谱数组大小，仍为编译期常量
+typedef struct {
+    // 梯度下降步长
+    float learning_rate_gain;           // Gain步长 (dB)
+    float learning_rate_q;              // Q步长
+    float learning_rate_fc;             // 中心频率步长 (Hz)
+    float learning_rate_total_gain;     // 总增益步长 (dB)
+    
+    // 单次更新最大变化量
+    float max_delta_gain;               // Gain最大变化量 (dB)
+    float max_delta_q;                  // Q最大变化量
+    float max_delta_fc;                 // fc最大变化量 (Hz)
+    float max_delta_total_gain;         // 总增益最大变化量 (dB)
+    
+    float loss_improvement_factor;      // 当前loss低于 init_loss * 此因子时跳过更新
+    int eq_fit_iterations;              // 直接拟合初值的极点重定位迭代次数，0=关闭
+    float eq_fit_oob_weight;            // 直接拟合中网格之外每个频点的权重
+    float mu_min;                       // 步长下限
+    float mu_max;                       // 步长上限（基准步长）
+    
+    // 评估网格
+    float eval_grid_freq_low;           // 网格频段下限 (Hz)
+    float eval_grid_freq_high;          // 网格频段上限 (Hz)
+    int eval_grid_num_points;           // 对数网格目标点数
+    
+    // 稳定性检测
+    float stable_check_freq_low;        // 检测频段下限 (Hz)
+    float stable_check_freq_high;       // 检测频段上限 (Hz)
+    StabilityThresholds stability;      // 检测阈值
+    
+    // 事件驱动调度
+    SchedulerThresholds scheduler;
+    
+    // 时域自适应引擎（--engine选择，默认EQ引擎不使用）
+    FxlmsParams fxlms;
+    FdafParams fdaf;
+    
+    // 时序
+    int num_fft_average;                // FFT平均次数
+    float iteration_time_ms;            // 每轮迭代时长 (ms)
+    int max_iterations;                 // 最大迭代轮数
+} AncParams;
+
+// ============ 前馈通道（每个参考麦一路） ============
+// 各通道的FF滤波器、EQ参数和目标频响相互独立，总loss对通道可分，优化器逐通道进行
+typedef struct {
+    FeedforwardFilter ff_filter;                    // 前馈滤波器
+    EQUpdateState eq_update;                        // EQ参数更新状态
+    
+    ANC_ALIGN(64) float sp_power[SPECTRUM_LENGTH];  // Σ_e |S_er(ω)|²，加载次级路径时预计算
+    ANC_ALIGN(64) float mu[SPECTRUM_LENGTH];        // 各频点步长
+    FreqResponse target_ff;                         // 目标前馈响应（各误差麦目标的平均）
+    FreqResponse current_ff;                        // 当前前馈滤波器响应
+    FreqResponse fit_rejected_target;               // 上次直接拟合被拒时的目标响应
+    float fit_rejected_loss;                        // 该次拟合的全频点loss，0=无缓存
+    
+    StabilityChecker stability;                     // 稳定性检测（缓存上一次目标的dB曲线）
+} FFChannel;
+
 // ============ 状态机枚举 ============
 typedef enum {
     SIGNAL_PROCESS = 0,     // 信号处理：FFT分析，计算PP_AVERAGE
@@ -130,54 +385,67 @@ typedef enum {
     STABLE_CHECK,           // 检测目标频响是否稳定/异常
     CAL_FF_INIT_LOSS,       // 计算初始loss作为更新阈值
     UPDATE_EQ_PARAMS,       // 更新EQ参数
-    UPDATE_FILTER_COEFFS    // 更新滤波器系数到375kHz
+    UPDATE_FILTER_COEFFS,   // 更新滤波器系数到375kHz
+    ADAPT_IDLE              // 调度器判定稳态，跳过本轮优化，重新开始FFT平均
 } ProcessState;
 
 // ============ 全局系统状态结构体 ============
+// 按访问频率分区，各区起始按cache line对齐:
+//   热区: 每帧（5ms）都访问的状态机、计数器、时域缓冲和FFT累积，连续存放
+//   每轮区: 每轮自适应各状态访问一次的频谱，按消费它们的处理阶段分组
+//   冷区: 初始化和日志才用到的字段
+// 结构体约300KB，改变字段顺序须同步递增SNAPSHOT_VERSION
 typedef struct {
-    ProcessState state;             // 当前状态
+    // ---- 热区（process_audio_frame每帧访问） ----
+    ANC_ALIGN(64) ProcessState state;       // 当前状态
+    int fft_count;                          // FFT执行计数
+    int frame_count;                        // 帧计数器
+    AncParams params;                       // 运行时调参配置（每帧读num_fft_average）
     
-    // 时域缓冲区
-    TimeBuffer ff_buffer;
-    TimeBuffer fb_buffer;
+    // 块处理接口（process_audio_block）的降采样进度：输出样本k取输入样本 k*fs_in/DSP_SAMPLE_RATE
+    long long block_input_pos;              // 已消费的输入样本数
+    long long block_output_pos;             // 已产生的降采样样本数
+    int block_pending;                      // 当前帧已填入缓冲的降采样样本数（满SAMPLES_PER_INTERVAL推进一次状态机）
+    
+    // 时域缓冲区，顺序与批量FFT的通道顺序一致: FF×R, FB×E, SPK
+    TimeBuffer ff_buffer[ANC_NUM_REF];
+    TimeBuffer fb_buffer[ANC_NUM_ERR];
     TimeBuffer spk_buffer;
     
-    // FFT累积器
+    // FFT累积器（每个hop累加一次）
     FFTAccumulator fft_accum;
     
-    // 平均后的频域数据
-    FreqResponse ff_avg;
-    FreqResponse fb_avg;
-    FreqResponse spk_avg;
+    // 细化FFT基带序列（仅细化分析模式）
+    ZoomState zoom;
     
-    // 平均后的主路径传函: PP_AVERAGE = Sre/Srr (误差麦/参考麦)
-    Complex pp_average[FFT_HALF_LENGTH];
+    // 事件驱动调度（逐hop累积功率谱/互谱）
+    AdaptScheduler sched;
     
-    // 次级路径模型（当前使用的预制集）
-    Complex secondary_path[FFT_HALF_LENGTH];
+    // ---- 每轮区: SIGNAL_PROCESS末平均，CAL_MU/CAL_TARGET_FF读取 ----
+    FreqResponse ff_avg[ANC_NUM_REF];
+    FreqResponse fb_avg[ANC_NUM_ERR];
+    FreqResponse spk_avg;
     
-    // 自适应参数
-    float mu[FFT_HALF_LENGTH];              // 各频点步长
-    Complex target_ff[FFT_HALF_LENGTH];     // 目标前馈响应
-    Complex current_ff[FFT_HALF_LENGTH];    // 当前前馈滤波器响应
-    Complex prev_target_ff[FFT_HALF_LENGTH]; // 上一次的目标响应（用于稳定性检测）
+    // 平均后的主路径传函: PP_AVERAGE[e][r] = Sre/Srr (误差麦e/参考麦r)
+    FreqResponse pp_average[ANC_NUM_ERR][ANC_NUM_REF];
     
-    // 稳定性检测
-    float prev_smoothness;                  // 上一次的平滑度指标
-    int target_valid;                       // 目标响应是否有效
+    // ---- 每轮区: CAL_TARGET_FF ----
+    // 次级路径模型（当前使用的预制集）: 扬声器r到误差麦e
+    FreqResponse secondary_path[ANC_NUM_ERR][ANC_NUM_REF];
     
-    // 前馈滤波器
-    FeedforwardFilter ff_filter;
+    // 各误差麦单独给出的目标前馈响应，及其相对当前FF响应的loss
+    FreqResponse pair_target[ANC_NUM_ERR][ANC_NUM_REF];
+    ANC_ALIGN(64) float err_loss[ANC_NUM_ERR];
+    int target_valid;                       // 目标响应是否有效（全部通道通过稳定性检测）
     
-    // EQ参数更新状态
-    EQUpdateState eq_update;
+    // ---- 每轮区: CAL_MU ~ UPDATE_FILTER_COEFFS逐通道访问 ----
+    FFChannel ff_ch[ANC_NUM_REF];
     
-    // 当前使用的预制集索引
-    int current_preset_index;
+    // 优化器评估网格（各通道依次复用）
+    EvalGrid eval_grid;
     
-    // 计数器
-    int fft_count;              // FFT执行计数
-    int frame_count;            // 帧计数器
+    // ---- 冷区 ----
+    ANC_ALIGN(64) int current_preset_index; // 当前使用的预制集索引
     
 } SystemState;
 
@@ -228,4 +496,35 @@ static inline Complex complex_scale(Complex a, float scale) {
     return result;
 }
 
+// FNV-1a 64位哈希（快照输入校验、次级路径频响缓存键）
+#define ANC_FNV_OFFSET_BASIS    0xcbf29ce484222325ULL
+#define ANC_FNV_PRIME           0x100000001b3ULL
+
+static inline uint64_t anc_fnv1a(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= ANC_FNV_PRIME;
+    }
+    return hash;
+}
+
+// 64字节对齐的堆分配（SystemState等含ANC_ALIGN成员的结构体在堆上分配时使用）
+static inline void *anc_aligned_alloc(size_t size) {
+#if defined(_WIN32)
+    return _aligned_malloc(size, 64);
+#else
+    void *ptr = NULL;
+    return posix_memalign(&ptr, 64, size) == 0 ? ptr : NULL;
+#endif
+}
+
+static inline void anc_aligned_free(void *ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
 #endif // CONFIG_H
@@ -0,0 +1,22 @@
+#ifndef DSP_TABLES_H
+#define DSP_TABLES_H
+
+#include "config.h"
+
+// 编译期尺寸的静态表，由 tools/gen_tables.c 生成到 src/dsp_tables.c
+// 修改FFT_LENGTH或DSP_SAMPLE_RATE后须重新生成（尺寸不符时编译报错）
+
+// Blackman窗
+extern const float dsp_blackman_window[FFT_LENGTH];
+
+// 实数FFT（FFT_LENGTH/2点复数FFT + 拆分）
+extern const uint16_t dsp_fft_bitrev[FFT_LENGTH / 2];      // 位反转置换表
+extern const float dsp_fft_stage_tw_re[FFT_LENGTH / 2];    // 各级旋转因子（第s级hl个，依次拼接）
+extern const float dsp_fft_stage_tw_im[FFT_LENGTH / 2];
+
+// 频点表（[FFT_HALF_LENGTH, SPECTRUM_LENGTH)为补零区）
+extern const float dsp_bin_freq[SPECTRUM_LENGTH];          // 频点k的频率 (Hz)
+extern const float dsp_bin_twiddle_re[SPECTRUM_LENGTH];    // e^(-j2πk/N)：z^-1在频点k的取值，
+extern const float dsp_bin_twiddle_im[SPECTRUM_LENGTH];    // 同时是实数FFT拆分旋转因子
+
+#endif // DSP_TABLES_H
@@ -0,0 +1,44 @@
+#ifndef EQ_FIT_H
+#define EQ_FIT_H
+
+#include "config.h"
+#include "analysis_bins.h"
+
+// EQ参数直接拟合（梯度下降的初值）
+// 在评估网格上把目标前馈响应拟合为 2*NUM_BIQUADS 阶有理模型，分解为二阶节后映射到
+// 最接近的lowshelf/peaking/highshelf参数，不依赖当前参数，目标大幅变化时一步到位。
+//
+// 拟合在双线性变换的模拟域 s = j·tan(ω/2) 上进行（RBJ EQ正是模拟原型的双线性变换，
+// 二阶节参数可直接读出），ω取网格频点的z^-1表:
+//   Steiglitz–McBride / Sanathanan–Koerner迭代以加权线性化最小二乘求解:
+//     σ(s)·T(s) ≈ N(s)，σ = 1 + Σ c̃_n φ_n(s)，N = d + Σ c_n φ_n(s)
+//   基函数φ取部分分式 1/(s - p_n)（向量拟合形式），每次迭代以σ的零点替换极点，
+//   避免20阶多项式基在网格频段上的严重病态
+//   收敛后以固定极点求留数，零点为 eig(A - b·cᵀ/d)
+// 极点/零点各自按共轭对（或相邻实根）组成二阶节，按固有频率排序配对:
+//   peaking:   ωp = ωz，Qp = A·Q，Qz = Q/A
+//   lowshelf:  Qp = Qz = Q，ωz/ωp = A
+//   highshelf: Qp = Qz = Q，ωp/ωz = A
+// 每节取三种映射中与原二阶节频响（最优比例下）误差最小者，参数限幅到有效范围，
+// fc另限制在拟合数据覆盖的频段内，总增益最后按最小二乘重新求解
+//
+// 只拟合网格时网格外的响应不受约束（shelf的渐近增益、频段边缘的高Q节可任意偏离目标），
+// 而是否采用以全频点loss为准：网格之外的分析频点（除直流与Nyquist）以out_of_band_weight
+// 的每频点权重加入最小二乘
+
+/**
+ * 在评估网格上直接拟合EQ参数
+ * @param grid 评估网格（须已调用eval_grid_load_target）
+ * @param bins 分析频点表（网格为其子集）
+ * @param target 全频点目标频响（取网格之外的频点）
+ * @param out_of_band_weight 网格之外每个频点的权重，0=只拟合网格
+ * @param iterations 极点重定位迭代次数
+ * @param params 输出各级EQ参数（按fc升序）
+ * @param total_gain_dB 输出总增益 (dB)
+ * @return 0=成功, -1=网格点数不足、求解奇异或结果非有限
+ */
+int eq_fit_grid(const EvalGrid *grid, const AnalysisBins *bins, const FreqResponse *target,
+                float out_of_band_weight, int iterations, BiquadParam params[NUM_BIQUADS],
+                float *total_gain_dB);
+
+#endif // EQ_FIT_H
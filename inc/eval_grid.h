@@ -0,0 +1,73 @@
+#ifndef EVAL_GRID_H
+#define EVAL_GRID_H
+
+#include "config.h"
+#include "analysis_bins.h"
+
+/**
+ * 初始化评估频点网格
+ * @param grid 网格结构体
+ * @param bins 分析频点表（网格为其子集）
+ * @param mode 网格类型 (FULL/BAND/LOG)
+ * @param freq_low 频段下限 (Hz)，FULL模式忽略
+ * @param freq_high 频段上限 (Hz)，FULL模式忽略
+ * @param num_points LOG模式的目标点数，其余模式忽略
+ * @return 网格频点数
+ */
+int eval_grid_init(EvalGrid *grid, const AnalysisBins *bins, EvalGridMode mode,
+                   float freq_low, float freq_high, int num_points);
+
+/**
+ * 将目标频响收集到网格紧凑数组（每轮优化开始时调用一次）
+ * @param grid 网格结构体
+ * @param target 全频点目标频响
+ */
+void eval_grid_load_target(EvalGrid *grid, const FreqResponse *target);
+
+/**
+ * 在网格频点上计算全部Biquad级的频响并缓存（每轮优化开始时调用一次）
+ * @param grid 网格结构体
+ * @param filter 前馈滤波器
+ */
+void eval_grid_load_filter(EvalGrid *grid, const FeedforwardFilter *filter);
+
+/**
+ * 开始试探第stage级：缓存其余各级频响之积，并以缓存的当前级频响填写resp
+ * 此后的试探与基准使用同一乘法顺序，loss差值不含舍入顺序带来的偏差
+ * @param grid 网格结构体
+ * @param stage 被试探的级（-1表示全部级参与乘积，用于试探总增益）
+ * @param total_gain 线性总增益
+ */
+void eval_grid_begin_stage(EvalGrid *grid, int stage, float total_gain);
+
+/**
+ * 试探单级系数：resp = 其余各级之积 × 该级频响 × 总增益
+ * @param grid 网格结构体
+ * @param coeffs 试探系数（a0已归一化）
+ * @param total_gain 线性总增益
+ */
+void eval_grid_trial_stage(EvalGrid *grid, const BiquadCoeffs *coeffs, float total_gain);
+
+/**
+ * 试探总增益：resp = 全部级之积 × 总增益（须先调用eval_grid_begin_stage(grid, -1, ...)）
+ * @param grid 网格结构体
+ * @param total_gain 线性总增益
+ */
+void eval_grid_trial_gain(EvalGrid *grid, float total_gain);
+
+/**
+ * 接受最近一次试探：写入该级频响缓存
+ * @param grid 网格结构体
+ * @param stage 被试探的级
+ */
+void eval_grid_commit_stage(EvalGrid *grid, int stage);
+
+/**
+ * 频点索引对应的频率
+ * @param bins 分析频点表
+ * @param bin 频点索引
+ * @return 频率 (Hz)
+ */
+float eval_grid_bin_freq(const AnalysisBins *bins, int bin);
+
+#endif // EVAL_GRID_H
@@ -0,0 +1,82 @@
+#ifndef FDAF_H
+#define FDAF_H
+
+#include "config.h"
+#include "fft.h"
+#include "time_domain_sim.h"
+
+// 分区频域块LMS（PBFDAF）控制器
+// 每个参考麦一路 P*B 抽头控制器，分为P个B抽头分区，频域为2B点FFT的B+1个频点（重叠保留）。
+// 每块B个样本:
+//   X_k     = FFT(参考麦最近2B个样本)，存入分区延迟线
+//   y       = IFFT(Σ_p W_p · X_{k-p}) 的后B个样本           控制器输出
+//   e       = d - S * y                                       误差麦（次级路径同样按B分区在频域卷积）
+//   X'_k    = FFT(最近2B个滤波参考 Ŝ * x)                   滤波参考（由X的分区延迟线得到）
+//   W_p    += mu / (P · (Φ_k + epsilon · mean(Φ))) · conj(X'_{k-p}) · FFT([0, e])
+// Φ_k为各频点滤波参考功率的指数平滑，正则项按平均功率缩放（仿真器采样率下高频点几乎无能量）。
+// 每块对一个分区（轮流）施加梯度约束（IFFT后清零后B个抽头再FFT），其余分区不约束。每样本代价为若干次2B点FFT的分摊，即O(log B)，
+// 另加O(P)次复数乘加，与控制器长度基本无关
+
+typedef struct {
+    int block;                      // 块长B
+    int num_partitions;             // 控制器分区数P
+    int sp_partitions;              // 次级路径分区数Q
+    int depth;                      // 参考分区延迟线深度 max(P, Q)
+    int bins;                       // 频点数B+1（内核按4的倍数处理，补零区为0）
+    float mu;
+    float power_alpha;
+    float epsilon;
+    FFTPlan plan;                   // 2B点实数FFT
+
+    // 频谱（FreqResponse数组，64字节对齐）
+    FreqResponse *sp;               // [E][R][Q] 次级路径分区频谱
+    FreqResponse *x_line;           // [R][depth] 参考分区延迟线
+    FreqResponse *y_line;           // [R][Q] 驱动信号分区延迟线
+    FreqResponse *fx_line;          // [E][R][P] 滤波参考分区延迟线
+    FreqResponse *w;                // [R][P] 控制器分区频谱
+    float *power;                   // [R][SPECTRUM_LENGTH] 滤波参考功率（各误差麦合计）
+    float *step;                    // [SPECTRUM_LENGTH] 本块各频点步长
+    int head;                       // 延迟线最新位置
+    int constrain_next;             // 下一个施加梯度约束的分区
+
+    // 上一块的时域样本（2B点窗口的前半）
+    float *y_prev;                  // [R][B]
+    float *fx_prev;                 // [E][R][B]
+
+    long long next_sample;          // 下一块起点（块可越过本次调用的末尾，预先写入simulated_fb）
+    long long blocks;               // 已处理块数
+} FdafController;
+
+/**
+ * 初始化控制器（系数清零）
+ * @param ctrl 控制器
+ * @param params 块长、分区数和步长
+ * @param sim 仿真器（取次级路径FIR）
+ * @return 0=成功, -1=参数无效或内存分配失败
+ */
+int fdaf_init(FdafController *ctrl, const FdafParams *params, const TimeDomainSimulator *sim);
+
+/**
+ * 闭环处理仿真器当前位置起的一段信号，游标前移num_samples
+ * 按整块处理：最后一块越过段末时整块算完，后续调用从下一块接着处理
+ * @param ctrl 控制器
+ * @param sim 仿真器
+ * @param num_samples 样本数（超出信号末尾时截断）
+ * @return 处理的样本数
+ */
+int fdaf_process(FdafController *ctrl, TimeDomainSimulator *sim, int num_samples);
+
+/**
+ * 控制器系数范数（全部参考麦，时域）
+ * @param ctrl 控制器
+ * @return ||W||
+ */
+float fdaf_weight_norm(const FdafController *ctrl);
+
+/**
+ * 释放控制器
+ * @param ctrl 控制器
+ */
+void fdaf_free(FdafController *ctrl);
+
+#endif // FDAF_H
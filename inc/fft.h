@@ -0,0 +1,70 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include "config.h"
+
+// 实数FFT计划：N点实数FFT按N/2点复数FFT + 拆分实现（基2，按时间抽取）
+// 旋转因子按级连续存放，批量变换时各通道共用同一级的旋转因子
+// N == FFT_LENGTH时使用生成的静态表（dsp_tables.h）和定长内核，不构造下列表
+typedef struct {
+    int length;                             // 实数FFT长度N（2的幂，<= FFT_LENGTH）
+    int half;                               // 复数FFT长度N/2
+    int fixed;                              // 1=定长内核（N == FFT_LENGTH）
+    int bitrev[FFT_LENGTH / 2];             // 位反转置换表
+    float stage_tw_re[FFT_LENGTH / 2];      // 各级旋转因子（第s级hl个，依次拼接）
+    float stage_tw_im[FFT_LENGTH / 2];
+    float split_re[FFT_LENGTH / 2 + 1];     // 实数拆分旋转因子 e^(-j2πk/N)
+    float split_im[FFT_LENGTH / 2 + 1];
+} FFTPlan;
+
+/**
+ * 初始化实数FFT计划
+ * @param plan FFT计划
+ * @param length FFT长度（2的幂，4 ~ FFT_LENGTH）
+ * @return 0=成功, -1=长度不支持
+ */
+int fft_init(FFTPlan *plan, int length);
+
+/**
+ * 批量实数FFT（多通道共用一次调用）
+ * 加窗在装载时完成；输出为正频率部分（length/2+1个频点），其余频点置0。
+ * 各级蝶形对所有通道依次执行，旋转因子只需载入一次
+ * @param plan FFT计划
+ * @param inputs 各通道输入（length个样本）
+ * @param window 窗函数（length个），NULL表示不加窗
+ * @param outputs 各通道输出频谱
+ * @param count 通道数
+ */
+void fft_real_batch(const FFTPlan *plan, const float *const inputs[], const float *window,
+                    FreqResponse *const outputs[], int count);
+
+/**
+ * 单通道实数FFT
+ * @param plan FFT计划
+ * @param input 输入（length个样本）
+ * @param window 窗函数，NULL表示不加窗
+ * @param output 输出频谱
+ */
+void fft_real(const FFTPlan *plan, const float *input, const float *window, FreqResponse *output);
+
+/**
+ * 批量复数FFT（plan->half点，即实数计划长度的一半）
+ * @param plan FFT计划
+ * @param in_re 各通道输入实部（plan->half个样本）
+ * @param in_im 各通道输入虚部
+ * @param outputs 各通道输出，前plan->half个为DFT结果（频点k对应k/half周期每样本），其余置0
+ * @param count 通道数
+ */
+void fft_complex_batch(const FFTPlan *plan, const float *const in_re[], const float *const in_im[],
+                       FreqResponse *const outputs[], int count);
+
+/**
+ * 实数逆FFT：由正频率部分（length/2+1个频点，共轭对称）恢复length个实数样本，含1/length缩放
+ * 按N/2点复数逆FFT（共轭 + 正向复数FFT）+ 拆分的逆过程实现
+ * @param plan FFT计划
+ * @param input 输入频谱
+ * @param output 输出样本（length个）
+ */
+void fft_real_inverse(const FFTPlan *plan, const FreqResponse *input, float *output);
+
+#endif // FFT_H
@@ -4,13 +4,24 @@
 #define MAX_FIR_LENGTH 8192
 
 // FIR滤波器结构体
+// 带整数前导延迟: y[n] = Σ h[k] * x[n - delay - k]，延迟线长度为delay + length
 typedef struct {
     float coeffs[MAX_FIR_LENGTH];  // 滤波器系数(冲击响应)
     float buffer[MAX_FIR_LENGTH];  // 延迟线缓冲区
     int length;                     // 滤波器长度
+    int delay;                      // 前导延迟（样本），只占延迟线不参与乘加
     int write_index;                // 循环缓冲区写指针
 } FIRFilter;
 
+// 冲击响应压缩结果：有效部分为 ir[delay, delay + length)
+typedef struct {
+    int raw_length;                 // 原始抽头数
+    int delay;                      // 检出的前导延迟（去除的首部抽头数）
+    int length;                     // 保留的有效抽头数
+    int tail_removed;               // 去除的尾部抽头数
+    float removed_energy_db;        // 去除部分能量 / 总能量 (dB)，即冲击响应的相对误差能量
+} FIRCompaction;
+
 /**
  * 初始化FIR滤波器
  * @param fir 滤波器结构体
@@ -19,6 +30,27 @@ typedef struct {
  */
 void fir_init(FIRFilter *fir, const float *coeffs, int length);
 
+/**
+ * 初始化带前导延迟的FIR滤波器
+ * 延迟只占延迟线，每样本乘加次数仍为length
+ * @param fir 滤波器结构体
+ * @param coeffs 有效部分的滤波器系数
+ * @param length 有效部分长度
+ * @param delay 前导延迟（样本），delay + length <= MAX_FIR_LENGTH
+ */
+void fir_init_delayed(FIRFilter *fir, const float *coeffs, int length, int delay);
+
+/**
+ * 分析冲击响应并确定可去除的首尾
+ * 首部（声学传播延迟）和尾部（低于噪底的残响）各自去除能量不超过总能量×门限/2的抽头，
+ * 首部改用整数延迟表示
+ * @param ir 原始冲击响应
+ * @param length 原始长度
+ * @param threshold_db 允许去除的能量占总能量之比 (dB，如-80)
+ * @param result 输出压缩结果（全零冲击响应不压缩）
+ */
+void fir_compact(const float *ir, int length, float threshold_db, FIRCompaction *result);
+
 /**
  * FIR滤波单个样本
  * @param fir 滤波器结构体
@@ -36,6 +68,29 @@ float fir_process(FIRFilter *fir, float input);
  */
 void fir_process_block(FIRFilter *fir, const float *input, float *output, int num_samples);
 
+/**
+ * 无状态线性卷积的一段输出（input[0]之前视为0）
+ * output[i] = Σ_k coeffs[k] * input[offset + i - k]，累加顺序与fir_process一致；
+ * 带前导延迟的滤波器传入offset - delay（可为负）
+ * @param coeffs 滤波器系数
+ * @param length 滤波器长度
+ * @param input 输入序列（至少offset + num_samples个样本）
+ * @param offset 第一个输出对应的输入位置
+ * @param output 输出样本数组
+ * @param num_samples 输出样本数
+ */
+void fir_convolve(const float *coeffs, int length, const float *input, int offset,
+                  float *output, int num_samples);
+
+/**
+ * 直接设置延迟线（不计算输出）
+ * 状态等同于fir_reset后对total_samples个输入逐样本调用fir_process
+ * @param fir 滤波器结构体
+ * @param tail 这些输入的最后min(total_samples, delay + length)个样本
+ * @param total_samples 输入总数
+ */
+void fir_set_history(FIRFilter *fir, const float *tail, int total_samples);
+
 /**
  * 重置FIR滤波器状态
  * @param fir 滤波器结构体
@@ -0,0 +1,67 @@
+#ifndef FXLMS_H
+#define FXLMS_H
+
+#include "config.h"
+#include "time_domain_sim.h"
+
+// 时域滤波参考LMS（FxLMS）控制器
+// 在仿真器采样率上逐样本运行，每个参考麦一路L抽头自适应FIR:
+//   y_r[n] = Σ_k w_r[k] x_r[n-k]                      控制器输出（扬声器驱动）
+//   e_e[n] = d_e[n] - Σ_r (S_er * y_r)[n]             误差麦（d为原始误差麦）
+//   w_r   += mu / (epsilon + P_r) · Σ_e e_e[n] x'_er[n-k]
+// 其中 x'_er = Ŝ_er * x_r 为经次级路径估计滤波的参考，P_r = Σ_e ||x'_er窗口||²；
+// 仿真中次级路径估计与被控对象相同（仿真器的次级路径FIR）
+// 滤波参考与闭环无关，每块一次批量卷积；逐样本只有两次点积和一次axpy，内循环SSE向量化
+
+typedef struct {
+    int num_taps;                   // 控制器抽头数L
+    float mu;
+    float epsilon;
+
+    // 次级路径（时间倒序，与驱动信号历史正序点积）
+    int sp_length;
+    int sp_delay;
+    float *sp_rev[ANC_NUM_ERR][ANC_NUM_REF];
+
+    // 控制器系数（时间倒序: w[j]乘x[n-L+1+j]）
+    float *w[ANC_NUM_REF];
+
+    // 上一块末尾的驱动信号（sp_delay + sp_length - 1个样本），块间闭环连续
+    float *drive_tail[ANC_NUM_REF];
+
+    long long samples;              // 已处理样本数
+} FxlmsController;
+
+/**
+ * 初始化控制器（系数清零）
+ * @param ctrl 控制器
+ * @param params 步长和抽头数
+ * @param sim 仿真器（取次级路径FIR）
+ * @return 0=成功, -1=内存分配失败
+ */
+int fxlms_init(FxlmsController *ctrl, const FxlmsParams *params, const TimeDomainSimulator *sim);
+
+/**
+ * 闭环处理仿真器当前位置起的一段信号：逐样本输出、更新控制器，
+ * 降噪后误差麦写入simulated_fb，游标前移
+ * @param ctrl 控制器
+ * @param sim 仿真器
+ * @param num_samples 样本数（超出信号末尾时截断）
+ * @return 处理的样本数，-1表示内存分配失败
+ */
+int fxlms_process(FxlmsController *ctrl, TimeDomainSimulator *sim, int num_samples);
+
+/**
+ * 控制器系数范数（全部参考麦）
+ * @param ctrl 控制器
+ * @return ||W||
+ */
+float fxlms_weight_norm(const FxlmsController *ctrl);
+
+/**
+ * 释放控制器
+ * @param ctrl 控制器
+ */
+void fxlms_free(FxlmsController *ctrl);
+
+#endif // FXLMS_H
@@ -38,4 +38,10 @@ void log_printf(const char *format, ...);
  */
 void logger_flush(void);
 
+/**
+ * 设置当前线程是否静默（只影响调用线程的log_printf）
+ * @param quiet 1=静默, 0=正常输出
+ */
+void logger_set_thread_quiet(int quiet);
+
 #endif // LOGGER_H
@@ -0,0 +1,66 @@
+#ifndef PARAMS_H
+#define PARAMS_H
+
+#include "config.h"
+
+// 参数值类型
+typedef enum {
+    PARAM_FLOAT = 0,
+    PARAM_INT
+} ParamType;
+
+// 参数描述（名称 → AncParams中的位置）
+typedef struct {
+    const char *name;       // 参数名（小写，与coeffs.h宏名对应）
+    ParamType type;
+    size_t offset;          // 在AncParams中的偏移
+    double min_val;         // 合法范围
+    double max_val;
+} AncParamDesc;
+
+/**
+ * 用coeffs.h中的宏填充默认参数
+ * @param params 输出参数
+ */
+void anc_params_default(AncParams *params);
+
+/**
+ * 按名称查找参数描述
+ * @param name 参数名
+ * @return 参数描述，未找到返回NULL
+ */
+const AncParamDesc *anc_params_find(const char *name);
+
+/**
+ * 读取参数值
+ * @param params 参数
+ * @param desc 参数描述
+ * @return 参数值
+ */
+double anc_params_get(const AncParams *params, const AncParamDesc *desc);
+
+/**
+ * 设置参数值（整型参数四舍五入，超出合法范围返回失败）
+ * @param params 参数
+ * @param desc 参数描述
+ * @param value 参数值
+ * @return 0=成功, -1=超出范围
+ */
+int anc_params_set(AncParams *params, const AncParamDesc *desc, double value);
+
+/**
+ * 解析 "name=value" 形式的参数赋值
+ * @param params 参数
+ * @param assignment 赋值字符串
+ * @return 0=成功, -1=格式错误、参数不存在或超出范围
+ */
+int anc_params_parse(AncParams *params, const char *assignment);
+
+/**
+ * 参数表（遍历用）
+ * @param count 输出参数个数
+ * @return 参数描述数组
+ */
+const AncParamDesc *anc_params_table(int *count);
+
+#endif // PARAMS_H
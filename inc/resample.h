@@ -0,0 +1,35 @@
+#ifndef RESAMPLE_H
+#define RESAMPLE_H
+
+// 有理数比率重采样（多相窗函数sinc）
+// 采样率比约分为 fs_out/fs_in = L/M，输出样本k对应输入时刻 t = k*M/L（零相位，不引入延迟），
+// 按 t 的小数部分（L种相位）查预先算好的低通抽头:
+//   h(d) = 2c·sinc(2c·d)·Blackman(d/K)，d = n - t，|d| < K
+// 截止 c 取两侧较低Nyquist频率的RESAMPLE_CUTOFF倍，半宽K覆盖RESAMPLE_ZERO_CROSSINGS个过零点，
+// 各相位抽头和归一化为1（直流增益1）；信号起点之前、终点之后视为0
+
+#define RESAMPLE_ZERO_CROSSINGS 16      // 低通半宽（过零点数）
+#define RESAMPLE_CUTOFF         0.9     // 截止频率 / 较低的Nyquist频率
+#define RESAMPLE_MAX_PHASES     1024    // 约分后L的上限（相位表大小 L × 2K）
+
+/**
+ * 重采样后的样本数 ceil(in_len * out_rate / in_rate)
+ * @param in_len 输入样本数
+ * @param in_rate 输入采样率 (Hz)
+ * @param out_rate 输出采样率 (Hz)
+ * @return 输出样本数
+ */
+int resample_length(int in_len, int in_rate, int out_rate);
+
+/**
+ * 重采样一段信号
+ * @param in 输入信号
+ * @param in_len 输入样本数
+ * @param in_rate 输入采样率 (Hz)
+ * @param out_rate 输出采样率 (Hz)
+ * @param out 输出缓冲区（resample_length(in_len, in_rate, out_rate)个样本）
+ * @return 0=成功, -1=采样率无效、约分后相位数超过RESAMPLE_MAX_PHASES或内存不足
+ */
+int resample_signal(const float *in, int in_len, int in_rate, int out_rate, float *out);
+
+#endif // RESAMPLE_H
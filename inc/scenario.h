@@ -0,0 +1,71 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "config.h"
+
+#define SCENARIO_MAX_TONES      16      // 最多单频分量数
+#define SCENARIO_MAX_CHANGES    16      // 最多主路径变化次数
+
+// 单频分量（各参考麦同频同幅，初相由种子决定）
+typedef struct {
+    float freq_hz;
+    float amplitude;
+} ScenarioTone;
+
+// 主路径时变：从time_s起主路径增益乘gain_scale、附加delay_ms延迟（均相对初始主路径）
+typedef struct {
+    float time_s;
+    float gain_scale;
+    float delay_ms;
+} ScenarioChange;
+
+// 合成场景配置
+// 参考麦 = 宽带噪声（各通道独立）+ 单频分量；误差麦 = Σ参考麦经主路径 + 非相干传感器噪声
+typedef struct {
+    unsigned int seed;                  // 随机种子（相同种子逐样本可复现）
+    float duration_s;                   // 时长 (s)
+    int sample_rate;                    // 采样率 (Hz)，固定为REALTIME_SAMPLE_RATE
+    float broadband_rms;                // 宽带噪声RMS
+    float broadband_cutoff_hz;          // 宽带噪声一阶低通截止频率 (Hz)，0=白噪声
+    int num_tones;
+    ScenarioTone tones[SCENARIO_MAX_TONES];
+    float primary_delay_ms;             // 主路径传播延迟 (ms)
+    float primary_gain;                 // 主路径直流增益
+    float primary_decay_ms;             // 主路径衰减时间常数 (ms)
+    float primary_resonance_hz;         // 主路径谐振频率 (Hz)，0=纯衰减
+    char primary_ir_path[256];          // 非空时从文件加载主路径冲击响应（替代上面的参数化形状）
+    int num_changes;
+    ScenarioChange changes[SCENARIO_MAX_CHANGES];   // 按时刻升序
+    float sensor_noise_rms;             // 误差麦非相干噪声RMS
+} ScenarioSpec;
+
+/**
+ * 默认场景（无输入WAV时使用）
+ * @param spec 输出配置
+ */
+void scenario_default(ScenarioSpec *spec);
+
+/**
+ * 解析场景配置文件（未出现的项取默认值）
+ * 每行一条: "seed S", "duration 秒", "broadband RMS 截止Hz", "tone 频率 幅度",
+ * "primary 延迟ms 增益 衰减ms 谐振Hz", "primary_ir 文件", "change 时刻s 增益倍数 附加延迟ms",
+ * "sensor_noise RMS", "static"（无主路径变化），#后为注释；
+ * 首次出现tone/change时替换默认列表
+ * @param filename 配置文件路径
+ * @param spec 输出配置
+ * @return 0=成功, -1=失败
+ */
+int scenario_load_spec(const char *filename, ScenarioSpec *spec);
+
+/**
+ * 合成场景信号
+ * 误差麦的主路径卷积按时间分块在线程池上并行，结果与线程数无关
+ * @param spec 场景配置
+ * @param ff 输出各参考麦信号（malloc分配，调用者free）
+ * @param fb 输出各误差麦信号（malloc分配，调用者free）
+ * @param num_threads 线程数
+ * @return 样本数，-1表示失败
+ */
+int scenario_generate(const ScenarioSpec *spec, float *ff[], float *fb[], int num_threads);
+
+#endif // SCENARIO_H
@@ -0,0 +1,54 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "config.h"
+#include "analysis_bins.h"
+
+// 事件驱动自适应调度
+// 每轮FFT平均结束时决定是否执行CAL_MU ~ UPDATE_FILTER_COEFFS：
+//   - 尚无比较基准，或上次自适应接受了更新且此后总残差下降超过converge_db（仍在收敛）：自适应
+//   - 已连续跳过max_idle_rounds轮：自适应
+//   - 任一参考麦频带能量变化超过change_db、任一(误差麦, 参考麦)频带相干度变化超过
+//     coherence_delta、或任一误差麦频带能量上升超过residual_rise_db：自适应
+//   - 否则跳过本轮（FFT平均照常进行，供下一轮比较）
+// 每次自适应都把本轮汇总记为新的比较基准
+
+/**
+ * 初始化调度器：评估网格频段 [freq_low, freq_high] 内的分析频点按对数频率分为SCHED_NUM_BANDS个频带
+ * @param sched 调度器
+ * @param bins 分析频点表
+ * @param freq_low 汇总频段下限 (Hz)
+ * @param freq_high 汇总频段上限 (Hz)
+ */
+void scheduler_init(AdaptScheduler *sched, const AnalysisBins *bins, float freq_low, float freq_high);
+
+/**
+ * 开始新一轮FFT平均：清空逐hop累积
+ * @param sched 调度器
+ */
+void scheduler_begin_round(AdaptScheduler *sched);
+
+/**
+ * 累积一个hop的功率谱和互谱（只累积参与汇总的频点）
+ * @param sched 调度器
+ * @param ff 各参考麦频谱
+ * @param fb 各误差麦频谱
+ */
+void scheduler_accumulate(AdaptScheduler *sched, const FreqResponse *ff, const FreqResponse *fb);
+
+/**
+ * 一轮FFT平均结束：汇总本轮并决定是否自适应
+ * @param sched 调度器
+ * @param thr 门限
+ * @return 1=执行自适应, 0=跳过本轮
+ */
+int scheduler_should_adapt(AdaptScheduler *sched, const SchedulerThresholds *thr);
+
+/**
+ * 一轮自适应结束（含稳定性检测未通过）
+ * @param sched 调度器
+ * @param updated 是否接受了更新
+ */
+void scheduler_end_adapt(AdaptScheduler *sched, int updated);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,91 @@
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include "config.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 单生产者单消费者(SPSC)共享内存环形缓冲区（POSIX shm_open + mmap）
+// 布局: [ShmRingHeader][capacity帧 x num_channels交错float]
+// 读写位置为单调递增的帧计数，取模capacity（2的幂）定位；生产者先写数据再以release发布
+// write_pos，消费者以acquire读取，反向同理，无需加锁
+
+#define SHM_RING_MAGIC          0x474E5252u  // "RRNG"
+#define SHM_RING_VERSION        1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_channels;              // 每帧通道数（交错存放）
+    uint32_t sample_rate;               // 生产者采样率 (Hz)
+    uint32_t capacity;                  // 容量（帧，2的幂）
+    uint32_t reserved;
+    // 读写位置分置不同缓存行，避免生产者和消费者互相失效
+    ANC_ALIGN(64) _Atomic uint64_t write_pos;   // 生产者已写入的帧数
+    ANC_ALIGN(64) _Atomic uint64_t read_pos;    // 消费者已读取的帧数
+    ANC_ALIGN(64) _Atomic uint32_t closed;      // 生产者写完后置1
+    _Atomic uint64_t dropped;                   // 缓冲区满时生产者丢弃的帧数
+} ShmRingHeader;
+
+typedef struct {
+    ShmRingHeader *header;
+    float *data;                        // 交错帧数据
+    size_t map_size;
+    int owner;                          // 1=创建者（销毁时删除共享内存对象）
+    char name[64];
+} ShmRing;
+
+/**
+ * 创建共享内存环形缓冲区（生产者调用，同名对象已存在时覆盖）
+ * @param ring 环形缓冲区
+ * @param name 共享内存对象名（POSIX要求以'/'开头）
+ * @param num_channels 每帧通道数
+ * @param sample_rate 采样率 (Hz)
+ * @param capacity 容量（帧，向上取整到2的幂）
+ * @return 0成功，-1失败（或当前平台不支持）
+ */
+int shm_ring_create(ShmRing *ring, const char *name, int num_channels, int sample_rate,
+                    int capacity);
+
+/**
+ * 连接已存在的共享内存环形缓冲区（消费者调用）
+ * @return 0成功，-1不存在或格式不符
+ */
+int shm_ring_open(ShmRing *ring, const char *name);
+
+/**
+ * 写入交错帧（生产者），空间不足时整块丢弃并累加dropped
+ * @param frames 交错样本，num_frames x num_channels
+ * @return 写入的帧数（0或num_frames）
+ */
+int shm_ring_write(ShmRing *ring, const float *frames, int num_frames);
+
+/**
+ * 读取交错帧（消费者），可用帧不足时不读
+ * @param frames 输出，num_frames x num_channels
+ * @return 读取的帧数（0或num_frames）
+ */
+int shm_ring_read(ShmRing *ring, float *frames, int num_frames);
+
+/**
+ * 当前可读帧数
+ */
+int shm_ring_available(const ShmRing *ring);
+
+/**
+ * 生产者标记写入结束
+ */
+void shm_ring_close_writer(ShmRing *ring);
+
+/**
+ * 生产者是否已结束写入
+ */
+int shm_ring_is_closed(const ShmRing *ring);
+
+/**
+ * 解除映射；创建者同时删除共享内存对象
+ */
+void shm_ring_destroy(ShmRing *ring);
+
+#endif // SHM_RING_H
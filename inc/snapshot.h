@@ -0,0 +1,86 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "config.h"
+#include "time_domain_sim.h"
+
+// 快照文件格式版本（SystemState等结构体布局变化时递增）
+#define SNAPSHOT_VERSION        14
+#define SNAPSHOT_MAGIC          "ANCSNAP"
+#define SNAPSHOT_ALIGN          64         // 各数据段起始偏移对齐，便于mmap后直接访问
+
+// 数据段类型
+typedef enum {
+    SNAPSHOT_SECTION_COUNTERS = 1,  // 主循环迭代计数
+    SNAPSHOT_SECTION_SYSTEM_STATE,  // SystemState原始镜像
+    SNAPSHOT_SECTION_SIM_STATE,     // 仿真器游标和滤波器状态
+    SNAPSHOT_SECTION_SIM_OUTPUT,    // 各误差麦simulated_fb全长（依次拼接）
+    SNAPSHOT_NUM_SECTIONS = 4
+} SnapshotSectionId;
+
+// 文件头（固定64字节）
+typedef struct {
+    char magic[8];              // "ANCSNAP\0"
+    uint32_t version;           // SNAPSHOT_VERSION
+    uint32_t header_size;       // sizeof(SnapshotHeader)
+    uint32_t num_sections;      // 段表项数
+    uint32_t reserved;
+    uint64_t file_size;         // 文件总长度
+    uint64_t input_hash;        // 原始FF/FB信号（全部通道）的FNV-1a哈希，恢复时校验输入一致
+    uint8_t padding[24];
+} SnapshotHeader;
+
+// 段表项（紧跟文件头）
+typedef struct {
+    uint32_t id;                // SnapshotSectionId
+    uint32_t reserved;
+    uint64_t offset;            // 段起始偏移（SNAPSHOT_ALIGN对齐）
+    uint64_t size;              // 段长度（字节）
+} SnapshotSection;
+
+// 主循环自适应计数
+typedef struct {
+    int32_t iteration;          // 下一轮迭代序号
+    int32_t updates_applied;    // 已应用的参数更新次数
+    int32_t sample_rate;        // 输入采样率
+    float iteration_time_ms;    // 每轮迭代时长
+} SnapshotCounters;
+
+// 仿真器游标和滤波器状态
+typedef struct {
+    int32_t total_samples;
+    int32_t current_sample;
+    int32_t num_ref;
+    int32_t num_err;
+    BiquadTimeDomainState biquad_states[ANC_NUM_REF][NUM_BIQUADS];
+    int32_t fir_length;
+    int32_t fir_delay;
+    int32_t fir_write_index[ANC_NUM_ERR][ANC_NUM_REF];
+    float fir_buffer[ANC_NUM_ERR][ANC_NUM_REF][MAX_FIR_LENGTH];
+} SnapshotSimState;
+
+/**
+ * 保存引擎快照
+ * @param filename 快照文件路径
+ * @param state 系统状态
+ * @param sim 时域仿真器
+ * @param counters 主循环计数
+ * @return 0=成功, -1=失败
+ */
+int snapshot_save(const char *filename, const SystemState *state,
+                  const TimeDomainSimulator *sim, const SnapshotCounters *counters);
+
+/**
+ * 从快照恢复引擎状态
+ * 仿真器须已用同一输入初始化（校验样本数和输入哈希），恢复游标、滤波器状态和simulated_fb
+ * @param filename 快照文件路径
+ * @param state 输出系统状态
+ * @param sim 时域仿真器
+ * @param counters 输出主循环计数
+ * @return 0=成功, -1=失败
+ */
+int snapshot_load(const char *filename, SystemState *state,
+                  TimeDomainSimulator *sim, SnapshotCounters *counters);
+
+#endif // SNAPSHOT_H
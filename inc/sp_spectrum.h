@@ -0,0 +1,51 @@
+#ifndef SP_SPECTRUM_H
+#define SP_SPECTRUM_H
+
+#include <stdint.h>
+#include "config.h"
+#include "analysis_bins.h"
+
+// 次级路径DSP频响：由实时采样率下的冲击响应计算，按冲击响应内容哈希缓存到磁盘
+typedef struct {
+    uint64_t key;                                   // 缓存键（冲击响应内容 + 采样率和分析频点）
+    FreqResponse response;                          // S(ω)，分析频点，补零区为0
+    ANC_ALIGN(64) float power[SPECTRUM_LENGTH];     // |S(ω)|²，供calculate_mu使用
+} SpSpectrum;
+
+/**
+ * 计算缓存键：冲击响应内容的FNV-1a哈希（含长度、采样率和分析频点）
+ * @param ir 冲击响应
+ * @param length 抽头数
+ * @param sample_rate 冲击响应采样率 (Hz)
+ * @param bins 分析频点表
+ * @return 缓存键
+ */
+uint64_t sp_spectrum_key(const float *ir, int length, int sample_rate, const AnalysisBins *bins);
+
+/**
+ * 由冲击响应计算分析频点上的频响
+ * 直接在各分析频点 f_k 求冲击响应的DTFT；全频带时 f_k = k*DSP_SAMPLE_RATE/FFT_LENGTH，
+ * 等价于理想抗混叠重采样到DSP采样率后做FFT_LENGTH点FFT，且没有重采样误差
+ * @param ir 冲击响应
+ * @param length 抽头数
+ * @param sample_rate 冲击响应采样率 (Hz)
+ * @param bins 分析频点表
+ * @param sp 输出频响（同时填写key和power）
+ */
+void sp_spectrum_compute(const float *ir, int length, int sample_rate, const AnalysisBins *bins,
+                         SpSpectrum *sp);
+
+/**
+ * 加载次级路径频响：缓存命中时直接读取，否则计算并写入缓存
+ * 缓存文件按键命名（SP_SPECTRUM_CACHE_FORMAT），写入失败不影响结果
+ * @param ir 冲击响应
+ * @param length 抽头数
+ * @param sample_rate 冲击响应采样率 (Hz)
+ * @param bins 分析频点表
+ * @param sp 输出频响
+ * @return 1=缓存命中, 0=重新计算
+ */
+int sp_spectrum_load(const float *ir, int length, int sample_rate, const AnalysisBins *bins,
+                     SpSpectrum *sp);
+
+#endif // SP_SPECTRUM_H
@@ -0,0 +1,134 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include "config.h"
+
+// SoA频谱向量化内核
+// 所有整谱内核处理全部SPECTRUM_LENGTH个频点（补零区结果仍为0），
+// x86下使用SSE，其余平台回退到标量实现
+
+// 单频点读写
+static inline Complex spectrum_get(const FreqResponse *x, int k) {
+    Complex result = {x->re[k], x->im[k]};
+    return result;
+}
+
+static inline void spectrum_set(FreqResponse *x, int k, Complex value) {
+    x->re[k] = value.real;
+    x->im[k] = value.imag;
+}
+
+/**
+ * 清零频谱（含补零区）
+ * @param x 频谱
+ */
+void spectrum_clear(FreqResponse *x);
+
+/**
+ * 累加: acc += x
+ * @param acc 累积频谱
+ * @param x 输入频谱
+ */
+void spectrum_accumulate(FreqResponse *acc, const FreqResponse *x);
+
+/**
+ * 缩放: dst = src * scale
+ * @param dst 输出频谱（可与src相同）
+ * @param src 输入频谱
+ * @param scale 缩放系数
+ */
+void spectrum_scale(FreqResponse *dst, const FreqResponse *src, float scale);
+
+/**
+ * 除法累加: acc += num / den
+ * 与complex_div相同，|den|² <= 1e-10 的频点结果为0
+ * @param acc 累积频谱
+ * @param num 分子频谱
+ * @param den 分母频谱
+ */
+void spectrum_div_accumulate(FreqResponse *acc, const FreqResponse *num, const FreqResponse *den);
+
+/**
+ * 复数乘累加（前count个频点）: acc += a · b
+ * @param acc 累积频谱
+ * @param a 频谱a
+ * @param b 频谱b
+ * @param count 频点数（向上取整到4的倍数，不超过SPECTRUM_LENGTH）
+ */
+void spectrum_mul_accumulate(FreqResponse *acc, const FreqResponse *a, const FreqResponse *b,
+                             int count);
+
+/**
+ * 加权共轭乘累加（前count个频点）: acc += weight · conj(a) · b
+ * @param acc 累积频谱
+ * @param a 频谱a（取共轭）
+ * @param b 频谱b
+ * @param weight 各频点权重（64字节对齐）
+ * @param count 频点数（向上取整到4的倍数，不超过SPECTRUM_LENGTH）
+ */
+void spectrum_conj_mul_accumulate(FreqResponse *acc, const FreqResponse *a, const FreqResponse *b,
+                                  const float *weight, int count);
+
+/**
+ * 功率谱: power = |x|²
+ * @param power 输出数组（SPECTRUM_LENGTH个，64字节对齐）
+ * @param x 输入频谱
+ */
+void spectrum_power(float *power, const FreqResponse *x);
+
+/**
+ * 幅度谱（区间）: mag[i] = |x[start + i]|
+ * @param mag 输出数组
+ * @param x 输入频谱
+ * @param start 起始频点
+ * @param count 频点数
+ */
+void spectrum_magnitude(float *mag, const FreqResponse *x, int start, int count);
+
+/**
+ * 步长计算: mu = clamp(mu_max / (|S|² * |X_ff|² + reg), mu_min, mu_max)
+ * @param mu 输出步长数组（SPECTRUM_LENGTH个，64字节对齐）
+ * @param ff 参考麦平均频谱
+ * @param sp_power 次级路径功率谱|S|²
+ * @param mu_min 步长下限
+ * @param mu_max 步长上限（同时作为基准步长）
+ * @param regularization 正则项
+ */
+void spectrum_calc_mu(float *mu, const FreqResponse *ff, const float *sp_power,
+                      float mu_min, float mu_max, float regularization);
+
+/**
+ * 目标频响: target = current + mu * pp / sp
+ * |sp|² <= 1e-10 的频点更新量为0（与原SP_EPSILON幅度保护 + complex_div的结果一致）
+ * @param target 输出目标频响
+ * @param current 当前FF频响
+ * @param pp 主路径传函平均
+ * @param sp 次级路径频响
+ * @param mu 步长数组
+ */
+void spectrum_calc_target(FreqResponse *target, const FreqResponse *current,
+                          const FreqResponse *pp, const FreqResponse *sp, const float *mu);
+
+/**
+ * 全频点误差能量: Σ|a - b|²
+ * @param a 频谱a
+ * @param b 频谱b
+ * @return 误差能量和（未归一化）
+ */
+float spectrum_loss(const FreqResponse *a, const FreqResponse *b);
+
+/**
+ * 紧凑数组上的加权误差能量: Σ w * |a - b|²
+ * @param a_re a实部
+ * @param a_im a虚部
+ * @param b_re b实部
+ * @param b_im b虚部
+ * @param weights 权重
+ * @param length 长度（4的倍数，数组16字节对齐）
+ * @return 加权误差能量和（未归一化）
+ */
+float spectrum_weighted_loss(const float *a_re, const float *a_im,
+                             const float *b_re, const float *b_im,
+                             const float *weights, int length);
+
+#endif // SPECTRUM_H
@@ -0,0 +1,36 @@
+#ifndef STABILITY_H
+#define STABILITY_H
+
+#include "config.h"
+#include "analysis_bins.h"
+
+/**
+ * 初始化稳定性检测器
+ * 上一次目标的dB缓存初始化为静音电平（与原先prev_target_ff清零一致）
+ * @param chk 检测器
+ * @param bins 分析频点表
+ * @param freq_low 检测频段下限 (Hz)
+ * @param freq_high 检测频段上限 (Hz)
+ * @param thr 检测阈值
+ */
+void stability_init(StabilityChecker *chk, const AnalysisBins *bins, float freq_low,
+                    float freq_high, const StabilityThresholds *thr);
+
+/**
+ * 检测目标频响是否稳定
+ * 一次融合遍历计算全部指标，每块结束后按代价顺序尝试提前判定失败；
+ * 只做判定，不改动下次检测的参考（见stability_commit）
+ * @param chk 检测器
+ * @param target 目标频响
+ * @return 1=通过, 0=异常
+ */
+int stability_check(StabilityChecker *chk, const FreqResponse *target);
+
+/**
+ * 采纳最近一次通过的检测：更新平滑度基准并缓存其dB曲线，作为下次检测的参考
+ * 多通道时须全部通道通过后再逐通道调用，避免未生效的目标成为参考
+ * @param chk 检测器（最近一次stability_check返回1）
+ */
+void stability_commit(StabilityChecker *chk);
+
+#endif // STABILITY_H
@@ -0,0 +1,67 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "config.h"
+#include "params.h"
+#include "band_analysis.h"
+
+#define SWEEP_MAX_PARAMS        16      // 最多扫描的参数个数
+#define SWEEP_MAX_VALUES        32      // 网格模式每个参数最多取值数
+#define SWEEP_MAX_CONFIGS       4096    // 最多配置数
+
+// 扫参模式
+typedef enum {
+    SWEEP_GRID = 0,         // 网格：各参数取值列表的笛卡尔积
+    SWEEP_RANDOM            // 随机搜索：各参数在[下限, 上限]内均匀采样
+} SweepMode;
+
+// 扫参配置（由配置文件解析得到）
+typedef struct {
+    SweepMode mode;
+    int num_samples;                                // 随机模式采样数
+    unsigned int seed;                              // 随机模式种子
+    int num_params;
+    const AncParamDesc *params[SWEEP_MAX_PARAMS];
+    int num_values[SWEEP_MAX_PARAMS];
+    double values[SWEEP_MAX_PARAMS][SWEEP_MAX_VALUES];  // 网格: 取值列表; 随机: [下限, 上限]
+} SweepSpec;
+
+// 单个配置的评估结果
+typedef struct {
+    int status;                     // 0=成功, -1=评估失败
+    float final_attenuation_db;     // 最后一轮的误差麦降噪量 (dB)
+    float convergence_ms;           // 收敛时间：此后各轮降噪量与最终值之差不超过容差 (ms)
+    int iterations;                 // 实际迭代轮数
+    int updates_applied;            // 应用的参数更新次数
+    float adapt_cpu_ms;             // 自适应计算耗时（DSP处理、重滤波或引擎闭环，ms）
+    int num_bands;                  // 分频带降噪量频带数（见band_layout）
+    float band_attenuation_db[BAND_MAX_BANDS];  // 最后一轮各频带降噪量 (dB)
+} SweepResult;
+
+// 评估函数：用给定参数完整运行一次自适应，可被多个线程同时调用
+typedef int (*SweepEvalFn)(const AncParams *params, SweepResult *result, void *ctx);
+
+/**
+ * 解析扫参配置文件
+ * 每行一条: "mode grid|random", "samples N", "seed S",
+ * 或 "<参数名> v1 v2 ..."（网格取值列表；随机模式为下限 上限），#后为注释
+ * @param filename 配置文件路径
+ * @param spec 输出配置
+ * @return 0=成功, -1=失败
+ */
+int sweep_load_spec(const char *filename, SweepSpec *spec);
+
+/**
+ * 在线程池上评估全部配置，按最终降噪量降序（相同时收敛时间升序）排名并写入CSV
+ * @param spec 扫参配置
+ * @param base 基准参数（未扫描的参数取此值）
+ * @param eval 评估函数
+ * @param ctx 评估函数上下文（共享只读输入）
+ * @param num_threads 线程数
+ * @param csv_path 排名表输出路径
+ * @return 0=成功, -1=失败
+ */
+int sweep_run(const SweepSpec *spec, const AncParams *base, SweepEvalFn eval, void *ctx,
+              int num_threads, const char *csv_path);
+
+#endif // SWEEP_H
@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// 任务函数：job_index为任务序号 [0, num_jobs)
+typedef void (*ThreadPoolJobFn)(void *ctx, int job_index);
+
+/**
+ * 并行执行一批相互独立的任务，全部完成后返回
+ * 工作线程依次领取下一个未执行的任务序号（动态负载均衡）
+ * @param num_threads 线程数（<=1时在调用线程串行执行）
+ * @param num_jobs 任务数
+ * @param fn 任务函数
+ * @param ctx 任务上下文（各线程共享，只读或由任务自行按序号分区）
+ * @return 0=成功, -1=线程创建失败（已创建的线程仍会完成全部任务）
+ */
+int thread_pool_run(int num_threads, int num_jobs, ThreadPoolJobFn fn, void *ctx);
+
+// 常驻线程池：线程创建一次，每批任务只需唤醒，适合高频小批量任务（如每hop的通道并行）
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * 创建常驻线程池
+ * @param num_threads 参与执行的线程数（含调用线程，额外创建num_threads-1个工作线程）
+ * @return 线程池，失败返回NULL；部分线程创建失败时以已创建的线程继续
+ */
+ThreadPool *thread_pool_create(int num_threads);
+
+/**
+ * 在线程池上执行一批任务，调用线程也参与执行，全部完成后返回（屏障）
+ * 同一线程池不可被多个线程同时调用
+ * @param pool 线程池（NULL时在调用线程串行执行）
+ * @param num_jobs 任务数
+ * @param fn 任务函数
+ * @param ctx 任务上下文
+ */
+void thread_pool_dispatch(ThreadPool *pool, int num_jobs, ThreadPoolJobFn fn, void *ctx);
+
+/**
+ * 线程池线程数（含调用线程）
+ * @param pool 线程池（NULL返回1）
+ * @return 线程数
+ */
+int thread_pool_size(const ThreadPool *pool);
+
+/**
+ * 结束工作线程并释放线程池
+ * @param pool 线程池（可为NULL）
+ */
+void thread_pool_destroy(ThreadPool *pool);
+
+/**
+ * 可用CPU核数
+ * @return 核数（至少为1）
+ */
+int thread_pool_num_cpus(void);
+
+#endif // THREAD_POOL_H
@@ -4,6 +4,8 @@
 #include "config.h"
 #include "fir_filter.h"
 
+#define SIM_MAX_THREADS 64   // 分段并行滤波最多线程数
+
 // Biquad时域滤波器状态
 typedef struct {
     float x1, x2;  // 输入延迟
@@ -12,16 +14,17 @@ typedef struct {
 
 // 时域仿真器结构体
 typedef struct {
-    // Biquad级联滤波器(10级)
-    BiquadTimeDomainState biquad_states[NUM_BIQUADS];
+    // Biquad级联滤波器(10级)，每个参考麦一组
+    BiquadTimeDomainState biquad_states[ANC_NUM_REF][NUM_BIQUADS];
     
-    // 次级路径FIR滤波器
-    FIRFilter secondary_path_fir;
+    // 次级路径FIR滤波器：扬声器r到误差麦e
+    FIRFilter secondary_path_fir[ANC_NUM_ERR][ANC_NUM_REF];
     
-    // 原始信号存储
-    float *original_ff;      // 原始参考麦信号
-    float *original_fb;      // 原始误差麦信号
-    float *simulated_fb;     // 模拟降噪后的误差麦信号
+    // 原始信号存储（只读，可由多个仿真器共享）
+    const float *original_ff[ANC_NUM_REF];  // 原始参考麦信号
+    const float *original_fb[ANC_NUM_ERR];  // 原始误差麦信号
+    float *simulated_fb[ANC_NUM_ERR];       // 模拟降噪后的误差麦信号
+    int owns_input;                         // 1=原始信号由本仿真器分配和释放
     
     int total_samples;       // 总样本数
     int current_sample;      // 当前处理到的样本索引
@@ -29,50 +32,110 @@ typedef struct {
     // 使能标志
     int enabled;
     
+    // 分段并行滤波线程数（1=串行）
+    int num_threads;
+    
+    // 预卷积参考 S * FF_r（NULL=未启用）：系数更新后只需对其重跑Biquad级联
+    const float *preconv_ff[ANC_NUM_REF];
+    int owns_preconv;                       // 1=预卷积参考由本仿真器分配和释放
+    
 } TimeDomainSimulator;
 
 /**
  * 初始化时域仿真器
+ * 所有(误差麦, 扬声器)对使用同一次级路径冲击响应，各自保留独立的FIR状态
  * @param sim 仿真器结构体
- * @param ff_signal 参考麦原始信号
- * @param fb_signal 误差麦原始信号
+ * @param ff_signals 各参考麦原始信号（ANC_NUM_REF路）
+ * @param fb_signals 各误差麦原始信号（ANC_NUM_ERR路）
  * @param num_samples 样本数
- * @param sp_ir 次级路径冲击响应
- * @param sp_length 次级路径长度
+ * @param sp_ir 次级路径冲击响应的有效部分（见fir_compact）
+ * @param sp_length 有效部分长度
+ * @param sp_delay 次级路径前导延迟（样本）
  * @return 0=成功, -1=失败
  */
 int time_sim_init(TimeDomainSimulator *sim, 
-                  const float *ff_signal,
-                  const float *fb_signal,
+                  const float *const ff_signals[],
+                  const float *const fb_signals[],
                   int num_samples,
                   const float *sp_ir,
-                  int sp_length);
+                  int sp_length,
+                  int sp_delay);
+
+/**
+ * 初始化时域仿真器，直接引用调用方的原始信号而不复制
+ * 用于扫参：输入只解码一次，各配置的仿真器共享同一份只读信号，
+ * 只各自分配模拟误差麦缓冲；调用方须保证原始信号在仿真器释放前有效
+ * 参数同time_sim_init
+ * @return 0=成功, -1=失败
+ */
+int time_sim_init_shared(TimeDomainSimulator *sim,
+                         const float *const ff_signals[],
+                         const float *const fb_signals[],
+                         int num_samples,
+                         const float *sp_ir,
+                         int sp_length,
+                         int sp_delay);
 
 /**
  * 时域滤波一段信号(保证因果性)
- * 处理从current_sample开始的一段信号
+ * 处理从current_sample开始的一段信号: FB_e = 原始FB_e - Σ_r S_er * (W_r * FF_r)
+ * num_threads > 1且信号足够长时分段并行
  * @param sim 仿真器结构体
- * @param coeffs Biquad系数数组
- * @param total_gain 总增益(线性)
+ * @param filters 各参考麦的前馈滤波器（ANC_NUM_REF个，使用系数和总增益）
  * @param num_samples 要处理的样本数
  */
 void time_sim_process(TimeDomainSimulator *sim,
-                      BiquadCoeffs *coeffs,
-                      float total_gain,
+                      const FeedforwardFilter *filters,
                       int num_samples);
 
+/**
+ * 设置分段并行滤波线程数
+ * 系数不变的一段信号切成至多num_threads块并行滤波，块0与串行结果逐位一致，
+ * 其余块的Biquad起始状态由级联状态转移矩阵精确递推，与串行结果仅差float舍入（与极点半径无关）
+ * @param sim 仿真器结构体
+ * @param num_threads 线程数（1=串行，默认）
+ */
+void time_sim_set_threads(TimeDomainSimulator *sim, int num_threads);
+
+/**
+ * 计算预卷积参考：整段参考麦信号与次级路径的线性卷积 S * FF（起点之前视为0）
+ * 按时间分块在线程池上计算，结果与分块数无关
+ * @param ff_signal 参考麦原始信号
+ * @param num_samples 样本数
+ * @param sp_ir 次级路径冲击响应的有效部分
+ * @param sp_length 有效部分长度
+ * @param sp_delay 次级路径前导延迟（样本）
+ * @param num_threads 线程数
+ * @return 预卷积信号（num_samples个，调用方free），失败返回NULL
+ */
+float *time_sim_preconvolve(const float *ff_signal, int num_samples,
+                            const float *sp_ir, int sp_length, int sp_delay, int num_threads);
+
+/**
+ * 启用预卷积模式
+ * Biquad级联与次级路径FIR都是线性时不变的，交换顺序后 S * (W * FF) = W * (S * FF)。
+ * S * FF与系数无关，只在加载时计算一次，此后每次重滤波只跑Biquad级联；
+ * 本段起点之前的参考麦历史在前SP长度个样本内就地扣除，与逐级滤波仅差float舍入。
+ * 要求所有(误差麦, 扬声器)对共用同一次级路径（time_sim_init的约定）
+ * @param sim 仿真器结构体
+ * @param shared 各参考麦已算好的预卷积参考（扫参时共享，须在仿真器释放前有效）；
+ *               NULL表示由本仿真器按num_threads计算并持有
+ * @return 0=成功, -1=失败
+ */
+int time_sim_enable_preconv(TimeDomainSimulator *sim, const float *const shared[]);
+
 /**
  * 获取当前时刻的参考麦和误差麦信号
  * 用于送回DSP进行下一轮FFT
  * @param sim 仿真器结构体
- * @param ff_out 输出参考麦信号缓冲区
- * @param fb_out 输出误差麦信号缓冲区  
+ * @param ff_out 各参考麦输出缓冲区（ANC_NUM_REF路）
+ * @param fb_out 各误差麦输出缓冲区（ANC_NUM_ERR路）
  * @param num_samples 需要获取的样本数
  * @return 实际获取的样本数
  */
 int time_sim_get_signals(TimeDomainSimulator *sim,
-                         float *ff_out,
-                         float *fb_out,
+                         float *const ff_out[],
+                         float *const fb_out[],
                          int num_samples);
 
 /**
@@ -82,7 +145,7 @@ int time_sim_get_signals(TimeDomainSimulator *sim,
  * @param state Biquad状态
  * @return 输出样本
  */
-float biquad_process_sample(float input, BiquadCoeffs *coeffs, BiquadTimeDomainState *state);
+float biquad_process_sample(float input, const BiquadCoeffs *coeffs, BiquadTimeDomainState *state);
 
 /**
  * 释放仿真器资源
@@ -0,0 +1,98 @@
+#include "../inc/adapt_engine.h"
+#include "../inc/fxlms.h"
+#include "../inc/fdaf.h"
+#include "../inc/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============ FxLMS ============
+static int fxlms_engine_process(void *ctx, TimeDomainSimulator *sim, int num_samples) {
+    FxlmsController *ctrl = (FxlmsController *)ctx;
+    int processed = fxlms_process(ctrl, sim, num_samples);
+    if (processed > 0) {
+        log_printf("  FxLMS: %d samples, ||W|| = %.4f\n", processed, fxlms_weight_norm(ctrl));
+    }
+    return processed;
+}
+
+static void fxlms_engine_destroy(void *ctx) {
+    fxlms_free((FxlmsController *)ctx);
+    free(ctx);
+}
+
+// ============ 分区频域块LMS ============
+static int fdaf_engine_process(void *ctx, TimeDomainSimulator *sim, int num_samples) {
+    FdafController *ctrl = (FdafController *)ctx;
+    int processed = fdaf_process(ctrl, sim, num_samples);
+    if (processed > 0) {
+        log_printf("  FDAF: %d samples, %lld blocks, ||W|| = %.4f\n", processed, ctrl->blocks,
+                   fdaf_weight_norm(ctrl));
+    }
+    return processed;
+}
+
+static void fdaf_engine_destroy(void *ctx) {
+    fdaf_free((FdafController *)ctx);
+    free(ctx);
+}
+
+// ============ 解析引擎名 ============
+int adapt_engine_parse(const char *name, AdaptEngineType *type) {
+    if (strcmp(name, "eq") == 0) {
+        *type = ENGINE_EQ;
+    } else if (strcmp(name, "fxlms") == 0) {
+        *type = ENGINE_FXLMS;
+    } else if (strcmp(name, "fdaf") == 0) {
+        *type = ENGINE_FDAF;
+    } else {
+        log_printf("Error: Unknown engine %s (expected eq, fxlms or fdaf)\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+// ============ 创建/释放 ============
+int adapt_engine_create(AdaptEngine *engine, AdaptEngineType type, const AncParams *params,
+                        const TimeDomainSimulator *sim) {
+    memset(engine, 0, sizeof(AdaptEngine));
+    engine->type = type;
+
+    switch (type) {
+    case ENGINE_FXLMS: {
+        FxlmsController *ctrl = (FxlmsController *)malloc(sizeof(FxlmsController));
+        if (!ctrl || fxlms_init(ctrl, &params->fxlms, sim) != 0) {
+            free(ctrl);
+            return -1;
+        }
+        engine->name = "fxlms";
+        engine->ctx = ctrl;
+        engine->process = fxlms_engine_process;
+        engine->destroy = fxlms_engine_destroy;
+        break;
+    }
+    case ENGINE_FDAF: {
+        FdafController *ctrl = (FdafController *)malloc(sizeof(FdafController));
+        if (!ctrl || fdaf_init(ctrl, &params->fdaf, sim) != 0) {
+            free(ctrl);
+            return -1;
+        }
+        engine->name = "fdaf";
+        engine->ctx = ctrl;
+        engine->process = fdaf_engine_process;
+        engine->destroy = fdaf_engine_destroy;
+        break;
+    }
+    case ENGINE_EQ:
+    default:
+        engine->name = "eq";
+        break;
+    }
+    return 0;
+}
+
+void adapt_engine_destroy(AdaptEngine *engine) {
+    if (engine->destroy) {
+        engine->destroy(engine->ctx);
+    }
+    engine->ctx = NULL;
+}
@@ -0,0 +1,380 @@
+#include "../inc/analysis_bins.h"
+#include "../inc/dsp_tables.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ANALYSIS_USE_SSE 1
+#else
+#define ANALYSIS_USE_SSE 0
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ============ 全频带 ============
+void analysis_bins_full(AnalysisBins *bins) {
+    memset(bins, 0, sizeof(AnalysisBins));
+    bins->mode = ANALYSIS_FULL;
+    bins->num_bins = FFT_HALF_LENGTH;
+    bins->freq_start = 0.0f;
+    bins->bin_spacing = (float)DSP_SAMPLE_RATE / FFT_LENGTH;
+    memcpy(bins->freq, dsp_bin_freq, sizeof(bins->freq));
+    memcpy(bins->z_re, dsp_bin_twiddle_re, sizeof(bins->z_re));
+    memcpy(bins->z_im, dsp_bin_twiddle_im, sizeof(bins->z_im));
+}
+
+// ============ 细化频段 ============
+int analysis_bins_zoom(AnalysisBins *bins, float freq_low, float freq_high) {
+    if (freq_low < 0.0f || freq_high <= freq_low || freq_high > DSP_SAMPLE_RATE / 2) {
+        log_printf("Error: Invalid zoom band [%.1f, %.1f] Hz (0 - %d Hz)\n",
+                   freq_low, freq_high, DSP_SAMPLE_RATE / 2);
+        return -1;
+    }
+
+    memset(bins, 0, sizeof(AnalysisBins));
+    bins->mode = ANALYSIS_ZOOM;
+
+    // 降采样倍数：基带带宽至少为频段宽度的ZOOM_GUARD倍
+    int decimation = (int)(DSP_SAMPLE_RATE / ((freq_high - freq_low) * ZOOM_GUARD));
+    if (decimation < 1) decimation = 1;
+    if (decimation > ZOOM_MAX_DECIMATION) decimation = ZOOM_MAX_DECIMATION;
+    bins->decimation = decimation;
+
+    // 中心取频点间隔的整数倍m，基带样本j的移频 e^(-j2πmj/N) 可按j mod N查表
+    const double spacing = (double)DSP_SAMPLE_RATE / decimation / ZOOM_FFT_LENGTH;
+    const long m = lround(0.5 * (freq_low + freq_high) / spacing);
+    bins->center_hz = (float)(m * spacing);
+    bins->bin_spacing = (float)spacing;
+
+    int first = (int)ceil((freq_low - m * spacing) / spacing - 1e-6);
+    int last = (int)floor((freq_high - m * spacing) / spacing + 1e-6);
+    if (first < -ZOOM_FFT_LENGTH / 2) first = -ZOOM_FFT_LENGTH / 2;
+    if (last > ZOOM_FFT_LENGTH / 2 - 1) last = ZOOM_FFT_LENGTH / 2 - 1;
+    bins->num_bins = last - first + 1;
+    bins->first_bin = (first + ZOOM_FFT_LENGTH) % ZOOM_FFT_LENGTH;
+    bins->freq_start = (float)((m + first) * spacing);
+
+    for (int k = 0; k < bins->num_bins; k++) {
+        double f = (m + first + k) * spacing;
+        double w = -2.0 * M_PI * f / DSP_SAMPLE_RATE;
+        bins->freq[k] = (float)f;
+        bins->z_re[k] = (float)cos(w);
+        bins->z_im[k] = (float)sin(w);
+    }
+
+    // 低通: Blackman窗sinc，截止在基带Nyquist频率，直流增益归一化；调制到f_c后时间倒序存放
+    const int taps = decimation * ZOOM_TAPS_PER_DECIMATION + 1;
+    const int mid = (taps - 1) / 2;
+    const double cutoff = 0.5 / decimation;
+    const double wc = 2.0 * M_PI * bins->center_hz / DSP_SAMPLE_RATE;
+    double h[ZOOM_MAX_TAPS];
+    double sum = 0.0;
+    for (int t = 0; t < taps; t++) {
+        int n = t - mid;
+        double sinc = n == 0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * n) / (M_PI * n);
+        double win = 0.42 - 0.5 * cos(2.0 * M_PI * t / (taps - 1))
+                          + 0.08 * cos(4.0 * M_PI * t / (taps - 1));
+        h[t] = sinc * win;
+        sum += h[t];
+    }
+    for (int t = 0; t < taps; t++) {
+        bins->taps_re[taps - 1 - t] = (float)(h[t] / sum * cos(wc * t));
+        bins->taps_im[taps - 1 - t] = (float)(h[t] / sum * sin(wc * t));
+    }
+    bins->num_taps = taps;
+
+    // 基带移频表和分析窗
+    double window_sum = 0.0;
+    for (int j = 0; j < ZOOM_FFT_LENGTH; j++) {
+        double angle = -2.0 * M_PI * (double)((m * j) % ZOOM_FFT_LENGTH) / ZOOM_FFT_LENGTH;
+        bins->rotate_re[j] = (float)cos(angle);
+        bins->rotate_im[j] = (float)sin(angle);
+        double win = 0.42 - 0.5 * cos(2.0 * M_PI * j / (ZOOM_FFT_LENGTH - 1))
+                          + 0.08 * cos(4.0 * M_PI * j / (ZOOM_FFT_LENGTH - 1));
+        bins->window[j] = (float)win;
+        window_sum += win;
+    }
+
+    // 单频分量在全频带FFT中的峰值为 A/2 * Σw，在细化FFT中为 A/2 * Σw_zoom
+    double full_sum = 0.0;
+    for (int i = 0; i < FFT_LENGTH; i++) {
+        full_sum += dsp_blackman_window[i];
+    }
+    bins->scale = (float)(full_sum / window_sum);
+
+    return fft_init(&bins->plan, 2 * ZOOM_FFT_LENGTH);
+}
+
+// ============ 稀疏频点 ============
+int analysis_bins_sparse(AnalysisBins *bins, const char *spec) {
+    const float bin_hz = (float)DSP_SAMPLE_RATE / FFT_LENGTH;
+    const float nyquist = (float)(DSP_SAMPLE_RATE / 2);
+    unsigned char selected[FFT_HALF_LENGTH];
+    int uniform = 0;
+    memset(selected, 0, sizeof(selected));
+
+    if (strchr(spec, ':')) {
+        // 频段：区间内全部频点，等间隔
+        float freq_low, freq_high;
+        if (sscanf(spec, "%f:%f", &freq_low, &freq_high) != 2 ||
+            freq_low < 0.0f || freq_high < freq_low || freq_high > nyquist) {
+            log_printf("Error: Invalid sparse band %s (0 - %d Hz)\n", spec, DSP_SAMPLE_RATE / 2);
+            return -1;
+        }
+        int first = (int)ceil(freq_low / bin_hz - 1e-6);
+        int last = (int)floor(freq_high / bin_hz + 1e-6);
+        for (int k = first; k <= last; k++) {
+            selected[k] = 1;
+        }
+        uniform = 1;
+    } else {
+        // 单频列表：各频率最近的频点
+        const char *p = spec;
+        while (*p) {
+            char *end;
+            float freq = strtof(p, &end);
+            if (end == p || freq < 0.0f || freq > nyquist || (*end != ',' && *end != '\0')) {
+                log_printf("Error: Invalid sparse bin list %s (expected f1,f2,... in 0 - %d Hz)\n",
+                           spec, DSP_SAMPLE_RATE / 2);
+                return -1;
+            }
+            selected[(int)lroundf(freq / bin_hz)] = 1;
+            p = *end == ',' ? end + 1 : end;
+        }
+    }
+
+    memset(bins, 0, sizeof(AnalysisBins));
+    bins->mode = ANALYSIS_SPARSE;
+    for (int k = 0; k < FFT_HALF_LENGTH; k++) {
+        if (!selected[k]) continue;
+        int i = bins->num_bins++;
+        double w = 2.0 * M_PI * k / FFT_LENGTH;
+        bins->freq[i] = dsp_bin_freq[k];
+        bins->z_re[i] = dsp_bin_twiddle_re[k];
+        bins->z_im[i] = dsp_bin_twiddle_im[k];
+        bins->goertzel_coef[i] = 2.0 * cos(w);
+        bins->goertzel_cos[i] = cos(w);
+        bins->goertzel_sin[i] = sin(w);
+    }
+    if (bins->num_bins == 0) {
+        log_printf("Error: Sparse selection %s contains no FFT bin\n", spec);
+        return -1;
+    }
+    bins->freq_start = bins->freq[0];
+    bins->bin_spacing = uniform ? bin_hz : 0.0f;
+    return 0;
+}
+
+// ============ 频率到频点 ============
+int analysis_bins_nearest(const AnalysisBins *bins, float freq) {
+    if (bins->bin_spacing <= 0.0f) {
+        // 间隔不定：二分查找首个不低于freq的频点，再与前一个比较
+        int lo = 0, hi = bins->num_bins - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (bins->freq[mid] < freq) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo > 0 && freq - bins->freq[lo - 1] <= bins->freq[lo] - freq) {
+            lo--;
+        }
+        return lo;
+    }
+
+    int bin = (int)((freq - bins->freq_start) / bins->bin_spacing + 0.5f);
+    if (bin < 0) bin = 0;
+    if (bin > bins->num_bins - 1) bin = bins->num_bins - 1;
+    return bin;
+}
+
+// ============ 频段到频点范围 ============
+void analysis_bins_range(const AnalysisBins *bins, float freq_low, float freq_high,
+                         int *bin_low, int *bin_high) {
+    int low, high;
+    if (bins->bin_spacing > 0.0f) {
+        low = (int)((freq_low - bins->freq_start) / bins->bin_spacing);
+        high = (int)((freq_high - bins->freq_start) / bins->bin_spacing);
+    } else {
+        for (low = 0; low < bins->num_bins && bins->freq[low] < freq_low; low++) {}
+        for (high = bins->num_bins - 1; high >= 0 && bins->freq[high] > freq_high; high--) {}
+    }
+    if (low < 0) low = 0;
+    if (high >= bins->num_bins) high = bins->num_bins - 1;
+    *bin_low = low;
+    *bin_high = high;
+}
+
+// ============ 细化FFT流式状态 ============
+void zoom_init(ZoomState *zoom, const AnalysisBins *bins) {
+    memset(zoom, 0, sizeof(ZoomState));
+    zoom->num_bins = bins->num_bins;
+    zoom->decimation = bins->decimation;
+}
+
+static float dot_product(const float *a, const float *b, int n) {
+    int i = 0;
+    float sum = 0.0f;
+#if ANALYSIS_USE_SSE
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&a[i]), _mm_loadu_ps(&b[i])));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void zoom_feed(ZoomState *zoom, const AnalysisBins *bins, const TimeBuffer *const buffers[],
+               int num_new) {
+    const int taps = bins->num_taps;
+    zoom->samples_in += num_new;
+
+    for (; zoom->next_output < zoom->samples_in; zoom->next_output += bins->decimation) {
+        // 低通窗口 [p - taps + 1, p] 在时域缓冲中的位置，信号起点之前的槽位尚未写入（为0）
+        long long first = zoom->next_output - taps + 1;
+        int start = (int)(((first % FFT_LENGTH) + FFT_LENGTH) % FFT_LENGTH);
+        int head = FFT_LENGTH - start < taps ? FFT_LENGTH - start : taps;
+        int j = (int)((zoom->next_output / bins->decimation) % ZOOM_FFT_LENGTH);
+
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            const float *x = buffers[c]->data;
+            float re = dot_product(bins->taps_re, &x[start], head) +
+                       dot_product(&bins->taps_re[head], x, taps - head);
+            float im = dot_product(bins->taps_im, &x[start], head) +
+                       dot_product(&bins->taps_im[head], x, taps - head);
+            zoom->base_re[c][zoom->write_index] = re * bins->rotate_re[j] - im * bins->rotate_im[j];
+            zoom->base_im[c][zoom->write_index] = re * bins->rotate_im[j] + im * bins->rotate_re[j];
+        }
+
+        zoom->write_index = (zoom->write_index + 1) % ZOOM_FFT_LENGTH;
+        if (zoom->count < ZOOM_FFT_LENGTH) zoom->count++;
+    }
+}
+
+int zoom_transform(const ZoomState *zoom, const AnalysisBins *bins, FreqResponse *const outputs[]) {
+    if (zoom->count < ZOOM_FFT_LENGTH) {
+        return 0;
+    }
+
+    // 按时间顺序展开环形缓冲区并加窗
+    ANC_ALIGN(64) float lin_re[NUM_CHANNELS][ZOOM_FFT_LENGTH];
+    ANC_ALIGN(64) float lin_im[NUM_CHANNELS][ZOOM_FFT_LENGTH];
+    const float *in_re[NUM_CHANNELS];
+    const float *in_im[NUM_CHANNELS];
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        for (int n = 0; n < ZOOM_FFT_LENGTH; n++) {
+            int src = (zoom->write_index + n) % ZOOM_FFT_LENGTH;
+            lin_re[c][n] = zoom->base_re[c][src] * bins->window[n];
+            lin_im[c][n] = zoom->base_im[c][src] * bins->window[n];
+        }
+        in_re[c] = lin_re[c];
+        in_im[c] = lin_im[c];
+    }
+
+    fft_complex_batch(&bins->plan, in_re, in_im, outputs, NUM_CHANNELS);
+
+    // 取出频段内的频点（负频率偏移在FFT输出末尾），幅度对齐全频带FFT
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        float *re = outputs[c]->re;
+        float *im = outputs[c]->im;
+        memcpy(lin_re[c], re, sizeof(lin_re[c]));
+        memcpy(lin_im[c], im, sizeof(lin_im[c]));
+        for (int k = 0; k < bins->num_bins; k++) {
+            int src = (bins->first_bin + k) % ZOOM_FFT_LENGTH;
+            re[k] = lin_re[c][src] * bins->scale;
+            im[k] = lin_im[c][src] * bins->scale;
+        }
+        memset(&re[bins->num_bins], 0, (ZOOM_FFT_LENGTH - bins->num_bins) * sizeof(float));
+        memset(&im[bins->num_bins], 0, (ZOOM_FFT_LENGTH - bins->num_bins) * sizeof(float));
+    }
+    return 1;
+}
+
+// ============ 稀疏频点变换 ============
+// Goertzel: s[n] = x[n] + 2cos(ω)s[n-1] - s[n-2]，
+// X(ω) = Σx[n]e^(-jωn) = e^(jω)s[N-1] - s[N-2]（ω = 2πk/N）
+// 递推链的延迟是瓶颈：x[n] - s[n-2]不依赖上一步结果，关键路径只有一次乘加；
+// 全部通道的递推在同一循环中交错执行
+static void goertzel_finish(const AnalysisBins *bins, int k, double s1, double s2,
+                            float *out_re, float *out_im) {
+    out_re[k] = (float)(bins->goertzel_cos[k] * s1 - s2);
+    out_im[k] = (float)(bins->goertzel_sin[k] * s1);
+}
+
+void sparse_transform(const AnalysisBins *bins, const TimeBuffer *const buffers[],
+                      FreqResponse *const outputs[]) {
+    // 装载与全频带FFT相同：缓冲区按存放顺序，加Blackman窗
+    ANC_ALIGN(64) float x[NUM_CHANNELS][FFT_LENGTH];
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        const float *data = buffers[c]->data;
+        for (int n = 0; n < FFT_LENGTH; n++) {
+            x[c][n] = data[n] * dsp_blackman_window[n];
+        }
+    }
+
+#if ANALYSIS_USE_SSE
+    // 每组4个频点（2个双精度向量）× 全部通道；末组不足4个时多算的频点系数为0，结果丢弃
+    for (int k = 0; k < bins->num_bins; k += 4) {
+        const __m128d coef_a = _mm_loadu_pd(&bins->goertzel_coef[k]);
+        const __m128d coef_b = _mm_loadu_pd(&bins->goertzel_coef[k + 2]);
+        __m128d s1a[NUM_CHANNELS], s2a[NUM_CHANNELS], s1b[NUM_CHANNELS], s2b[NUM_CHANNELS];
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            s1a[c] = s2a[c] = s1b[c] = s2b[c] = _mm_setzero_pd();
+        }
+        for (int n = 0; n < FFT_LENGTH; n++) {
+            for (int c = 0; c < NUM_CHANNELS; c++) {
+                const __m128d xn = _mm_set1_pd(x[c][n]);
+                __m128d s0a = _mm_add_pd(_mm_sub_pd(xn, s2a[c]), _mm_mul_pd(coef_a, s1a[c]));
+                __m128d s0b = _mm_add_pd(_mm_sub_pd(xn, s2b[c]), _mm_mul_pd(coef_b, s1b[c]));
+                s2a[c] = s1a[c];
+                s1a[c] = s0a;
+                s2b[c] = s1b[c];
+                s1b[c] = s0b;
+            }
+        }
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            double s1[4], s2[4];
+            _mm_storeu_pd(&s1[0], s1a[c]);
+            _mm_storeu_pd(&s1[2], s1b[c]);
+            _mm_storeu_pd(&s2[0], s2a[c]);
+            _mm_storeu_pd(&s2[2], s2b[c]);
+            for (int j = 0; j < 4 && k + j < bins->num_bins; j++) {
+                goertzel_finish(bins, k + j, s1[j], s2[j], outputs[c]->re, outputs[c]->im);
+            }
+        }
+    }
+#else
+    for (int k = 0; k < bins->num_bins; k++) {
+        const double coef = bins->goertzel_coef[k];
+        double s1[NUM_CHANNELS] = {0.0}, s2[NUM_CHANNELS] = {0.0};
+        for (int n = 0; n < FFT_LENGTH; n++) {
+            for (int c = 0; c < NUM_CHANNELS; c++) {
+                double s0 = (x[c][n] - s2[c]) + coef * s1[c];
+                s2[c] = s1[c];
+                s1[c] = s0;
+            }
+        }
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            goertzel_finish(bins, k, s1[c], s2[c], outputs[c]->re, outputs[c]->im);
+        }
+    }
+#endif
+
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        memset(&outputs[c]->re[bins->num_bins], 0, (SPECTRUM_LENGTH - bins->num_bins) * sizeof(float));
+        memset(&outputs[c]->im[bins->num_bins], 0, (SPECTRUM_LENGTH - bins->num_bins) * sizeof(float));
+    }
+}
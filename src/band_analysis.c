@@ -0,0 +1,163 @@
+#include "../inc/band_analysis.h"
+#include "../inc/dsp_tables.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BAND_USE_SSE 1
+#else
+#define BAND_USE_SSE 0
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ============ 频带划分 ============
+int band_layout(float *center_hz) {
+    // 容差避免log2的舍入把恰好落在上下限上的频带排除在外
+    int k_lo = (int)ceil(BAND_PER_OCTAVE * log2(BAND_LOW_HZ / 1000.0) - 1e-9);
+    int k_hi = (int)floor(BAND_PER_OCTAVE * log2(BAND_HIGH_HZ / 1000.0) + 1e-9);
+    int count = 0;
+    for (int k = k_lo; k <= k_hi && count < BAND_MAX_BANDS; k++) {
+        center_hz[count++] = (float)(1000.0 * pow(2.0, (double)k / BAND_PER_OCTAVE));
+    }
+    return count;
+}
+
+// ============ 初始化 ============
+void band_analyzer_init(BandAnalyzer *an, const FFTPlan *plan, int sample_rate) {
+    memset(an, 0, sizeof(BandAnalyzer));
+    an->plan = plan;
+    an->num_bands = band_layout(an->center_hz);
+
+    // 频带边界 fc*2^(±1/(2*BAND_PER_OCTAVE)) 换算为降采样后的频点
+    const double bin_hz = (double)sample_rate / BAND_DECIMATION / FFT_LENGTH;
+    const double half_band = pow(2.0, 0.5 / BAND_PER_OCTAVE);
+    for (int b = 0; b < an->num_bands; b++) {
+        int lo = (int)ceil(an->center_hz[b] / half_band / bin_hz);
+        int hi = (int)ceil(an->center_hz[b] * half_band / bin_hz);
+        if (hi > FFT_HALF_LENGTH) hi = FFT_HALF_LENGTH;
+        if (hi <= lo) {
+            // 频带窄于频点间隔：取最近的频点
+            lo = (int)lround(an->center_hz[b] / bin_hz);
+            hi = lo + 1;
+        }
+        an->bin_lo[b] = lo;
+        an->bin_hi[b] = hi;
+    }
+
+    // 抗混叠低通: Blackman窗sinc，截止在降采样后的Nyquist频率，直流增益归一化
+    const double cutoff = 0.5 / BAND_DECIMATION;
+    const int mid = (BAND_LOWPASS_TAPS - 1) / 2;
+    double sum = 0.0;
+    double taps[BAND_LOWPASS_TAPS];
+    for (int k = 0; k < BAND_LOWPASS_TAPS; k++) {
+        int m = k - mid;
+        double sinc = m == 0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * m) / (M_PI * m);
+        double w = 0.42 - 0.5 * cos(2.0 * M_PI * k / (BAND_LOWPASS_TAPS - 1))
+                        + 0.08 * cos(4.0 * M_PI * k / (BAND_LOWPASS_TAPS - 1));
+        taps[k] = sinc * w;
+        sum += taps[k];
+    }
+    for (int k = 0; k < BAND_LOWPASS_TAPS; k++) {
+        an->lowpass[k] = (float)(taps[k] / sum);
+    }
+}
+
+// ============ 降采样 ============
+static float dot_product(const float *a, const float *b, int n) {
+    int i = 0;
+    float sum = 0.0f;
+#if BAND_USE_SSE
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&a[i]), _mm_loadu_ps(&b[i])));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// 低通输出在输入位置pos的取值（线性相位滤波器系数对称，可直接与输入正序点积）
+static float lowpass_at(const float *h, const float *x, int pos) {
+    int first = pos - BAND_LOWPASS_TAPS + 1;
+    if (first >= 0) {
+        return dot_product(h, &x[first], BAND_LOWPASS_TAPS);
+    }
+    return dot_product(&h[-first], x, BAND_LOWPASS_TAPS + first);
+}
+
+// ============ STFT帧 ============
+// 全部通道一次批量FFT，各频带能量计入本段
+static void analyze_frame(BandAnalyzer *an) {
+    FreqResponse spectra[2 * ANC_NUM_ERR];
+    const float *inputs[2 * ANC_NUM_ERR];
+    FreqResponse *outputs[2 * ANC_NUM_ERR];
+    for (int c = 0; c < 2 * ANC_NUM_ERR; c++) {
+        inputs[c] = an->frame[c];
+        outputs[c] = &spectra[c];
+    }
+    fft_real_batch(an->plan, inputs, dsp_blackman_window, outputs, 2 * ANC_NUM_ERR);
+
+    for (int c = 0; c < 2 * ANC_NUM_ERR; c++) {
+        double *energy = c < ANC_NUM_ERR ? an->energy_orig : an->energy_sim;
+        const FreqResponse *x = &spectra[c];
+        for (int b = 0; b < an->num_bands; b++) {
+            double e = 0.0;
+            for (int k = an->bin_lo[b]; k < an->bin_hi[b]; k++) {
+                e += (double)x->re[k] * x->re[k] + (double)x->im[k] * x->im[k];
+            }
+            energy[b] += e;
+        }
+    }
+    an->frames++;
+}
+
+// ============ 送入信号 ============
+void band_analyzer_feed(BandAnalyzer *an, const float *const orig[], const float *const sim[],
+                        int start, int num_samples) {
+    const long long end = (long long)start + num_samples;
+
+    // 首次送入或中间有跳跃（如从快照恢复）时对齐到降采样网格
+    if (an->next_input < start) {
+        an->next_input = ((long long)start + BAND_DECIMATION - 1) / BAND_DECIMATION * BAND_DECIMATION;
+    }
+
+    for (; an->next_input < end; an->next_input += BAND_DECIMATION) {
+        const int pos = (int)an->next_input;
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            an->frame[e][an->fill] = lowpass_at(an->lowpass, orig[e], pos);
+            an->frame[ANC_NUM_ERR + e][an->fill] = lowpass_at(an->lowpass, sim[e], pos);
+        }
+        an->fill++;
+
+        if (an->fill == FFT_LENGTH) {
+            analyze_frame(an);
+            for (int c = 0; c < 2 * ANC_NUM_ERR; c++) {
+                memmove(an->frame[c], &an->frame[c][FFT_HOP_SIZE],
+                        (FFT_LENGTH - FFT_HOP_SIZE) * sizeof(float));
+            }
+            an->fill -= FFT_HOP_SIZE;
+        }
+    }
+}
+
+// ============ 结束本段 ============
+int band_analyzer_end_block(BandAnalyzer *an, float *attenuation_db) {
+    for (int b = 0; b < an->num_bands; b++) {
+        attenuation_db[b] = an->frames > 0 ?
+            (float)(10.0 * log10((an->energy_orig[b] + 1e-30) / (an->energy_sim[b] + 1e-30))) : 0.0f;
+        an->energy_orig[b] = 0.0;
+        an->energy_sim[b] = 0.0;
+    }
+    int frames = an->frames;
+    an->frames = 0;
+    return frames;
+}
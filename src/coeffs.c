@@ -0,0 +1,23 @@
+#include "../inc/coeffs.h"
+
+// 实际数据定义（这里给出示例结构，实际数值需要根据测量填充）
+const EQPreset eq_presets[NUM_PRESET_SETS] = {
+    // Set 0
+    {
+        .biquads = {
+            {BIQUAD_LOWSHELF, 0.0f, 0.707f, 100.0f},    // Biquad 0: Lowshelf
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 250.0f},       // Biquad 1-8: Peaking
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 500.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 1000.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 2000.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 4000.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 8000.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 12000.0f},
+            {BIQUAD_PEAKING, 0.0f, 1.0f, 14000.0f},
+            {BIQUAD_HIGHSHELF, 0.0f, 0.707f, 15000.0f}  // Biquad 9: Highshelf
+        },
+        .total_gain_dB = 0.0f
+    },
+    // Set 1-9: 其他预制集（类似结构）
+    // ...
+};
@@ -0,0 +1,999 @@
+// 由 tools/gen_tables.c 生成，请勿手工修改
+#include "../inc/dsp_tables.h"
+
+#if FFT_LENGTH != 2048 || DSP_SAMPLE_RATE != 32000 || SPECTRUM_LENGTH != 1040
+#error "dsp_tables.c is stale: rerun tools/gen_tables"
+#endif
+
+// Blackman窗
+ANC_ALIGN(64) const float dsp_blackman_window[FFT_LENGTH] = {
+    0.0f, 8.47945693e-07f, 3.39181739e-06f, 7.63171894e-06f, 1.35678234e-05f, 2.12003732e-05f, 3.05296797e-05f, 4.15561236e-05f,
+    5.42801549e-05f, 6.87022924e-05f, 8.48231245e-05f, 0.000102643308f, 0.00012216357f, 0.000143384704f, 0.000166307576f, 0.000190933119f,
+    0.000217262334f, 0.000245296292f, 0.000275036133f, 0.000306483065f, 0.000339638364f, 0.000374503377f, 0.000411079517f, 0.000449368266f,
+    0.000489371174f, 0.000531089861f, 0.000574526013f, 0.000619681385f, 0.000666557801f, 0.000715157149f, 0.00076548139f, 0.000817532549f,
+    0.000871312719f, 0.000926824062f, 0.000984068805f, 0.00104304924f, 0.00110376774f, 0.00116622672f, 0.00123042869f, 0.00129637621f,
+    0.00136407189f, 0.00143351845f, 0.00150471864f, 0.00157767529f, 0.00165239129f, 0.0017288696f, 0.00180711325f, 0.00188712532f,
+    0.00196890898f, 0.00205246743f, 0.00213780398f, 0.00222492195f, 0.00231382478f, 0.00240451593f, 0.00249699896f, 0.00259127746f,
+    0.0026873551f, 0.00278523563f, 0.00288492283f, 0.00298642056f, 0.00308973275f, 0.00319486339f, 0.00330181651f, 0.00341059624f,
+    0.00352120673f, 0.00363365223f, 0.00374793703f, 0.00386406547f, 0.00398204199f, 0.00410187106f, 0.00422355722f, 0.00434710505f,
+    0.00447251923f, 0.00459980446f, 0.00472896554f, 0.00486000728f, 0.00499293459f, 0.00512775242f, 0.00526446578f, 0.00540307974f,
+    0.00554359943f, 0.00568603004f, 0.0058303768f, 0.00597664501f, 0.00612484004f, 0.00627496729f, 0.00642703223f, 0.00658104038f,
+    0.00673699732f, 0.00689490869f, 0.00705478017f, 0.00721661751f, 0.0073804265f, 0.00754621299f, 0.00771398289f, 0.00788374215f,
+    0.00805549678f, 0.00822925284f, 0.00840501646f, 0.00858279378f, 0.00876259104f, 0.00894441449f, 0.00912827046f, 0.0093141653f,
+    0.00950210545f, 0.00969209737f, 0.00988414757f, 0.0100782626f, 0.0102744491f, 0.0104727138f, 0.0106730633f, 0.0108755043f,
+    0.0110800438f, 0.0112866885f, 0.0114954453f, 0.0117063213f, 0.0119193233f, 0.0121344583f, 0.0123517336f, 0.0125711562f,
+    0.0127927332f, 0.0130164719f, 0.0132423795f, 0.0134704633f, 0.0137007306f, 0.0139331889f, 0.0141678454f, 0.0144047078f,
+    0.0146437835f, 0.0148850799f, 0.0151286048f, 0.0153743657f, 0.0156223702f, 0.0158726261f, 0.0161251411f, 0.0163799229f,
+    0.0166369794f, 0.0168963183f, 0.0171579477f, 0.0174218753f, 0.0176881091f, 0.0179566571f, 0.0182275273f, 0.0185007278f,
+    0.0187762666f, 0.0190541518f, 0.0193343917f, 0.0196169943f, 0.0199019678f, 0.0201893206f, 0.0204790609f, 0.0207711968f,
+    0.0210657369f, 0.0213626895f, 0.0216620628f, 0.0219638654f, 0.0222681056f, 0.022574792f, 0.022883933f, 0.0231955371f,
+    0.0235096128f, 0.0238261688f, 0.0241452137f, 0.0244667559f, 0.0247908042f, 0.0251173672f, 0.0254464536f, 0.0257780721f,
+    0.0261122314f, 0.0264489402f, 0.0267882073f, 0.0271300416f, 0.0274744517f, 0.0278214465f, 0.0281710348f, 0.0285232256f,
+    0.0288780275f, 0.0292354496f, 0.0295955007f, 0.0299581898f, 0.0303235257f, 0.0306915175f, 0.031062174f, 0.0314355042f,
+    0.0318115172f, 0.0321902218f, 0.0325716272f, 0.0329557422f, 0.033342576f, 0.0337321376f, 0.034124436f, 0.0345194802f,
+    0.0349172794f, 0.0353178425f, 0.0357211787f, 0.036127297f, 0.0365362065f, 0.0369479163f, 0.0373624354f, 0.0377797731f,
+    0.0381999383f, 0.0386229402f, 0.0390487878f, 0.0394774904f, 0.0399090569f, 0.0403434965f, 0.0407808182f, 0.0412210313f,
+    0.0416641447f, 0.0421101677f, 0.0425591092f, 0.0430109784f, 0.0434657843f, 0.0439235362f, 0.0443842429f, 0.0448479136f,
+    0.0453145574f, 0.0457841834f, 0.0462568005f, 0.0467324178f, 0.0472110444f, 0.0476926893f, 0.0481773615f, 0.0486650701f,
+    0.0491558239f, 0.049649632f, 0.0501465034f, 0.050646447f, 0.0511494718f, 0.0516555867f, 0.0521648006f, 0.0526771224f,
+    0.0531925611f, 0.0537111254f, 0.0542328242f, 0.0547576664f, 0.0552856608f, 0.0558168162f, 0.0563511413f, 0.056888645f,
+    0.0574293359f, 0.0579732228f, 0.0585203144f, 0.0590706193f, 0.0596241461f, 0.0601809036f, 0.0607409004f, 0.0613041449f,
+    0.0618706458f, 0.0624404115f, 0.0630134506f, 0.0635897716f, 0.0641693828f, 0.0647522927f, 0.0653385098f, 0.0659280422f,
+    0.0665208985f, 0.0671170868f, 0.0677166154f, 0.0683194927f, 0.0689257266f, 0.0695353255f, 0.0701482975f, 0.0707646506f,
+    0.0713843929f, 0.0720075325f, 0.0726340773f, 0.0732640353f, 0.0738974144f, 0.0745342225f, 0.0751744675f, 0.075818157f,
+    0.076465299f, 0.077115901f, 0.0777699709f, 0.0784275161f, 0.0790885444f, 0.0797530633f, 0.0804210802f, 0.0810926027f,
+    0.0817676382f, 0.0824461939f, 0.0831282774f, 0.0838138958f, 0.0845030565f, 0.0851957665f, 0.085892033f, 0.0865918631f,
+    0.0872952639f, 0.0880022424f, 0.0887128054f, 0.0894269599f, 0.0901447128f, 0.0908660707f, 0.0915910406f, 0.0923196289f,
+    0.0930518424f, 0.0937876877f, 0.0945271711f, 0.0952702994f, 0.0960170787f, 0.0967675155f, 0.0975216161f, 0.0982793867f,
+    0.0990408334f, 0.0998059625f, 0.10057478f, 0.101347292f, 0.102123504f, 0.102903422f, 0.103687052f, 0.1044744f,
+    0.105265471f, 0.106060272f, 0.106858807f, 0.107661082f, 0.108467103f, 0.109276874f, 0.110090402f, 0.110907691f,
+    0.111728747f, 0.112553575f, 0.113382179f, 0.114214565f, 0.115050738f, 0.115890702f, 0.116734463f, 0.117582024f,
+    0.11843339f, 0.119288567f, 0.120147558f, 0.121010368f, 0.121877001f, 0.122747462f, 0.123621754f, 0.124499883f,
+    0.12538185f, 0.126267662f, 0.127157321f, 0.128050831f, 0.128948196f, 0.129849421f, 0.130754507f, 0.131663459f,
+    0.13257628f, 0.133492974f, 0.134413543f, 0.135337992f, 0.136266322f, 0.137198537f, 0.13813464f, 0.139074634f,
+    0.140018521f, 0.140966304f, 0.141917986f, 0.142873569f, 0.143833055f, 0.144796448f, 0.145763748f, 0.146734959f,
+    0.147710083f, 0.14868912f, 0.149672074f, 0.150658946f, 0.151649738f, 0.152644451f, 0.153643087f, 0.154645647f,
+    0.155652133f, 0.156662546f, 0.157676887f, 0.158695157f, 0.159717358f, 0.160743489f, 0.161773553f, 0.162807549f,
+    0.163845479f, 0.164887342f, 0.165933139f, 0.166982871f, 0.168036538f, 0.16909414f, 0.170155677f, 0.171221148f,
+    0.172290555f, 0.173363896f, 0.174441171f, 0.17552238f, 0.176607522f, 0.177696597f, 0.178789603f, 0.179886541f,
+    0.180987409f, 0.182092206f, 0.18320093f, 0.184313582f, 0.185430159f, 0.18655066f, 0.187675083f, 0.188803427f,
+    0.18993569f, 0.19107187f, 0.192211966f, 0.193355975f, 0.194503894f, 0.195655723f, 0.196811458f, 0.197971097f,
+    0.199134637f, 0.200302077f, 0.201473412f, 0.20264864f, 0.203827758f, 0.205010763f, 0.206197652f, 0.207388422f,
+    0.208583069f, 0.209781589f, 0.210983979f, 0.212190235f, 0.213400354f, 0.21461433f, 0.215832162f, 0.217053843f,
+    0.21827937f, 0.219508739f, 0.220741945f, 0.221978983f, 0.223219849f, 0.224464537f, 0.225713044f, 0.226965363f,
+    0.22822149f, 0.229481419f, 0.230745146f, 0.232012663f, 0.233283967f, 0.234559051f, 0.23583791f, 0.237120537f,
+    0.238406926f, 0.239697072f, 0.240990967f, 0.242288606f, 0.243589983f, 0.244895089f, 0.24620392f, 0.247516467f,
+    0.248832724f, 0.250152684f, 0.25147634f, 0.252803684f, 0.25413471f, 0.255469408f, 0.256807773f, 0.258149796f,
+    0.259495468f, 0.260844783f, 0.262197733f, 0.263554308f, 0.264914501f, 0.266278302f, 0.267645705f, 0.269016699f,
+    0.270391277f, 0.271769429f, 0.273151146f, 0.27453642f, 0.27592524f, 0.277317597f, 0.278713483f, 0.280112887f,
+    0.2815158f, 0.282922212f, 0.284332113f, 0.285745493f, 0.287162341f, 0.288582648f, 0.290006404f, 0.291433596f,
+    0.292864216f, 0.294298252f, 0.295735693f, 0.297176528f, 0.298620747f, 0.300068337f, 0.301519289f, 0.302973589f,
+    0.304431228f, 0.305892192f, 0.30735647f, 0.308824051f, 0.310294923f, 0.311769072f, 0.313246487f, 0.314727156f,
+    0.316211066f, 0.317698204f, 0.319188558f, 0.320682115f, 0.322178862f, 0.323678786f, 0.325181874f, 0.326688112f,
+    0.328197487f, 0.329709986f, 0.331225595f, 0.332744299f, 0.334266087f, 0.335790942f, 0.337318852f, 0.338849801f,
+    0.340383777f, 0.341920763f, 0.343460747f, 0.345003712f, 0.346549645f, 0.34809853f, 0.349650353f, 0.351205098f,
+    0.35276275f, 0.354323294f, 0.355886714f, 0.357452995f, 0.35902212f, 0.360594076f, 0.362168844f, 0.36374641f,
+    0.365326757f, 0.36690987f, 0.368495731f, 0.370084324f, 0.371675633f, 0.373269641f, 0.374866331f, 0.376465687f,
+    0.37806769f, 0.379672325f, 0.381279575f, 0.38288942f, 0.384501845f, 0.386116832f, 0.387734363f, 0.38935442f,
+    0.390976985f, 0.392602041f, 0.39422957f, 0.395859552f, 0.39749197f, 0.399126806f, 0.400764041f, 0.402403656f,
+    0.404045633f, 0.405689952f, 0.407336596f, 0.408985544f, 0.410636778f, 0.412290279f, 0.413946026f, 0.415604002f,
+    0.417264185f, 0.418926557f, 0.420591098f, 0.422257787f, 0.423926605f, 0.425597533f, 0.427270549f, 0.428945633f,
+    0.430622765f, 0.432301925f, 0.433983093f, 0.435666246f, 0.437351365f, 0.439038429f, 0.440727417f, 0.442418307f,
+    0.44411108f, 0.445805712f, 0.447502184f, 0.449200473f, 0.450900558f, 0.452602418f, 0.45430603f, 0.456011374f,
+    0.457718426f, 0.459427166f, 0.46113757f, 0.462849617f, 0.464563285f, 0.46627855f, 0.467995391f, 0.469713786f,
+    0.47143371f, 0.473155143f, 0.47487806f, 0.476602439f, 0.478328258f, 0.480055492f, 0.481784119f, 0.483514115f,
+    0.485245457f, 0.486978122f, 0.488712086f, 0.490447326f, 0.492183818f, 0.493921537f, 0.495660461f, 0.497400565f,
+    0.499141826f, 0.500884218f, 0.502627719f, 0.504372303f, 0.506117947f, 0.507864625f, 0.509612314f, 0.511360989f,
+    0.513110625f, 0.514861197f, 0.516612682f, 0.518365052f, 0.520118285f, 0.521872354f, 0.523627235f, 0.525382903f,
+    0.527139331f, 0.528896496f, 0.53065437f, 0.53241293f, 0.534172149f, 0.535932002f, 0.537692462f, 0.539453505f,
+    0.541215105f, 0.542977234f, 0.544739869f, 0.546502982f, 0.548266547f, 0.550030538f, 0.55179493f, 0.553559695f,
+    0.555324807f, 0.55709024f, 0.558855968f, 0.560621963f, 0.562388199f, 0.56415465f, 0.565921289f, 0.567688089f,
+    0.569455022f, 0.571222063f, 0.572989184f, 0.574756358f, 0.576523559f, 0.578290758f, 0.580057928f, 0.581825044f,
+    0.583592076f, 0.585358998f, 0.587125782f, 0.588892401f, 0.590658828f, 0.592425034f, 0.594190992f, 0.595956675f,
+    0.597722055f, 0.599487103f, 0.601251793f, 0.603016095f, 0.604779984f, 0.606543429f, 0.608306404f, 0.61006888f,
+    0.61183083f, 0.613592224f, 0.615353036f, 0.617113236f, 0.618872796f, 0.620631689f, 0.622389886f, 0.624147358f,
+    0.625904077f, 0.627660015f, 0.629415142f, 0.631169432f, 0.632922854f, 0.634675381f, 0.636426983f, 0.638177633f,
+    0.639927301f, 0.641675959f, 0.643423578f, 0.645170129f, 0.646915583f, 0.648659912f, 0.650403087f, 0.652145078f,
+    0.653885858f, 0.655625396f, 0.657363664f, 0.659100633f, 0.660836275f, 0.662570559f, 0.664303457f, 0.666034939f,
+    0.667764978f, 0.669493543f, 0.671220605f, 0.672946136f, 0.674670106f, 0.676392486f, 0.678113246f, 0.679832358f,
+    0.681549792f, 0.683265519f, 0.68497951f, 0.686691736f, 0.688402166f, 0.690110773f, 0.691817526f, 0.693522396f,
+    0.695225355f, 0.696926372f, 0.698625418f, 0.700322464f, 0.702017481f, 0.70371044f, 0.70540131f, 0.707090063f,
+    0.708776669f, 0.710461099f, 0.712143323f, 0.713823313f, 0.715501039f, 0.717176471f, 0.71884958f, 0.720520337f,
+    0.722188713f, 0.723854677f, 0.725518202f, 0.727179257f, 0.728837813f, 0.730493841f, 0.732147312f, 0.733798196f,
+    0.735446464f, 0.737092087f, 0.738735035f, 0.74037528f, 0.742012792f, 0.743647541f, 0.7452795f, 0.746908638f,
+    0.748534926f, 0.750158336f, 0.751778837f, 0.753396402f, 0.755011001f, 0.756622604f, 0.758231184f, 0.75983671f,
+    0.761439154f, 0.763038487f, 0.76463468f, 0.766227704f, 0.76781753f, 0.76940413f, 0.770987474f, 0.772567534f,
+    0.774144281f, 0.775717685f, 0.77728772f, 0.778854355f, 0.780417562f, 0.781977313f, 0.783533579f, 0.785086332f,
+    0.786635542f, 0.788181182f, 0.789723223f, 0.791261637f, 0.792796395f, 0.794327469f, 0.795854831f, 0.797378453f,
+    0.798898306f, 0.800414362f, 0.801926593f, 0.803434972f, 0.804939469f, 0.806440058f, 0.80793671f, 0.809429397f,
+    0.810918092f, 0.812402767f, 0.813883394f, 0.815359946f, 0.816832394f, 0.818300712f, 0.819764871f, 0.821224845f,
+    0.822680606f, 0.824132126f, 0.825579379f, 0.827022337f, 0.828460974f, 0.829895261f, 0.831325171f, 0.832750679f,
+    0.834171757f, 0.835588378f, 0.837000515f, 0.838408142f, 0.839811232f, 0.841209758f, 0.842603693f, 0.843993013f,
+    0.845377689f, 0.846757695f, 0.848133006f, 0.849503596f, 0.850869437f, 0.852230504f, 0.853586771f, 0.854938212f,
+    0.856284802f, 0.857626514f, 0.858963322f, 0.860295202f, 0.861622128f, 0.862944074f, 0.864261014f, 0.865572925f,
+    0.866879779f, 0.868181553f, 0.86947822f, 0.870769757f, 0.872056138f, 0.873337339f, 0.874613334f, 0.875884099f,
+    0.87714961f, 0.878409842f, 0.87966477f, 0.880914371f, 0.88215862f, 0.883397492f, 0.884630965f, 0.885859014f,
+    0.887081615f, 0.888298744f, 0.889510378f, 0.890716493f, 0.891917066f, 0.893112073f, 0.894301491f, 0.895485296f,
+    0.896663467f, 0.897835978f, 0.899002809f, 0.900163936f, 0.901319335f, 0.902468986f, 0.903612864f, 0.904750948f,
+    0.905883215f, 0.907009644f, 0.908130211f, 0.909244896f, 0.910353675f, 0.911456528f, 0.912553432f, 0.913644367f,
+    0.914729309f, 0.91580824f, 0.916881135f, 0.917947976f, 0.91900874f, 0.920063407f, 0.921111956f, 0.922154367f,
+    0.923190617f, 0.924220688f, 0.925244558f, 0.926262208f, 0.927273617f, 0.928278766f, 0.929277633f, 0.9302702f,
+    0.931256447f, 0.932236354f, 0.933209902f, 0.934177071f, 0.935137843f, 0.936092197f, 0.937040115f, 0.937981579f,
+    0.938916569f, 0.939845067f, 0.940767054f, 0.941682512f, 0.942591423f, 0.943493768f, 0.94438953f, 0.94527869f,
+    0.946161231f, 0.947037136f, 0.947906386f, 0.948768964f, 0.949624854f, 0.950474037f, 0.951316497f, 0.952152218f,
+    0.952981181f, 0.953803371f, 0.954618772f, 0.955427366f, 0.956229137f, 0.957024071f, 0.957812149f, 0.958593358f,
+    0.95936768f, 0.960135101f, 0.960895605f, 0.961649176f, 0.9623958f, 0.963135461f, 0.963868145f, 0.964593837f,
+    0.965312522f, 0.966024186f, 0.966728814f, 0.967426392f, 0.968116906f, 0.968800343f, 0.969476687f, 0.970145927f,
+    0.970808047f, 0.971463036f, 0.972110879f, 0.972751563f, 0.973385076f, 0.974011405f, 0.974630536f, 0.975242459f,
+    0.975847159f, 0.976444625f, 0.977034845f, 0.977617806f, 0.978193498f, 0.978761908f, 0.979323025f, 0.979876837f,
+    0.980423333f, 0.980962503f, 0.981494334f, 0.982018817f, 0.982535941f, 0.983045695f, 0.983548069f, 0.984043052f,
+    0.984530635f, 0.985010808f, 0.985483561f, 0.985948884f, 0.986406768f, 0.986857203f, 0.987300181f, 0.987735692f,
+    0.988163728f, 0.98858428f, 0.988997338f, 0.989402896f, 0.989800944f, 0.990191475f, 0.99057448f, 0.990949952f,
+    0.991317883f, 0.991678265f, 0.992031092f, 0.992376356f, 0.99271405f, 0.993044167f, 0.9933667f, 0.993681643f,
+    0.993988989f, 0.994288733f, 0.994580867f, 0.994865387f, 0.995142286f, 0.995411558f, 0.995673198f, 0.995927201f,
+    0.996173562f, 0.996412275f, 0.996643336f, 0.99686674f, 0.997082482f, 0.997290558f, 0.997490963f, 0.997683695f,
+    0.997868748f, 0.998046118f, 0.998215803f, 0.998377799f, 0.998532103f, 0.99867871f, 0.998817619f, 0.998948827f,
+    0.99907233f, 0.999188127f, 0.999296214f, 0.99939659f, 0.999489253f, 0.999574201f, 0.999651431f, 0.999720943f,
+    0.999782735f, 0.999836806f, 0.999883155f, 0.99992178f, 0.999952681f, 0.999975857f, 0.999991309f, 0.999999034f,
+    0.999999034f, 0.999991309f, 0.999975857f, 0.999952681f, 0.99992178f, 0.999883155f, 0.999836806f, 0.999782735f,
+    0.999720943f, 0.999651431f, 0.999574201f, 0.999489253f, 0.99939659f, 0.999296214f, 0.999188127f, 0.99907233f,
+    0.998948827f, 0.998817619f, 0.99867871f, 0.998532103f, 0.998377799f, 0.998215803f, 0.998046118f, 0.997868748f,
+    0.997683695f, 0.997490963f, 0.997290558f, 0.997082482f, 0.99686674f, 0.996643336f, 0.996412275f, 0.996173562f,
+    0.995927201f, 0.995673198f, 0.995411558f, 0.995142286f, 0.994865387f, 0.994580867f, 0.994288733f, 0.993988989f,
+    0.993681643f, 0.9933667f, 0.993044167f, 0.99271405f, 0.992376356f, 0.992031092f, 0.991678265f, 0.991317883f,
+    0.990949952f, 0.99057448f, 0.990191475f, 0.989800944f, 0.989402896f, 0.988997338f, 0.98858428f, 0.988163728f,
+    0.987735692f, 0.987300181f, 0.986857203f, 0.986406768f, 0.985948884f, 0.985483561f, 0.985010808f, 0.984530635f,
+    0.984043052f, 0.983548069f, 0.983045695f, 0.982535941f, 0.982018817f, 0.981494334f, 0.980962503f, 0.980423333f,
+    0.979876837f, 0.979323025f, 0.978761908f, 0.978193498f, 0.977617806f, 0.977034845f, 0.976444625f, 0.975847159f,
+    0.975242459f, 0.974630536f, 0.974011405f, 0.973385076f, 0.972751563f, 0.972110879f, 0.971463036f, 0.970808047f,
+    0.970145927f, 0.969476687f, 0.968800343f, 0.968116906f, 0.967426392f, 0.966728814f, 0.966024186f, 0.965312522f,
+    0.964593837f, 0.963868145f, 0.963135461f, 0.9623958f, 0.961649176f, 0.960895605f, 0.960135101f, 0.95936768f,
+    0.958593358f, 0.957812149f, 0.957024071f, 0.956229137f, 0.955427366f, 0.954618772f, 0.953803371f, 0.952981181f,
+    0.952152218f, 0.951316497f, 0.950474037f, 0.949624854f, 0.948768964f, 0.947906386f, 0.947037136f, 0.946161231f,
+    0.94527869f, 0.94438953f, 0.943493768f, 0.942591423f, 0.941682512f, 0.940767054f, 0.939845067f, 0.938916569f,
+    0.937981579f, 0.937040115f, 0.936092197f, 0.935137843f, 0.934177071f, 0.933209902f, 0.932236354f, 0.931256447f,
+    0.9302702f, 0.929277633f, 0.928278766f, 0.927273617f, 0.926262208f, 0.925244558f, 0.924220688f, 0.923190617f,
+    0.922154367f, 0.921111956f, 0.920063407f, 0.91900874f, 0.917947976f, 0.916881135f, 0.91580824f, 0.914729309f,
+    0.913644367f, 0.912553432f, 0.911456528f, 0.910353675f, 0.909244896f, 0.908130211f, 0.907009644f, 0.905883215f,
+    0.904750948f, 0.903612864f, 0.902468986f, 0.901319335f, 0.900163936f, 0.899002809f, 0.897835978f, 0.896663467f,
+    0.895485296f, 0.894301491f, 0.893112073f, 0.891917066f, 0.890716493f, 0.889510378f, 0.888298744f, 0.887081615f,
+    0.885859014f, 0.884630965f, 0.883397492f, 0.88215862f, 0.880914371f, 0.87966477f, 0.878409842f, 0.87714961f,
+    0.875884099f, 0.874613334f, 0.873337339f, 0.872056138f, 0.870769757f, 0.86947822f, 0.868181553f, 0.866879779f,
+    0.865572925f, 0.864261014f, 0.862944074f, 0.861622128f, 0.860295202f, 0.858963322f, 0.857626514f, 0.856284802f,
+    0.854938212f, 0.853586771f, 0.852230504f, 0.850869437f, 0.849503596f, 0.848133006f, 0.846757695f, 0.845377689f,
+    0.843993013f, 0.842603693f, 0.841209758f, 0.839811232f, 0.838408142f, 0.837000515f, 0.835588378f, 0.834171757f,
+    0.832750679f, 0.831325171f, 0.829895261f, 0.828460974f, 0.827022337f, 0.825579379f, 0.824132126f, 0.822680606f,
+    0.821224845f, 0.819764871f, 0.818300712f, 0.816832394f, 0.815359946f, 0.813883394f, 0.812402767f, 0.810918092f,
+    0.809429397f, 0.80793671f, 0.806440058f, 0.804939469f, 0.803434972f, 0.801926593f, 0.800414362f, 0.798898306f,
+    0.797378453f, 0.795854831f, 0.794327469f, 0.792796395f, 0.791261637f, 0.789723223f, 0.788181182f, 0.786635542f,
+    0.785086332f, 0.783533579f, 0.781977313f, 0.780417562f, 0.778854355f, 0.77728772f, 0.775717685f, 0.774144281f,
+    0.772567534f, 0.770987474f, 0.76940413f, 0.76781753f, 0.766227704f, 0.76463468f, 0.763038487f, 0.761439154f,
+    0.75983671f, 0.758231184f, 0.756622604f, 0.755011001f, 0.753396402f, 0.751778837f, 0.750158336f, 0.748534926f,
+    0.746908638f, 0.7452795f, 0.743647541f, 0.742012792f, 0.74037528f, 0.738735035f, 0.737092087f, 0.735446464f,
+    0.733798196f, 0.732147312f, 0.730493841f, 0.728837813f, 0.727179257f, 0.725518202f, 0.723854677f, 0.722188713f,
+    0.720520337f, 0.71884958f, 0.717176471f, 0.715501039f, 0.713823313f, 0.712143323f, 0.710461099f, 0.708776669f,
+    0.707090063f, 0.70540131f, 0.70371044f, 0.702017481f, 0.700322464f, 0.698625418f, 0.696926372f, 0.695225355f,
+    0.693522396f, 0.691817526f, 0.690110773f, 0.688402166f, 0.686691736f, 0.68497951f, 0.683265519f, 0.681549792f,
+    0.679832358f, 0.678113246f, 0.676392486f, 0.674670106f, 0.672946136f, 0.671220605f, 0.669493543f, 0.667764978f,
+    0.666034939f, 0.664303457f, 0.662570559f, 0.660836275f, 0.659100633f, 0.657363664f, 0.655625396f, 0.653885858f,
+    0.652145078f, 0.650403087f, 0.648659912f, 0.646915583f, 0.645170129f, 0.643423578f, 0.641675959f, 0.639927301f,
+    0.638177633f, 0.636426983f, 0.634675381f, 0.632922854f, 0.631169432f, 0.629415142f, 0.627660015f, 0.625904077f,
+    0.624147358f, 0.622389886f, 0.620631689f, 0.618872796f, 0.617113236f, 0.615353036f, 0.613592224f, 0.61183083f,
+    0.61006888f, 0.608306404f, 0.606543429f, 0.604779984f, 0.603016095f, 0.601251793f, 0.599487103f, 0.597722055f,
+    0.595956675f, 0.594190992f, 0.592425034f, 0.590658828f, 0.588892401f, 0.587125782f, 0.585358998f, 0.583592076f,
+    0.581825044f, 0.580057928f, 0.578290758f, 0.576523559f, 0.574756358f, 0.572989184f, 0.571222063f, 0.569455022f,
+    0.567688089f, 0.565921289f, 0.56415465f, 0.562388199f, 0.560621963f, 0.558855968f, 0.55709024f, 0.555324807f,
+    0.553559695f, 0.55179493f, 0.550030538f, 0.548266547f, 0.546502982f, 0.544739869f, 0.542977234f, 0.541215105f,
+    0.539453505f, 0.537692462f, 0.535932002f, 0.534172149f, 0.53241293f, 0.53065437f, 0.528896496f, 0.527139331f,
+    0.525382903f, 0.523627235f, 0.521872354f, 0.520118285f, 0.518365052f, 0.516612682f, 0.514861197f, 0.513110625f,
+    0.511360989f, 0.509612314f, 0.507864625f, 0.506117947f, 0.504372303f, 0.502627719f, 0.500884218f, 0.499141826f,
+    0.497400565f, 0.495660461f, 0.493921537f, 0.492183818f, 0.490447326f, 0.488712086f, 0.486978122f, 0.485245457f,
+    0.483514115f, 0.481784119f, 0.480055492f, 0.478328258f, 0.476602439f, 0.47487806f, 0.473155143f, 0.47143371f,
+    0.469713786f, 0.467995391f, 0.46627855f, 0.464563285f, 0.462849617f, 0.46113757f, 0.459427166f, 0.457718426f,
+    0.456011374f, 0.45430603f, 0.452602418f, 0.450900558f, 0.449200473f, 0.447502184f, 0.445805712f, 0.44411108f,
+    0.442418307f, 0.440727417f, 0.439038429f, 0.437351365f, 0.435666246f, 0.433983093f, 0.432301925f, 0.430622765f,
+    0.428945633f, 0.427270549f, 0.425597533f, 0.423926605f, 0.422257787f, 0.420591098f, 0.418926557f, 0.417264185f,
+    0.415604002f, 0.413946026f, 0.412290279f, 0.410636778f, 0.408985544f, 0.407336596f, 0.405689952f, 0.404045633f,
+    0.402403656f, 0.400764041f, 0.399126806f, 0.39749197f, 0.395859552f, 0.39422957f, 0.392602041f, 0.390976985f,
+    0.38935442f, 0.387734363f, 0.386116832f, 0.384501845f, 0.38288942f, 0.381279575f, 0.379672325f, 0.37806769f,
+    0.376465687f, 0.374866331f, 0.373269641f, 0.371675633f, 0.370084324f, 0.368495731f, 0.36690987f, 0.365326757f,
+    0.36374641f, 0.362168844f, 0.360594076f, 0.35902212f, 0.357452995f, 0.355886714f, 0.354323294f, 0.35276275f,
+    0.351205098f, 0.349650353f, 0.34809853f, 0.346549645f, 0.345003712f, 0.343460747f, 0.341920763f, 0.340383777f,
+    0.338849801f, 0.337318852f, 0.335790942f, 0.334266087f, 0.332744299f, 0.331225595f, 0.329709986f, 0.328197487f,
+    0.326688112f, 0.325181874f, 0.323678786f, 0.322178862f, 0.320682115f, 0.319188558f, 0.317698204f, 0.316211066f,
+    0.314727156f, 0.313246487f, 0.311769072f, 0.310294923f, 0.308824051f, 0.30735647f, 0.305892192f, 0.304431228f,
+    0.302973589f, 0.301519289f, 0.300068337f, 0.298620747f, 0.297176528f, 0.295735693f, 0.294298252f, 0.292864216f,
+    0.291433596f, 0.290006404f, 0.288582648f, 0.287162341f, 0.285745493f, 0.284332113f, 0.282922212f, 0.2815158f,
+    0.280112887f, 0.278713483f, 0.277317597f, 0.27592524f, 0.27453642f, 0.273151146f, 0.271769429f, 0.270391277f,
+    0.269016699f, 0.267645705f, 0.266278302f, 0.264914501f, 0.263554308f, 0.262197733f, 0.260844783f, 0.259495468f,
+    0.258149796f, 0.256807773f, 0.255469408f, 0.25413471f, 0.252803684f, 0.25147634f, 0.250152684f, 0.248832724f,
+    0.247516467f, 0.24620392f, 0.244895089f, 0.243589983f, 0.242288606f, 0.240990967f, 0.239697072f, 0.238406926f,
+    0.237120537f, 0.23583791f, 0.234559051f, 0.233283967f, 0.232012663f, 0.230745146f, 0.229481419f, 0.22822149f,
+    0.226965363f, 0.225713044f, 0.224464537f, 0.223219849f, 0.221978983f, 0.220741945f, 0.219508739f, 0.21827937f,
+    0.217053843f, 0.215832162f, 0.21461433f, 0.213400354f, 0.212190235f, 0.210983979f, 0.209781589f, 0.208583069f,
+    0.207388422f, 0.206197652f, 0.205010763f, 0.203827758f, 0.20264864f, 0.201473412f, 0.200302077f, 0.199134637f,
+    0.197971097f, 0.196811458f, 0.195655723f, 0.194503894f, 0.193355975f, 0.192211966f, 0.19107187f, 0.18993569f,
+    0.188803427f, 0.187675083f, 0.18655066f, 0.185430159f, 0.184313582f, 0.18320093f, 0.182092206f, 0.180987409f,
+    0.179886541f, 0.178789603f, 0.177696597f, 0.176607522f, 0.17552238f, 0.174441171f, 0.173363896f, 0.172290555f,
+    0.171221148f, 0.170155677f, 0.16909414f, 0.168036538f, 0.166982871f, 0.165933139f, 0.164887342f, 0.163845479f,
+    0.162807549f, 0.161773553f, 0.160743489f, 0.159717358f, 0.158695157f, 0.157676887f, 0.156662546f, 0.155652133f,
+    0.154645647f, 0.153643087f, 0.152644451f, 0.151649738f, 0.150658946f, 0.149672074f, 0.14868912f, 0.147710083f,
+    0.146734959f, 0.145763748f, 0.144796448f, 0.143833055f, 0.142873569f, 0.141917986f, 0.140966304f, 0.140018521f,
+    0.139074634f, 0.13813464f, 0.137198537f, 0.136266322f, 0.135337992f, 0.134413543f, 0.133492974f, 0.13257628f,
+    0.131663459f, 0.130754507f, 0.129849421f, 0.128948196f, 0.128050831f, 0.127157321f, 0.126267662f, 0.12538185f,
+    0.124499883f, 0.123621754f, 0.122747462f, 0.121877001f, 0.121010368f, 0.120147558f, 0.119288567f, 0.11843339f,
+    0.117582024f, 0.116734463f, 0.115890702f, 0.115050738f, 0.114214565f, 0.113382179f, 0.112553575f, 0.111728747f,
+    0.110907691f, 0.110090402f, 0.109276874f, 0.108467103f, 0.107661082f, 0.106858807f, 0.106060272f, 0.105265471f,
+    0.1044744f, 0.103687052f, 0.102903422f, 0.102123504f, 0.101347292f, 0.10057478f, 0.0998059625f, 0.0990408334f,
+    0.0982793867f, 0.0975216161f, 0.0967675155f, 0.0960170787f, 0.0952702994f, 0.0945271711f, 0.0937876877f, 0.0930518424f,
+    0.0923196289f, 0.0915910406f, 0.0908660707f, 0.0901447128f, 0.0894269599f, 0.0887128054f, 0.0880022424f, 0.0872952639f,
+    0.0865918631f, 0.085892033f, 0.0851957665f, 0.0845030565f, 0.0838138958f, 0.0831282774f, 0.0824461939f, 0.0817676382f,
+    0.0810926027f, 0.0804210802f, 0.0797530633f, 0.0790885444f, 0.0784275161f, 0.0777699709f, 0.077115901f, 0.076465299f,
+    0.075818157f, 0.0751744675f, 0.0745342225f, 0.0738974144f, 0.0732640353f, 0.0726340773f, 0.0720075325f, 0.0713843929f,
+    0.0707646506f, 0.0701482975f, 0.0695353255f, 0.0689257266f, 0.0683194927f, 0.0677166154f, 0.0671170868f, 0.0665208985f,
+    0.0659280422f, 0.0653385098f, 0.0647522927f, 0.0641693828f, 0.0635897716f, 0.0630134506f, 0.0624404115f, 0.0618706458f,
+    0.0613041449f, 0.0607409004f, 0.0601809036f, 0.0596241461f, 0.0590706193f, 0.0585203144f, 0.0579732228f, 0.0574293359f,
+    0.056888645f, 0.0563511413f, 0.0558168162f, 0.0552856608f, 0.0547576664f, 0.0542328242f, 0.0537111254f, 0.0531925611f,
+    0.0526771224f, 0.0521648006f, 0.0516555867f, 0.0511494718f, 0.050646447f, 0.0501465034f, 0.049649632f, 0.0491558239f,
+    0.0486650701f, 0.0481773615f, 0.0476926893f, 0.0472110444f, 0.0467324178f, 0.0462568005f, 0.0457841834f, 0.0453145574f,
+    0.0448479136f, 0.0443842429f, 0.0439235362f, 0.0434657843f, 0.0430109784f, 0.0425591092f, 0.0421101677f, 0.0416641447f,
+    0.0412210313f, 0.0407808182f, 0.0403434965f, 0.0399090569f, 0.0394774904f, 0.0390487878f, 0.0386229402f, 0.0381999383f,
+    0.0377797731f, 0.0373624354f, 0.0369479163f, 0.0365362065f, 0.036127297f, 0.0357211787f, 0.0353178425f, 0.0349172794f,
+    0.0345194802f, 0.034124436f, 0.0337321376f, 0.033342576f, 0.0329557422f, 0.0325716272f, 0.0321902218f, 0.0318115172f,
+    0.0314355042f, 0.031062174f, 0.0306915175f, 0.0303235257f, 0.0299581898f, 0.0295955007f, 0.0292354496f, 0.0288780275f,
+    0.0285232256f, 0.0281710348f, 0.0278214465f, 0.0274744517f, 0.0271300416f, 0.0267882073f, 0.0264489402f, 0.0261122314f,
+    0.0257780721f, 0.0254464536f, 0.0251173672f, 0.0247908042f, 0.0244667559f, 0.0241452137f, 0.0238261688f, 0.0235096128f,
+    0.0231955371f, 0.022883933f, 0.022574792f, 0.0222681056f, 0.0219638654f, 0.0216620628f, 0.0213626895f, 0.0210657369f,
+    0.0207711968f, 0.0204790609f, 0.0201893206f, 0.0199019678f, 0.0196169943f, 0.0193343917f, 0.0190541518f, 0.0187762666f,
+    0.0185007278f, 0.0182275273f, 0.0179566571f, 0.0176881091f, 0.0174218753f, 0.0171579477f, 0.0168963183f, 0.0166369794f,
+    0.0163799229f, 0.0161251411f, 0.0158726261f, 0.0156223702f, 0.0153743657f, 0.0151286048f, 0.0148850799f, 0.0146437835f,
+    0.0144047078f, 0.0141678454f, 0.0139331889f, 0.0137007306f, 0.0134704633f, 0.0132423795f, 0.0130164719f, 0.0127927332f,
+    0.0125711562f, 0.0123517336f, 0.0121344583f, 0.0119193233f, 0.0117063213f, 0.0114954453f, 0.0112866885f, 0.0110800438f,
+    0.0108755043f, 0.0106730633f, 0.0104727138f, 0.0102744491f, 0.0100782626f, 0.00988414757f, 0.00969209737f, 0.00950210545f,
+    0.0093141653f, 0.00912827046f, 0.00894441449f, 0.00876259104f, 0.00858279378f, 0.00840501646f, 0.00822925284f, 0.00805549678f,
+    0.00788374215f, 0.00771398289f, 0.00754621299f, 0.0073804265f, 0.00721661751f, 0.00705478017f, 0.00689490869f, 0.00673699732f,
+    0.00658104038f, 0.00642703223f, 0.00627496729f, 0.00612484004f, 0.00597664501f, 0.0058303768f, 0.00568603004f, 0.00554359943f,
+    0.00540307974f, 0.00526446578f, 0.00512775242f, 0.00499293459f, 0.00486000728f, 0.00472896554f, 0.00459980446f, 0.00447251923f,
+    0.00434710505f, 0.00422355722f, 0.00410187106f, 0.00398204199f, 0.00386406547f, 0.00374793703f, 0.00363365223f, 0.00352120673f,
+    0.00341059624f, 0.00330181651f, 0.00319486339f, 0.00308973275f, 0.00298642056f, 0.00288492283f, 0.00278523563f, 0.0026873551f,
+    0.00259127746f, 0.00249699896f, 0.00240451593f, 0.00231382478f, 0.00222492195f, 0.00213780398f, 0.00205246743f, 0.00196890898f,
+    0.00188712532f, 0.00180711325f, 0.0017288696f, 0.00165239129f, 0.00157767529f, 0.00150471864f, 0.00143351845f, 0.00136407189f,
+    0.00129637621f, 0.00123042869f, 0.00116622672f, 0.00110376774f, 0.00104304924f, 0.000984068805f, 0.000926824062f, 0.000871312719f,
+    0.000817532549f, 0.00076548139f, 0.000715157149f, 0.000666557801f, 0.000619681385f, 0.000574526013f, 0.000531089861f, 0.000489371174f,
+    0.000449368266f, 0.000411079517f, 0.000374503377f, 0.000339638364f, 0.000306483065f, 0.000275036133f, 0.000245296292f, 0.000217262334f,
+    0.000190933119f, 0.000166307576f, 0.000143384704f, 0.00012216357f, 0.000102643308f, 8.48231245e-05f, 6.87022924e-05f, 5.42801549e-05f,
+    4.15561236e-05f, 3.05296797e-05f, 2.12003732e-05f, 1.35678234e-05f, 7.63171894e-06f, 3.39181739e-06f, 8.47945693e-07f, 0.0f,
+};
+
+// 位反转置换表（N/2点复数FFT）
+const uint16_t dsp_fft_bitrev[FFT_LENGTH / 2] = {
+    0, 512, 256, 768, 128, 640, 384, 896, 64, 576, 320, 832, 192, 704, 448, 960,
+    32, 544, 288, 800, 160, 672, 416, 928, 96, 608, 352, 864, 224, 736, 480, 992,
+    16, 528, 272, 784, 144, 656, 400, 912, 80, 592, 336, 848, 208, 720, 464, 976,
+    48, 560, 304, 816, 176, 688, 432, 944, 112, 624, 368, 880, 240, 752, 496, 1008,
+    8, 520, 264, 776, 136, 648, 392, 904, 72, 584, 328, 840, 200, 712, 456, 968,
+    40, 552, 296, 808, 168, 680, 424, 936, 104, 616, 360, 872, 232, 744, 488, 1000,
+    24, 536, 280, 792, 152, 664, 408, 920, 88, 600, 344, 856, 216, 728, 472, 984,
+    56, 568, 312, 824, 184, 696, 440, 952, 120, 632, 376, 888, 248, 760, 504, 1016,
+    4, 516, 260, 772, 132, 644, 388, 900, 68, 580, 324, 836, 196, 708, 452, 964,
+    36, 548, 292, 804, 164, 676, 420, 932, 100, 612, 356, 868, 228, 740, 484, 996,
+    20, 532, 276, 788, 148, 660, 404, 916, 84, 596, 340, 852, 212, 724, 468, 980,
+    52, 564, 308, 820, 180, 692, 436, 948, 116, 628, 372, 884, 244, 756, 500, 1012,
+    12, 524, 268, 780, 140, 652, 396, 908, 76, 588, 332, 844, 204, 716, 460, 972,
+    44, 556, 300, 812, 172, 684, 428, 940, 108, 620, 364, 876, 236, 748, 492, 1004,
+    28, 540, 284, 796, 156, 668, 412, 924, 92, 604, 348, 860, 220, 732, 476, 988,
+    60, 572, 316, 828, 188, 700, 444, 956, 124, 636, 380, 892, 252, 764, 508, 1020,
+    2, 514, 258, 770, 130, 642, 386, 898, 66, 578, 322, 834, 194, 706, 450, 962,
+    34, 546, 290, 802, 162, 674, 418, 930, 98, 610, 354, 866, 226, 738, 482, 994,
+    18, 530, 274, 786, 146, 658, 402, 914, 82, 594, 338, 850, 210, 722, 466, 978,
+    50, 562, 306, 818, 178, 690, 434, 946, 114, 626, 370, 882, 242, 754, 498, 1010,
+    10, 522, 266, 778, 138, 650, 394, 906, 74, 586, 330, 842, 202, 714, 458, 970,
+    42, 554, 298, 810, 170, 682, 426, 938, 106, 618, 362, 874, 234, 746, 490, 1002,
+    26, 538, 282, 794, 154, 666, 410, 922, 90, 602, 346, 858, 218, 730, 474, 986,
+    58, 570, 314, 826, 186, 698, 442, 954, 122, 634, 378, 890, 250, 762, 506, 1018,
+    6, 518, 262, 774, 134, 646, 390, 902, 70, 582, 326, 838, 198, 710, 454, 966,
+    38, 550, 294, 806, 166, 678, 422, 934, 102, 614, 358, 870, 230, 742, 486, 998,
+    22, 534, 278, 790, 150, 662, 406, 918, 86, 598, 342, 854, 214, 726, 470, 982,
+    54, 566, 310, 822, 182, 694, 438, 950, 118, 630, 374, 886, 246, 758, 502, 1014,
+    14, 526, 270, 782, 142, 654, 398, 910, 78, 590, 334, 846, 206, 718, 462, 974,
+    46, 558, 302, 814, 174, 686, 430, 942, 110, 622, 366, 878, 238, 750, 494, 1006,
+    30, 542, 286, 798, 158, 670, 414, 926, 94, 606, 350, 862, 222, 734, 478, 990,
+    62, 574, 318, 830, 190, 702, 446, 958, 126, 638, 382, 894, 254, 766, 510, 1022,
+    1, 513, 257, 769, 129, 641, 385, 897, 65, 577, 321, 833, 193, 705, 449, 961,
+    33, 545, 289, 801, 161, 673, 417, 929, 97, 609, 353, 865, 225, 737, 481, 993,
+    17, 529, 273, 785, 145, 657, 401, 913, 81, 593, 337, 849, 209, 721, 465, 977,
+    49, 561, 305, 817, 177, 689, 433, 945, 113, 625, 369, 881, 241, 753, 497, 1009,
+    9, 521, 265, 777, 137, 649, 393, 905, 73, 585, 329, 841, 201, 713, 457, 969,
+    41, 553, 297, 809, 169, 681, 425, 937, 105, 617, 361, 873, 233, 745, 489, 1001,
+    25, 537, 281, 793, 153, 665, 409, 921, 89, 601, 345, 857, 217, 729, 473, 985,
+    57, 569, 313, 825, 185, 697, 441, 953, 121, 633, 377, 889, 249, 761, 505, 1017,
+    5, 517, 261, 773, 133, 645, 389, 901, 69, 581, 325, 837, 197, 709, 453, 965,
+    37, 549, 293, 805, 165, 677, 421, 933, 101, 613, 357, 869, 229, 741, 485, 997,
+    21, 533, 277, 789, 149, 661, 405, 917, 85, 597, 341, 853, 213, 725, 469, 981,
+    53, 565, 309, 821, 181, 693, 437, 949, 117, 629, 373, 885, 245, 757, 501, 1013,
+    13, 525, 269, 781, 141, 653, 397, 909, 77, 589, 333, 845, 205, 717, 461, 973,
+    45, 557, 301, 813, 173, 685, 429, 941, 109, 621, 365, 877, 237, 749, 493, 1005,
+    29, 541, 285, 797, 157, 669, 413, 925, 93, 605, 349, 861, 221, 733, 477, 989,
+    61, 573, 317, 829, 189, 701, 445, 957, 125, 637, 381, 893, 253, 765, 509, 1021,
+    3, 515, 259, 771, 131, 643, 387, 899, 67, 579, 323, 835, 195, 707, 451, 963,
+    35, 547, 291, 803, 163, 675, 419, 931, 99, 611, 355, 867, 227, 739, 483, 995,
+    19, 531, 275, 787, 147, 659, 403, 915, 83, 595, 339, 851, 211, 723, 467, 979,
+    51, 563, 307, 819, 179, 691, 435, 947, 115, 627, 371, 883, 243, 755, 499, 1011,
+    11, 523, 267, 779, 139, 651, 395, 907, 75, 587, 331, 843, 203, 715, 459, 971,
+    43, 555, 299, 811, 171, 683, 427, 939, 107, 619, 363, 875, 235, 747, 491, 1003,
+    27, 539, 283, 795, 155, 667, 411, 923, 91, 603, 347, 859, 219, 731, 475, 987,
+    59, 571, 315, 827, 187, 699, 443, 955, 123, 635, 379, 891, 251, 763, 507, 1019,
+    7, 519, 263, 775, 135, 647, 391, 903, 71, 583, 327, 839, 199, 711, 455, 967,
+    39, 551, 295, 807, 167, 679, 423, 935, 103, 615, 359, 871, 231, 743, 487, 999,
+    23, 535, 279, 791, 151, 663, 407, 919, 87, 599, 343, 855, 215, 727, 471, 983,
+    55, 567, 311, 823, 183, 695, 439, 951, 119, 631, 375, 887, 247, 759, 503, 1015,
+    15, 527, 271, 783, 143, 655, 399, 911, 79, 591, 335, 847, 207, 719, 463, 975,
+    47, 559, 303, 815, 175, 687, 431, 943, 111, 623, 367, 879, 239, 751, 495, 1007,
+    31, 543, 287, 799, 159, 671, 415, 927, 95, 607, 351, 863, 223, 735, 479, 991,
+    63, 575, 319, 831, 191, 703, 447, 959, 127, 639, 383, 895, 255, 767, 511, 1023,
+};
+
+// 各级蝶形旋转因子（第s级hl个，依次拼接）
+ANC_ALIGN(64) const float dsp_fft_stage_tw_re[FFT_LENGTH / 2] = {
+    1.0f, 1.0f, 0.0f, 1.0f, 0.707106781f, 0.0f, -0.707106781f, 1.0f,
+    0.923879533f, 0.707106781f, 0.382683432f, 0.0f, -0.382683432f, -0.707106781f, -0.923879533f, 1.0f,
+    0.98078528f, 0.923879533f, 0.831469612f, 0.707106781f, 0.555570233f, 0.382683432f, 0.195090322f, 0.0f,
+    -0.195090322f, -0.382683432f, -0.555570233f, -0.707106781f, -0.831469612f, -0.923879533f, -0.98078528f, 1.0f,
+    0.995184727f, 0.98078528f, 0.956940336f, 0.923879533f, 0.881921264f, 0.831469612f, 0.773010453f, 0.707106781f,
+    0.634393284f, 0.555570233f, 0.471396737f, 0.382683432f, 0.290284677f, 0.195090322f, 0.0980171403f, 0.0f,
+    -0.0980171403f, -0.195090322f, -0.290284677f, -0.382683432f, -0.471396737f, -0.555570233f, -0.634393284f, -0.707106781f,
+    -0.773010453f, -0.831469612f, -0.881921264f, -0.923879533f, -0.956940336f, -0.98078528f, -0.995184727f, 1.0f,
+    0.998795456f, 0.995184727f, 0.98917651f, 0.98078528f, 0.970031253f, 0.956940336f, 0.941544065f, 0.923879533f,
+    0.903989293f, 0.881921264f, 0.85772861f, 0.831469612f, 0.803207531f, 0.773010453f, 0.740951125f, 0.707106781f,
+    0.671558955f, 0.634393284f, 0.595699304f, 0.555570233f, 0.514102744f, 0.471396737f, 0.427555093f, 0.382683432f,
+    0.336889853f, 0.290284677f, 0.24298018f, 0.195090322f, 0.146730474f, 0.0980171403f, 0.0490676743f, 0.0f,
+    -0.0490676743f, -0.0980171403f, -0.146730474f, -0.195090322f, -0.24298018f, -0.290284677f, -0.336889853f, -0.382683432f,
+    -0.427555093f, -0.471396737f, -0.514102744f, -0.555570233f, -0.595699304f, -0.634393284f, -0.671558955f, -0.707106781f,
+    -0.740951125f, -0.773010453f, -0.803207531f, -0.831469612f, -0.85772861f, -0.881921264f, -0.903989293f, -0.923879533f,
+    -0.941544065f, -0.956940336f, -0.970031253f, -0.98078528f, -0.98917651f, -0.995184727f, -0.998795456f, 1.0f,
+    0.999698819f, 0.998795456f, 0.997290457f, 0.995184727f, 0.992479535f, 0.98917651f, 0.985277642f, 0.98078528f,
+    0.97570213f, 0.970031253f, 0.963776066f, 0.956940336f, 0.949528181f, 0.941544065f, 0.932992799f, 0.923879533f,
+    0.914209756f, 0.903989293f, 0.893224301f, 0.881921264f, 0.870086991f, 0.85772861f, 0.844853565f, 0.831469612f,
+    0.817584813f, 0.803207531f, 0.788346428f, 0.773010453f, 0.757208847f, 0.740951125f, 0.724247083f, 0.707106781f,
+    0.689540545f, 0.671558955f, 0.653172843f, 0.634393284f, 0.615231591f, 0.595699304f, 0.575808191f, 0.555570233f,
+    0.53499762f, 0.514102744f, 0.492898192f, 0.471396737f, 0.44961133f, 0.427555093f, 0.405241314f, 0.382683432f,
+    0.359895037f, 0.336889853f, 0.31368174f, 0.290284677f, 0.266712757f, 0.24298018f, 0.21910124f, 0.195090322f,
+    0.170961889f, 0.146730474f, 0.122410675f, 0.0980171403f, 0.0735645636f, 0.0490676743f, 0.0245412285f, 0.0f,
+    -0.0245412285f, -0.0490676743f, -0.0735645636f, -0.0980171403f, -0.122410675f, -0.146730474f, -0.170961889f, -0.195090322f,
+    -0.21910124f, -0.24298018f, -0.266712757f, -0.290284677f, -0.31368174f, -0.336889853f, -0.359895037f, -0.382683432f,
+    -0.405241314f, -0.427555093f, -0.44961133f, -0.471396737f, -0.492898192f, -0.514102744f, -0.53499762f, -0.555570233f,
+    -0.575808191f, -0.595699304f, -0.615231591f, -0.634393284f, -0.653172843f, -0.671558955f, -0.689540545f, -0.707106781f,
+    -0.724247083f, -0.740951125f, -0.757208847f, -0.773010453f, -0.788346428f, -0.803207531f, -0.817584813f, -0.831469612f,
+    -0.844853565f, -0.85772861f, -0.870086991f, -0.881921264f, -0.893224301f, -0.903989293f, -0.914209756f, -0.923879533f,
+    -0.932992799f, -0.941544065f, -0.949528181f, -0.956940336f, -0.963776066f, -0.970031253f, -0.97570213f, -0.98078528f,
+    -0.985277642f, -0.98917651f, -0.992479535f, -0.995184727f, -0.997290457f, -0.998795456f, -0.999698819f, 1.0f,
+    0.999924702f, 0.999698819f, 0.999322385f, 0.998795456f, 0.998118113f, 0.997290457f, 0.996312612f, 0.995184727f,
+    0.99390697f, 0.992479535f, 0.990902635f, 0.98917651f, 0.987301418f, 0.985277642f, 0.983105487f, 0.98078528f,
+    0.978317371f, 0.97570213f, 0.972939952f, 0.970031253f, 0.966976471f, 0.963776066f, 0.960430519f, 0.956940336f,
+    0.95330604f, 0.949528181f, 0.945607325f, 0.941544065f, 0.937339012f, 0.932992799f, 0.92850608f, 0.923879533f,
+    0.919113852f, 0.914209756f, 0.909167983f, 0.903989293f, 0.898674466f, 0.893224301f, 0.88763962f, 0.881921264f,
+    0.876070094f, 0.870086991f, 0.863972856f, 0.85772861f, 0.851355193f, 0.844853565f, 0.838224706f, 0.831469612f,
+    0.824589303f, 0.817584813f, 0.810457198f, 0.803207531f, 0.795836905f, 0.788346428f, 0.780737229f, 0.773010453f,
+    0.765167266f, 0.757208847f, 0.749136395f, 0.740951125f, 0.732654272f, 0.724247083f, 0.715730825f, 0.707106781f,
+    0.698376249f, 0.689540545f, 0.680600998f, 0.671558955f, 0.662415778f, 0.653172843f, 0.643831543f, 0.634393284f,
+    0.624859488f, 0.615231591f, 0.605511041f, 0.595699304f, 0.585797857f, 0.575808191f, 0.565731811f, 0.555570233f,
+    0.545324988f, 0.53499762f, 0.524589683f, 0.514102744f, 0.503538384f, 0.492898192f, 0.482183772f, 0.471396737f,
+    0.460538711f, 0.44961133f, 0.438616239f, 0.427555093f, 0.41642956f, 0.405241314f, 0.39399204f, 0.382683432f,
+    0.371317194f, 0.359895037f, 0.34841868f, 0.336889853f, 0.325310292f, 0.31368174f, 0.302005949f, 0.290284677f,
+    0.278519689f, 0.266712757f, 0.25486566f, 0.24298018f, 0.231058108f, 0.21910124f, 0.207111376f, 0.195090322f,
+    0.183039888f, 0.170961889f, 0.158858143f, 0.146730474f, 0.134580709f, 0.122410675f, 0.110222207f, 0.0980171403f,
+    0.0857973123f, 0.0735645636f, 0.0613207363f, 0.0490676743f, 0.0368072229f, 0.0245412285f, 0.0122715383f, 0.0f,
+    -0.0122715383f, -0.0245412285f, -0.0368072229f, -0.0490676743f, -0.0613207363f, -0.0735645636f, -0.0857973123f, -0.0980171403f,
+    -0.110222207f, -0.122410675f, -0.134580709f, -0.146730474f, -0.158858143f, -0.170961889f, -0.183039888f, -0.195090322f,
+    -0.207111376f, -0.21910124f, -0.231058108f, -0.24298018f, -0.25486566f, -0.266712757f, -0.278519689f, -0.290284677f,
+    -0.302005949f, -0.31368174f, -0.325310292f, -0.336889853f, -0.34841868f, -0.359895037f, -0.371317194f, -0.382683432f,
+    -0.39399204f, -0.405241314f, -0.41642956f, -0.427555093f, -0.438616239f, -0.44961133f, -0.460538711f, -0.471396737f,
+    -0.482183772f, -0.492898192f, -0.503538384f, -0.514102744f, -0.524589683f, -0.53499762f, -0.545324988f, -0.555570233f,
+    -0.565731811f, -0.575808191f, -0.585797857f, -0.595699304f, -0.605511041f, -0.615231591f, -0.624859488f, -0.634393284f,
+    -0.643831543f, -0.653172843f, -0.662415778f, -0.671558955f, -0.680600998f, -0.689540545f, -0.698376249f, -0.707106781f,
+    -0.715730825f, -0.724247083f, -0.732654272f, -0.740951125f, -0.749136395f, -0.757208847f, -0.765167266f, -0.773010453f,
+    -0.780737229f, -0.788346428f, -0.795836905f, -0.803207531f, -0.810457198f, -0.817584813f, -0.824589303f, -0.831469612f,
+    -0.838224706f, -0.844853565f, -0.851355193f, -0.85772861f, -0.863972856f, -0.870086991f, -0.876070094f, -0.881921264f,
+    -0.88763962f, -0.893224301f, -0.898674466f, -0.903989293f, -0.909167983f, -0.914209756f, -0.919113852f, -0.923879533f,
+    -0.92850608f, -0.932992799f, -0.937339012f, -0.941544065f, -0.945607325f, -0.949528181f, -0.95330604f, -0.956940336f,
+    -0.960430519f, -0.963776066f, -0.966976471f, -0.970031253f, -0.972939952f, -0.97570213f, -0.978317371f, -0.98078528f,
+    -0.983105487f, -0.985277642f, -0.987301418f, -0.98917651f, -0.990902635f, -0.992479535f, -0.99390697f, -0.995184727f,
+    -0.996312612f, -0.997290457f, -0.998118113f, -0.998795456f, -0.999322385f, -0.999698819f, -0.999924702f, 1.0f,
+    0.999981175f, 0.999924702f, 0.999830582f, 0.999698819f, 0.999529418f, 0.999322385f, 0.999077728f, 0.998795456f,
+    0.998475581f, 0.998118113f, 0.997723067f, 0.997290457f, 0.996820299f, 0.996312612f, 0.995767414f, 0.995184727f,
+    0.994564571f, 0.99390697f, 0.993211949f, 0.992479535f, 0.991709754f, 0.990902635f, 0.99005821f, 0.98917651f,
+    0.988257568f, 0.987301418f, 0.986308097f, 0.985277642f, 0.984210092f, 0.983105487f, 0.981963869f, 0.98078528f,
+    0.979569766f, 0.978317371f, 0.977028143f, 0.97570213f, 0.974339383f, 0.972939952f, 0.971503891f, 0.970031253f,
+    0.968522094f, 0.966976471f, 0.965394442f, 0.963776066f, 0.962121404f, 0.960430519f, 0.958703475f, 0.956940336f,
+    0.955141168f, 0.95330604f, 0.951435021f, 0.949528181f, 0.947585591f, 0.945607325f, 0.943593458f, 0.941544065f,
+    0.939459224f, 0.937339012f, 0.93518351f, 0.932992799f, 0.930766961f, 0.92850608f, 0.926210242f, 0.923879533f,
+    0.921514039f, 0.919113852f, 0.91667906f, 0.914209756f, 0.911706032f, 0.909167983f, 0.906595705f, 0.903989293f,
+    0.901348847f, 0.898674466f, 0.89596625f, 0.893224301f, 0.890448723f, 0.88763962f, 0.884797098f, 0.881921264f,
+    0.879012226f, 0.876070094f, 0.873094978f, 0.870086991f, 0.867046246f, 0.863972856f, 0.860866939f, 0.85772861f,
+    0.854557988f, 0.851355193f, 0.848120345f, 0.844853565f, 0.841554977f, 0.838224706f, 0.834862875f, 0.831469612f,
+    0.828045045f, 0.824589303f, 0.821102515f, 0.817584813f, 0.81403633f, 0.810457198f, 0.806847554f, 0.803207531f,
+    0.799537269f, 0.795836905f, 0.792106577f, 0.788346428f, 0.784556597f, 0.780737229f, 0.776888466f, 0.773010453f,
+    0.769103338f, 0.765167266f, 0.761202385f, 0.757208847f, 0.753186799f, 0.749136395f, 0.745057785f, 0.740951125f,
+    0.736816569f, 0.732654272f, 0.72846439f, 0.724247083f, 0.720002508f, 0.715730825f, 0.711432196f, 0.707106781f,
+    0.702754744f, 0.698376249f, 0.693971461f, 0.689540545f, 0.685083668f, 0.680600998f, 0.676092704f, 0.671558955f,
+    0.666999922f, 0.662415778f, 0.657806693f, 0.653172843f, 0.648514401f, 0.643831543f, 0.639124445f, 0.634393284f,
+    0.629638239f, 0.624859488f, 0.620057212f, 0.615231591f, 0.610382806f, 0.605511041f, 0.600616479f, 0.595699304f,
+    0.590759702f, 0.585797857f, 0.580813958f, 0.575808191f, 0.570780746f, 0.565731811f, 0.560661576f, 0.555570233f,
+    0.550457973f, 0.545324988f, 0.540171473f, 0.53499762f, 0.529803625f, 0.524589683f, 0.51935599f, 0.514102744f,
+    0.508830143f, 0.503538384f, 0.498227667f, 0.492898192f, 0.48755016f, 0.482183772f, 0.47679923f, 0.471396737f,
+    0.465976496f, 0.460538711f, 0.455083587f, 0.44961133f, 0.444122145f, 0.438616239f, 0.433093819f, 0.427555093f,
+    0.422000271f, 0.41642956f, 0.410843171f, 0.405241314f, 0.3996242f, 0.39399204f, 0.388345047f, 0.382683432f,
+    0.37700741f, 0.371317194f, 0.365612998f, 0.359895037f, 0.354163525f, 0.34841868f, 0.342660717f, 0.336889853f,
+    0.331106306f, 0.325310292f, 0.319502031f, 0.31368174f, 0.30784964f, 0.302005949f, 0.296150888f, 0.290284677f,
+    0.284407537f, 0.278519689f, 0.272621355f, 0.266712757f, 0.260794118f, 0.25486566f, 0.248927606f, 0.24298018f,
+    0.237023606f, 0.231058108f, 0.225083911f, 0.21910124f, 0.21311032f, 0.207111376f, 0.201104635f, 0.195090322f,
+    0.189068664f, 0.183039888f, 0.17700422f, 0.170961889f, 0.16491312f, 0.158858143f, 0.152797185f, 0.146730474f,
+    0.140658239f, 0.134580709f, 0.128498111f, 0.122410675f, 0.116318631f, 0.110222207f, 0.104121634f, 0.0980171403f,
+    0.0919089565f, 0.0857973123f, 0.079682438f, 0.0735645636f, 0.0674439196f, 0.0613207363f, 0.0551952443f, 0.0490676743f,
+    0.0429382569f, 0.0368072229f, 0.0306748032f, 0.0245412285f, 0.0184067299f, 0.0122715383f, 0.00613588465f, 0.0f,
+    -0.00613588465f, -0.0122715383f, -0.0184067299f, -0.0245412285f, -0.0306748032f, -0.0368072229f, -0.0429382569f, -0.0490676743f,
+    -0.0551952443f, -0.0613207363f, -0.0674439196f, -0.0735645636f, -0.079682438f, -0.0857973123f, -0.0919089565f, -0.0980171403f,
+    -0.104121634f, -0.110222207f, -0.116318631f, -0.122410675f, -0.128498111f, -0.134580709f, -0.140658239f, -0.146730474f,
+    -0.152797185f, -0.158858143f, -0.16491312f, -0.170961889f, -0.17700422f, -0.183039888f, -0.189068664f, -0.195090322f,
+    -0.201104635f, -0.207111376f, -0.21311032f, -0.21910124f, -0.225083911f, -0.231058108f, -0.237023606f, -0.24298018f,
+    -0.248927606f, -0.25486566f, -0.260794118f, -0.266712757f, -0.272621355f, -0.278519689f, -0.284407537f, -0.290284677f,
+    -0.296150888f, -0.302005949f, -0.30784964f, -0.31368174f, -0.319502031f, -0.325310292f, -0.331106306f, -0.336889853f,
+    -0.342660717f, -0.34841868f, -0.354163525f, -0.359895037f, -0.365612998f, -0.371317194f, -0.37700741f, -0.382683432f,
+    -0.388345047f, -0.39399204f, -0.3996242f, -0.405241314f, -0.410843171f, -0.41642956f, -0.422000271f, -0.427555093f,
+    -0.433093819f, -0.438616239f, -0.444122145f, -0.44961133f, -0.455083587f, -0.460538711f, -0.465976496f, -0.471396737f,
+    -0.47679923f, -0.482183772f, -0.48755016f, -0.492898192f, -0.498227667f, -0.503538384f, -0.508830143f, -0.514102744f,
+    -0.51935599f, -0.524589683f, -0.529803625f, -0.53499762f, -0.540171473f, -0.545324988f, -0.550457973f, -0.555570233f,
+    -0.560661576f, -0.565731811f, -0.570780746f, -0.575808191f, -0.580813958f, -0.585797857f, -0.590759702f, -0.595699304f,
+    -0.600616479f, -0.605511041f, -0.610382806f, -0.615231591f, -0.620057212f, -0.624859488f, -0.629638239f, -0.634393284f,
+    -0.639124445f, -0.643831543f, -0.648514401f, -0.653172843f, -0.657806693f, -0.662415778f, -0.666999922f, -0.671558955f,
+    -0.676092704f, -0.680600998f, -0.685083668f, -0.689540545f, -0.693971461f, -0.698376249f, -0.702754744f, -0.707106781f,
+    -0.711432196f, -0.715730825f, -0.720002508f, -0.724247083f, -0.72846439f, -0.732654272f, -0.736816569f, -0.740951125f,
+    -0.745057785f, -0.749136395f, -0.753186799f, -0.757208847f, -0.761202385f, -0.765167266f, -0.769103338f, -0.773010453f,
+    -0.776888466f, -0.780737229f, -0.784556597f, -0.788346428f, -0.792106577f, -0.795836905f, -0.799537269f, -0.803207531f,
+    -0.806847554f, -0.810457198f, -0.81403633f, -0.817584813f, -0.821102515f, -0.824589303f, -0.828045045f, -0.831469612f,
+    -0.834862875f, -0.838224706f, -0.841554977f, -0.844853565f, -0.848120345f, -0.851355193f, -0.854557988f, -0.85772861f,
+    -0.860866939f, -0.863972856f, -0.867046246f, -0.870086991f, -0.873094978f, -0.876070094f, -0.879012226f, -0.881921264f,
+    -0.884797098f, -0.88763962f, -0.890448723f, -0.893224301f, -0.89596625f, -0.898674466f, -0.901348847f, -0.903989293f,
+    -0.906595705f, -0.909167983f, -0.911706032f, -0.914209756f, -0.91667906f, -0.919113852f, -0.921514039f, -0.923879533f,
+    -0.926210242f, -0.92850608f, -0.930766961f, -0.932992799f, -0.93518351f, -0.937339012f, -0.939459224f, -0.941544065f,
+    -0.943593458f, -0.945607325f, -0.947585591f, -0.949528181f, -0.951435021f, -0.95330604f, -0.955141168f, -0.956940336f,
+    -0.958703475f, -0.960430519f, -0.962121404f, -0.963776066f, -0.965394442f, -0.966976471f, -0.968522094f, -0.970031253f,
+    -0.971503891f, -0.972939952f, -0.974339383f, -0.97570213f, -0.977028143f, -0.978317371f, -0.979569766f, -0.98078528f,
+    -0.981963869f, -0.983105487f, -0.984210092f, -0.985277642f, -0.986308097f, -0.987301418f, -0.988257568f, -0.98917651f,
+    -0.99005821f, -0.990902635f, -0.991709754f, -0.992479535f, -0.993211949f, -0.99390697f, -0.994564571f, -0.995184727f,
+    -0.995767414f, -0.996312612f, -0.996820299f, -0.997290457f, -0.997723067f, -0.998118113f, -0.998475581f, -0.998795456f,
+    -0.999077728f, -0.999322385f, -0.999529418f, -0.999698819f, -0.999830582f, -0.999924702f, -0.999981175f, 0.0f,
+};
+
+ANC_ALIGN(64) const float dsp_fft_stage_tw_im[FFT_LENGTH / 2] = {
+    0.0f, 0.0f, -1.0f, 0.0f, -0.707106781f, -1.0f, -0.707106781f, 0.0f,
+    -0.382683432f, -0.707106781f, -0.923879533f, -1.0f, -0.923879533f, -0.707106781f, -0.382683432f, 0.0f,
+    -0.195090322f, -0.382683432f, -0.555570233f, -0.707106781f, -0.831469612f, -0.923879533f, -0.98078528f, -1.0f,
+    -0.98078528f, -0.923879533f, -0.831469612f, -0.707106781f, -0.555570233f, -0.382683432f, -0.195090322f, 0.0f,
+    -0.0980171403f, -0.195090322f, -0.290284677f, -0.382683432f, -0.471396737f, -0.555570233f, -0.634393284f, -0.707106781f,
+    -0.773010453f, -0.831469612f, -0.881921264f, -0.923879533f, -0.956940336f, -0.98078528f, -0.995184727f, -1.0f,
+    -0.995184727f, -0.98078528f, -0.956940336f, -0.923879533f, -0.881921264f, -0.831469612f, -0.773010453f, -0.707106781f,
+    -0.634393284f, -0.555570233f, -0.471396737f, -0.382683432f, -0.290284677f, -0.195090322f, -0.0980171403f, 0.0f,
+    -0.0490676743f, -0.0980171403f, -0.146730474f, -0.195090322f, -0.24298018f, -0.290284677f, -0.336889853f, -0.382683432f,
+    -0.427555093f, -0.471396737f, -0.514102744f, -0.555570233f, -0.595699304f, -0.634393284f, -0.671558955f, -0.707106781f,
+    -0.740951125f, -0.773010453f, -0.803207531f, -0.831469612f, -0.85772861f, -0.881921264f, -0.903989293f, -0.923879533f,
+    -0.941544065f, -0.956940336f, -0.970031253f, -0.98078528f, -0.98917651f, -0.995184727f, -0.998795456f, -1.0f,
+    -0.998795456f, -0.995184727f, -0.98917651f, -0.98078528f, -0.970031253f, -0.956940336f, -0.941544065f, -0.923879533f,
+    -0.903989293f, -0.881921264f, -0.85772861f, -0.831469612f, -0.803207531f, -0.773010453f, -0.740951125f, -0.707106781f,
+    -0.671558955f, -0.634393284f, -0.595699304f, -0.555570233f, -0.514102744f, -0.471396737f, -0.427555093f, -0.382683432f,
+    -0.336889853f, -0.290284677f, -0.24298018f, -0.195090322f, -0.146730474f, -0.0980171403f, -0.0490676743f, 0.0f,
+    -0.0245412285f, -0.0490676743f, -0.0735645636f, -0.0980171403f, -0.122410675f, -0.146730474f, -0.170961889f, -0.195090322f,
+    -0.21910124f, -0.24298018f, -0.266712757f, -0.290284677f, -0.31368174f, -0.336889853f, -0.359895037f, -0.382683432f,
+    -0.405241314f, -0.427555093f, -0.44961133f, -0.471396737f, -0.492898192f, -0.514102744f, -0.53499762f, -0.555570233f,
+    -0.575808191f, -0.595699304f, -0.615231591f, -0.634393284f, -0.653172843f, -0.671558955f, -0.689540545f, -0.707106781f,
+    -0.724247083f, -0.740951125f, -0.757208847f, -0.773010453f, -0.788346428f, -0.803207531f, -0.817584813f, -0.831469612f,
+    -0.844853565f, -0.85772861f, -0.870086991f, -0.881921264f, -0.893224301f, -0.903989293f, -0.914209756f, -0.923879533f,
+    -0.932992799f, -0.941544065f, -0.949528181f, -0.956940336f, -0.963776066f, -0.970031253f, -0.97570213f, -0.98078528f,
+    -0.985277642f, -0.98917651f, -0.992479535f, -0.995184727f, -0.997290457f, -0.998795456f, -0.999698819f, -1.0f,
+    -0.999698819f, -0.998795456f, -0.997290457f, -0.995184727f, -0.992479535f, -0.98917651f, -0.985277642f, -0.98078528f,
+    -0.97570213f, -0.970031253f, -0.963776066f, -0.956940336f, -0.949528181f, -0.941544065f, -0.932992799f, -0.923879533f,
+    -0.914209756f, -0.903989293f, -0.893224301f, -0.881921264f, -0.870086991f, -0.85772861f, -0.844853565f, -0.831469612f,
+    -0.817584813f, -0.803207531f, -0.788346428f, -0.773010453f, -0.757208847f, -0.740951125f, -0.724247083f, -0.707106781f,
+    -0.689540545f, -0.671558955f, -0.653172843f, -0.634393284f, -0.615231591f, -0.595699304f, -0.575808191f, -0.555570233f,
+    -0.53499762f, -0.514102744f, -0.492898192f, -0.471396737f, -0.44961133f, -0.427555093f, -0.405241314f, -0.382683432f,
+    -0.359895037f, -0.336889853f, -0.31368174f, -0.290284677f, -0.266712757f, -0.24298018f, -0.21910124f, -0.195090322f,
+    -0.170961889f, -0.146730474f, -0.122410675f, -0.0980171403f, -0.0735645636f, -0.0490676743f, -0.0245412285f, 0.0f,
+    -0.0122715383f, -0.0245412285f, -0.0368072229f, -0.0490676743f, -0.0613207363f, -0.0735645636f, -0.0857973123f, -0.0980171403f,
+    -0.110222207f, -0.122410675f, -0.134580709f, -0.146730474f, -0.158858143f, -0.170961889f, -0.183039888f, -0.195090322f,
+    -0.207111376f, -0.21910124f, -0.231058108f, -0.24298018f, -0.25486566f, -0.266712757f, -0.278519689f, -0.290284677f,
+    -0.302005949f, -0.31368174f, -0.325310292f, -0.336889853f, -0.34841868f, -0.359895037f, -0.371317194f, -0.382683432f,
+    -0.39399204f, -0.405241314f, -0.41642956f, -0.427555093f, -0.438616239f, -0.44961133f, -0.460538711f, -0.471396737f,
+    -0.482183772f, -0.492898192f, -0.503538384f, -0.514102744f, -0.524589683f, -0.53499762f, -0.545324988f, -0.555570233f,
+    -0.565731811f, -0.575808191f, -0.585797857f, -0.595699304f, -0.605511041f, -0.615231591f, -0.624859488f, -0.634393284f,
+    -0.643831543f, -0.653172843f, -0.662415778f, -0.671558955f, -0.680600998f, -0.689540545f, -0.698376249f, -0.707106781f,
+    -0.715730825f, -0.724247083f, -0.732654272f, -0.740951125f, -0.749136395f, -0.757208847f, -0.765167266f, -0.773010453f,
+    -0.780737229f, -0.788346428f, -0.795836905f, -0.803207531f, -0.810457198f, -0.817584813f, -0.824589303f, -0.831469612f,
+    -0.838224706f, -0.844853565f, -0.851355193f, -0.85772861f, -0.863972856f, -0.870086991f, -0.876070094f, -0.881921264f,
+    -0.88763962f, -0.893224301f, -0.898674466f, -0.903989293f, -0.909167983f, -0.914209756f, -0.919113852f, -0.923879533f,
+    -0.92850608f, -0.932992799f, -0.937339012f, -0.941544065f, -0.945607325f, -0.949528181f, -0.95330604f, -0.956940336f,
+    -0.960430519f, -0.963776066f, -0.966976471f, -0.970031253f, -0.972939952f, -0.97570213f, -0.978317371f, -0.98078528f,
+    -0.983105487f, -0.985277642f, -0.987301418f, -0.98917651f, -0.990902635f, -0.992479535f, -0.99390697f, -0.995184727f,
+    -0.996312612f, -0.997290457f, -0.998118113f, -0.998795456f, -0.999322385f, -0.999698819f, -0.999924702f, -1.0f,
+    -0.999924702f, -0.999698819f, -0.999322385f, -0.998795456f, -0.998118113f, -0.997290457f, -0.996312612f, -0.995184727f,
+    -0.99390697f, -0.992479535f, -0.990902635f, -0.98917651f, -0.987301418f, -0.985277642f, -0.983105487f, -0.98078528f,
+    -0.978317371f, -0.97570213f, -0.972939952f, -0.970031253f, -0.966976471f, -0.963776066f, -0.960430519f, -0.956940336f,
+    -0.95330604f, -0.949528181f, -0.945607325f, -0.941544065f, -0.937339012f, -0.932992799f, -0.92850608f, -0.923879533f,
+    -0.919113852f, -0.914209756f, -0.909167983f, -0.903989293f, -0.898674466f, -0.893224301f, -0.88763962f, -0.881921264f,
+    -0.876070094f, -0.870086991f, -0.863972856f, -0.85772861f, -0.851355193f, -0.844853565f, -0.838224706f, -0.831469612f,
+    -0.824589303f, -0.817584813f, -0.810457198f, -0.803207531f, -0.795836905f, -0.788346428f, -0.780737229f, -0.773010453f,
+    -0.765167266f, -0.757208847f, -0.749136395f, -0.740951125f, -0.732654272f, -0.724247083f, -0.715730825f, -0.707106781f,
+    -0.698376249f, -0.689540545f, -0.680600998f, -0.671558955f, -0.662415778f, -0.653172843f, -0.643831543f, -0.634393284f,
+    -0.624859488f, -0.615231591f, -0.605511041f, -0.595699304f, -0.585797857f, -0.575808191f, -0.565731811f, -0.555570233f,
+    -0.545324988f, -0.53499762f, -0.524589683f, -0.514102744f, -0.503538384f, -0.492898192f, -0.482183772f, -0.471396737f,
+    -0.460538711f, -0.44961133f, -0.438616239f, -0.427555093f, -0.41642956f, -0.405241314f, -0.39399204f, -0.382683432f,
+    -0.371317194f, -0.359895037f, -0.34841868f, -0.336889853f, -0.325310292f, -0.31368174f, -0.302005949f, -0.290284677f,
+    -0.278519689f, -0.266712757f, -0.25486566f, -0.24298018f, -0.231058108f, -0.21910124f, -0.207111376f, -0.195090322f,
+    -0.183039888f, -0.170961889f, -0.158858143f, -0.146730474f, -0.134580709f, -0.122410675f, -0.110222207f, -0.0980171403f,
+    -0.0857973123f, -0.0735645636f, -0.0613207363f, -0.0490676743f, -0.0368072229f, -0.0245412285f, -0.0122715383f, 0.0f,
+    -0.00613588465f, -0.0122715383f, -0.0184067299f, -0.0245412285f, -0.0306748032f, -0.0368072229f, -0.0429382569f, -0.0490676743f,
+    -0.0551952443f, -0.0613207363f, -0.0674439196f, -0.0735645636f, -0.079682438f, -0.0857973123f, -0.0919089565f, -0.0980171403f,
+    -0.104121634f, -0.110222207f, -0.116318631f, -0.122410675f, -0.128498111f, -0.134580709f, -0.140658239f, -0.146730474f,
+    -0.152797185f, -0.158858143f, -0.16491312f, -0.170961889f, -0.17700422f, -0.183039888f, -0.189068664f, -0.195090322f,
+    -0.201104635f, -0.207111376f, -0.21311032f, -0.21910124f, -0.225083911f, -0.231058108f, -0.237023606f, -0.24298018f,
+    -0.248927606f, -0.25486566f, -0.260794118f, -0.266712757f, -0.272621355f, -0.278519689f, -0.284407537f, -0.290284677f,
+    -0.296150888f, -0.302005949f, -0.30784964f, -0.31368174f, -0.319502031f, -0.325310292f, -0.331106306f, -0.336889853f,
+    -0.342660717f, -0.34841868f, -0.354163525f, -0.359895037f, -0.365612998f, -0.371317194f, -0.37700741f, -0.382683432f,
+    -0.388345047f, -0.39399204f, -0.3996242f, -0.405241314f, -0.410843171f, -0.41642956f, -0.422000271f, -0.427555093f,
+    -0.433093819f, -0.438616239f, -0.444122145f, -0.44961133f, -0.455083587f, -0.460538711f, -0.465976496f, -0.471396737f,
+    -0.47679923f, -0.482183772f, -0.48755016f, -0.492898192f, -0.498227667f, -0.503538384f, -0.508830143f, -0.514102744f,
+    -0.51935599f, -0.524589683f, -0.529803625f, -0.53499762f, -0.540171473f, -0.545324988f, -0.550457973f, -0.555570233f,
+    -0.560661576f, -0.565731811f, -0.570780746f, -0.575808191f, -0.580813958f, -0.585797857f, -0.590759702f, -0.595699304f,
+    -0.600616479f, -0.605511041f, -0.610382806f, -0.615231591f, -0.620057212f, -0.624859488f, -0.629638239f, -0.634393284f,
+    -0.639124445f, -0.643831543f, -0.648514401f, -0.653172843f, -0.657806693f, -0.662415778f, -0.666999922f, -0.671558955f,
+    -0.676092704f, -0.680600998f, -0.685083668f, -0.689540545f, -0.693971461f, -0.698376249f, -0.702754744f, -0.707106781f,
+    -0.711432196f, -0.715730825f, -0.720002508f, -0.724247083f, -0.72846439f, -0.732654272f, -0.736816569f, -0.740951125f,
+    -0.745057785f, -0.749136395f, -0.753186799f, -0.757208847f, -0.761202385f, -0.765167266f, -0.769103338f, -0.773010453f,
+    -0.776888466f, -0.780737229f, -0.784556597f, -0.788346428f, -0.792106577f, -0.795836905f, -0.799537269f, -0.803207531f,
+    -0.806847554f, -0.810457198f, -0.81403633f, -0.817584813f, -0.821102515f, -0.824589303f, -0.828045045f, -0.831469612f,
+    -0.834862875f, -0.838224706f, -0.841554977f, -0.844853565f, -0.848120345f, -0.851355193f, -0.854557988f, -0.85772861f,
+    -0.860866939f, -0.863972856f, -0.867046246f, -0.870086991f, -0.873094978f, -0.876070094f, -0.879012226f, -0.881921264f,
+    -0.884797098f, -0.88763962f, -0.890448723f, -0.893224301f, -0.89596625f, -0.898674466f, -0.901348847f, -0.903989293f,
+    -0.906595705f, -0.909167983f, -0.911706032f, -0.914209756f, -0.91667906f, -0.919113852f, -0.921514039f, -0.923879533f,
+    -0.926210242f, -0.92850608f, -0.930766961f, -0.932992799f, -0.93518351f, -0.937339012f, -0.939459224f, -0.941544065f,
+    -0.943593458f, -0.945607325f, -0.947585591f, -0.949528181f, -0.951435021f, -0.95330604f, -0.955141168f, -0.956940336f,
+    -0.958703475f, -0.960430519f, -0.962121404f, -0.963776066f, -0.965394442f, -0.966976471f, -0.968522094f, -0.970031253f,
+    -0.971503891f, -0.972939952f, -0.974339383f, -0.97570213f, -0.977028143f, -0.978317371f, -0.979569766f, -0.98078528f,
+    -0.981963869f, -0.983105487f, -0.984210092f, -0.985277642f, -0.986308097f, -0.987301418f, -0.988257568f, -0.98917651f,
+    -0.99005821f, -0.990902635f, -0.991709754f, -0.992479535f, -0.993211949f, -0.99390697f, -0.994564571f, -0.995184727f,
+    -0.995767414f, -0.996312612f, -0.996820299f, -0.997290457f, -0.997723067f, -0.998118113f, -0.998475581f, -0.998795456f,
+    -0.999077728f, -0.999322385f, -0.999529418f, -0.999698819f, -0.999830582f, -0.999924702f, -0.999981175f, -1.0f,
+    -0.999981175f, -0.999924702f, -0.999830582f, -0.999698819f, -0.999529418f, -0.999322385f, -0.999077728f, -0.998795456f,
+    -0.998475581f, -0.998118113f, -0.997723067f, -0.997290457f, -0.996820299f, -0.996312612f, -0.995767414f, -0.995184727f,
+    -0.994564571f, -0.99390697f, -0.993211949f, -0.992479535f, -0.991709754f, -0.990902635f, -0.99005821f, -0.98917651f,
+    -0.988257568f, -0.987301418f, -0.986308097f, -0.985277642f, -0.984210092f, -0.983105487f, -0.981963869f, -0.98078528f,
+    -0.979569766f, -0.978317371f, -0.977028143f, -0.97570213f, -0.974339383f, -0.972939952f, -0.971503891f, -0.970031253f,
+    -0.968522094f, -0.966976471f, -0.965394442f, -0.963776066f, -0.962121404f, -0.960430519f, -0.958703475f, -0.956940336f,
+    -0.955141168f, -0.95330604f, -0.951435021f, -0.949528181f, -0.947585591f, -0.945607325f, -0.943593458f, -0.941544065f,
+    -0.939459224f, -0.937339012f, -0.93518351f, -0.932992799f, -0.930766961f, -0.92850608f, -0.926210242f, -0.923879533f,
+    -0.921514039f, -0.919113852f, -0.91667906f, -0.914209756f, -0.911706032f, -0.909167983f, -0.906595705f, -0.903989293f,
+    -0.901348847f, -0.898674466f, -0.89596625f, -0.893224301f, -0.890448723f, -0.88763962f, -0.884797098f, -0.881921264f,
+    -0.879012226f, -0.876070094f, -0.873094978f, -0.870086991f, -0.867046246f, -0.863972856f, -0.860866939f, -0.85772861f,
+    -0.854557988f, -0.851355193f, -0.848120345f, -0.844853565f, -0.841554977f, -0.838224706f, -0.834862875f, -0.831469612f,
+    -0.828045045f, -0.824589303f, -0.821102515f, -0.817584813f, -0.81403633f, -0.810457198f, -0.806847554f, -0.803207531f,
+    -0.799537269f, -0.795836905f, -0.792106577f, -0.788346428f, -0.784556597f, -0.780737229f, -0.776888466f, -0.773010453f,
+    -0.769103338f, -0.765167266f, -0.761202385f, -0.757208847f, -0.753186799f, -0.749136395f, -0.745057785f, -0.740951125f,
+    -0.736816569f, -0.732654272f, -0.72846439f, -0.724247083f, -0.720002508f, -0.715730825f, -0.711432196f, -0.707106781f,
+    -0.702754744f, -0.698376249f, -0.693971461f, -0.689540545f, -0.685083668f, -0.680600998f, -0.676092704f, -0.671558955f,
+    -0.666999922f, -0.662415778f, -0.657806693f, -0.653172843f, -0.648514401f, -0.643831543f, -0.639124445f, -0.634393284f,
+    -0.629638239f, -0.624859488f, -0.620057212f, -0.615231591f, -0.610382806f, -0.605511041f, -0.600616479f, -0.595699304f,
+    -0.590759702f, -0.585797857f, -0.580813958f, -0.575808191f, -0.570780746f, -0.565731811f, -0.560661576f, -0.555570233f,
+    -0.550457973f, -0.545324988f, -0.540171473f, -0.53499762f, -0.529803625f, -0.524589683f, -0.51935599f, -0.514102744f,
+    -0.508830143f, -0.503538384f, -0.498227667f, -0.492898192f, -0.48755016f, -0.482183772f, -0.47679923f, -0.471396737f,
+    -0.465976496f, -0.460538711f, -0.455083587f, -0.44961133f, -0.444122145f, -0.438616239f, -0.433093819f, -0.427555093f,
+    -0.422000271f, -0.41642956f, -0.410843171f, -0.405241314f, -0.3996242f, -0.39399204f, -0.388345047f, -0.382683432f,
+    -0.37700741f, -0.371317194f, -0.365612998f, -0.359895037f, -0.354163525f, -0.34841868f, -0.342660717f, -0.336889853f,
+    -0.331106306f, -0.325310292f, -0.319502031f, -0.31368174f, -0.30784964f, -0.302005949f, -0.296150888f, -0.290284677f,
+    -0.284407537f, -0.278519689f, -0.272621355f, -0.266712757f, -0.260794118f, -0.25486566f, -0.248927606f, -0.24298018f,
+    -0.237023606f, -0.231058108f, -0.225083911f, -0.21910124f, -0.21311032f, -0.207111376f, -0.201104635f, -0.195090322f,
+    -0.189068664f, -0.183039888f, -0.17700422f, -0.170961889f, -0.16491312f, -0.158858143f, -0.152797185f, -0.146730474f,
+    -0.140658239f, -0.134580709f, -0.128498111f, -0.122410675f, -0.116318631f, -0.110222207f, -0.104121634f, -0.0980171403f,
+    -0.0919089565f, -0.0857973123f, -0.079682438f, -0.0735645636f, -0.0674439196f, -0.0613207363f, -0.0551952443f, -0.0490676743f,
+    -0.0429382569f, -0.0368072229f, -0.0306748032f, -0.0245412285f, -0.0184067299f, -0.0122715383f, -0.00613588465f, 0.0f,
+};
+
+// 各频点频率 (Hz)，补零区为0
+ANC_ALIGN(64) const float dsp_bin_freq[SPECTRUM_LENGTH] = {
+    0.0f, 15.625f, 31.25f, 46.875f, 62.5f, 78.125f, 93.75f, 109.375f,
+    125.0f, 140.625f, 156.25f, 171.875f, 187.5f, 203.125f, 218.75f, 234.375f,
+    250.0f, 265.625f, 281.25f, 296.875f, 312.5f, 328.125f, 343.75f, 359.375f,
+    375.0f, 390.625f, 406.25f, 421.875f, 437.5f, 453.125f, 468.75f, 484.375f,
+    500.0f, 515.625f, 531.25f, 546.875f, 562.5f, 578.125f, 593.75f, 609.375f,
+    625.0f, 640.625f, 656.25f, 671.875f, 687.5f, 703.125f, 718.75f, 734.375f,
+    750.0f, 765.625f, 781.25f, 796.875f, 812.5f, 828.125f, 843.75f, 859.375f,
+    875.0f, 890.625f, 906.25f, 921.875f, 937.5f, 953.125f, 968.75f, 984.375f,
+    1000.0f, 1015.625f, 1031.25f, 1046.875f, 1062.5f, 1078.125f, 1093.75f, 1109.375f,
+    1125.0f, 1140.625f, 1156.25f, 1171.875f, 1187.5f, 1203.125f, 1218.75f, 1234.375f,
+    1250.0f, 1265.625f, 1281.25f, 1296.875f, 1312.5f, 1328.125f, 1343.75f, 1359.375f,
+    1375.0f, 1390.625f, 1406.25f, 1421.875f, 1437.5f, 1453.125f, 1468.75f, 1484.375f,
+    1500.0f, 1515.625f, 1531.25f, 1546.875f, 1562.5f, 1578.125f, 1593.75f, 1609.375f,
+    1625.0f, 1640.625f, 1656.25f, 1671.875f, 1687.5f, 1703.125f, 1718.75f, 1734.375f,
+    1750.0f, 1765.625f, 1781.25f, 1796.875f, 1812.5f, 1828.125f, 1843.75f, 1859.375f,
+    1875.0f, 1890.625f, 1906.25f, 1921.875f, 1937.5f, 1953.125f, 1968.75f, 1984.375f,
+    2000.0f, 2015.625f, 2031.25f, 2046.875f, 2062.5f, 2078.125f, 2093.75f, 2109.375f,
+    2125.0f, 2140.625f, 2156.25f, 2171.875f, 2187.5f, 2203.125f, 2218.75f, 2234.375f,
+    2250.0f, 2265.625f, 2281.25f, 2296.875f, 2312.5f, 2328.125f, 2343.75f, 2359.375f,
+    2375.0f, 2390.625f, 2406.25f, 2421.875f, 2437.5f, 2453.125f, 2468.75f, 2484.375f,
+    2500.0f, 2515.625f, 2531.25f, 2546.875f, 2562.5f, 2578.125f, 2593.75f, 2609.375f,
+    2625.0f, 2640.625f, 2656.25f, 2671.875f, 2687.5f, 2703.125f, 2718.75f, 2734.375f,
+    2750.0f, 2765.625f, 2781.25f, 2796.875f, 2812.5f, 2828.125f, 2843.75f, 2859.375f,
+    2875.0f, 2890.625f, 2906.25f, 2921.875f, 2937.5f, 2953.125f, 2968.75f, 2984.375f,
+    3000.0f, 3015.625f, 3031.25f, 3046.875f, 3062.5f, 3078.125f, 3093.75f, 3109.375f,
+    3125.0f, 3140.625f, 3156.25f, 3171.875f, 3187.5f, 3203.125f, 3218.75f, 3234.375f,
+    3250.0f, 3265.625f, 3281.25f, 3296.875f, 3312.5f, 3328.125f, 3343.75f, 3359.375f,
+    3375.0f, 3390.625f, 3406.25f, 3421.875f, 3437.5f, 3453.125f, 3468.75f, 3484.375f,
+    3500.0f, 3515.625f, 3531.25f, 3546.875f, 3562.5f, 3578.125f, 3593.75f, 3609.375f,
+    3625.0f, 3640.625f, 3656.25f, 3671.875f, 3687.5f, 3703.125f, 3718.75f, 3734.375f,
+    3750.0f, 3765.625f, 3781.25f, 3796.875f, 3812.5f, 3828.125f, 3843.75f, 3859.375f,
+    3875.0f, 3890.625f, 3906.25f, 3921.875f, 3937.5f, 3953.125f, 3968.75f, 3984.375f,
+    4000.0f, 4015.625f, 4031.25f, 4046.875f, 4062.5f, 4078.125f, 4093.75f, 4109.375f,
+    4125.0f, 4140.625f, 4156.25f, 4171.875f, 4187.5f, 4203.125f, 4218.75f, 4234.375f,
+    4250.0f, 4265.625f, 4281.25f, 4296.875f, 4312.5f, 4328.125f, 4343.75f, 4359.375f,
+    4375.0f, 4390.625f, 4406.25f, 4421.875f, 4437.5f, 4453.125f, 4468.75f, 4484.375f,
+    4500.0f, 4515.625f, 4531.25f, 4546.875f, 4562.5f, 4578.125f, 4593.75f, 4609.375f,
+    4625.0f, 4640.625f, 4656.25f, 4671.875f, 4687.5f, 4703.125f, 4718.75f, 4734.375f,
+    4750.0f, 4765.625f, 4781.25f, 4796.875f, 4812.5f, 4828.125f, 4843.75f, 4859.375f,
+    4875.0f, 4890.625f, 4906.25f, 4921.875f, 4937.5f, 4953.125f, 4968.75f, 4984.375f,
+    5000.0f, 5015.625f, 5031.25f, 5046.875f, 5062.5f, 5078.125f, 5093.75f, 5109.375f,
+    5125.0f, 5140.625f, 5156.25f, 5171.875f, 5187.5f, 5203.125f, 5218.75f, 5234.375f,
+    5250.0f, 5265.625f, 5281.25f, 5296.875f, 5312.5f, 5328.125f, 5343.75f, 5359.375f,
+    5375.0f, 5390.625f, 5406.25f, 5421.875f, 5437.5f, 5453.125f, 5468.75f, 5484.375f,
+    5500.0f, 5515.625f, 5531.25f, 5546.875f, 5562.5f, 5578.125f, 5593.75f, 5609.375f,
+    5625.0f, 5640.625f, 5656.25f, 5671.875f, 5687.5f, 5703.125f, 5718.75f, 5734.375f,
+    5750.0f, 5765.625f, 5781.25f, 5796.875f, 5812.5f, 5828.125f, 5843.75f, 5859.375f,
+    5875.0f, 5890.625f, 5906.25f, 5921.875f, 5937.5f, 5953.125f, 5968.75f, 5984.375f,
+    6000.0f, 6015.625f, 6031.25f, 6046.875f, 6062.5f, 6078.125f, 6093.75f, 6109.375f,
+    6125.0f, 6140.625f, 6156.25f, 6171.875f, 6187.5f, 6203.125f, 6218.75f, 6234.375f,
+    6250.0f, 6265.625f, 6281.25f, 6296.875f, 6312.5f, 6328.125f, 6343.75f, 6359.375f,
+    6375.0f, 6390.625f, 6406.25f, 6421.875f, 6437.5f, 6453.125f, 6468.75f, 6484.375f,
+    6500.0f, 6515.625f, 6531.25f, 6546.875f, 6562.5f, 6578.125f, 6593.75f, 6609.375f,
+    6625.0f, 6640.625f, 6656.25f, 6671.875f, 6687.5f, 6703.125f, 6718.75f, 6734.375f,
+    6750.0f, 6765.625f, 6781.25f, 6796.875f, 6812.5f, 6828.125f, 6843.75f, 6859.375f,
+    6875.0f, 6890.625f, 6906.25f, 6921.875f, 6937.5f, 6953.125f, 6968.75f, 6984.375f,
+    7000.0f, 7015.625f, 7031.25f, 7046.875f, 7062.5f, 7078.125f, 7093.75f, 7109.375f,
+    7125.0f, 7140.625f, 7156.25f, 7171.875f, 7187.5f, 7203.125f, 7218.75f, 7234.375f,
+    7250.0f, 7265.625f, 7281.25f, 7296.875f, 7312.5f, 7328.125f, 7343.75f, 7359.375f,
+    7375.0f, 7390.625f, 7406.25f, 7421.875f, 7437.5f, 7453.125f, 7468.75f, 7484.375f,
+    7500.0f, 7515.625f, 7531.25f, 7546.875f, 7562.5f, 7578.125f, 7593.75f, 7609.375f,
+    7625.0f, 7640.625f, 7656.25f, 7671.875f, 7687.5f, 7703.125f, 7718.75f, 7734.375f,
+    7750.0f, 7765.625f, 7781.25f, 7796.875f, 7812.5f, 7828.125f, 7843.75f, 7859.375f,
+    7875.0f, 7890.625f, 7906.25f, 7921.875f, 7937.5f, 7953.125f, 7968.75f, 7984.375f,
+    8000.0f, 8015.625f, 8031.25f, 8046.875f, 8062.5f, 8078.125f, 8093.75f, 8109.375f,
+    8125.0f, 8140.625f, 8156.25f, 8171.875f, 8187.5f, 8203.125f, 8218.75f, 8234.375f,
+    8250.0f, 8265.625f, 8281.25f, 8296.875f, 8312.5f, 8328.125f, 8343.75f, 8359.375f,
+    8375.0f, 8390.625f, 8406.25f, 8421.875f, 8437.5f, 8453.125f, 8468.75f, 8484.375f,
+    8500.0f, 8515.625f, 8531.25f, 8546.875f, 8562.5f, 8578.125f, 8593.75f, 8609.375f,
+    8625.0f, 8640.625f, 8656.25f, 8671.875f, 8687.5f, 8703.125f, 8718.75f, 8734.375f,
+    8750.0f, 8765.625f, 8781.25f, 8796.875f, 8812.5f, 8828.125f, 8843.75f, 8859.375f,
+    8875.0f, 8890.625f, 8906.25f, 8921.875f, 8937.5f, 8953.125f, 8968.75f, 8984.375f,
+    9000.0f, 9015.625f, 9031.25f, 9046.875f, 9062.5f, 9078.125f, 9093.75f, 9109.375f,
+    9125.0f, 9140.625f, 9156.25f, 9171.875f, 9187.5f, 9203.125f, 9218.75f, 9234.375f,
+    9250.0f, 9265.625f, 9281.25f, 9296.875f, 9312.5f, 9328.125f, 9343.75f, 9359.375f,
+    9375.0f, 9390.625f, 9406.25f, 9421.875f, 9437.5f, 9453.125f, 9468.75f, 9484.375f,
+    9500.0f, 9515.625f, 9531.25f, 9546.875f, 9562.5f, 9578.125f, 9593.75f, 9609.375f,
+    9625.0f, 9640.625f, 9656.25f, 9671.875f, 9687.5f, 9703.125f, 9718.75f, 9734.375f,
+    9750.0f, 9765.625f, 9781.25f, 9796.875f, 9812.5f, 9828.125f, 9843.75f, 9859.375f,
+    9875.0f, 9890.625f, 9906.25f, 9921.875f, 9937.5f, 9953.125f, 9968.75f, 9984.375f,
+    10000.0f, 10015.625f, 10031.25f, 10046.875f, 10062.5f, 10078.125f, 10093.75f, 10109.375f,
+    10125.0f, 10140.625f, 10156.25f, 10171.875f, 10187.5f, 10203.125f, 10218.75f, 10234.375f,
+    10250.0f, 10265.625f, 10281.25f, 10296.875f, 10312.5f, 10328.125f, 10343.75f, 10359.375f,
+    10375.0f, 10390.625f, 10406.25f, 10421.875f, 10437.5f, 10453.125f, 10468.75f, 10484.375f,
+    10500.0f, 10515.625f, 10531.25f, 10546.875f, 10562.5f, 10578.125f, 10593.75f, 10609.375f,
+    10625.0f, 10640.625f, 10656.25f, 10671.875f, 10687.5f, 10703.125f, 10718.75f, 10734.375f,
+    10750.0f, 10765.625f, 10781.25f, 10796.875f, 10812.5f, 10828.125f, 10843.75f, 10859.375f,
+    10875.0f, 10890.625f, 10906.25f, 10921.875f, 10937.5f, 10953.125f, 10968.75f, 10984.375f,
+    11000.0f, 11015.625f, 11031.25f, 11046.875f, 11062.5f, 11078.125f, 11093.75f, 11109.375f,
+    11125.0f, 11140.625f, 11156.25f, 11171.875f, 11187.5f, 11203.125f, 11218.75f, 11234.375f,
+    11250.0f, 11265.625f, 11281.25f, 11296.875f, 11312.5f, 11328.125f, 11343.75f, 11359.375f,
+    11375.0f, 11390.625f, 11406.25f, 11421.875f, 11437.5f, 11453.125f, 11468.75f, 11484.375f,
+    11500.0f, 11515.625f, 11531.25f, 11546.875f, 11562.5f, 11578.125f, 11593.75f, 11609.375f,
+    11625.0f, 11640.625f, 11656.25f, 11671.875f, 11687.5f, 11703.125f, 11718.75f, 11734.375f,
+    11750.0f, 11765.625f, 11781.25f, 11796.875f, 11812.5f, 11828.125f, 11843.75f, 11859.375f,
+    11875.0f, 11890.625f, 11906.25f, 11921.875f, 11937.5f, 11953.125f, 11968.75f, 11984.375f,
+    12000.0f, 12015.625f, 12031.25f, 12046.875f, 12062.5f, 12078.125f, 12093.75f, 12109.375f,
+    12125.0f, 12140.625f, 12156.25f, 12171.875f, 12187.5f, 12203.125f, 12218.75f, 12234.375f,
+    12250.0f, 12265.625f, 12281.25f, 12296.875f, 12312.5f, 12328.125f, 12343.75f, 12359.375f,
+    12375.0f, 12390.625f, 12406.25f, 12421.875f, 12437.5f, 12453.125f, 12468.75f, 12484.375f,
+    12500.0f, 12515.625f, 12531.25f, 12546.875f, 12562.5f, 12578.125f, 12593.75f, 12609.375f,
+    12625.0f, 12640.625f, 12656.25f, 12671.875f, 12687.5f, 12703.125f, 12718.75f, 12734.375f,
+    12750.0f, 12765.625f, 12781.25f, 12796.875f, 12812.5f, 12828.125f, 12843.75f, 12859.375f,
+    12875.0f, 12890.625f, 12906.25f, 12921.875f, 12937.5f, 12953.125f, 12968.75f, 12984.375f,
+    13000.0f, 13015.625f, 13031.25f, 13046.875f, 13062.5f, 13078.125f, 13093.75f, 13109.375f,
+    13125.0f, 13140.625f, 13156.25f, 13171.875f, 13187.5f, 13203.125f, 13218.75f, 13234.375f,
+    13250.0f, 13265.625f, 13281.25f, 13296.875f, 13312.5f, 13328.125f, 13343.75f, 13359.375f,
+    13375.0f, 13390.625f, 13406.25f, 13421.875f, 13437.5f, 13453.125f, 13468.75f, 13484.375f,
+    13500.0f, 13515.625f, 13531.25f, 13546.875f, 13562.5f, 13578.125f, 13593.75f, 13609.375f,
+    13625.0f, 13640.625f, 13656.25f, 13671.875f, 13687.5f, 13703.125f, 13718.75f, 13734.375f,
+    13750.0f, 13765.625f, 13781.25f, 13796.875f, 13812.5f, 13828.125f, 13843.75f, 13859.375f,
+    13875.0f, 13890.625f, 13906.25f, 13921.875f, 13937.5f, 13953.125f, 13968.75f, 13984.375f,
+    14000.0f, 14015.625f, 14031.25f, 14046.875f, 14062.5f, 14078.125f, 14093.75f, 14109.375f,
+    14125.0f, 14140.625f, 14156.25f, 14171.875f, 14187.5f, 14203.125f, 14218.75f, 14234.375f,
+    14250.0f, 14265.625f, 14281.25f, 14296.875f, 14312.5f, 14328.125f, 14343.75f, 14359.375f,
+    14375.0f, 14390.625f, 14406.25f, 14421.875f, 14437.5f, 14453.125f, 14468.75f, 14484.375f,
+    14500.0f, 14515.625f, 14531.25f, 14546.875f, 14562.5f, 14578.125f, 14593.75f, 14609.375f,
+    14625.0f, 14640.625f, 14656.25f, 14671.875f, 14687.5f, 14703.125f, 14718.75f, 14734.375f,
+    14750.0f, 14765.625f, 14781.25f, 14796.875f, 14812.5f, 14828.125f, 14843.75f, 14859.375f,
+    14875.0f, 14890.625f, 14906.25f, 14921.875f, 14937.5f, 14953.125f, 14968.75f, 14984.375f,
+    15000.0f, 15015.625f, 15031.25f, 15046.875f, 15062.5f, 15078.125f, 15093.75f, 15109.375f,
+    15125.0f, 15140.625f, 15156.25f, 15171.875f, 15187.5f, 15203.125f, 15218.75f, 15234.375f,
+    15250.0f, 15265.625f, 15281.25f, 15296.875f, 15312.5f, 15328.125f, 15343.75f, 15359.375f,
+    15375.0f, 15390.625f, 15406.25f, 15421.875f, 15437.5f, 15453.125f, 15468.75f, 15484.375f,
+    15500.0f, 15515.625f, 15531.25f, 15546.875f, 15562.5f, 15578.125f, 15593.75f, 15609.375f,
+    15625.0f, 15640.625f, 15656.25f, 15671.875f, 15687.5f, 15703.125f, 15718.75f, 15734.375f,
+    15750.0f, 15765.625f, 15781.25f, 15796.875f, 15812.5f, 15828.125f, 15843.75f, 15859.375f,
+    15875.0f, 15890.625f, 15906.25f, 15921.875f, 15937.5f, 15953.125f, 15968.75f, 15984.375f,
+    16000.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+};
+
+// e^(-j2πk/N)，补零区为0
+ANC_ALIGN(64) const float dsp_bin_twiddle_re[SPECTRUM_LENGTH] = {
+    1.0f, 0.999995294f, 0.999981175f, 0.999957645f, 0.999924702f, 0.999882347f, 0.999830582f, 0.999769405f,
+    0.999698819f, 0.999618822f, 0.999529418f, 0.999430605f, 0.999322385f, 0.999204759f, 0.999077728f, 0.998941293f,
+    0.998795456f, 0.998640218f, 0.998475581f, 0.998301545f, 0.998118113f, 0.997925286f, 0.997723067f, 0.997511456f,
+    0.997290457f, 0.99706007f, 0.996820299f, 0.996571146f, 0.996312612f, 0.996044701f, 0.995767414f, 0.995480755f,
+    0.995184727f, 0.994879331f, 0.994564571f, 0.994240449f, 0.99390697f, 0.993564136f, 0.993211949f, 0.992850414f,
+    0.992479535f, 0.992099313f, 0.991709754f, 0.99131086f, 0.990902635f, 0.990485084f, 0.99005821f, 0.989622017f,
+    0.98917651f, 0.988721692f, 0.988257568f, 0.987784142f, 0.987301418f, 0.986809402f, 0.986308097f, 0.985797509f,
+    0.985277642f, 0.984748502f, 0.984210092f, 0.983662419f, 0.983105487f, 0.982539302f, 0.981963869f, 0.981379193f,
+    0.98078528f, 0.980182136f, 0.979569766f, 0.978948175f, 0.978317371f, 0.977677358f, 0.977028143f, 0.976369731f,
+    0.97570213f, 0.975025345f, 0.974339383f, 0.97364425f, 0.972939952f, 0.972226497f, 0.971503891f, 0.970772141f,
+    0.970031253f, 0.969281235f, 0.968522094f, 0.967753837f, 0.966976471f, 0.966190003f, 0.965394442f, 0.964589793f,
+    0.963776066f, 0.962953267f, 0.962121404f, 0.961280486f, 0.960430519f, 0.959571513f, 0.958703475f, 0.957826413f,
+    0.956940336f, 0.956045251f, 0.955141168f, 0.954228095f, 0.95330604f, 0.952375013f, 0.951435021f, 0.950486074f,
+    0.949528181f, 0.94856135f, 0.947585591f, 0.946600913f, 0.945607325f, 0.944604837f, 0.943593458f, 0.942573198f,
+    0.941544065f, 0.940506071f, 0.939459224f, 0.938403534f, 0.937339012f, 0.936265667f, 0.93518351f, 0.93409255f,
+    0.932992799f, 0.931884266f, 0.930766961f, 0.929640896f, 0.92850608f, 0.927362526f, 0.926210242f, 0.925049241f,
+    0.923879533f, 0.922701128f, 0.921514039f, 0.920318277f, 0.919113852f, 0.917900776f, 0.91667906f, 0.915448716f,
+    0.914209756f, 0.91296219f, 0.911706032f, 0.910441292f, 0.909167983f, 0.907886116f, 0.906595705f, 0.905296759f,
+    0.903989293f, 0.902673318f, 0.901348847f, 0.900015892f, 0.898674466f, 0.897324581f, 0.89596625f, 0.894599486f,
+    0.893224301f, 0.891840709f, 0.890448723f, 0.889048356f, 0.88763962f, 0.88622253f, 0.884797098f, 0.883363339f,
+    0.881921264f, 0.880470889f, 0.879012226f, 0.87754529f, 0.876070094f, 0.874586652f, 0.873094978f, 0.871595087f,
+    0.870086991f, 0.868570706f, 0.867046246f, 0.865513624f, 0.863972856f, 0.862423956f, 0.860866939f, 0.859301818f,
+    0.85772861f, 0.856147328f, 0.854557988f, 0.852960605f, 0.851355193f, 0.849741768f, 0.848120345f, 0.846490939f,
+    0.844853565f, 0.84320824f, 0.841554977f, 0.839893794f, 0.838224706f, 0.836547727f, 0.834862875f, 0.833170165f,
+    0.831469612f, 0.829761234f, 0.828045045f, 0.826321063f, 0.824589303f, 0.822849781f, 0.821102515f, 0.81934752f,
+    0.817584813f, 0.815814411f, 0.81403633f, 0.812250587f, 0.810457198f, 0.808656182f, 0.806847554f, 0.805031331f,
+    0.803207531f, 0.801376172f, 0.799537269f, 0.797690841f, 0.795836905f, 0.793975478f, 0.792106577f, 0.790230221f,
+    0.788346428f, 0.786455214f, 0.784556597f, 0.782650596f, 0.780737229f, 0.778816512f, 0.776888466f, 0.774953107f,
+    0.773010453f, 0.771060524f, 0.769103338f, 0.767138912f, 0.765167266f, 0.763188417f, 0.761202385f, 0.759209189f,
+    0.757208847f, 0.755201377f, 0.753186799f, 0.751165132f, 0.749136395f, 0.747100606f, 0.745057785f, 0.743007952f,
+    0.740951125f, 0.738887324f, 0.736816569f, 0.734738878f, 0.732654272f, 0.730562769f, 0.72846439f, 0.726359155f,
+    0.724247083f, 0.722128194f, 0.720002508f, 0.717870045f, 0.715730825f, 0.713584869f, 0.711432196f, 0.709272826f,
+    0.707106781f, 0.70493408f, 0.702754744f, 0.700568794f, 0.698376249f, 0.696177131f, 0.693971461f, 0.691759258f,
+    0.689540545f, 0.687315341f, 0.685083668f, 0.682845546f, 0.680600998f, 0.678350043f, 0.676092704f, 0.673829f,
+    0.671558955f, 0.669282588f, 0.666999922f, 0.664710978f, 0.662415778f, 0.660114342f, 0.657806693f, 0.655492853f,
+    0.653172843f, 0.650846685f, 0.648514401f, 0.646176013f, 0.643831543f, 0.641481013f, 0.639124445f, 0.636761861f,
+    0.634393284f, 0.632018736f, 0.629638239f, 0.627251815f, 0.624859488f, 0.622461279f, 0.620057212f, 0.617647308f,
+    0.615231591f, 0.612810082f, 0.610382806f, 0.607949785f, 0.605511041f, 0.603066599f, 0.600616479f, 0.598160707f,
+    0.595699304f, 0.593232295f, 0.590759702f, 0.588281548f, 0.585797857f, 0.583308653f, 0.580813958f, 0.578313796f,
+    0.575808191f, 0.573297167f, 0.570780746f, 0.568258953f, 0.565731811f, 0.563199344f, 0.560661576f, 0.558118531f,
+    0.555570233f, 0.553016706f, 0.550457973f, 0.547894059f, 0.545324988f, 0.542750785f, 0.540171473f, 0.537587076f,
+    0.53499762f, 0.532403128f, 0.529803625f, 0.527199135f, 0.524589683f, 0.521975293f, 0.51935599f, 0.516731799f,
+    0.514102744f, 0.51146885f, 0.508830143f, 0.506186645f, 0.503538384f, 0.500885383f, 0.498227667f, 0.495565262f,
+    0.492898192f, 0.490226483f, 0.48755016f, 0.484869248f, 0.482183772f, 0.479493758f, 0.47679923f, 0.474100215f,
+    0.471396737f, 0.468688822f, 0.465976496f, 0.463259784f, 0.460538711f, 0.457813304f, 0.455083587f, 0.452349587f,
+    0.44961133f, 0.44686884f, 0.444122145f, 0.441371269f, 0.438616239f, 0.43585708f, 0.433093819f, 0.430326481f,
+    0.427555093f, 0.424779681f, 0.422000271f, 0.419216888f, 0.41642956f, 0.413638312f, 0.410843171f, 0.408044163f,
+    0.405241314f, 0.402434651f, 0.3996242f, 0.396809987f, 0.39399204f, 0.391170384f, 0.388345047f, 0.385516054f,
+    0.382683432f, 0.379847209f, 0.37700741f, 0.374164063f, 0.371317194f, 0.36846683f, 0.365612998f, 0.362755724f,
+    0.359895037f, 0.357030961f, 0.354163525f, 0.351292756f, 0.34841868f, 0.345541325f, 0.342660717f, 0.339776884f,
+    0.336889853f, 0.333999651f, 0.331106306f, 0.328209844f, 0.325310292f, 0.322407679f, 0.319502031f, 0.316593376f,
+    0.31368174f, 0.310767153f, 0.30784964f, 0.30492923f, 0.302005949f, 0.299079826f, 0.296150888f, 0.293219163f,
+    0.290284677f, 0.28734746f, 0.284407537f, 0.281464938f, 0.278519689f, 0.275571819f, 0.272621355f, 0.269668326f,
+    0.266712757f, 0.263754679f, 0.260794118f, 0.257831102f, 0.25486566f, 0.251897818f, 0.248927606f, 0.24595505f,
+    0.24298018f, 0.240003022f, 0.237023606f, 0.234041959f, 0.231058108f, 0.228072083f, 0.225083911f, 0.222093621f,
+    0.21910124f, 0.216106797f, 0.21311032f, 0.210111837f, 0.207111376f, 0.204108966f, 0.201104635f, 0.198098411f,
+    0.195090322f, 0.192080397f, 0.189068664f, 0.186055152f, 0.183039888f, 0.180022901f, 0.17700422f, 0.173983873f,
+    0.170961889f, 0.167938295f, 0.16491312f, 0.161886394f, 0.158858143f, 0.155828398f, 0.152797185f, 0.149764535f,
+    0.146730474f, 0.143695033f, 0.140658239f, 0.137620122f, 0.134580709f, 0.131540029f, 0.128498111f, 0.125454983f,
+    0.122410675f, 0.119365215f, 0.116318631f, 0.113270952f, 0.110222207f, 0.107172425f, 0.104121634f, 0.101069863f,
+    0.0980171403f, 0.0949634953f, 0.0919089565f, 0.0888535526f, 0.0857973123f, 0.0827402645f, 0.079682438f, 0.0766238614f,
+    0.0735645636f, 0.0705045734f, 0.0674439196f, 0.0643826309f, 0.0613207363f, 0.0582582645f, 0.0551952443f, 0.0521317047f,
+    0.0490676743f, 0.0460031821f, 0.0429382569f, 0.0398729276f, 0.0368072229f, 0.0337411719f, 0.0306748032f, 0.0276081458f,
+    0.0245412285f, 0.0214740803f, 0.0184067299f, 0.0153392063f, 0.0122715383f, 0.00920375478f, 0.00613588465f, 0.00306795676f,
+    0.0f, -0.00306795676f, -0.00613588465f, -0.00920375478f, -0.0122715383f, -0.0153392063f, -0.0184067299f, -0.0214740803f,
+    -0.0245412285f, -0.0276081458f, -0.0306748032f, -0.0337411719f, -0.0368072229f, -0.0398729276f, -0.0429382569f, -0.0460031821f,
+    -0.0490676743f, -0.0521317047f, -0.0551952443f, -0.0582582645f, -0.0613207363f, -0.0643826309f, -0.0674439196f, -0.0705045734f,
+    -0.0735645636f, -0.0766238614f, -0.079682438f, -0.0827402645f, -0.0857973123f, -0.0888535526f, -0.0919089565f, -0.0949634953f,
+    -0.0980171403f, -0.101069863f, -0.104121634f, -0.107172425f, -0.110222207f, -0.113270952f, -0.116318631f, -0.119365215f,
+    -0.122410675f, -0.125454983f, -0.128498111f, -0.131540029f, -0.134580709f, -0.137620122f, -0.140658239f, -0.143695033f,
+    -0.146730474f, -0.149764535f, -0.152797185f, -0.155828398f, -0.158858143f, -0.161886394f, -0.16491312f, -0.167938295f,
+    -0.170961889f, -0.173983873f, -0.17700422f, -0.180022901f, -0.183039888f, -0.186055152f, -0.189068664f, -0.192080397f,
+    -0.195090322f, -0.198098411f, -0.201104635f, -0.204108966f, -0.207111376f, -0.210111837f, -0.21311032f, -0.216106797f,
+    -0.21910124f, -0.222093621f, -0.225083911f, -0.228072083f, -0.231058108f, -0.234041959f, -0.237023606f, -0.240003022f,
+    -0.24298018f, -0.24595505f, -0.248927606f, -0.251897818f, -0.25486566f, -0.257831102f, -0.260794118f, -0.263754679f,
+    -0.266712757f, -0.269668326f, -0.272621355f, -0.275571819f, -0.278519689f, -0.281464938f, -0.284407537f, -0.28734746f,
+    -0.290284677f, -0.293219163f, -0.296150888f, -0.299079826f, -0.302005949f, -0.30492923f, -0.30784964f, -0.310767153f,
+    -0.31368174f, -0.316593376f, -0.319502031f, -0.322407679f, -0.325310292f, -0.328209844f, -0.331106306f, -0.333999651f,
+    -0.336889853f, -0.339776884f, -0.342660717f, -0.345541325f, -0.34841868f, -0.351292756f, -0.354163525f, -0.357030961f,
+    -0.359895037f, -0.362755724f, -0.365612998f, -0.36846683f, -0.371317194f, -0.374164063f, -0.37700741f, -0.379847209f,
+    -0.382683432f, -0.385516054f, -0.388345047f, -0.391170384f, -0.39399204f, -0.396809987f, -0.3996242f, -0.402434651f,
+    -0.405241314f, -0.408044163f, -0.410843171f, -0.413638312f, -0.41642956f, -0.419216888f, -0.422000271f, -0.424779681f,
+    -0.427555093f, -0.430326481f, -0.433093819f, -0.43585708f, -0.438616239f, -0.441371269f, -0.444122145f, -0.44686884f,
+    -0.44961133f, -0.452349587f, -0.455083587f, -0.457813304f, -0.460538711f, -0.463259784f, -0.465976496f, -0.468688822f,
+    -0.471396737f, -0.474100215f, -0.47679923f, -0.479493758f, -0.482183772f, -0.484869248f, -0.48755016f, -0.490226483f,
+    -0.492898192f, -0.495565262f, -0.498227667f, -0.500885383f, -0.503538384f, -0.506186645f, -0.508830143f, -0.51146885f,
+    -0.514102744f, -0.516731799f, -0.51935599f, -0.521975293f, -0.524589683f, -0.527199135f, -0.529803625f, -0.532403128f,
+    -0.53499762f, -0.537587076f, -0.540171473f, -0.542750785f, -0.545324988f, -0.547894059f, -0.550457973f, -0.553016706f,
+    -0.555570233f, -0.558118531f, -0.560661576f, -0.563199344f, -0.565731811f, -0.568258953f, -0.570780746f, -0.573297167f,
+    -0.575808191f, -0.578313796f, -0.580813958f, -0.583308653f, -0.585797857f, -0.588281548f, -0.590759702f, -0.593232295f,
+    -0.595699304f, -0.598160707f, -0.600616479f, -0.603066599f, -0.605511041f, -0.607949785f, -0.610382806f, -0.612810082f,
+    -0.615231591f, -0.617647308f, -0.620057212f, -0.622461279f, -0.624859488f, -0.627251815f, -0.629638239f, -0.632018736f,
+    -0.634393284f, -0.636761861f, -0.639124445f, -0.641481013f, -0.643831543f, -0.646176013f, -0.648514401f, -0.650846685f,
+    -0.653172843f, -0.655492853f, -0.657806693f, -0.660114342f, -0.662415778f, -0.664710978f, -0.666999922f, -0.669282588f,
+    -0.671558955f, -0.673829f, -0.676092704f, -0.678350043f, -0.680600998f, -0.682845546f, -0.685083668f, -0.687315341f,
+    -0.689540545f, -0.691759258f, -0.693971461f, -0.696177131f, -0.698376249f, -0.700568794f, -0.702754744f, -0.70493408f,
+    -0.707106781f, -0.709272826f, -0.711432196f, -0.713584869f, -0.715730825f, -0.717870045f, -0.720002508f, -0.722128194f,
+    -0.724247083f, -0.726359155f, -0.72846439f, -0.730562769f, -0.732654272f, -0.734738878f, -0.736816569f, -0.738887324f,
+    -0.740951125f, -0.743007952f, -0.745057785f, -0.747100606f, -0.749136395f, -0.751165132f, -0.753186799f, -0.755201377f,
+    -0.757208847f, -0.759209189f, -0.761202385f, -0.763188417f, -0.765167266f, -0.767138912f, -0.769103338f, -0.771060524f,
+    -0.773010453f, -0.774953107f, -0.776888466f, -0.778816512f, -0.780737229f, -0.782650596f, -0.784556597f, -0.786455214f,
+    -0.788346428f, -0.790230221f, -0.792106577f, -0.793975478f, -0.795836905f, -0.797690841f, -0.799537269f, -0.801376172f,
+    -0.803207531f, -0.805031331f, -0.806847554f, -0.808656182f, -0.810457198f, -0.812250587f, -0.81403633f, -0.815814411f,
+    -0.817584813f, -0.81934752f, -0.821102515f, -0.822849781f, -0.824589303f, -0.826321063f, -0.828045045f, -0.829761234f,
+    -0.831469612f, -0.833170165f, -0.834862875f, -0.836547727f, -0.838224706f, -0.839893794f, -0.841554977f, -0.84320824f,
+    -0.844853565f, -0.846490939f, -0.848120345f, -0.849741768f, -0.851355193f, -0.852960605f, -0.854557988f, -0.856147328f,
+    -0.85772861f, -0.859301818f, -0.860866939f, -0.862423956f, -0.863972856f, -0.865513624f, -0.867046246f, -0.868570706f,
+    -0.870086991f, -0.871595087f, -0.873094978f, -0.874586652f, -0.876070094f, -0.87754529f, -0.879012226f, -0.880470889f,
+    -0.881921264f, -0.883363339f, -0.884797098f, -0.88622253f, -0.88763962f, -0.889048356f, -0.890448723f, -0.891840709f,
+    -0.893224301f, -0.894599486f, -0.89596625f, -0.897324581f, -0.898674466f, -0.900015892f, -0.901348847f, -0.902673318f,
+    -0.903989293f, -0.905296759f, -0.906595705f, -0.907886116f, -0.909167983f, -0.910441292f, -0.911706032f, -0.91296219f,
+    -0.914209756f, -0.915448716f, -0.91667906f, -0.917900776f, -0.919113852f, -0.920318277f, -0.921514039f, -0.922701128f,
+    -0.923879533f, -0.925049241f, -0.926210242f, -0.927362526f, -0.92850608f, -0.929640896f, -0.930766961f, -0.931884266f,
+    -0.932992799f, -0.93409255f, -0.93518351f, -0.936265667f, -0.937339012f, -0.938403534f, -0.939459224f, -0.940506071f,
+    -0.941544065f, -0.942573198f, -0.943593458f, -0.944604837f, -0.945607325f, -0.946600913f, -0.947585591f, -0.94856135f,
+    -0.949528181f, -0.950486074f, -0.951435021f, -0.952375013f, -0.95330604f, -0.954228095f, -0.955141168f, -0.956045251f,
+    -0.956940336f, -0.957826413f, -0.958703475f, -0.959571513f, -0.960430519f, -0.961280486f, -0.962121404f, -0.962953267f,
+    -0.963776066f, -0.964589793f, -0.965394442f, -0.966190003f, -0.966976471f, -0.967753837f, -0.968522094f, -0.969281235f,
+    -0.970031253f, -0.970772141f, -0.971503891f, -0.972226497f, -0.972939952f, -0.97364425f, -0.974339383f, -0.975025345f,
+    -0.97570213f, -0.976369731f, -0.977028143f, -0.977677358f, -0.978317371f, -0.978948175f, -0.979569766f, -0.980182136f,
+    -0.98078528f, -0.981379193f, -0.981963869f, -0.982539302f, -0.983105487f, -0.983662419f, -0.984210092f, -0.984748502f,
+    -0.985277642f, -0.985797509f, -0.986308097f, -0.986809402f, -0.987301418f, -0.987784142f, -0.988257568f, -0.988721692f,
+    -0.98917651f, -0.989622017f, -0.99005821f, -0.990485084f, -0.990902635f, -0.99131086f, -0.991709754f, -0.992099313f,
+    -0.992479535f, -0.992850414f, -0.993211949f, -0.993564136f, -0.99390697f, -0.994240449f, -0.994564571f, -0.994879331f,
+    -0.995184727f, -0.995480755f, -0.995767414f, -0.996044701f, -0.996312612f, -0.996571146f, -0.996820299f, -0.99706007f,
+    -0.997290457f, -0.997511456f, -0.997723067f, -0.997925286f, -0.998118113f, -0.998301545f, -0.998475581f, -0.998640218f,
+    -0.998795456f, -0.998941293f, -0.999077728f, -0.999204759f, -0.999322385f, -0.999430605f, -0.999529418f, -0.999618822f,
+    -0.999698819f, -0.999769405f, -0.999830582f, -0.999882347f, -0.999924702f, -0.999957645f, -0.999981175f, -0.999995294f,
+    -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+};
+
+ANC_ALIGN(64) const float dsp_bin_twiddle_im[SPECTRUM_LENGTH] = {
+    0.0f, -0.00306795676f, -0.00613588465f, -0.00920375478f, -0.0122715383f, -0.0153392063f, -0.0184067299f, -0.0214740803f,
+    -0.0245412285f, -0.0276081458f, -0.0306748032f, -0.0337411719f, -0.0368072229f, -0.0398729276f, -0.0429382569f, -0.0460031821f,
+    -0.0490676743f, -0.0521317047f, -0.0551952443f, -0.0582582645f, -0.0613207363f, -0.0643826309f, -0.0674439196f, -0.0705045734f,
+    -0.0735645636f, -0.0766238614f, -0.079682438f, -0.0827402645f, -0.0857973123f, -0.0888535526f, -0.0919089565f, -0.0949634953f,
+    -0.0980171403f, -0.101069863f, -0.104121634f, -0.107172425f, -0.110222207f, -0.113270952f, -0.116318631f, -0.119365215f,
+    -0.122410675f, -0.125454983f, -0.128498111f, -0.131540029f, -0.134580709f, -0.137620122f, -0.140658239f, -0.143695033f,
+    -0.146730474f, -0.149764535f, -0.152797185f, -0.155828398f, -0.158858143f, -0.161886394f, -0.16491312f, -0.167938295f,
+    -0.170961889f, -0.173983873f, -0.17700422f, -0.180022901f, -0.183039888f, -0.186055152f, -0.189068664f, -0.192080397f,
+    -0.195090322f, -0.198098411f, -0.201104635f, -0.204108966f, -0.207111376f, -0.210111837f, -0.21311032f, -0.216106797f,
+    -0.21910124f, -0.222093621f, -0.225083911f, -0.228072083f, -0.231058108f, -0.234041959f, -0.237023606f, -0.240003022f,
+    -0.24298018f, -0.24595505f, -0.248927606f, -0.251897818f, -0.25486566f, -0.257831102f, -0.260794118f, -0.263754679f,
+    -0.266712757f, -0.269668326f, -0.272621355f, -0.275571819f, -0.278519689f, -0.281464938f, -0.284407537f, -0.28734746f,
+    -0.290284677f, -0.293219163f, -0.296150888f, -0.299079826f, -0.302005949f, -0.30492923f, -0.30784964f, -0.310767153f,
+    -0.31368174f, -0.316593376f, -0.319502031f, -0.322407679f, -0.325310292f, -0.328209844f, -0.331106306f, -0.333999651f,
+    -0.336889853f, -0.339776884f, -0.342660717f, -0.345541325f, -0.34841868f, -0.351292756f, -0.354163525f, -0.357030961f,
+    -0.359895037f, -0.362755724f, -0.365612998f, -0.36846683f, -0.371317194f, -0.374164063f, -0.37700741f, -0.379847209f,
+    -0.382683432f, -0.385516054f, -0.388345047f, -0.391170384f, -0.39399204f, -0.396809987f, -0.3996242f, -0.402434651f,
+    -0.405241314f, -0.408044163f, -0.410843171f, -0.413638312f, -0.41642956f, -0.419216888f, -0.422000271f, -0.424779681f,
+    -0.427555093f, -0.430326481f, -0.433093819f, -0.43585708f, -0.438616239f, -0.441371269f, -0.444122145f, -0.44686884f,
+    -0.44961133f, -0.452349587f, -0.455083587f, -0.457813304f, -0.460538711f, -0.463259784f, -0.465976496f, -0.468688822f,
+    -0.471396737f, -0.474100215f, -0.47679923f, -0.479493758f, -0.482183772f, -0.484869248f, -0.48755016f, -0.490226483f,
+    -0.492898192f, -0.495565262f, -0.498227667f, -0.500885383f, -0.503538384f, -0.506186645f, -0.508830143f, -0.51146885f,
+    -0.514102744f, -0.516731799f, -0.51935599f, -0.521975293f, -0.524589683f, -0.527199135f, -0.529803625f, -0.532403128f,
+    -0.53499762f, -0.537587076f, -0.540171473f, -0.542750785f, -0.545324988f, -0.547894059f, -0.550457973f, -0.553016706f,
+    -0.555570233f, -0.558118531f, -0.560661576f, -0.563199344f, -0.565731811f, -0.568258953f, -0.570780746f, -0.573297167f,
+    -0.575808191f, -0.578313796f, -0.580813958f, -0.583308653f, -0.585797857f, -0.588281548f, -0.590759702f, -0.593232295f,
+    -0.595699304f, -0.598160707f, -0.600616479f, -0.603066599f, -0.605511041f, -0.607949785f, -0.610382806f, -0.612810082f,
+    -0.615231591f, -0.617647308f, -0.620057212f, -0.622461279f, -0.624859488f, -0.627251815f, -0.629638239f, -0.632018736f,
+    -0.634393284f, -0.636761861f, -0.639124445f, -0.641481013f, -0.643831543f, -0.646176013f, -0.648514401f, -0.650846685f,
+    -0.653172843f, -0.655492853f, -0.657806693f, -0.660114342f, -0.662415778f, -0.664710978f, -0.666999922f, -0.669282588f,
+    -0.671558955f, -0.673829f, -0.676092704f, -0.678350043f, -0.680600998f, -0.682845546f, -0.685083668f, -0.687315341f,
+    -0.689540545f, -0.691759258f, -0.693971461f, -0.696177131f, -0.698376249f, -0.700568794f, -0.702754744f, -0.70493408f,
+    -0.707106781f, -0.709272826f, -0.711432196f, -0.713584869f, -0.715730825f, -0.717870045f, -0.720002508f, -0.722128194f,
+    -0.724247083f, -0.726359155f, -0.72846439f, -0.730562769f, -0.732654272f, -0.734738878f, -0.736816569f, -0.738887324f,
+    -0.740951125f, -0.743007952f, -0.745057785f, -0.747100606f, -0.749136395f, -0.751165132f, -0.753186799f, -0.755201377f,
+    -0.757208847f, -0.759209189f, -0.761202385f, -0.763188417f, -0.765167266f, -0.767138912f, -0.769103338f, -0.771060524f,
+    -0.773010453f, -0.774953107f, -0.776888466f, -0.778816512f, -0.780737229f, -0.782650596f, -0.784556597f, -0.786455214f,
+    -0.788346428f, -0.790230221f, -0.792106577f, -0.793975478f, -0.795836905f, -0.797690841f, -0.799537269f, -0.801376172f,
+    -0.803207531f, -0.805031331f, -0.806847554f, -0.808656182f, -0.810457198f, -0.812250587f, -0.81403633f, -0.815814411f,
+    -0.817584813f, -0.81934752f, -0.821102515f, -0.822849781f, -0.824589303f, -0.826321063f, -0.828045045f, -0.829761234f,
+    -0.831469612f, -0.833170165f, -0.834862875f, -0.836547727f, -0.838224706f, -0.839893794f, -0.841554977f, -0.84320824f,
+    -0.844853565f, -0.846490939f, -0.848120345f, -0.849741768f, -0.851355193f, -0.852960605f, -0.854557988f, -0.856147328f,
+    -0.85772861f, -0.859301818f, -0.860866939f, -0.862423956f, -0.863972856f, -0.865513624f, -0.867046246f, -0.868570706f,
+    -0.870086991f, -0.871595087f, -0.873094978f, -0.874586652f, -0.876070094f, -0.87754529f, -0.879012226f, -0.880470889f,
+    -0.881921264f, -0.883363339f, -0.884797098f, -0.88622253f, -0.88763962f, -0.889048356f, -0.890448723f, -0.891840709f,
+    -0.893224301f, -0.894599486f, -0.89596625f, -0.897324581f, -0.898674466f, -0.900015892f, -0.901348847f, -0.902673318f,
+    -0.903989293f, -0.905296759f, -0.906595705f, -0.907886116f, -0.909167983f, -0.910441292f, -0.911706032f, -0.91296219f,
+    -0.914209756f, -0.915448716f, -0.91667906f, -0.917900776f, -0.919113852f, -0.920318277f, -0.921514039f, -0.922701128f,
+    -0.923879533f, -0.925049241f, -0.926210242f, -0.927362526f, -0.92850608f, -0.929640896f, -0.930766961f, -0.931884266f,
+    -0.932992799f, -0.93409255f, -0.93518351f, -0.936265667f, -0.937339012f, -0.938403534f, -0.939459224f, -0.940506071f,
+    -0.941544065f, -0.942573198f, -0.943593458f, -0.944604837f, -0.945607325f, -0.946600913f, -0.947585591f, -0.94856135f,
+    -0.949528181f, -0.950486074f, -0.951435021f, -0.952375013f, -0.95330604f, -0.954228095f, -0.955141168f, -0.956045251f,
+    -0.956940336f, -0.957826413f, -0.958703475f, -0.959571513f, -0.960430519f, -0.961280486f, -0.962121404f, -0.962953267f,
+    -0.963776066f, -0.964589793f, -0.965394442f, -0.966190003f, -0.966976471f, -0.967753837f, -0.968522094f, -0.969281235f,
+    -0.970031253f, -0.970772141f, -0.971503891f, -0.972226497f, -0.972939952f, -0.97364425f, -0.974339383f, -0.975025345f,
+    -0.97570213f, -0.976369731f, -0.977028143f, -0.977677358f, -0.978317371f, -0.978948175f, -0.979569766f, -0.980182136f,
+    -0.98078528f, -0.981379193f, -0.981963869f, -0.982539302f, -0.983105487f, -0.983662419f, -0.984210092f, -0.984748502f,
+    -0.985277642f, -0.985797509f, -0.986308097f, -0.986809402f, -0.987301418f, -0.987784142f, -0.988257568f, -0.988721692f,
+    -0.98917651f, -0.989622017f, -0.99005821f, -0.990485084f, -0.990902635f, -0.99131086f, -0.991709754f, -0.992099313f,
+    -0.992479535f, -0.992850414f, -0.993211949f, -0.993564136f, -0.99390697f, -0.994240449f, -0.994564571f, -0.994879331f,
+    -0.995184727f, -0.995480755f, -0.995767414f, -0.996044701f, -0.996312612f, -0.996571146f, -0.996820299f, -0.99706007f,
+    -0.997290457f, -0.997511456f, -0.997723067f, -0.997925286f, -0.998118113f, -0.998301545f, -0.998475581f, -0.998640218f,
+    -0.998795456f, -0.998941293f, -0.999077728f, -0.999204759f, -0.999322385f, -0.999430605f, -0.999529418f, -0.999618822f,
+    -0.999698819f, -0.999769405f, -0.999830582f, -0.999882347f, -0.999924702f, -0.999957645f, -0.999981175f, -0.999995294f,
+    -1.0f, -0.999995294f, -0.999981175f, -0.999957645f, -0.999924702f, -0.999882347f, -0.999830582f, -0.999769405f,
+    -0.999698819f, -0.999618822f, -0.999529418f, -0.999430605f, -0.999322385f, -0.999204759f, -0.999077728f, -0.998941293f,
+    -0.998795456f, -0.998640218f, -0.998475581f, -0.998301545f, -0.998118113f, -0.997925286f, -0.997723067f, -0.997511456f,
+    -0.997290457f, -0.99706007f, -0.996820299f, -0.996571146f, -0.996312612f, -0.996044701f, -0.995767414f, -0.995480755f,
+    -0.995184727f, -0.994879331f, -0.994564571f, -0.994240449f, -0.99390697f, -0.993564136f, -0.993211949f, -0.992850414f,
+    -0.992479535f, -0.992099313f, -0.991709754f, -0.99131086f, -0.990902635f, -0.990485084f, -0.99005821f, -0.989622017f,
+    -0.98917651f, -0.988721692f, -0.988257568f, -0.987784142f, -0.987301418f, -0.986809402f, -0.986308097f, -0.985797509f,
+    -0.985277642f, -0.984748502f, -0.984210092f, -0.983662419f, -0.983105487f, -0.982539302f, -0.981963869f, -0.981379193f,
+    -0.98078528f, -0.980182136f, -0.979569766f, -0.978948175f, -0.978317371f, -0.977677358f, -0.977028143f, -0.976369731f,
+    -0.97570213f, -0.975025345f, -0.974339383f, -0.97364425f, -0.972939952f, -0.972226497f, -0.971503891f, -0.970772141f,
+    -0.970031253f, -0.969281235f, -0.968522094f, -0.967753837f, -0.966976471f, -0.966190003f, -0.965394442f, -0.964589793f,
+    -0.963776066f, -0.962953267f, -0.962121404f, -0.961280486f, -0.960430519f, -0.959571513f, -0.958703475f, -0.957826413f,
+    -0.956940336f, -0.956045251f, -0.955141168f, -0.954228095f, -0.95330604f, -0.952375013f, -0.951435021f, -0.950486074f,
+    -0.949528181f, -0.94856135f, -0.947585591f, -0.946600913f, -0.945607325f, -0.944604837f, -0.943593458f, -0.942573198f,
+    -0.941544065f, -0.940506071f, -0.939459224f, -0.938403534f, -0.937339012f, -0.936265667f, -0.93518351f, -0.93409255f,
+    -0.932992799f, -0.931884266f, -0.930766961f, -0.929640896f, -0.92850608f, -0.927362526f, -0.926210242f, -0.925049241f,
+    -0.923879533f, -0.922701128f, -0.921514039f, -0.920318277f, -0.919113852f, -0.917900776f, -0.91667906f, -0.915448716f,
+    -0.914209756f, -0.91296219f, -0.911706032f, -0.910441292f, -0.909167983f, -0.907886116f, -0.906595705f, -0.905296759f,
+    -0.903989293f, -0.902673318f, -0.901348847f, -0.900015892f, -0.898674466f, -0.897324581f, -0.89596625f, -0.894599486f,
+    -0.893224301f, -0.891840709f, -0.890448723f, -0.889048356f, -0.88763962f, -0.88622253f, -0.884797098f, -0.883363339f,
+    -0.881921264f, -0.880470889f, -0.879012226f, -0.87754529f, -0.876070094f, -0.874586652f, -0.873094978f, -0.871595087f,
+    -0.870086991f, -0.868570706f, -0.867046246f, -0.865513624f, -0.863972856f, -0.862423956f, -0.860866939f, -0.859301818f,
+    -0.85772861f, -0.856147328f, -0.854557988f, -0.852960605f, -0.851355193f, -0.849741768f, -0.848120345f, -0.846490939f,
+    -0.844853565f, -0.84320824f, -0.841554977f, -0.839893794f, -0.838224706f, -0.836547727f, -0.834862875f, -0.833170165f,
+    -0.831469612f, -0.829761234f, -0.828045045f, -0.826321063f, -0.824589303f, -0.822849781f, -0.821102515f, -0.81934752f,
+    -0.817584813f, -0.815814411f, -0.81403633f, -0.812250587f, -0.810457198f, -0.808656182f, -0.806847554f, -0.805031331f,
+    -0.803207531f, -0.801376172f, -0.799537269f, -0.797690841f, -0.795836905f, -0.793975478f, -0.792106577f, -0.790230221f,
+    -0.788346428f, -0.786455214f, -0.784556597f, -0.782650596f, -0.780737229f, -0.778816512f, -0.776888466f, -0.774953107f,
+    -0.773010453f, -0.771060524f, -0.769103338f, -0.767138912f, -0.765167266f, -0.763188417f, -0.761202385f, -0.759209189f,
+    -0.757208847f, -0.755201377f, -0.753186799f, -0.751165132f, -0.749136395f, -0.747100606f, -0.745057785f, -0.743007952f,
+    -0.740951125f, -0.738887324f, -0.736816569f, -0.734738878f, -0.732654272f, -0.730562769f, -0.72846439f, -0.726359155f,
+    -0.724247083f, -0.722128194f, -0.720002508f, -0.717870045f, -0.715730825f, -0.713584869f, -0.711432196f, -0.709272826f,
+    -0.707106781f, -0.70493408f, -0.702754744f, -0.700568794f, -0.698376249f, -0.696177131f, -0.693971461f, -0.691759258f,
+    -0.689540545f, -0.687315341f, -0.685083668f, -0.682845546f, -0.680600998f, -0.678350043f, -0.676092704f, -0.673829f,
+    -0.671558955f, -0.669282588f, -0.666999922f, -0.664710978f, -0.662415778f, -0.660114342f, -0.657806693f, -0.655492853f,
+    -0.653172843f, -0.650846685f, -0.648514401f, -0.646176013f, -0.643831543f, -0.641481013f, -0.639124445f, -0.636761861f,
+    -0.634393284f, -0.632018736f, -0.629638239f, -0.627251815f, -0.624859488f, -0.622461279f, -0.620057212f, -0.617647308f,
+    -0.615231591f, -0.612810082f, -0.610382806f, -0.607949785f, -0.605511041f, -0.603066599f, -0.600616479f, -0.598160707f,
+    -0.595699304f, -0.593232295f, -0.590759702f, -0.588281548f, -0.585797857f, -0.583308653f, -0.580813958f, -0.578313796f,
+    -0.575808191f, -0.573297167f, -0.570780746f, -0.568258953f, -0.565731811f, -0.563199344f, -0.560661576f, -0.558118531f,
+    -0.555570233f, -0.553016706f, -0.550457973f, -0.547894059f, -0.545324988f, -0.542750785f, -0.540171473f, -0.537587076f,
+    -0.53499762f, -0.532403128f, -0.529803625f, -0.527199135f, -0.524589683f, -0.521975293f, -0.51935599f, -0.516731799f,
+    -0.514102744f, -0.51146885f, -0.508830143f, -0.506186645f, -0.503538384f, -0.500885383f, -0.498227667f, -0.495565262f,
+    -0.492898192f, -0.490226483f, -0.48755016f, -0.484869248f, -0.482183772f, -0.479493758f, -0.47679923f, -0.474100215f,
+    -0.471396737f, -0.468688822f, -0.465976496f, -0.463259784f, -0.460538711f, -0.457813304f, -0.455083587f, -0.452349587f,
+    -0.44961133f, -0.44686884f, -0.444122145f, -0.441371269f, -0.438616239f, -0.43585708f, -0.433093819f, -0.430326481f,
+    -0.427555093f, -0.424779681f, -0.422000271f, -0.419216888f, -0.41642956f, -0.413638312f, -0.410843171f, -0.408044163f,
+    -0.405241314f, -0.402434651f, -0.3996242f, -0.396809987f, -0.39399204f, -0.391170384f, -0.388345047f, -0.385516054f,
+    -0.382683432f, -0.379847209f, -0.37700741f, -0.374164063f, -0.371317194f, -0.36846683f, -0.365612998f, -0.362755724f,
+    -0.359895037f, -0.357030961f, -0.354163525f, -0.351292756f, -0.34841868f, -0.345541325f, -0.342660717f, -0.339776884f,
+    -0.336889853f, -0.333999651f, -0.331106306f, -0.328209844f, -0.325310292f, -0.322407679f, -0.319502031f, -0.316593376f,
+    -0.31368174f, -0.310767153f, -0.30784964f, -0.30492923f, -0.302005949f, -0.299079826f, -0.296150888f, -0.293219163f,
+    -0.290284677f, -0.28734746f, -0.284407537f, -0.281464938f, -0.278519689f, -0.275571819f, -0.272621355f, -0.269668326f,
+    -0.266712757f, -0.263754679f, -0.260794118f, -0.257831102f, -0.25486566f, -0.251897818f, -0.248927606f, -0.24595505f,
+    -0.24298018f, -0.240003022f, -0.237023606f, -0.234041959f, -0.231058108f, -0.228072083f, -0.225083911f, -0.222093621f,
+    -0.21910124f, -0.216106797f, -0.21311032f, -0.210111837f, -0.207111376f, -0.204108966f, -0.201104635f, -0.198098411f,
+    -0.195090322f, -0.192080397f, -0.189068664f, -0.186055152f, -0.183039888f, -0.180022901f, -0.17700422f, -0.173983873f,
+    -0.170961889f, -0.167938295f, -0.16491312f, -0.161886394f, -0.158858143f, -0.155828398f, -0.152797185f, -0.149764535f,
+    -0.146730474f, -0.143695033f, -0.140658239f, -0.137620122f, -0.134580709f, -0.131540029f, -0.128498111f, -0.125454983f,
+    -0.122410675f, -0.119365215f, -0.116318631f, -0.113270952f, -0.110222207f, -0.107172425f, -0.104121634f, -0.101069863f,
+    -0.0980171403f, -0.0949634953f, -0.0919089565f, -0.0888535526f, -0.0857973123f, -0.0827402645f, -0.079682438f, -0.0766238614f,
+    -0.0735645636f, -0.0705045734f, -0.0674439196f, -0.0643826309f, -0.0613207363f, -0.0582582645f, -0.0551952443f, -0.0521317047f,
+    -0.0490676743f, -0.0460031821f, -0.0429382569f, -0.0398729276f, -0.0368072229f, -0.0337411719f, -0.0306748032f, -0.0276081458f,
+    -0.0245412285f, -0.0214740803f, -0.0184067299f, -0.0153392063f, -0.0122715383f, -0.00920375478f, -0.00613588465f, -0.00306795676f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+};
+
@@ -0,0 +1,737 @@
+#include "../inc/eq_fit.h"
+#include "../inc/coeffs.h"
+#include <complex.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIT_ORDER   (2 * NUM_BIQUADS)   // 有理模型阶数
+#define HQR_MAX_ITS 60                  // 每个特征值的QR迭代上限
+#define FIT_MAX_PREWARP 1e3             // 网格外频点的预畸变频率上限（排除Nyquist附近）
+
+// 极点集合：每个条目为实极点（im = 0，占一列基函数）或共轭对的上半平面极点（im > 0，占两列）
+typedef struct {
+    int count;
+    double re[FIT_ORDER];
+    double im[FIT_ORDER];
+} PoleSet;
+
+// 二阶多项式 s² + (w/q)s + w²
+typedef struct {
+    double w;
+    double q;
+} SecondOrder;
+
+// ============ 部分分式基函数 ============
+// 共轭对p: φ1 = 1/(s-p) + 1/(s-p*)，φ2 = j/(s-p) - j/(s-p*)，系数实数时组合为实系数有理函数
+static void fill_basis(double complex s, const PoleSet *poles, double complex *phi) {
+    int col = 0;
+    for (int n = 0; n < poles->count; n++) {
+        double complex p = poles->re[n] + I * poles->im[n];
+        if (poles->im[n] > 0.0) {
+            double complex a = 1.0 / (s - p);
+            double complex b = 1.0 / (s - conj(p));
+            phi[col++] = a + b;
+            phi[col++] = I * a - I * b;
+        } else {
+            phi[col++] = 1.0 / (s - p);
+        }
+    }
+}
+
+// 实数状态空间形式 A - b·cᵀ·scale：其特征值为 1 + scale·Σ c_n φ_n(s) 的零点
+// 共轭对块 [[α, β], [-β, α]]，b = [2, 0]ᵀ；实极点块 [α]，b = 1
+static void residue_matrix(const PoleSet *poles, const double *c, double scale,
+                           double a[FIT_ORDER][FIT_ORDER]) {
+    double b[FIT_ORDER];
+    memset(a, 0, sizeof(double) * FIT_ORDER * FIT_ORDER);
+    int col = 0;
+    for (int n = 0; n < poles->count; n++) {
+        if (poles->im[n] > 0.0) {
+            a[col][col] = poles->re[n];
+            a[col][col + 1] = poles->im[n];
+            a[col + 1][col] = -poles->im[n];
+            a[col + 1][col + 1] = poles->re[n];
+            b[col] = 2.0;
+            b[col + 1] = 0.0;
+            col += 2;
+        } else {
+            a[col][col] = poles->re[n];
+            b[col] = 1.0;
+            col++;
+        }
+    }
+    for (int i = 0; i < FIT_ORDER; i++) {
+        for (int j = 0; j < FIT_ORDER; j++) {
+            a[i][j] -= b[i] * c[j] * scale;
+        }
+    }
+}
+
+// ============ 一般实矩阵特征值 ============
+// 平衡 → 消元化为上Hessenberg → 带位移的双步QR（EISPACK hqr），原地破坏a
+static void eig_balance(double a[FIT_ORDER][FIT_ORDER], int n) {
+    const double radix = 2.0;
+    int done = 0;
+    while (!done) {
+        done = 1;
+        for (int i = 0; i < n; i++) {
+            double r = 0.0, c = 0.0;
+            for (int j = 0; j < n; j++) {
+                if (j != i) {
+                    c += fabs(a[j][i]);
+                    r += fabs(a[i][j]);
+                }
+            }
+            if (c != 0.0 && r != 0.0) {
+                double g = r / radix, f = 1.0, s = c + r;
+                while (c < g) {
+                    f *= radix;
+                    c *= radix * radix;
+                }
+                g = r * radix;
+                while (c > g) {
+                    f /= radix;
+                    c /= radix * radix;
+                }
+                if ((c + r) / f < 0.95 * s) {
+                    done = 0;
+                    for (int j = 0; j < n; j++) a[i][j] /= f;
+                    for (int j = 0; j < n; j++) a[j][i] *= f;
+                }
+            }
+        }
+    }
+}
+
+static void eig_hessenberg(double a[FIT_ORDER][FIT_ORDER], int n) {
+    for (int m = 1; m < n - 1; m++) {
+        double x = 0.0;
+        int i = m;
+        for (int j = m; j < n; j++) {
+            if (fabs(a[j][m - 1]) > fabs(x)) {
+                x = a[j][m - 1];
+                i = j;
+            }
+        }
+        if (i != m) {
+            for (int j = m - 1; j < n; j++) {
+                double t = a[i][j]; a[i][j] = a[m][j]; a[m][j] = t;
+            }
+            for (int j = 0; j < n; j++) {
+                double t = a[j][i]; a[j][i] = a[j][m]; a[j][m] = t;
+            }
+        }
+        if (x != 0.0) {
+            for (i = m + 1; i < n; i++) {
+                double y = a[i][m - 1];
+                if (y != 0.0) {
+                    y /= x;
+                    a[i][m - 1] = y;
+                    for (int j = m; j < n; j++) a[i][j] -= y * a[m][j];
+                    for (int j = 0; j < n; j++) a[j][m] += y * a[j][i];
+                }
+            }
+        }
+    }
+    for (int i = 2; i < n; i++) {
+        for (int j = 0; j < i - 1; j++) {
+            a[i][j] = 0.0;
+        }
+    }
+}
+
+static int eig_hqr(double a[FIT_ORDER][FIT_ORDER], int n, double *wr, double *wi) {
+    double anorm = 0.0, t = 0.0;
+    double p = 0.0, q = 0.0, r = 0.0, s, w, x, y, z;
+    for (int i = 0; i < n; i++) {
+        for (int j = (i > 0 ? i - 1 : 0); j < n; j++) {
+            anorm += fabs(a[i][j]);
+        }
+    }
+
+    int nn = n - 1;
+    while (nn >= 0) {
+        int its = 0, l;
+        do {
+            for (l = nn; l > 0; l--) {
+                s = fabs(a[l - 1][l - 1]) + fabs(a[l][l]);
+                if (s == 0.0) s = anorm;
+                if (fabs(a[l][l - 1]) <= DBL_EPSILON * s) {
+                    a[l][l - 1] = 0.0;
+                    break;
+                }
+            }
+            x = a[nn][nn];
+            if (l == nn) {
+                // 一个实根
+                wr[nn] = x + t;
+                wi[nn--] = 0.0;
+            } else {
+                y = a[nn - 1][nn - 1];
+                w = a[nn][nn - 1] * a[nn - 1][nn];
+                if (l == nn - 1) {
+                    // 两个根
+                    p = 0.5 * (y - x);
+                    q = p * p + w;
+                    z = sqrt(fabs(q));
+                    x += t;
+                    if (q >= 0.0) {
+                        z = p + (p >= 0.0 ? z : -z);
+                        wr[nn - 1] = wr[nn] = x + z;
+                        if (z != 0.0) wr[nn] = x - w / z;
+                        wi[nn - 1] = wi[nn] = 0.0;
+                    } else {
+                        wr[nn - 1] = wr[nn] = x + p;
+                        wi[nn - 1] = -z;
+                        wi[nn] = z;
+                    }
+                    nn -= 2;
+                } else {
+                    if (its == HQR_MAX_ITS) {
+                        return -1;
+                    }
+                    if (its == 10 || its == 20) {
+                        // 特殊位移
+                        t += x;
+                        for (int i = 0; i <= nn; i++) a[i][i] -= x;
+                        s = fabs(a[nn][nn - 1]) + fabs(a[nn - 1][nn - 2]);
+                        y = x = 0.75 * s;
+                        w = -0.4375 * s * s;
+                    }
+                    ++its;
+                    int m;
+                    for (m = nn - 2; m >= l; m--) {
+                        z = a[m][m];
+                        r = x - z;
+                        s = y - z;
+                        p = (r * s - w) / a[m + 1][m] + a[m][m + 1];
+                        q = a[m + 1][m + 1] - z - r - s;
+                        r = a[m + 2][m + 1];
+                        s = fabs(p) + fabs(q) + fabs(r);
+                        p /= s;
+                        q /= s;
+                        r /= s;
+                        if (m == l) break;
+                        double u = fabs(a[m][m - 1]) * (fabs(q) + fabs(r));
+                        double v = fabs(p) * (fabs(a[m - 1][m - 1]) + fabs(z) + fabs(a[m + 1][m + 1]));
+                        if (u <= DBL_EPSILON * v) break;
+                    }
+                    for (int i = m; i < nn - 1; i++) {
+                        a[i + 2][i] = 0.0;
+                        if (i != m) a[i + 2][i - 1] = 0.0;
+                    }
+                    for (int k = m; k < nn; k++) {
+                        if (k != m) {
+                            p = a[k][k - 1];
+                            q = a[k + 1][k - 1];
+                            r = 0.0;
+                            if (k + 1 != nn) r = a[k + 2][k - 1];
+                            if ((x = fabs(p) + fabs(q) + fabs(r)) != 0.0) {
+                                p /= x;
+                                q /= x;
+                                r /= x;
+                            }
+                        }
+                        s = sqrt(p * p + q * q + r * r);
+                        if (p < 0.0) s = -s;
+                        if (s != 0.0) {
+                            if (k == m) {
+                                if (l != m) a[k][k - 1] = -a[k][k - 1];
+                            } else {
+                                a[k][k - 1] = -s * x;
+                            }
+                            p += s;
+                            x = p / s;
+                            y = q / s;
+                            z = r / s;
+                            q /= p;
+                            r /= p;
+                            for (int j = k; j <= nn; j++) {
+                                p = a[k][j] + q * a[k + 1][j];
+                                if (k + 1 != nn) {
+                                    p += r * a[k + 2][j];
+                                    a[k + 2][j] -= p * z;
+                                }
+                                a[k + 1][j] -= p * y;
+                                a[k][j] -= p * x;
+                            }
+                            int mmin = nn < k + 3 ? nn : k + 3;
+                            for (int i = l; i <= mmin; i++) {
+                                p = x * a[i][k] + y * a[i][k + 1];
+                                if (k + 1 != nn) {
+                                    p += z * a[i][k + 2];
+                                    a[i][k + 2] -= p * r;
+                                }
+                                a[i][k + 1] -= p * q;
+                                a[i][k] -= p;
+                            }
+                        }
+                    }
+                }
+            }
+        } while (l + 1 < nn);
+    }
+    return 0;
+}
+
+static int eig_real(double a[FIT_ORDER][FIT_ORDER], double *wr, double *wi) {
+    eig_balance(a, FIT_ORDER);
+    eig_hessenberg(a, FIT_ORDER);
+    return eig_hqr(a, FIT_ORDER, wr, wi);
+}
+
+// ============ 最小二乘（列归一化的Householder QR） ============
+// a为m×n行主序矩阵，a和b被破坏
+static int least_squares(double *a, double *b, int m, int n, double *x) {
+    double scale[2 * FIT_ORDER + 1];
+    for (int j = 0; j < n; j++) {
+        double norm = 0.0;
+        for (int i = 0; i < m; i++) norm += a[i * n + j] * a[i * n + j];
+        norm = sqrt(norm);
+        scale[j] = norm > 0.0 ? 1.0 / norm : 1.0;
+        for (int i = 0; i < m; i++) a[i * n + j] *= scale[j];
+    }
+
+    double diag[2 * FIT_ORDER + 1];
+    for (int k = 0; k < n; k++) {
+        double norm = 0.0;
+        for (int i = k; i < m; i++) norm += a[i * n + k] * a[i * n + k];
+        norm = sqrt(norm);
+        if (norm < 1e-13) {
+            return -1;
+        }
+        double alpha = a[k * n + k] > 0.0 ? -norm : norm;
+        // v = x - alpha·e1，存回第k列
+        a[k * n + k] -= alpha;
+        double vnorm2 = 0.0;
+        for (int i = k; i < m; i++) vnorm2 += a[i * n + k] * a[i * n + k];
+        for (int j = k + 1; j < n; j++) {
+            double dot = 0.0;
+            for (int i = k; i < m; i++) dot += a[i * n + k] * a[i * n + j];
+            double f = 2.0 * dot / vnorm2;
+            for (int i = k; i < m; i++) a[i * n + j] -= f * a[i * n + k];
+        }
+        double dot = 0.0;
+        for (int i = k; i < m; i++) dot += a[i * n + k] * b[i];
+        double f = 2.0 * dot / vnorm2;
+        for (int i = k; i < m; i++) b[i] -= f * a[i * n + k];
+        diag[k] = alpha;
+    }
+
+    for (int k = n - 1; k >= 0; k--) {
+        double sum = b[k];
+        for (int j = k + 1; j < n; j++) sum -= a[k * n + j] * x[j];
+        x[k] = sum / diag[k];
+    }
+    for (int j = 0; j < n; j++) x[j] *= scale[j];
+    return 0;
+}
+
+// ============ 特征值转极点/二阶节 ============
+// 取上半平面与实轴上的特征值；stable=1时右半平面极点镜像到左半平面
+static void roots_to_poles(const double *wr, const double *wi, int stable, PoleSet *poles) {
+    poles->count = 0;
+    for (int i = 0; i < FIT_ORDER; i++) {
+        if (wi[i] < 0.0) continue;
+        poles->re[poles->count] = (stable && wr[i] > 0.0) ? -wr[i] : wr[i];
+        poles->im[poles->count] = wi[i];
+        poles->count++;
+    }
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_section(const void *a, const void *b) {
+    return compare_double(&((const SecondOrder *)a)->w, &((const SecondOrder *)b)->w);
+}
+
+// 共轭对各成一节，实根排序后相邻两两成节；右半平面根取镜像（幅频不变）
+static int roots_to_sections(const double *wr, const double *wi, SecondOrder *sec) {
+    const double tiny = 1e-9;
+    double real_roots[FIT_ORDER];
+    int num_real = 0, num_sec = 0;
+    for (int i = 0; i < FIT_ORDER; i++) {
+        if (wi[i] > 0.0) {
+            double w = hypot(wr[i], wi[i]);
+            sec[num_sec].w = w;
+            sec[num_sec].q = w / fmax(2.0 * fabs(wr[i]), tiny * w);
+            num_sec++;
+        } else if (wi[i] == 0.0) {
+            real_roots[num_real++] = wr[i];
+        }
+    }
+    if (num_real % 2 != 0) {
+        return -1;
+    }
+    qsort(real_roots, num_real, sizeof(double), compare_double);
+    for (int i = 0; i < num_real; i += 2) {
+        double r1 = fmax(fabs(real_roots[i]), tiny);
+        double r2 = fmax(fabs(real_roots[i + 1]), tiny);
+        sec[num_sec].w = sqrt(r1 * r2);
+        sec[num_sec].q = sec[num_sec].w / (r1 + r2);
+        num_sec++;
+    }
+    qsort(sec, num_sec, sizeof(SecondOrder), compare_section);
+    return num_sec;
+}
+
+// ============ RBJ模拟原型 ============
+// 预畸变频率 Ω = tan(ω/2)；RBJ EQ即模拟原型在 s = (1-z^-1)/(1+z^-1) 下的双线性变换
+static double fc_to_prewarp(float fc) {
+    return tan(M_PI * fc / REALTIME_SAMPLE_RATE);
+}
+
+static float prewarp_to_fc(double omega) {
+    return (float)(atan(omega) * REALTIME_SAMPLE_RATE / M_PI);
+}
+
+static double complex prototype_response(const BiquadParam *param, double omega) {
+    const double A = pow(10.0, param->gain_dB / 40.0);
+    const double sa = sqrt(A);
+    const double q = param->q;
+    const double complex s = I * omega / fc_to_prewarp(param->fc);
+    const double complex s2 = s * s;
+    switch (param->type) {
+    case BIQUAD_LOWSHELF:
+        return A * (s2 + (sa / q) * s + A) / (A * s2 + (sa / q) * s + 1.0);
+    case BIQUAD_HIGHSHELF:
+        return A * (A * s2 + (sa / q) * s + 1.0) / (s2 + (sa / q) * s + A);
+    case BIQUAD_PEAKING:
+    default:
+        return (s2 + (A / q) * s + 1.0) / (s2 + s / (A * q) + 1.0);
+    }
+}
+
+// 极点节与零点节配对：peaking要求ωp = ωz，shelf要求Qp = Qz且ωz/ωp不超过增益上限对应的A，
+// 代价取两者较小者，全局贪心取最小代价对（相消的极零点对代价为0，自然配在一起）
+static double pairing_cost(const SecondOrder *pole, const SecondOrder *zero) {
+    const double max_ln_a = log(10.0) * MAX_GAIN_DB / 40.0;
+    double dw = fabs(log(zero->w / pole->w));
+    double dq = fabs(log(zero->q / pole->q));
+    double shelf = dq + (dw > max_ln_a ? dw - max_ln_a : 0.0);
+    return dw < shelf ? dw : shelf;
+}
+
+static void pair_sections(const SecondOrder *pole, SecondOrder *zero) {
+    SecondOrder sorted[NUM_BIQUADS];
+    int pole_used[NUM_BIQUADS] = {0}, zero_used[NUM_BIQUADS] = {0};
+    for (int n = 0; n < NUM_BIQUADS; n++) {
+        int bi = 0, bj = 0;
+        double best = INFINITY;
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            if (pole_used[i]) continue;
+            for (int j = 0; j < NUM_BIQUADS; j++) {
+                if (zero_used[j]) continue;
+                double cost = pairing_cost(&pole[i], &zero[j]);
+                if (cost < best) {
+                    best = cost;
+                    bi = i;
+                    bj = j;
+                }
+            }
+        }
+        pole_used[bi] = zero_used[bj] = 1;
+        sorted[bi] = zero[bj];
+    }
+    memcpy(zero, sorted, sizeof(sorted));
+}
+
+static float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// 二阶节（分子zero、分母pole，预畸变频率）映射到指定类型的EQ参数并限幅
+// fc限制在[fc_lo, fc_hi]（拟合数据覆盖的频段）：频段外的节不受数据约束，留在原处会在频段外
+// 形成任意大的峰/搁架，移到频段边缘后由类型选择和总增益按拟合误差重新权衡
+static BiquadParam section_to_param(BiquadType type, const SecondOrder *pole, const SecondOrder *zero,
+                                    float fc_lo, float fc_hi) {
+    BiquadParam param;
+    param.type = type;
+    double ratio;
+    switch (type) {
+    case BIQUAD_LOWSHELF:  ratio = zero->w / pole->w; break;           // A
+    case BIQUAD_HIGHSHELF: ratio = pole->w / zero->w; break;           // A
+    case BIQUAD_PEAKING:
+    default:               ratio = sqrt(pole->q / zero->q); break;     // A
+    }
+    param.gain_dB = clampf((float)(40.0 * log10(ratio)), MIN_GAIN_DB, MAX_GAIN_DB);
+    param.q = clampf((float)sqrt(pole->q * zero->q), MIN_Q, MAX_Q);
+    param.fc = clampf(prewarp_to_fc(sqrt(pole->w * zero->w)), fc_lo, fc_hi);
+    return param;
+}
+
+// ============ 直接拟合 ============
+// 拟合数据与最小二乘工作区
+typedef struct {
+    int K;
+    double band_lo, band_hi;    // 拟合数据频段两端的预畸变频率
+    double *omega;              // 预畸变频率Ω（升序：网格下方、网格、网格上方）
+    double *weight;             // sqrt(权重)
+    double complex *s;          // jΩ/ref
+    double complex *target;
+    double *a;                  // 2K × (2N+1)
+    double *rhs;                // 2K
+} FitData;
+
+static int fit_model(const FitData *fd, int iterations,
+                     BiquadParam params[NUM_BIQUADS], float *total_gain_dB) {
+    const int K = fd->K;
+    const int N = FIT_ORDER;
+    const double *omega = fd->omega, *weight = fd->weight;
+    const double complex *target = fd->target;
+    double *a = fd->a, *rhs = fd->rhs;
+    double complex *s = fd->s;
+
+    // 按拟合频段的几何中心归一化改善条件数
+    const double ref = sqrt(fd->band_lo * fd->band_hi);
+    if (!(ref > 0.0)) {
+        return -1;
+    }
+    for (int k = 0; k < K; k++) {
+        s[k] = I * omega[k] / ref;
+    }
+
+    // 初始极点：拟合频段内对数分布的弱阻尼共轭对
+    PoleSet poles;
+    poles.count = N / 2;
+    const double lo = fd->band_lo / ref, hi = fd->band_hi / ref;
+    for (int n = 0; n < N / 2; n++) {
+        double beta = lo * pow(hi / lo, (double)n / (N / 2 - 1));
+        poles.re[n] = -beta / 100.0;
+        poles.im[n] = beta;
+    }
+
+    double x[2 * FIT_ORDER + 1];
+    double complex phi[FIT_ORDER];
+    double mat[FIT_ORDER][FIT_ORDER];
+    double wr[FIT_ORDER], wi[FIT_ORDER];
+
+    // 极点重定位: min Σ w|N(s) - σ(s)T(s)|²，新极点为σ的零点
+    const int cols_sigma = 2 * N + 1;
+    for (int it = 0; it < iterations; it++) {
+        for (int k = 0; k < K; k++) {
+            fill_basis(s[k], &poles, phi);
+            double *row_re = &a[(2 * k) * cols_sigma];
+            double *row_im = &a[(2 * k + 1) * cols_sigma];
+            for (int j = 0; j < N; j++) {
+                double complex u = weight[k] * phi[j];
+                double complex v = -weight[k] * target[k] * phi[j];
+                row_re[j] = creal(u);
+                row_im[j] = cimag(u);
+                row_re[N + 1 + j] = creal(v);
+                row_im[N + 1 + j] = cimag(v);
+            }
+            row_re[N] = weight[k];
+            row_im[N] = 0.0;
+            rhs[2 * k] = weight[k] * creal(target[k]);
+            rhs[2 * k + 1] = weight[k] * cimag(target[k]);
+        }
+        if (least_squares(a, rhs, 2 * K, cols_sigma, x) != 0) {
+            return -1;
+        }
+        residue_matrix(&poles, &x[N + 1], 1.0, mat);
+        if (eig_real(mat, wr, wi) != 0) {
+            return -1;
+        }
+        roots_to_poles(wr, wi, 1, &poles);
+    }
+
+    // 固定极点求留数: min Σ w|N(s) - T(s)|²
+    const int cols = N + 1;
+    for (int k = 0; k < K; k++) {
+        fill_basis(s[k], &poles, phi);
+        double *row_re = &a[(2 * k) * cols];
+        double *row_im = &a[(2 * k + 1) * cols];
+        for (int j = 0; j < N; j++) {
+            row_re[j] = weight[k] * creal(phi[j]);
+            row_im[j] = weight[k] * cimag(phi[j]);
+        }
+        row_re[N] = weight[k];
+        row_im[N] = 0.0;
+        rhs[2 * k] = weight[k] * creal(target[k]);
+        rhs[2 * k + 1] = weight[k] * cimag(target[k]);
+    }
+    if (least_squares(a, rhs, 2 * K, cols, x) != 0) {
+        return -1;
+    }
+    const double d = x[N];
+    if (!(fabs(d) > 1e-12)) {
+        return -1;
+    }
+
+    // 零点 = eig(A - b·cᵀ/d)
+    SecondOrder pole_sec[NUM_BIQUADS], zero_sec[NUM_BIQUADS];
+    {
+        double pr[FIT_ORDER], pi[FIT_ORDER];
+        int col = 0;
+        for (int n = 0; n < poles.count; n++) {
+            pr[col] = poles.re[n];
+            pi[col++] = poles.im[n];
+            if (poles.im[n] > 0.0) {
+                pr[col] = poles.re[n];
+                pi[col++] = -poles.im[n];
+            }
+        }
+        if (roots_to_sections(pr, pi, pole_sec) != NUM_BIQUADS) {
+            return -1;
+        }
+    }
+    residue_matrix(&poles, x, 1.0 / d, mat);
+    if (eig_real(mat, wr, wi) != 0 || roots_to_sections(wr, wi, zero_sec) != NUM_BIQUADS) {
+        return -1;
+    }
+
+    pair_sections(pole_sec, zero_sec);
+
+    // 逐节选择最接近的EQ类型：与原二阶节频响在最优实比例g下的加权误差最小
+    // lowshelf(-G)与highshelf(+G)只差一个常数比例，误差相当的候选中取使累计比例（即所需总增益
+    // ≈ d·Πg）最接近0 dB者，避免总增益越限
+    double log_scale = log(fabs(d));
+    const float fc_lo = clampf(prewarp_to_fc(fd->band_lo), MIN_FC, MAX_FC);
+    const float fc_hi = clampf(prewarp_to_fc(fd->band_hi), MIN_FC, MAX_FC);
+    for (int i = 0; i < NUM_BIQUADS; i++) {
+        pole_sec[i].w *= ref;
+        zero_sec[i].w *= ref;
+        BiquadParam cand[3];
+        double err[3], scale[3], best_err = INFINITY;
+        for (int type = BIQUAD_LOWSHELF; type <= BIQUAD_HIGHSHELF; type++) {
+            cand[type] = section_to_param((BiquadType)type, &pole_sec[i], &zero_sec[i], fc_lo, fc_hi);
+            double num = 0.0, den = 0.0, energy = 0.0;
+            for (int k = 0; k < K; k++) {
+                double complex sk = I * omega[k];
+                double complex raw = (sk * sk + (zero_sec[i].w / zero_sec[i].q) * sk + zero_sec[i].w * zero_sec[i].w) /
+                                     (sk * sk + (pole_sec[i].w / pole_sec[i].q) * sk + pole_sec[i].w * pole_sec[i].w);
+                double complex h = prototype_response(&cand[type], omega[k]);
+                double w2 = weight[k] * weight[k];
+                num += w2 * creal(conj(h) * raw);
+                den += w2 * creal(conj(h) * h);
+                energy += w2 * creal(conj(raw) * raw);
+            }
+            err[type] = den > 0.0 ? energy - num * num / den : INFINITY;
+            scale[type] = (den > 0.0 && num != 0.0) ? log(fabs(num / den)) : 0.0;
+            if (err[type] < best_err) best_err = err[type];
+        }
+        int pick = -1;
+        for (int type = BIQUAD_LOWSHELF; type <= BIQUAD_HIGHSHELF; type++) {
+            if (!(err[type] <= 1.1 * best_err + 1e-12)) continue;
+            if (pick < 0 || fabs(log_scale + scale[type]) < fabs(log_scale + scale[pick])) {
+                pick = type;
+            }
+        }
+        if (pick < 0) {
+            return -1;
+        }
+        params[i] = cand[pick];
+        log_scale += scale[pick];
+    }
+
+    // 总增益: g = Re(Σ w·conj(H)·T) / Σ w|H|²
+    double num = 0.0, den = 0.0;
+    for (int k = 0; k < K; k++) {
+        double complex h = 1.0;
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            h *= prototype_response(&params[i], omega[k]);
+        }
+        double w2 = weight[k] * weight[k];
+        num += w2 * creal(conj(h) * target[k]);
+        den += w2 * creal(conj(h) * h);
+    }
+    double gain_dB = (num > 0.0 && den > 0.0) ? 20.0 * log10(num / den) : MIN_TOTAL_GAIN_DB;
+    if (!isfinite(gain_dB)) {
+        return -1;
+    }
+    *total_gain_dB = clampf((float)gain_dB, MIN_TOTAL_GAIN_DB, MAX_TOTAL_GAIN_DB);
+
+    // fc升序排列
+    for (int i = 1; i < NUM_BIQUADS; i++) {
+        BiquadParam key = params[i];
+        int j = i - 1;
+        while (j >= 0 && params[j].fc > key.fc) {
+            params[j + 1] = params[j];
+            j--;
+        }
+        params[j + 1] = key;
+    }
+    return 0;
+}
+
+// 频点的预畸变频率: z^-1 = e^(-jω) → Ω = tan(ω/2)
+static double bin_prewarp(float z_re, float z_im) {
+    return tan(0.5 * atan2(-z_im, z_re));
+}
+
+// 网格之外的频点：Ω须为有限正值（排除直流与Nyquist频点）
+static int bin_usable(const AnalysisBins *bins, int k) {
+    double omega = bin_prewarp(bins->z_re[k], bins->z_im[k]);
+    return omega > 0.0 && omega < FIT_MAX_PREWARP;
+}
+
+int eq_fit_grid(const EvalGrid *grid, const AnalysisBins *bins, const FreqResponse *target,
+                float out_of_band_weight, int iterations, BiquadParam params[NUM_BIQUADS],
+                float *total_gain_dB) {
+    const int G = grid->num_bins;
+    if (G < 2 || 2 * G < 2 * FIT_ORDER + 1) {
+        return -1;
+    }
+
+    // 网格之外的分析频点
+    const int first = grid->bins[0], last = grid->bins[G - 1];
+    int extra = 0;
+    if (out_of_band_weight > 0.0f) {
+        for (int k = 0; k < bins->num_bins; k++) {
+            if ((k < first || k > last) && bin_usable(bins, k)) extra++;
+        }
+    }
+    const int K = G + extra;
+
+    FitData fd;
+    fd.K = K;
+    fd.omega = (double *)malloc(K * sizeof(double));
+    fd.weight = (double *)malloc(K * sizeof(double));
+    fd.s = (double complex *)malloc(K * sizeof(double complex));
+    fd.target = (double complex *)malloc(K * sizeof(double complex));
+    fd.a = (double *)malloc((size_t)2 * K * (2 * FIT_ORDER + 1) * sizeof(double));
+    fd.rhs = (double *)malloc((size_t)2 * K * sizeof(double));
+
+    int result = -1;
+    if (fd.omega && fd.weight && fd.s && fd.target && fd.a && fd.rhs) {
+        const double oob_weight = sqrt((double)out_of_band_weight);
+        int n = 0;
+        for (int k = 0; extra > 0 && k < first; k++) {
+            if (!bin_usable(bins, k)) continue;
+            fd.omega[n] = bin_prewarp(bins->z_re[k], bins->z_im[k]);
+            fd.weight[n] = oob_weight;
+            fd.target[n] = target->re[k] + I * target->im[k];
+            n++;
+        }
+        for (int k = 0; k < G; k++, n++) {
+            fd.omega[n] = bin_prewarp(grid->z1_re[k], grid->z1_im[k]);
+            fd.weight[n] = sqrt(grid->weights[k]);
+            fd.target[n] = grid->target_re[k] + I * grid->target_im[k];
+        }
+        for (int k = last + 1; extra > 0 && k < bins->num_bins; k++) {
+            if (!bin_usable(bins, k)) continue;
+            fd.omega[n] = bin_prewarp(bins->z_re[k], bins->z_im[k]);
+            fd.weight[n] = oob_weight;
+            fd.target[n] = target->re[k] + I * target->im[k];
+            n++;
+        }
+        // 极点初值与fc限幅覆盖全部拟合数据所在的频段
+        fd.band_lo = fd.omega[0];
+        fd.band_hi = fd.omega[K - 1];
+        result = fit_model(&fd, iterations, params, total_gain_dB);
+    }
+
+    free(fd.omega);
+    free(fd.weight);
+    free(fd.s);
+    free(fd.target);
+    free(fd.a);
+    free(fd.rhs);
+    return result;
+}
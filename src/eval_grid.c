@@ -0,0 +1,202 @@
+#include "../inc/eval_grid.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <string.h>
+
+// 频点索引对应的频率
+float eval_grid_bin_freq(const AnalysisBins *bins, int bin) {
+    return bins->freq[bin];
+}
+
+// 频段内全部频点，等权
+static void build_band_grid(EvalGrid *grid, int bin_low, int bin_high) {
+    for (int bin = bin_low; bin <= bin_high; bin++) {
+        grid->bins[grid->num_bins] = bin;
+        grid->weights[grid->num_bins] = 1.0f;
+        grid->num_bins++;
+    }
+}
+
+// 频段内对数间隔频点
+// 权重 = 该点代表的全网格频点数（相邻网格点中点之间的区间宽度），
+// 使加权和近似于频段内全部频点的求和
+static void build_log_grid(EvalGrid *grid, const AnalysisBins *bins, int bin_low, int bin_high,
+                           int num_points) {
+    float f_low = eval_grid_bin_freq(bins, bin_low);
+    float f_high = eval_grid_bin_freq(bins, bin_high);
+    float ratio = f_high / f_low;
+
+    for (int j = 0; j < num_points; j++) {
+        float freq = f_low * powf(ratio, (float)j / (num_points - 1));
+        int bin = analysis_bins_nearest(bins, freq);
+        if (bin < bin_low) bin = bin_low;
+        if (bin > bin_high) bin = bin_high;
+
+        // 低频段对数间隔小于频点间隔，去重
+        if (grid->num_bins > 0 && bin <= grid->bins[grid->num_bins - 1]) {
+            continue;
+        }
+        grid->bins[grid->num_bins++] = bin;
+    }
+
+    for (int i = 0; i < grid->num_bins; i++) {
+        float lower = (i == 0) ? (bin_low - 0.5f)
+                               : 0.5f * (grid->bins[i - 1] + grid->bins[i]);
+        float upper = (i == grid->num_bins - 1) ? (bin_high + 0.5f)
+                                                : 0.5f * (grid->bins[i] + grid->bins[i + 1]);
+        grid->weights[i] = upper - lower;
+    }
+}
+
+// 初始化评估网格
+int eval_grid_init(EvalGrid *grid, const AnalysisBins *bins, EvalGridMode mode,
+                   float freq_low, float freq_high, int num_points) {
+    grid->mode = mode;
+    grid->num_bins = 0;
+    grid->weight_sum = 0.0f;
+    memset(grid->weights, 0, sizeof(grid->weights));
+    memset(grid->target_re, 0, sizeof(grid->target_re));
+    memset(grid->target_im, 0, sizeof(grid->target_im));
+    memset(grid->resp_re, 0, sizeof(grid->resp_re));
+    memset(grid->resp_im, 0, sizeof(grid->resp_im));
+    memset(grid->z1_re, 0, sizeof(grid->z1_re));
+    memset(grid->z1_im, 0, sizeof(grid->z1_im));
+    memset(grid->z2_re, 0, sizeof(grid->z2_re));
+    memset(grid->z2_im, 0, sizeof(grid->z2_im));
+
+    int bin_low = 0;
+    int bin_high = bins->num_bins - 1;
+
+    if (mode != EVAL_GRID_FULL) {
+        bin_low = analysis_bins_nearest(bins, freq_low);
+        bin_high = analysis_bins_nearest(bins, freq_high);
+
+        if (bin_high <= bin_low) {
+            log_printf("Warning: Invalid eval grid band [%.1f, %.1f] Hz, using full grid\n",
+                       freq_low, freq_high);
+            mode = EVAL_GRID_FULL;
+            grid->mode = mode;
+            bin_low = 0;
+            bin_high = bins->num_bins - 1;
+        }
+    }
+
+    if (mode == EVAL_GRID_LOG && bins->freq[bin_low] <= 0.0f) {
+        bin_low = 1;  // 对数网格不包含DC
+    }
+
+    if (mode == EVAL_GRID_LOG && num_points >= 2) {
+        build_log_grid(grid, bins, bin_low, bin_high, num_points);
+    } else {
+        build_band_grid(grid, bin_low, bin_high);
+    }
+
+    for (int i = 0; i < grid->num_bins; i++) {
+        grid->weight_sum += grid->weights[i];
+    }
+    
+    // 补齐到4的倍数，补齐部分权重为0，不影响加权loss
+    grid->padded_bins = (grid->num_bins + 3) & ~3;
+    
+    // z^-1 = e^(-jω)取自分析频点表；补齐部分保持为0（频响为b0，有限值）
+    for (int i = 0; i < grid->num_bins; i++) {
+        float re = bins->z_re[grid->bins[i]];
+        float im = bins->z_im[grid->bins[i]];
+        grid->z1_re[i] = re;
+        grid->z1_im[i] = im;
+        grid->z2_re[i] = re * re - im * im;
+        grid->z2_im[i] = 2.0f * re * im;
+    }
+
+    const char *mode_name = (grid->mode == EVAL_GRID_FULL) ? "full" :
+                            (grid->mode == EVAL_GRID_BAND) ? "band" : "log";
+    log_printf("Eval grid: %s, %d bins (%.1f - %.1f Hz), %.1fx fewer than full grid\n",
+               mode_name, grid->num_bins,
+               eval_grid_bin_freq(bins, grid->bins[0]),
+               eval_grid_bin_freq(bins, grid->bins[grid->num_bins - 1]),
+               (float)bins->num_bins / grid->num_bins);
+
+    return grid->num_bins;
+}
+
+// 单级在网格频点上的频响: (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+static void stage_response(const EvalGrid *grid, const BiquadCoeffs *c, float *out_re, float *out_im) {
+    const float b0 = c->b0, b1 = c->b1, b2 = c->b2, a1 = c->a1, a2 = c->a2;
+    for (int i = 0; i < grid->padded_bins; i++) {
+        float num_re = b0 + b1 * grid->z1_re[i] + b2 * grid->z2_re[i];
+        float num_im = b1 * grid->z1_im[i] + b2 * grid->z2_im[i];
+        float den_re = 1.0f + a1 * grid->z1_re[i] + a2 * grid->z2_re[i];
+        float den_im = a1 * grid->z1_im[i] + a2 * grid->z2_im[i];
+        float inv = 1.0f / (den_re * den_re + den_im * den_im);
+        out_re[i] = (num_re * den_re + num_im * den_im) * inv;
+        out_im[i] = (num_im * den_re - num_re * den_im) * inv;
+    }
+}
+
+// resp = a × b × gain
+static void product_scaled(const EvalGrid *grid, const float *a_re, const float *a_im,
+                           const float *b_re, const float *b_im, float gain,
+                           float *out_re, float *out_im) {
+    for (int i = 0; i < grid->padded_bins; i++) {
+        float re = a_re[i] * b_re[i] - a_im[i] * b_im[i];
+        float im = a_re[i] * b_im[i] + a_im[i] * b_re[i];
+        out_re[i] = re * gain;
+        out_im[i] = im * gain;
+    }
+}
+
+// 计算并缓存各级频响
+void eval_grid_load_filter(EvalGrid *grid, const FeedforwardFilter *filter) {
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        stage_response(grid, &filter->coeffs[stage], grid->stage_re[stage], grid->stage_im[stage]);
+    }
+}
+
+// 开始试探第stage级
+void eval_grid_begin_stage(EvalGrid *grid, int stage, float total_gain) {
+    for (int i = 0; i < grid->padded_bins; i++) {
+        grid->rest_re[i] = 1.0f;
+        grid->rest_im[i] = 0.0f;
+    }
+    for (int s = 0; s < NUM_BIQUADS; s++) {
+        if (s == stage) continue;
+        product_scaled(grid, grid->rest_re, grid->rest_im, grid->stage_re[s], grid->stage_im[s],
+                       1.0f, grid->rest_re, grid->rest_im);
+    }
+    
+    if (stage < 0) {
+        eval_grid_trial_gain(grid, total_gain);
+    } else {
+        product_scaled(grid, grid->rest_re, grid->rest_im, grid->stage_re[stage],
+                       grid->stage_im[stage], total_gain, grid->resp_re, grid->resp_im);
+    }
+}
+
+// 试探单级系数
+void eval_grid_trial_stage(EvalGrid *grid, const BiquadCoeffs *coeffs, float total_gain) {
+    stage_response(grid, coeffs, grid->trial_re, grid->trial_im);
+    product_scaled(grid, grid->rest_re, grid->rest_im, grid->trial_re, grid->trial_im,
+                   total_gain, grid->resp_re, grid->resp_im);
+}
+
+// 试探总增益
+void eval_grid_trial_gain(EvalGrid *grid, float total_gain) {
+    for (int i = 0; i < grid->padded_bins; i++) {
+        grid->resp_re[i] = grid->rest_re[i] * total_gain;
+        grid->resp_im[i] = grid->rest_im[i] * total_gain;
+    }
+}
+
+// 接受最近一次试探
+void eval_grid_commit_stage(EvalGrid *grid, int stage) {
+    memcpy(grid->stage_re[stage], grid->trial_re, sizeof(grid->trial_re));
+    memcpy(grid->stage_im[stage], grid->trial_im, sizeof(grid->trial_im));
+}
+
+// 收集目标频响到网格紧凑数组
+void eval_grid_load_target(EvalGrid *grid, const FreqResponse *target) {
+    for (int i = 0; i < grid->num_bins; i++) {
+        grid->target_re[i] = target->re[grid->bins[i]];
+        grid->target_im[i] = target->im[grid->bins[i]];
+    }
+}
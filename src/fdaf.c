@@ -0,0 +1,274 @@
+#include "../inc/fdaf.h"
+#include "../inc/spectrum.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 分区下标
+#define SP_AT(c, e, r, q)   (&(c)->sp[((e) * ANC_NUM_REF + (r)) * (c)->sp_partitions + (q)])
+#define X_AT(c, r, i)       (&(c)->x_line[(r) * (c)->depth + (i)])
+#define Y_AT(c, r, i)       (&(c)->y_line[(r) * (c)->sp_partitions + (i)])
+#define FX_AT(c, e, r, i)   (&(c)->fx_line[((e) * ANC_NUM_REF + (r)) * (c)->num_partitions + (i)])
+#define W_AT(c, r, p)       (&(c)->w[(r) * (c)->num_partitions + (p)])
+
+// 延迟线第lag个旧分区的位置
+static inline int line_index(int head, int lag, int depth) {
+    int i = head - lag;
+    return i < 0 ? i + depth : i;
+}
+
+// 读取信号 [begin, begin + len)，信号范围外为0
+static void load_range(float *dst, const float *src, long long begin, int len, int total) {
+    for (int i = 0; i < len; i++) {
+        long long t = begin + i;
+        dst[i] = (t >= 0 && t < total) ? src[t] : 0.0f;
+    }
+}
+
+static FreqResponse *alloc_spectra(int count) {
+    FreqResponse *x = (FreqResponse *)anc_aligned_alloc((size_t)count * sizeof(FreqResponse));
+    if (x) {
+        memset(x, 0, (size_t)count * sizeof(FreqResponse));
+    }
+    return x;
+}
+
+// ============ 初始化 ============
+int fdaf_init(FdafController *ctrl, const FdafParams *params, const TimeDomainSimulator *sim) {
+    memset(ctrl, 0, sizeof(FdafController));
+    const int B = params->block_size;
+    if (fft_init(&ctrl->plan, 2 * B) != 0) {
+        log_printf("Error: FDAF block size %d needs 2B to be a power of 2 <= %d\n", B, FFT_LENGTH);
+        return -1;
+    }
+    ctrl->block = B;
+    ctrl->num_partitions = params->num_partitions;
+    ctrl->bins = B + 1;
+    ctrl->mu = params->mu;
+    ctrl->power_alpha = params->power_alpha;
+    ctrl->epsilon = params->epsilon;
+
+    const FIRFilter *fir = &sim->secondary_path_fir[0][0];
+    const int span = fir->delay + fir->length;
+    ctrl->sp_partitions = (span + B - 1) / B;
+    ctrl->depth = ctrl->num_partitions > ctrl->sp_partitions ? ctrl->num_partitions : ctrl->sp_partitions;
+
+    const int P = ctrl->num_partitions, Q = ctrl->sp_partitions;
+    ctrl->sp = alloc_spectra(ANC_NUM_ERR * ANC_NUM_REF * Q);
+    ctrl->x_line = alloc_spectra(ANC_NUM_REF * ctrl->depth);
+    ctrl->y_line = alloc_spectra(ANC_NUM_REF * Q);
+    ctrl->fx_line = alloc_spectra(ANC_NUM_ERR * ANC_NUM_REF * P);
+    ctrl->w = alloc_spectra(ANC_NUM_REF * P);
+    ctrl->power = (float *)anc_aligned_alloc(ANC_NUM_REF * SPECTRUM_LENGTH * sizeof(float));
+    ctrl->step = (float *)anc_aligned_alloc(SPECTRUM_LENGTH * sizeof(float));
+    ctrl->y_prev = (float *)calloc((size_t)ANC_NUM_REF * B, sizeof(float));
+    ctrl->fx_prev = (float *)calloc((size_t)ANC_NUM_ERR * ANC_NUM_REF * B, sizeof(float));
+    float *frame = (float *)calloc(2 * B, sizeof(float));
+    if (!ctrl->sp || !ctrl->x_line || !ctrl->y_line || !ctrl->fx_line || !ctrl->w ||
+        !ctrl->power || !ctrl->step || !ctrl->y_prev || !ctrl->fx_prev || !frame) {
+        log_printf("Error: Failed to allocate FDAF controller\n");
+        free(frame);
+        fdaf_free(ctrl);
+        return -1;
+    }
+    memset(ctrl->power, 0, ANC_NUM_REF * SPECTRUM_LENGTH * sizeof(float));
+    memset(ctrl->step, 0, SPECTRUM_LENGTH * sizeof(float));
+
+    // 次级路径（含前导延迟）按B分区，各分区补零到2B后FFT
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            const FIRFilter *path = &sim->secondary_path_fir[e][r];
+            for (int q = 0; q < Q; q++) {
+                memset(frame, 0, 2 * B * sizeof(float));
+                for (int i = 0; i < B; i++) {
+                    int k = q * B + i - path->delay;
+                    if (k >= 0 && k < path->length) {
+                        frame[i] = path->coeffs[k];
+                    }
+                }
+                fft_real(&ctrl->plan, frame, NULL, SP_AT(ctrl, e, r, q));
+            }
+        }
+    }
+    free(frame);
+
+    log_printf("FDAF controller: %d x %d taps x %d ref (%d-point FFT), mu %g, power alpha %g, "
+               "epsilon %g, SP estimate %d partitions\n",
+               P, B, ANC_NUM_REF, 2 * B, ctrl->mu, ctrl->power_alpha, ctrl->epsilon, Q);
+    return 0;
+}
+
+// ============ 处理一块 [t0, t0 + B) ============
+static void fdaf_block(FdafController *ctrl, TimeDomainSimulator *sim, long long t0) {
+    const int B = ctrl->block;
+    const int N = 2 * B;
+    const int P = ctrl->num_partitions, Q = ctrl->sp_partitions;
+    const int bins = ctrl->bins;
+    const int total = sim->total_samples;
+
+    float frame[FFT_LENGTH];
+    float out[FFT_LENGTH];
+    float err[ANC_NUM_ERR][FFT_LENGTH / 2];
+    FreqResponse acc;
+    FreqResponse err_spec[ANC_NUM_ERR];
+
+    const int head = ctrl->head;
+    const int y_head = (int)(ctrl->blocks % Q);
+    const int fx_head = (int)(ctrl->blocks % P);
+
+    // 1. 参考麦频谱入延迟线
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        load_range(frame, sim->original_ff[r], t0 - B, N, total);
+        fft_real(&ctrl->plan, frame, NULL, X_AT(ctrl, r, head));
+    }
+
+    // 2. 控制器输出 y = IFFT(Σ_p W_p X_{k-p}) 后B个样本；驱动信号频谱入延迟线
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        spectrum_clear(&acc);
+        for (int p = 0; p < P; p++) {
+            spectrum_mul_accumulate(&acc, W_AT(ctrl, r, p), X_AT(ctrl, r, line_index(head, p, ctrl->depth)),
+                                    bins);
+        }
+        fft_real_inverse(&ctrl->plan, &acc, out);
+
+        float *y_prev = &ctrl->y_prev[r * B];
+        memcpy(frame, y_prev, B * sizeof(float));
+        memcpy(&frame[B], &out[B], B * sizeof(float));
+        memcpy(y_prev, &out[B], B * sizeof(float));
+        fft_real(&ctrl->plan, frame, NULL, Y_AT(ctrl, r, y_head));
+    }
+
+    // 3. 经次级路径到达误差麦: e = d - IFFT(Σ_r Σ_q S_q Y_{k-q}) 后B个样本
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        spectrum_clear(&acc);
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            for (int q = 0; q < Q; q++) {
+                spectrum_mul_accumulate(&acc, SP_AT(ctrl, e, r, q),
+                                        Y_AT(ctrl, r, line_index(y_head, q, Q)), bins);
+            }
+        }
+        fft_real_inverse(&ctrl->plan, &acc, out);
+
+        load_range(err[e], sim->original_fb[e], t0, B, total);
+        for (int i = 0; i < B; i++) {
+            err[e][i] -= out[B + i];
+            if (t0 + i < total) {
+                sim->simulated_fb[e][t0 + i] = err[e][i];
+            }
+        }
+
+        memset(frame, 0, B * sizeof(float));
+        memcpy(&frame[B], err[e], B * sizeof(float));
+        fft_real(&ctrl->plan, frame, NULL, &err_spec[e]);
+    }
+
+    // 4. 滤波参考 x' = IFFT(Σ_q Ŝ_q X_{k-q}) 后B个样本，与上一块拼成2B点再FFT
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            spectrum_clear(&acc);
+            for (int q = 0; q < Q; q++) {
+                spectrum_mul_accumulate(&acc, SP_AT(ctrl, e, r, q),
+                                        X_AT(ctrl, r, line_index(head, q, ctrl->depth)), bins);
+            }
+            fft_real_inverse(&ctrl->plan, &acc, out);
+
+            float *fx_prev = &ctrl->fx_prev[(e * ANC_NUM_REF + r) * B];
+            memcpy(frame, fx_prev, B * sizeof(float));
+            memcpy(&frame[B], &out[B], B * sizeof(float));
+            memcpy(fx_prev, &out[B], B * sizeof(float));
+            fft_real(&ctrl->plan, frame, NULL, FX_AT(ctrl, e, r, fx_head));
+        }
+    }
+
+    // 5. 各频点归一化步长，更新全部分区
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        float *power = &ctrl->power[r * SPECTRUM_LENGTH];
+        const float alpha = ctrl->power_alpha;
+        double mean = 0.0;
+        for (int k = 0; k < bins; k++) {
+            float p = 0.0f;
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                const FreqResponse *fx = FX_AT(ctrl, e, r, fx_head);
+                p += fx->re[k] * fx->re[k] + fx->im[k] * fx->im[k];
+            }
+            power[k] = ctrl->blocks == 0 ? p : alpha * power[k] + (1.0f - alpha) * p;
+            mean += power[k];
+        }
+        // 正则项按平均功率缩放：仿真器采样率远高于信号带宽，空频点功率近0，绝对正则无法兼顾
+        // 分母乘P：P个分区共同承担误差，步长与分区数无关
+        const float floor = ctrl->epsilon * (float)(mean / bins);
+        for (int k = 0; k < bins; k++) {
+            float den = (floor + power[k]) * P;
+            ctrl->step[k] = den > 0.0f ? ctrl->mu / den : 0.0f;
+        }
+
+        for (int p = 0; p < P; p++) {
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                spectrum_conj_mul_accumulate(W_AT(ctrl, r, p), FX_AT(ctrl, e, r, line_index(fx_head, p, P)),
+                                             &err_spec[e], ctrl->step, bins);
+            }
+        }
+
+        // 6. 梯度约束（本块轮到的分区）：时域后B个抽头清零
+        FreqResponse *w = W_AT(ctrl, r, ctrl->constrain_next);
+        fft_real_inverse(&ctrl->plan, w, out);
+        memset(&out[B], 0, B * sizeof(float));
+        fft_real(&ctrl->plan, out, NULL, w);
+    }
+
+    ctrl->constrain_next = (ctrl->constrain_next + 1) % P;
+    ctrl->head = (head + 1) % ctrl->depth;
+    ctrl->blocks++;
+}
+
+// ============ 闭环处理 ============
+int fdaf_process(FdafController *ctrl, TimeDomainSimulator *sim, int num_samples) {
+    const int start = sim->current_sample;
+    if (start + num_samples > sim->total_samples) {
+        num_samples = sim->total_samples - start;
+    }
+    if (num_samples <= 0) {
+        return 0;
+    }
+
+    const long long end = (long long)start + num_samples;
+    while (ctrl->next_sample < end) {
+        fdaf_block(ctrl, sim, ctrl->next_sample);
+        ctrl->next_sample += ctrl->block;
+    }
+
+    sim->current_sample += num_samples;
+    return num_samples;
+}
+
+// ============ 系数范数 ============
+// Parseval: ||w||² = (|W_0|² + |W_{N/2}|² + 2Σ|W_k|²) / N
+float fdaf_weight_norm(const FdafController *ctrl) {
+    const int B = ctrl->block;
+    double sum = 0.0;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        for (int p = 0; p < ctrl->num_partitions; p++) {
+            const FreqResponse *w = &ctrl->w[r * ctrl->num_partitions + p];
+            for (int k = 0; k <= B; k++) {
+                double m = (double)w->re[k] * w->re[k] + (double)w->im[k] * w->im[k];
+                sum += (k == 0 || k == B) ? m : 2.0 * m;
+            }
+        }
+    }
+    return (float)sqrt(sum / (2.0 * B));
+}
+
+// ============ 释放 ============
+void fdaf_free(FdafController *ctrl) {
+    anc_aligned_free(ctrl->sp);
+    anc_aligned_free(ctrl->x_line);
+    anc_aligned_free(ctrl->y_line);
+    anc_aligned_free(ctrl->fx_line);
+    anc_aligned_free(ctrl->w);
+    anc_aligned_free(ctrl->power);
+    anc_aligned_free(ctrl->step);
+    free(ctrl->y_prev);
+    free(ctrl->fx_prev);
+    memset(ctrl, 0, sizeof(FdafController));
+}
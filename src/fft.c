@@ -0,0 +1,343 @@
+#include "../inc/fft.h"
+#include "../inc/dsp_tables.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ============ 初始化FFT计划 ============
+int fft_init(FFTPlan *plan, int length) {
+    if (length < 4 || length > FFT_LENGTH || (length & (length - 1)) != 0) {
+        log_printf("Error: Unsupported FFT length %d (power of 2, 4 - %d)\n", length, FFT_LENGTH);
+        return -1;
+    }
+
+    memset(plan, 0, sizeof(FFTPlan));
+    plan->length = length;
+    plan->half = length / 2;
+
+    // 定长直接使用生成的静态表
+    plan->fixed = (length == FFT_LENGTH);
+    if (plan->fixed) {
+        return 0;
+    }
+
+    int bits = 0;
+    while ((1 << bits) < plan->half) bits++;
+
+    // 位反转表
+    for (int i = 0; i < plan->half; i++) {
+        int rev = 0;
+        for (int b = 0; b < bits; b++) {
+            if (i & (1 << b)) rev |= 1 << (bits - 1 - b);
+        }
+        plan->bitrev[i] = rev;
+    }
+
+    // 各级旋转因子：长度为len的级需要 e^(-j2πj/len), j < len/2
+    int offset = 0;
+    for (int len = 2; len <= plan->half; len <<= 1) {
+        for (int j = 0; j < len / 2; j++) {
+            double angle = -2.0 * M_PI * j / len;
+            plan->stage_tw_re[offset + j] = (float)cos(angle);
+            plan->stage_tw_im[offset + j] = (float)sin(angle);
+        }
+        offset += len / 2;
+    }
+
+    // 实数拆分旋转因子
+    for (int k = 0; k <= plan->half; k++) {
+        double angle = -2.0 * M_PI * k / length;
+        plan->split_re[k] = (float)cos(angle);
+        plan->split_im[k] = (float)sin(angle);
+    }
+
+    return 0;
+}
+
+// 实数序列打包为复数序列 z[n] = x[2n] + j*x[2n+1]，按位反转顺序写入
+static void load_packed(const FFTPlan *plan, const float *input, const float *window,
+                        float *re, float *im) {
+    if (window) {
+        for (int n = 0; n < plan->half; n++) {
+            int dst = plan->bitrev[n];
+            re[dst] = input[2 * n] * window[2 * n];
+            im[dst] = input[2 * n + 1] * window[2 * n + 1];
+        }
+    } else {
+        for (int n = 0; n < plan->half; n++) {
+            int dst = plan->bitrev[n];
+            re[dst] = input[2 * n];
+            im[dst] = input[2 * n + 1];
+        }
+    }
+}
+
+// N/2点复数FFT结果拆分为N点实数FFT的正频率部分（原地）
+// X[k] = Fe[k] + W^k * Fo[k]，Fe/Fo由Z[k]与conj(Z[N/2-k])组合得到
+static void split_real(const FFTPlan *plan, float *re, float *im) {
+    int half = plan->half;
+
+    float z0r = re[0];
+    float z0i = im[0];
+    re[0] = z0r + z0i;
+    im[0] = 0.0f;
+    re[half] = z0r - z0i;
+    im[half] = 0.0f;
+
+    for (int k = 1; k <= half / 2; k++) {
+        int m = half - k;
+        float ar = re[k], ai = im[k];
+        float br = re[m], bi = im[m];
+
+        float fe_r = 0.5f * (ar + br);
+        float fe_i = 0.5f * (ai - bi);
+        float fo_r = 0.5f * (ai + bi);
+        float fo_i = -0.5f * (ar - br);
+
+        float cr = plan->split_re[k];
+        float ci = plan->split_im[k];
+
+        re[k] = fe_r + cr * fo_r - ci * fo_i;
+        im[k] = fe_i + cr * fo_i + ci * fo_r;
+
+        // W^(N/2-k) = -conj(W^k)，Fe[m] = conj(Fe[k])，Fo[m] = conj(Fo[k])
+        re[m] = fe_r - cr * fo_r + ci * fo_i;
+        im[m] = -fe_i + cr * fo_i + ci * fo_r;
+    }
+}
+
+// ============ 定长内核（N == FFT_LENGTH） ============
+// 循环次数和表地址均为编译期常量，前两级合并为无乘法的基4蝶形
+#define FIXED_HALF (FFT_LENGTH / 2)
+
+static void load_packed_fixed(const float *input, const float *window, float *re, float *im) {
+    if (window) {
+        for (int n = 0; n < FIXED_HALF; n++) {
+            int dst = dsp_fft_bitrev[n];
+            re[dst] = input[2 * n] * window[2 * n];
+            im[dst] = input[2 * n + 1] * window[2 * n + 1];
+        }
+    } else {
+        for (int n = 0; n < FIXED_HALF; n++) {
+            int dst = dsp_fft_bitrev[n];
+            re[dst] = input[2 * n];
+            im[dst] = input[2 * n + 1];
+        }
+    }
+}
+
+// 第1、2级（len=2, 4）：旋转因子为1和-j
+static void first_stages_fixed(float *re, float *im) {
+    for (int start = 0; start < FIXED_HALF; start += 4) {
+        float *r = re + start, *i = im + start;
+
+        float a0r = r[0] + r[1], a0i = i[0] + i[1];
+        float a1r = r[0] - r[1], a1i = i[0] - i[1];
+        float a2r = r[2] + r[3], a2i = i[2] + i[3];
+        float a3r = r[2] - r[3], a3i = i[2] - i[3];
+
+        // -j * a3 = (a3i, -a3r)
+        r[0] = a0r + a2r;  i[0] = a0i + a2i;
+        r[2] = a0r - a2r;  i[2] = a0i - a2i;
+        r[1] = a1r + a3i;  i[1] = a1i - a3r;
+        r[3] = a1r - a3i;  i[3] = a1i + a3r;
+    }
+}
+
+static inline void radix2_stage_fixed(float *re, float *im, const float *tw_re, const float *tw_im,
+                                      int hl) {
+    for (int start = 0; start < FIXED_HALF; start += 2 * hl) {
+        float *ar = re + start, *ai = im + start;
+        float *br = ar + hl, *bi = ai + hl;
+
+        for (int j = 0; j < hl; j++) {
+            float tr = tw_re[j] * br[j] - tw_im[j] * bi[j];
+            float ti = tw_re[j] * bi[j] + tw_im[j] * br[j];
+            br[j] = ar[j] - tr;
+            bi[j] = ai[j] - ti;
+            ar[j] += tr;
+            ai[j] += ti;
+        }
+    }
+}
+
+static void split_real_fixed(float *re, float *im) {
+    float z0r = re[0];
+    float z0i = im[0];
+    re[0] = z0r + z0i;
+    im[0] = 0.0f;
+    re[FIXED_HALF] = z0r - z0i;
+    im[FIXED_HALF] = 0.0f;
+
+    for (int k = 1; k <= FIXED_HALF / 2; k++) {
+        int m = FIXED_HALF - k;
+        float ar = re[k], ai = im[k];
+        float br = re[m], bi = im[m];
+
+        float fe_r = 0.5f * (ar + br);
+        float fe_i = 0.5f * (ai - bi);
+        float fo_r = 0.5f * (ai + bi);
+        float fo_i = -0.5f * (ar - br);
+
+        float cr = dsp_bin_twiddle_re[k];
+        float ci = dsp_bin_twiddle_im[k];
+
+        re[k] = fe_r + cr * fo_r - ci * fo_i;
+        im[k] = fe_i + cr * fo_i + ci * fo_r;
+        re[m] = fe_r - cr * fo_r + ci * fo_i;
+        im[m] = -fe_i + cr * fo_i + ci * fo_r;
+    }
+}
+
+static void fft_real_batch_fixed(const float *const inputs[], const float *window,
+                                 FreqResponse *const outputs[], int count) {
+    for (int c = 0; c < count; c++) {
+        load_packed_fixed(inputs[c], window, outputs[c]->re, outputs[c]->im);
+        first_stages_fixed(outputs[c]->re, outputs[c]->im);
+    }
+
+    // 其余各级：跳过前两级的1+2个旋转因子
+    const float *tw_re = dsp_fft_stage_tw_re + 3;
+    const float *tw_im = dsp_fft_stage_tw_im + 3;
+    ANC_UNROLL(16)
+    for (int hl = 4; hl < FIXED_HALF; hl <<= 1) {
+        for (int c = 0; c < count; c++) {
+            radix2_stage_fixed(outputs[c]->re, outputs[c]->im, tw_re, tw_im, hl);
+        }
+        tw_re += hl;
+        tw_im += hl;
+    }
+
+    for (int c = 0; c < count; c++) {
+        split_real_fixed(outputs[c]->re, outputs[c]->im);
+        memset(&outputs[c]->re[FIXED_HALF + 1], 0, (SPECTRUM_LENGTH - FIXED_HALF - 1) * sizeof(float));
+        memset(&outputs[c]->im[FIXED_HALF + 1], 0, (SPECTRUM_LENGTH - FIXED_HALF - 1) * sizeof(float));
+    }
+}
+
+// 逐级蝶形运算（输入已按位反转顺序存放），每级对所有通道执行
+static void complex_stages(int half, const float *tw_re, const float *tw_im,
+                           FreqResponse *const outputs[], int count) {
+    for (int len = 2; len <= half; len <<= 1) {
+        int hl = len / 2;
+
+        for (int c = 0; c < count; c++) {
+            float *re = outputs[c]->re;
+            float *im = outputs[c]->im;
+
+            for (int start = 0; start < half; start += len) {
+                float *ar = re + start, *ai = im + start;
+                float *br = ar + hl, *bi = ai + hl;
+
+                for (int j = 0; j < hl; j++) {
+                    float tr = tw_re[j] * br[j] - tw_im[j] * bi[j];
+                    float ti = tw_re[j] * bi[j] + tw_im[j] * br[j];
+                    br[j] = ar[j] - tr;
+                    bi[j] = ai[j] - ti;
+                    ar[j] += tr;
+                    ai[j] += ti;
+                }
+            }
+        }
+
+        tw_re += hl;
+        tw_im += hl;
+    }
+}
+
+// ============ 批量实数FFT ============
+void fft_real_batch(const FFTPlan *plan, const float *const inputs[], const float *window,
+                    FreqResponse *const outputs[], int count) {
+    if (plan->fixed) {
+        fft_real_batch_fixed(inputs, window, outputs, count);
+        return;
+    }
+
+    int half = plan->half;
+
+    // 直接以输出频谱的re/im数组作为工作区（SPECTRUM_LENGTH >= half + 1）
+    for (int c = 0; c < count; c++) {
+        load_packed(plan, inputs[c], window, outputs[c]->re, outputs[c]->im);
+    }
+
+    complex_stages(half, plan->stage_tw_re, plan->stage_tw_im, outputs, count);
+
+    // 拆分为实数FFT结果，补零区清零
+    for (int c = 0; c < count; c++) {
+        split_real(plan, outputs[c]->re, outputs[c]->im);
+        memset(&outputs[c]->re[half + 1], 0, (SPECTRUM_LENGTH - half - 1) * sizeof(float));
+        memset(&outputs[c]->im[half + 1], 0, (SPECTRUM_LENGTH - half - 1) * sizeof(float));
+    }
+}
+
+// ============ 单通道实数FFT ============
+void fft_real(const FFTPlan *plan, const float *input, const float *window, FreqResponse *output) {
+    fft_real_batch(plan, &input, window, &output, 1);
+}
+
+// ============ 批量复数FFT ============
+void fft_complex_batch(const FFTPlan *plan, const float *const in_re[], const float *const in_im[],
+                       FreqResponse *const outputs[], int count) {
+    int half = plan->half;
+
+    // 定长计划的位反转表和各级旋转因子取自静态表，布局与非定长计划相同
+    for (int c = 0; c < count; c++) {
+        for (int n = 0; n < half; n++) {
+            int dst = plan->fixed ? dsp_fft_bitrev[n] : plan->bitrev[n];
+            outputs[c]->re[dst] = in_re[c][n];
+            outputs[c]->im[dst] = in_im[c][n];
+        }
+    }
+
+    complex_stages(half, plan->fixed ? dsp_fft_stage_tw_re : plan->stage_tw_re,
+                   plan->fixed ? dsp_fft_stage_tw_im : plan->stage_tw_im, outputs, count);
+
+    for (int c = 0; c < count; c++) {
+        memset(&outputs[c]->re[half], 0, (SPECTRUM_LENGTH - half) * sizeof(float));
+        memset(&outputs[c]->im[half], 0, (SPECTRUM_LENGTH - half) * sizeof(float));
+    }
+}
+
+// ============ 实数逆FFT ============
+// Z[k] = Fe[k] + j*Fo[k]，Fe[k] = (X[k] + conj(X[N/2-k]))/2，Fo[k] = (X[k] - conj(X[N/2-k])) * conj(W^k)/2，
+// z = IFFT(Z) = conj(FFT(conj(Z))) / (N/2)，x[2n] = Re z[n]，x[2n+1] = Im z[n]
+void fft_real_inverse(const FFTPlan *plan, const FreqResponse *input, float *output) {
+    int half = plan->half;
+    const float *tw_re = plan->fixed ? dsp_bin_twiddle_re : plan->split_re;
+    const float *tw_im = plan->fixed ? dsp_bin_twiddle_im : plan->split_im;
+
+    float z_re[FFT_LENGTH / 2];
+    float z_im[FFT_LENGTH / 2];
+    for (int k = 0; k < half; k++) {
+        int m = half - k;
+        float xr = input->re[k], xi = input->im[k];
+        float yr = input->re[m], yi = -input->im[m];
+
+        float fe_r = 0.5f * (xr + yr);
+        float fe_i = 0.5f * (xi + yi);
+        float dr = 0.5f * (xr - yr);
+        float di = 0.5f * (xi - yi);
+        float fo_r = dr * tw_re[k] + di * tw_im[k];
+        float fo_i = di * tw_re[k] - dr * tw_im[k];
+
+        // conj(Z)
+        z_re[k] = fe_r - fo_i;
+        z_im[k] = -(fe_i + fo_r);
+    }
+
+    FreqResponse work;
+    FreqResponse *outputs[1] = {&work};
+    const float *in_re[1] = {z_re};
+    const float *in_im[1] = {z_im};
+    fft_complex_batch(plan, in_re, in_im, outputs, 1);
+
+    const float scale = 1.0f / half;
+    for (int n = 0; n < half; n++) {
+        output[2 * n] = work.re[n] * scale;
+        output[2 * n + 1] = -work.im[n] * scale;
+    }
+}
@@ -1,16 +1,23 @@
 #include "../inc/fir_filter.h"
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 
 // 初始化FIR滤波器
 void fir_init(FIRFilter *fir, const float *coeffs, int length) {
-    if (length > MAX_FIR_LENGTH) {
-        printf("Warning: FIR length %d exceeds max %d, truncating\n", 
-               length, MAX_FIR_LENGTH);
-        length = MAX_FIR_LENGTH;
+    fir_init_delayed(fir, coeffs, length, 0);
+}
+
+// 初始化带前导延迟的FIR滤波器
+void fir_init_delayed(FIRFilter *fir, const float *coeffs, int length, int delay) {
+    if (delay + length > MAX_FIR_LENGTH) {
+        printf("Warning: FIR delay %d + length %d exceeds max %d, truncating\n", 
+               delay, length, MAX_FIR_LENGTH);
+        length = MAX_FIR_LENGTH - delay;
     }
     
     fir->length = length;
+    fir->delay = delay;
     fir->write_index = 0;
     
     // 复制系数
@@ -25,9 +32,13 @@ float fir_process(FIRFilter *fir, float input) {
     // 写入新样本到循环缓冲区
     fir->buffer[fir->write_index] = input;
     
-    // 计算卷积: y[n] = Σ h[k] * x[n-k]
+    // 计算卷积: y[n] = Σ h[k] * x[n-delay-k]
+    int span = fir->length + fir->delay;
     float output = 0.0f;
-    int read_index = fir->write_index;
+    int read_index = fir->write_index - fir->delay;
+    if (read_index < 0) {
+        read_index += span;
+    }
     
     for (int k = 0; k < fir->length; k++) {
         output += fir->coeffs[k] * fir->buffer[read_index];
@@ -35,13 +46,13 @@ float fir_process(FIRFilter *fir, float input) {
         // 循环索引递减
         read_index--;
         if (read_index < 0) {
-            read_index = fir->length - 1;
+            read_index = span - 1;
         }
     }
     
     // 更新写指针
     fir->write_index++;
-    if (fir->write_index >= fir->length) {
+    if (fir->write_index >= span) {
         fir->write_index = 0;
     }
     
@@ -55,6 +66,85 @@ void fir_process_block(FIRFilter *fir, const float *input, float *output, int nu
     }
 }
 
+// 无状态线性卷积的一段输出
+void fir_convolve(const float *coeffs, int length, const float *input, int offset,
+                  float *output, int num_samples) {
+    for (int i = 0; i < num_samples; i++) {
+        int n = offset + i;
+        int taps = n + 1 < length ? n + 1 : length;
+        if (taps <= 0) {
+            output[i] = 0.0f;
+            continue;
+        }
+        const float *x = &input[n];
+        
+        // 与fir_process相同的累加顺序（k从0递增）
+        float acc = 0.0f;
+        for (int k = 0; k < taps; k++) {
+            acc += coeffs[k] * x[-k];
+        }
+        output[i] = acc;
+    }
+}
+
+// 直接设置延迟线
+void fir_set_history(FIRFilter *fir, const float *tail, int total_samples) {
+    fir_reset(fir);
+    
+    int span = fir->length + fir->delay;
+    int count = total_samples < span ? total_samples : span;
+    int index = (total_samples - count) % span;
+    for (int i = 0; i < count; i++) {
+        fir->buffer[index] = tail[i];
+        index++;
+        if (index >= span) {
+            index = 0;
+        }
+    }
+    fir->write_index = index;
+}
+
+// 分析冲击响应并确定可去除的首尾
+void fir_compact(const float *ir, int length, float threshold_db, FIRCompaction *result) {
+    double total = 0.0;
+    for (int k = 0; k < length; k++) {
+        total += (double)ir[k] * ir[k];
+    }
+    
+    result->raw_length = length;
+    result->delay = 0;
+    result->length = length;
+    result->tail_removed = 0;
+    result->removed_energy_db = -INFINITY;
+    if (total <= 0.0) {
+        return;
+    }
+    
+    // 首尾各分得一半的允许误差能量
+    double budget = 0.5 * total * pow(10.0, threshold_db / 10.0);
+    
+    double head = 0.0;
+    int start = 0;
+    while (start < length - 1 && head + (double)ir[start] * ir[start] <= budget) {
+        head += (double)ir[start] * ir[start];
+        start++;
+    }
+    
+    double tail = 0.0;
+    int end = length;
+    while (end > start + 1 && tail + (double)ir[end - 1] * ir[end - 1] <= budget) {
+        tail += (double)ir[end - 1] * ir[end - 1];
+        end--;
+    }
+    
+    result->delay = start;
+    result->length = end - start;
+    result->tail_removed = length - end;
+    if (head + tail > 0.0) {
+        result->removed_energy_db = (float)(10.0 * log10((head + tail) / total));
+    }
+}
+
 // 重置FIR滤波器状态
 void fir_reset(FIRFilter *fir) {
     memset(fir->buffer, 0, MAX_FIR_LENGTH * sizeof(float));
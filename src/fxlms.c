@@ -0,0 +1,242 @@
+#include "../inc/fxlms.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FXLMS_USE_SSE 1
+#else
+#define FXLMS_USE_SSE 0
+#endif
+
+// ============ 向量内核 ============
+// 点积：两组4路累加器，隐藏加法延迟
+static float fxlms_dot(const float *a, const float *b, int n) {
+    int i = 0;
+    float sum = 0.0f;
+#if FXLMS_USE_SSE
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&a[i]), _mm_loadu_ps(&b[i])));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&a[i + 4]), _mm_loadu_ps(&b[i + 4])));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// y += g * x
+static void fxlms_axpy(float *y, float g, const float *x, int n) {
+    int i = 0;
+#if FXLMS_USE_SSE
+    const __m128 vg = _mm_set1_ps(g);
+    for (; i + 8 <= n; i += 8) {
+        _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(vg, _mm_loadu_ps(&x[i]))));
+        _mm_storeu_ps(&y[i + 4], _mm_add_ps(_mm_loadu_ps(&y[i + 4]),
+                                            _mm_mul_ps(vg, _mm_loadu_ps(&x[i + 4]))));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] += g * x[i];
+    }
+}
+
+// ============ 初始化 ============
+int fxlms_init(FxlmsController *ctrl, const FxlmsParams *params, const TimeDomainSimulator *sim) {
+    memset(ctrl, 0, sizeof(FxlmsController));
+    ctrl->num_taps = params->num_taps;
+    ctrl->mu = params->mu;
+    ctrl->epsilon = params->epsilon;
+
+    const FIRFilter *fir = &sim->secondary_path_fir[0][0];
+    ctrl->sp_length = fir->length;
+    ctrl->sp_delay = fir->delay;
+    const int span = ctrl->sp_delay + ctrl->sp_length;
+
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            const FIRFilter *path = &sim->secondary_path_fir[e][r];
+            ctrl->sp_rev[e][r] = (float *)malloc(ctrl->sp_length * sizeof(float));
+            if (!ctrl->sp_rev[e][r]) {
+                log_printf("Error: Failed to allocate FxLMS controller\n");
+                fxlms_free(ctrl);
+                return -1;
+            }
+            for (int k = 0; k < ctrl->sp_length; k++) {
+                ctrl->sp_rev[e][r][k] = path->coeffs[ctrl->sp_length - 1 - k];
+            }
+        }
+    }
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        ctrl->w[r] = (float *)calloc(ctrl->num_taps, sizeof(float));
+        ctrl->drive_tail[r] = (float *)calloc(span, sizeof(float));
+        if (!ctrl->w[r] || !ctrl->drive_tail[r]) {
+            log_printf("Error: Failed to allocate FxLMS controller\n");
+            fxlms_free(ctrl);
+            return -1;
+        }
+    }
+
+    log_printf("FxLMS controller: %d taps x %d ref, mu %g, epsilon %g, SP estimate %d taps + %d delay\n",
+               ctrl->num_taps, ANC_NUM_REF, ctrl->mu, ctrl->epsilon, ctrl->sp_length, ctrl->sp_delay);
+    return 0;
+}
+
+// ============ 闭环处理 ============
+int fxlms_process(FxlmsController *ctrl, TimeDomainSimulator *sim, int num_samples) {
+    const int start = sim->current_sample;
+    if (start + num_samples > sim->total_samples) {
+        num_samples = sim->total_samples - start;
+    }
+    if (num_samples <= 0) {
+        return 0;
+    }
+
+    const int L = ctrl->num_taps;
+    const int S = ctrl->sp_length;
+    const int span = ctrl->sp_delay + S;
+    const int n = num_samples;
+
+    // 本块缓冲（下标0对应的信号时刻）:
+    //   ref  : start - (L-1) - (span-1)   参考麦，向前多取滤波参考所需的次级路径长度
+    //   fx   : start - (L-1)              滤波参考，样本i的控制器窗口为 [i, i+L)
+    //   drive: start - (span-1)           驱动信号，样本i的次级路径窗口为 [i, i+S)
+    const int ref_len = n + L - 1 + span - 1;
+    const int fx_len = n + L - 1;
+    const int drive_len = n + span - 1;
+    float *ref[ANC_NUM_REF];
+    float *fx[ANC_NUM_ERR][ANC_NUM_REF];
+    float *drive[ANC_NUM_REF];
+    int failed = 0;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        ref[r] = (float *)malloc(ref_len * sizeof(float));
+        drive[r] = (float *)malloc(drive_len * sizeof(float));
+        failed |= !ref[r] || !drive[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            fx[e][r] = (float *)malloc(fx_len * sizeof(float));
+            failed |= !fx[e][r];
+        }
+    }
+
+    if (!failed) {
+        // 参考麦（信号起点之前为0）
+        const int ref_origin = start - (L - 1) - (span - 1);
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            int lead = ref_origin < 0 ? -ref_origin : 0;
+            if (lead > ref_len) lead = ref_len;
+            memset(ref[r], 0, lead * sizeof(float));
+            memcpy(&ref[r][lead], &sim->original_ff[r][ref_origin + lead],
+                   (ref_len - lead) * sizeof(float));
+            memcpy(drive[r], ctrl->drive_tail[r], (span - 1) * sizeof(float));
+        }
+
+        // 滤波参考 x'[m] = Σ_k Ŝ[k] x[m - delay - k]：与闭环无关，整块先算
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                for (int m = 0; m < fx_len; m++) {
+                    fx[e][r][m] = fxlms_dot(ctrl->sp_rev[e][r], &ref[r][m], S);
+                }
+            }
+        }
+
+        // 各参考麦滤波参考窗口能量（逐样本滑动更新，双精度避免累积误差）
+        double power[ANC_NUM_REF];
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            power[r] = 0.0;
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                for (int m = 0; m < L - 1; m++) {
+                    power[r] += (double)fx[e][r][m] * fx[e][r][m];
+                }
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            // 1. 控制器输出
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                drive[r][span - 1 + i] = fxlms_dot(ctrl->w[r], &ref[r][span - 1 + i], L);
+            }
+
+            // 2. 经次级路径到达误差麦
+            float err[ANC_NUM_ERR];
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                float anti = 0.0f;
+                for (int r = 0; r < ANC_NUM_REF; r++) {
+                    anti += fxlms_dot(ctrl->sp_rev[e][r], &drive[r][i], S);
+                }
+                err[e] = sim->original_fb[e][start + i] - anti;
+                sim->simulated_fb[e][start + i] = err[e];
+            }
+
+            // 3. 归一化更新
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                for (int e = 0; e < ANC_NUM_ERR; e++) {
+                    float in = fx[e][r][i + L - 1];
+                    float out = i > 0 ? fx[e][r][i - 1] : 0.0f;
+                    power[r] += (double)in * in - (double)out * out;
+                }
+                float step = ctrl->mu / (ctrl->epsilon + (float)(power[r] > 0.0 ? power[r] : 0.0));
+                for (int e = 0; e < ANC_NUM_ERR; e++) {
+                    fxlms_axpy(ctrl->w[r], step * err[e], &fx[e][r][i], L);
+                }
+            }
+        }
+
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            memcpy(ctrl->drive_tail[r], &drive[r][n], (span - 1) * sizeof(float));
+        }
+        ctrl->samples += n;
+        sim->current_sample += n;
+    }
+
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        free(ref[r]);
+        free(drive[r]);
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free(fx[e][r]);
+        }
+    }
+    if (failed) {
+        log_printf("Error: Failed to allocate FxLMS block buffers\n");
+        return -1;
+    }
+    return n;
+}
+
+// ============ 系数范数 ============
+float fxlms_weight_norm(const FxlmsController *ctrl) {
+    double sum = 0.0;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        for (int k = 0; k < ctrl->num_taps; k++) {
+            sum += (double)ctrl->w[r][k] * ctrl->w[r][k];
+        }
+    }
+    return (float)sqrt(sum);
+}
+
+// ============ 释放 ============
+void fxlms_free(FxlmsController *ctrl) {
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free(ctrl->sp_rev[e][r]);
+            ctrl->sp_rev[e][r] = NULL;
+        }
+    }
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        free(ctrl->w[r]);
+        free(ctrl->drive_tail[r]);
+        ctrl->w[r] = NULL;
+        ctrl->drive_tail[r] = NULL;
+    }
+}
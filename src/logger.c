@@ -5,6 +5,9 @@
 // 全局日志实例
 Logger g_logger = {NULL, 1, 0};
 
+// 线程局部静默标志（扫参等工作线程静默运行，不影响主线程输出）
+static __thread int t_logger_quiet = 0;
+
 // 初始化日志系统
 int logger_init(const char *filename, int log_to_console) {
     if (filename == NULL) {
@@ -41,7 +44,7 @@ void logger_close(void) {
 
 // 写入日志
 void log_printf(const char *format, ...) {
-    if (!g_logger.enabled) return;
+    if (!g_logger.enabled || t_logger_quiet) return;
     
     va_list args;
     
@@ -67,3 +70,8 @@ void logger_flush(void) {
     }
     fflush(stdout);
 }
+
+// 设置当前线程静默
+void logger_set_thread_quiet(int quiet) {
+    t_logger_quiet = quiet;
+}
@@ -2,46 +2,131 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
+#include <stddef.h>
 #include "../inc/config.h"
 #include "../inc/coeffs.h"
 #include "../inc/wav_io.h"
 #include "../inc/fir_filter.h"
+#include "../inc/sp_spectrum.h"
 #include "../inc/time_domain_sim.h"
 #include "../inc/logger.h"
+#include "../inc/eval_grid.h"
+#include "../inc/spectrum.h"
+#include "../inc/stability.h"
+#include "../inc/snapshot.h"
+#include "../inc/fft.h"
+#include "../inc/dsp_tables.h"
+#include "../inc/params.h"
+#include "../inc/sweep.h"
+#include "../inc/thread_pool.h"
+#include "../inc/shm_ring.h"
+#include "../inc/scenario.h"
+#include "../inc/band_analysis.h"
+#include "../inc/analysis_bins.h"
+#include "../inc/scheduler.h"
+#include "../inc/adapt_engine.h"
+#include "../inc/eq_fit.h"
+#include "../inc/resample.h"
 
 // 定义M_PI（某些编译器可能没有）
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+#define MAX_PARAM_OVERRIDES 64    // 命令行--set最多个数
+
 // ============ 全局变量 ============
 SystemState g_system_state;
 TimeDomainSimulator g_time_sim;
 
-// Blackman窗函数
-float blackman_window[FFT_LENGTH];
+// 扫参评估的共享只读输入（解码一次，各线程的仿真器直接引用）
+typedef struct {
+    const float *ff_signal[ANC_NUM_REF];
+    const float *fb_signal[ANC_NUM_ERR];
+    int total_samples;
+    int sample_rate;
+    const float *sp_ir;
+    int sp_length;
+    int sp_delay;
+    const SpSpectrum *sp_spectrum;          // 次级路径DSP频响
+    const float *preconv_ff[ANC_NUM_REF];   // 预卷积参考（NULL=未启用）
+    AdaptEngineType engine;                 // 自适应引擎（各配置独立创建）
+} SweepInput;
+
+// 降速率快速仿真的输入（--fast-sim）：各通道和次级路径重采样到DSP_SAMPLE_RATE
+typedef struct {
+    float *ff_signal[ANC_NUM_REF];
+    float *fb_signal[ANC_NUM_ERR];
+    int total_samples;
+    int sample_rate;
+    float sp_ir[SP_IR_LENGTH];              // 有效部分（已去除前导延迟）
+    int sp_length;
+    int sp_delay;
+} FastSimInput;
+
+// 全速率校验渲染用的仿真器（--fast-sim）
+TimeDomainSimulator g_verify_sim;
+
+// 分析FFT计划（FFT_LENGTH点实数FFT）
+FFTPlan g_fft_plan;
+
+// 分析频点（全频带FFT或细化FFT频段，启动时确定，扫参时各线程只读共享）
+AnalysisBins g_analysis_bins;
+
+// 谱分析通道并行线程池（--dsp-threads > 1 时创建，NULL=串行）
+ThreadPool *g_dsp_pool = NULL;
 
 // ============ 函数声明 ============
-void system_init(void);
-void init_blackman_window(void);
-void anti_alias_decimate(float *input, int input_len, float *output, int output_len);
-void apply_window(float *buffer, float *windowed, int length);
-void perform_fft(float *input, Complex *output, int length);
-void accumulate_fft_results(Complex *fft_result, FreqResponse *accum);
+void system_init(SystemState *state, const AncParams *params, const SpSpectrum *sp);
+void anti_alias_decimate(const float *input, int input_len, float *output, int output_len);
+void accumulate_fft_results(FreqResponse *fft_result, FreqResponse *accum);
 void average_fft_results(FFTAccumulator *accum, FreqResponse *ff_avg, FreqResponse *fb_avg, 
-                         FreqResponse *spk_avg, Complex *pp_average);
+                         FreqResponse *spk_avg, FreqResponse pp_average[][ANC_NUM_REF]);
 void calculate_mu(SystemState *state);
 void calculate_target_ff(SystemState *state);
-void calculate_ff_response(SystemState *state);
-float calculate_smoothness(float *H_db, int length);
-int check_target_stability(SystemState *state);
+void calculate_ff_response(FFChannel *ch);
 void calculate_ff_init_loss(SystemState *state);
 float calculate_loss(SystemState *state);
-int update_single_param(SystemState *state, int biquad_idx, int param_type);
+float calculate_ff_loss(const FFChannel *ch);
+float calculate_loss_grid(const EvalGrid *grid);
+int update_single_param(FFChannel *ch, EvalGrid *grid, const AncParams *params,
+                        int biquad_idx, int param_type);
 void update_eq_params(SystemState *state);
 void eq_to_biquad_coeffs(BiquadParam *eq_param, float sample_rate, BiquadCoeffs *coeffs);
 void update_filter_coeffs(SystemState *state);
-void process_audio_frame(float *ff_in, float *fb_in, float *spk_in, int frame_len);
+int any_update_accepted(const SystemState *state);
+void process_audio_frame(SystemState *state, float *const ff_in[], float *const fb_in[],
+                         const float *spk_in, int frame_len);
+int process_audio_block(SystemState *state, float *const ff_in[], float *const fb_in[],
+                        const float *spk_in, int num_samples, int sample_rate);
+static void log_overridden_params(const AncParams *params);
+static int run_single(const AncParams *params, float *const ff_signal[], float *const fb_signal[],
+                      int total_samples, int sample_rate,
+                      const float *sp_ir, int sp_length, int sp_delay, const SpSpectrum *sp_spectrum,
+                      const char *resume_path, int snapshot_interval, int sim_threads,
+                      int preconv, AdaptEngineType engine_type, const FastSimInput *fast);
+static int fast_sim_prepare(FastSimInput *fast, float *const ff_signal[], float *const fb_signal[],
+                            int total_samples, int sample_rate, const float *sp_ir, int sp_length,
+                            int sp_trim, float sp_trim_db);
+static void fast_sim_free(FastSimInput *fast);
+static double monotonic_ms(void);
+static float block_attenuation_db(const TimeDomainSimulator *sim, int start, int num_samples);
+static int run_producer(float *const ff_signal[], float *const fb_signal[], int total_samples,
+                        int sample_rate, const char *ring_name);
+static int run_stream(const AncParams *params, const SpSpectrum *sp_spectrum,
+                      const char *ring_name);
+static int run_frame_bench(const AncParams *params, const SpSpectrum *sp_spectrum,
+                           float *const ff_signal[], float *const fb_signal[],
+                           int total_samples, int sample_rate, int num_frames);
+static int run_sim_check(float *const ff_signal[], float *const fb_signal[], int total_samples,
+                         const float *sp_ir, int sp_length, int sp_delay, int num_threads,
+                         int preconv);
+static int sweep_evaluate(const AncParams *params, SweepResult *result, void *ctx);
+static int run_adaptation(SystemState *state, TimeDomainSimulator *sim, const AdaptEngine *engine,
+                          int snapshot_interval, SnapshotCounters *counters, SweepResult *result,
+                          const char *band_csv_path, int filter_rate,
+                          FeedforwardFilter applied_filters[]);
 
 // ============ 主函数 ============
 /*
@@ -73,6 +158,7 @@ void process_audio_frame(float *ff_in, float *fb_in, float *spk_in, int frame_le
  *    - 作为梯度下降更新的基准阈值
  * 
  * 7. UPDATE_EQ_PARAMS:
+ *    - 先在评估网格上直接拟合EQ参数（eq_fit.h），全频点loss更低时作为起点
  *    - 梯度下降优化10个Biquad参数(gain, Q, fc)和总增益
  *    - 只有新loss < init_loss才接受更新
  * 
@@ -81,14 +167,124 @@ void process_audio_frame(float *ff_in, float *fb_in, float *spk_in, int frame_le
  *    - 应用到实时滤波通路
  *    - 【关键时序】用新参数对当前位置之后的所有剩余原始信号进行滤波
  * 
+ * 调度（--set sched_max_idle_rounds=N 启用）:
+ *    - SIGNAL_PROCESS结束时比较本轮与上次自适应时的频带能量/相干度
+ *    - 收敛后无明显变化则转入ADAPT_IDLE，跳过2~8，最多连续跳过N轮
+ * 
+ * 离线仿真每轮一次调用process_audio_block送入整块信号（任意长度，降采样相位跨调用连续），
+ * 内部每满一帧的降采样样本推进一步状态机，与按5ms帧调用process_audio_frame逐位一致
+ * 
+ * 以上为默认的EQ引擎；--engine fxlms / fdaf 改用逐样本FxLMS或分区频域块LMS控制器
+ * 在仿真器上闭环（见adapt_engine.h），不经过状态机，每轮只统计降噪量
+ * 
  * 时序示例:
  *   0-100ms:    原始FF + 原始FB → DSP处理 → 得到参数v1
  *   滤波:       用v1对100ms后的所有剩余原始FF信号滤波，更新FB
  *   100-200ms:  原始FF + 降噪后FB → DSP处理 → 得到参数v2  
  *   滤波:       用v2对200ms后的所有剩余原始FF信号滤波，更新FB
  *   ...依此类推
+ * 
+ * 命令行参数:
+ *   --resume <file>        从快照恢复（须使用生成快照时的同一输入）
+ *   --snapshot-every <N>   每N轮迭代保存一次快照到 result/
+ *   --set <name=value>     覆盖可调参数（可重复，参数名见params.c）
+ *   --sweep <spec>         扫参模式：并行评估spec中的全部配置，排名写入 result/
+ *   --threads <N>          扫参线程数（默认CPU核数）
+ *   --sim-threads <N>      时域仿真分段并行线程数（默认SIM_THREADS=1，串行）
+ *   --dsp-threads <N>      每hop谱分析按通道并行的线程数（默认DSP_THREADS=1，串行）
+ *   --preconv              预卷积模式：加载时算一次S*FF，每次更新只重跑Biquad级联
+ *   --sim-check            分段并行仿真自检：极端EQ参数下比较并行与串行滤波结果
+ *   --fast-sim             降速率快速仿真：闭环在DSP采样率上运行，最后全速率重渲染最终参数
+ *   --sp-trim <dB|off>     次级路径首尾裁剪门限（默认SP_TRIM_THRESHOLD_DB），off=不裁剪
+ *   --produce <name>       把输入按实时节拍写入共享内存环形缓冲区<name>（如/anc_stream）
+ *   --stream <name>        从共享内存环形缓冲区<name>实时取帧处理（先启动，再启动--produce）
+ *   --scenario <spec>      用合成场景代替输入WAV（配置格式见scenario.h）
+ *   --bench-frames <N>     逐帧处理基准：冷/热缓存下各计时N帧
+ *   --zoom <low:high|off>  细化FFT只分析该频段
+ *   --bins <spec|off>      稀疏频点（Goertzel）："low:high"或"f1,f2,..."，off=全频带FFT
+ *   --engine <eq|fxlms|fdaf> 自适应引擎（默认eq）
  */
-int main(void) {
+int main(int argc, char *argv[]) {
+    const char *resume_path = NULL;
+    const char *sweep_path = NULL;
+    const char *produce_name = NULL;
+    const char *stream_name = NULL;
+    const char *scenario_path = NULL;
+    int snapshot_interval = SNAPSHOT_INTERVAL;
+    int bench_frames = 0;
+    int sim_check = 0;
+    int num_threads = thread_pool_num_cpus();
+    int sim_threads = SIM_THREADS;
+    int dsp_threads = DSP_THREADS;
+    int preconv = SIM_PRECONV;
+    int fast_sim = FAST_SIM;
+    float zoom_low = 0.0f, zoom_high = 0.0f;
+    const char *sparse_spec = NULL;
+    const char *engine_name = NULL;
+    int sp_trim = 1;
+    float sp_trim_db = SP_TRIM_THRESHOLD_DB;
+    const char *overrides[MAX_PARAM_OVERRIDES];
+    int num_overrides = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            resume_path = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot-every") == 0 && i + 1 < argc) {
+            snapshot_interval = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--set") == 0 && i + 1 < argc) {
+            if (num_overrides < MAX_PARAM_OVERRIDES) {
+                overrides[num_overrides++] = argv[++i];
+            } else {
+                printf("Warning: Too many --set arguments, ignoring %s\n", argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweep_path = argv[++i];
+        } else if (strcmp(argv[i], "--sim-threads") == 0 && i + 1 < argc) {
+            sim_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dsp-threads") == 0 && i + 1 < argc) {
+            dsp_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sp-trim") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "off") == 0) {
+                sp_trim = 0;
+            } else {
+                sp_trim_db = (float)atof(argv[i]);
+            }
+        } else if (strcmp(argv[i], "--produce") == 0 && i + 1 < argc) {
+            produce_name = argv[++i];
+        } else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            stream_name = argv[++i];
+        } else if (strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) {
+            scenario_path = argv[++i];
+        } else if (strcmp(argv[i], "--bench-frames") == 0 && i + 1 < argc) {
+            bench_frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--zoom") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "off") == 0) {
+                zoom_low = zoom_high = 0.0f;
+            } else if (sscanf(argv[i], "%f:%f", &zoom_low, &zoom_high) != 2) {
+                printf("Warning: Invalid --zoom band %s (expected low:high), ignoring\n", argv[i]);
+                zoom_low = zoom_high = 0.0f;
+            }
+        } else if (strcmp(argv[i], "--bins") == 0 && i + 1 < argc) {
+            i++;
+            sparse_spec = strcmp(argv[i], "off") == 0 ? NULL : argv[i];
+        } else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            engine_name = argv[++i];
+        } else if (strcmp(argv[i], "--preconv") == 0) {
+            preconv = 1;
+        } else if (strcmp(argv[i], "--sim-check") == 0) {
+            sim_check = 1;
+        } else if (strcmp(argv[i], "--fast-sim") == 0) {
+            fast_sim = 1;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+            if (num_threads < 1) num_threads = 1;
+        } else {
+            printf("Warning: Unknown argument: %s\n", argv[i]);
+        }
+    }
+    
     log_printf("==============================================\n");
     log_printf("  Adaptive ANC System with Time Domain Sim\n");
     log_printf("==============================================\n\n");
@@ -101,30 +297,83 @@ int main(void) {
     log_printf("  Realtime Sample Rate: %d Hz\n", REALTIME_SAMPLE_RATE);
     log_printf("  FFT Length: %d\n", FFT_LENGTH);
     log_printf("  Process Interval: %d ms\n", PROCESS_INTERVAL_MS);
+    
+    // 运行时可调参数：默认值取自coeffs.h，可由--set覆盖
+    AncParams params;
+    anc_params_default(&params);
+    for (int i = 0; i < num_overrides; i++) {
+        if (anc_params_parse(&params, overrides[i]) != 0) {
+            logger_close();
+            return -1;
+        }
+    }
+    log_overridden_params(&params);
     log_printf("\n");
     
+    // 自适应引擎：FxLMS等引擎的控制器状态不在快照中
+    AdaptEngineType engine_type = ENGINE_EQ;
+    if (engine_name && adapt_engine_parse(engine_name, &engine_type) != 0) {
+        logger_close();
+        return -1;
+    }
+    if (engine_type != ENGINE_EQ && (resume_path || snapshot_interval > 0)) {
+        log_printf("Error: Snapshots are only supported by the eq engine\n");
+        logger_close();
+        return -1;
+    }
+    
+    // 快速仿真只用于单次运行的EQ引擎（其余引擎的抽头数按仿真器采样率设定，快照按全速率存放）
+    if (fast_sim && (engine_type != ENGINE_EQ || resume_path || snapshot_interval > 0)) {
+        log_printf("Error: --fast-sim requires the eq engine and no snapshots\n");
+        logger_close();
+        return -1;
+    }
+    if (fast_sim && (sweep_path || produce_name || stream_name || bench_frames > 0 || sim_check)) {
+        log_printf("Note: --fast-sim only applies to single simulation runs, ignored\n");
+        fast_sim = 0;
+    }
+    
     // ========== 1. 加载WAV文件（如果存在） ==========
     WavData wav_data;
     int use_wav_input = 0;
-    float *ff_signal = NULL;
-    float *fb_signal = NULL;
+    float *ff_signal[ANC_NUM_REF];
+    float *fb_signal[ANC_NUM_ERR];
     int total_samples = 0;
     int sample_rate_actual = REALTIME_SAMPLE_RATE;
+    int need_input = (stream_name == NULL);   // 流式消费者的输入来自共享内存
+    
+    // 映射所需的最少通道数
+    int required_channels = WAV_CH_REF(ANC_NUM_REF - 1) + 1;
+    if (WAV_CH_ERR(ANC_NUM_ERR - 1) + 1 > required_channels) {
+        required_channels = WAV_CH_ERR(ANC_NUM_ERR - 1) + 1;
+    }
     
-    if (wav_file_exists(WAV_INPUT_PATH)) {
+    log_printf("  MIMO: %d reference x %d error mics\n\n", ANC_NUM_REF, ANC_NUM_ERR);
+    
+    if (!need_input) {
+        log_printf("Input: shared-memory stream %s\n", stream_name);
+    } else if (scenario_path) {
+        log_printf("Using synthetic scenario: %s\n", scenario_path);
+    } else if (wav_file_exists(WAV_INPUT_PATH)) {
         log_printf("Loading WAV file: %s\n", WAV_INPUT_PATH);
         if (wav_read(WAV_INPUT_PATH, &wav_data) == 0) {
-            if (wav_data.num_channels >= 2) {
-                ff_signal = wav_data.channels[WAV_CH_FF];
-                fb_signal = wav_data.channels[WAV_CH_FB];
+            if (wav_data.num_channels >= required_channels) {
                 total_samples = wav_data.num_samples;
                 sample_rate_actual = wav_data.sample_rate;
                 use_wav_input = 1;
                 log_printf("WAV file loaded successfully\n");
-                log_printf("  Using channel %d as FF (reference mic)\n", WAV_CH_FF);
-                log_printf("  Using channel %d as FB (error mic)\n", WAV_CH_FB);
+                for (int r = 0; r < ANC_NUM_REF; r++) {
+                    ff_signal[r] = wav_data.channels[WAV_CH_REF(r)];
+                    log_printf("  Using channel %d as FF%d (reference mic)\n", WAV_CH_REF(r), r);
+                }
+                for (int e = 0; e < ANC_NUM_ERR; e++) {
+                    fb_signal[e] = wav_data.channels[WAV_CH_ERR(e)];
+                    log_printf("  Using channel %d as FB%d (error mic)\n", WAV_CH_ERR(e), e);
+                }
             } else {
-                log_printf("Warning: WAV file has < 2 channels, using generated signal\n");
+                log_printf("Warning: WAV file has < %d channels, using generated signal\n",
+                           required_channels);
+                wav_free(&wav_data);
             }
         }
     } else {
@@ -132,17 +381,23 @@ int main(void) {
         log_printf("Using generated signal instead\n");
     }
     
-    // 如果没有WAV文件,生成模拟信号
-    if (!use_wav_input) {
-        total_samples = sample_rate_actual * 10;  // 10秒
-        ff_signal = (float *)malloc(total_samples * sizeof(float));
-        fb_signal = (float *)malloc(total_samples * sizeof(float));
-        
-        for (int i = 0; i < total_samples; i++) {
-            ff_signal[i] = 0.001f * sinf(2.0f * M_PI * 1000.0f * i / sample_rate_actual);
-            fb_signal[i] = 0.0005f * sinf(2.0f * M_PI * 2000.0f * i / sample_rate_actual);
+    // 没有WAV文件（或指定了场景）时合成场景信号：参考麦经主路径得到相干的误差麦
+    if (need_input && !use_wav_input) {
+        ScenarioSpec scenario;
+        if (scenario_path) {
+            if (scenario_load_spec(scenario_path, &scenario) != 0) {
+                logger_close();
+                return -1;
+            }
+        } else {
+            scenario_default(&scenario);
+        }
+        total_samples = scenario_generate(&scenario, ff_signal, fb_signal, num_threads);
+        if (total_samples <= 0) {
+            logger_close();
+            return -1;
         }
-        log_printf("Generated %d samples at %d Hz\n", total_samples, sample_rate_actual);
+        sample_rate_actual = scenario.sample_rate;
     }
     
     log_printf("\n");
@@ -162,27 +417,973 @@ int main(void) {
         }
     }
     
+    // 分析频点：默认全频带FFT，--zoom low:high 只分析该频段（细化FFT），
+    // --bins 只更新选定的FFT频点（Goertzel）
+    if (zoom_high > 0.0f && sparse_spec) {
+        log_printf("Error: --zoom and --bins are mutually exclusive\n");
+        logger_close();
+        return -1;
+    }
+    if (sparse_spec) {
+        if (analysis_bins_sparse(&g_analysis_bins, sparse_spec) != 0) {
+            logger_close();
+            return -1;
+        }
+        log_printf("Analysis: sparse Goertzel, %d of %d FFT bins (%.1f - %.1f Hz)\n",
+                   g_analysis_bins.num_bins, FFT_HALF_LENGTH, g_analysis_bins.freq[0],
+                   g_analysis_bins.freq[g_analysis_bins.num_bins - 1]);
+    } else if (zoom_high > 0.0f) {
+        if (analysis_bins_zoom(&g_analysis_bins, zoom_low, zoom_high) != 0) {
+            logger_close();
+            return -1;
+        }
+        log_printf("Analysis: zoom FFT %.1f - %.1f Hz, decimation %d (%.1f Hz), %d-point complex FFT, "
+                   "%d bins @ %.2f Hz (full FFT: %d bins @ %.2f Hz)\n",
+                   g_analysis_bins.freq[0], g_analysis_bins.freq[g_analysis_bins.num_bins - 1],
+                   g_analysis_bins.decimation, (float)DSP_SAMPLE_RATE / g_analysis_bins.decimation,
+                   ZOOM_FFT_LENGTH, g_analysis_bins.num_bins, g_analysis_bins.bin_spacing,
+                   FFT_HALF_LENGTH, (float)DSP_SAMPLE_RATE / FFT_LENGTH);
+    } else {
+        analysis_bins_full(&g_analysis_bins);
+    }
+    
+    // 分析频点上的次级路径频响（按冲击响应内容和频点缓存）
+    static SpSpectrum sp_spectrum;
+    sp_spectrum_load(sp_ir, sp_length, REALTIME_SAMPLE_RATE, &g_analysis_bins, &sp_spectrum);
+    
+    // 快速仿真输入：次级路径在裁剪前重采样（前导延迟按DSP采样率重新检出）
+    FastSimInput fast;
+    if (fast_sim &&
+        fast_sim_prepare(&fast, ff_signal, fb_signal, total_samples, sample_rate_actual,
+                         sp_ir, sp_length, sp_trim, sp_trim_db) != 0) {
+        logger_close();
+        return -1;
+    }
+    
+    // 前导延迟改用整数延迟线，低于门限的首尾不再参与卷积
+    int sp_delay = 0;
+    if (sp_trim) {
+        FIRCompaction compaction;
+        fir_compact(sp_ir, sp_length, sp_trim_db, &compaction);
+        sp_delay = compaction.delay;
+        sp_length = compaction.length;
+        log_printf("Secondary path compaction (threshold %.1f dB): %d taps -> %d delay + %d taps "
+                   "(%d tail taps removed), removed energy %.1f dB\n",
+                   sp_trim_db, compaction.raw_length, compaction.delay, compaction.length,
+                   compaction.tail_removed, compaction.removed_energy_db);
+    }
+    
     log_printf("\n");
     
-    // ========== 3. 初始化时域仿真器 ==========
-    if (time_sim_init(&g_time_sim, ff_signal, fb_signal, total_samples, 
-                      sp_ir, sp_length) != 0) {
+    // ========== 3. 分析FFT（窗函数和旋转因子为静态表，扫参时各线程只读共享） ==========
+    fft_init(&g_fft_plan, FFT_LENGTH);
+    
+    // 谱分析通道并行：常驻线程池在各hop间复用；扫参时各配置已并行，不再嵌套
+    if (dsp_threads > 1) {
+        if (sweep_path) {
+            log_printf("Note: --dsp-threads ignored in sweep mode (configs already run in parallel)\n\n");
+        } else {
+            g_dsp_pool = thread_pool_create(dsp_threads);
+            log_printf("DSP analysis: %d threads (per-channel FFT and accumulation, %d channels)\n\n",
+                       thread_pool_size(g_dsp_pool), NUM_CHANNELS);
+        }
+    }
+    
+    int exit_code = 0;
+    
+    if (produce_name) {
+        // ========== 流式生产者：输入按实时节拍写入共享内存 ==========
+        exit_code = run_producer(ff_signal, fb_signal, total_samples, sample_rate_actual,
+                                 produce_name);
+    } else if (stream_name) {
+        // ========== 流式消费者：逐帧取共享内存数据处理 ==========
+        exit_code = run_stream(&params, &sp_spectrum, stream_name);
+    } else if (bench_frames > 0) {
+        // ========== 逐帧处理基准 ==========
+        exit_code = run_frame_bench(&params, &sp_spectrum, ff_signal, fb_signal, total_samples,
+                                    sample_rate_actual, bench_frames);
+    } else if (sim_check) {
+        // ========== 分段并行仿真自检 ==========
+        exit_code = run_sim_check(ff_signal, fb_signal, total_samples, sp_ir + sp_delay, sp_length,
+                                  sp_delay, sim_threads > 1 ? sim_threads : SIM_CHECK_THREADS, preconv);
+    } else if (sweep_path) {
+        // ========== 扫参模式：输入只解码一次，各配置并行评估 ==========
+        SweepInput input;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            input.ff_signal[r] = ff_signal[r];
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            input.fb_signal[e] = fb_signal[e];
+        }
+        input.total_samples = total_samples;
+        input.sample_rate = sample_rate_actual;
+        input.sp_ir = sp_ir + sp_delay;
+        input.sp_length = sp_length;
+        input.sp_delay = sp_delay;
+        input.sp_spectrum = &sp_spectrum;
+        input.engine = engine_type;
+        
+        // 预卷积参考与参数无关，全部配置共享一份
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            input.preconv_ff[r] = NULL;
+            if (preconv && exit_code == 0) {
+                input.preconv_ff[r] = time_sim_preconvolve(ff_signal[r], total_samples,
+                                                           sp_ir + sp_delay, sp_length, sp_delay,
+                                                           num_threads);
+                if (!input.preconv_ff[r]) exit_code = -1;
+            }
+        }
+        
+        SweepSpec spec;
+        if (exit_code != 0 ||
+            sweep_load_spec(sweep_path, &spec) != 0 ||
+            sweep_run(&spec, &params, sweep_evaluate, &input, num_threads, SWEEP_RESULT_PATH) != 0) {
+            exit_code = -1;
+        }
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free((void *)input.preconv_ff[r]);
+        }
+    } else {
+        exit_code = run_single(&params, ff_signal, fb_signal, total_samples, sample_rate_actual,
+                               sp_ir + sp_delay, sp_length, sp_delay, &sp_spectrum,
+                               resume_path, snapshot_interval, sim_threads, preconv, engine_type,
+                               fast_sim ? &fast : NULL);
+    }
+    
+    // ========== 清理资源 ==========
+    thread_pool_destroy(g_dsp_pool);
+    g_dsp_pool = NULL;
+    if (fast_sim) {
+        fast_sim_free(&fast);
+    }
+    
+    if (use_wav_input) {
+        wav_free(&wav_data);
+    } else if (need_input) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free(ff_signal[r]);
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            free(fb_signal[e]);
+        }
+    }
+    
+    logger_close();
+    
+    if (exit_code != 0) {
+        return exit_code;
+    }
+    
+    log_printf("\n==============================================\n");
+    log_printf("  System finished successfully\n");
+    log_printf("  Log file: %s\n", LOG_OUTPUT_PATH);
+    if (!produce_name && !stream_name && bench_frames <= 0 && !sim_check) {
+        log_printf("  Output WAV: %s\n", sweep_path ? SWEEP_RESULT_PATH : WAV_OUTPUT_PATH);
+    }
+    log_printf("==============================================\n");
+    
+    return 0;
+}
+
+// ============ 记录被覆盖的可调参数 ============
+static void log_overridden_params(const AncParams *params) {
+    AncParams defaults;
+    anc_params_default(&defaults);
+    
+    int count;
+    const AncParamDesc *table = anc_params_table(&count);
+    for (int i = 0; i < count; i++) {
+        double value = anc_params_get(params, &table[i]);
+        if (value != anc_params_get(&defaults, &table[i])) {
+            log_printf("  Override: %s = %g\n", table[i].name, value);
+        }
+    }
+}
+
+// ============ 单次运行：仿真、自适应、保存输出 ============
+// fast非NULL时闭环在降速率输入上运行，结束后按全速率重渲染最终参数，输出WAV取校验渲染结果
+static int run_single(const AncParams *params, float *const ff_signal[], float *const fb_signal[],
+                      int total_samples, int sample_rate,
+                      const float *sp_ir, int sp_length, int sp_delay, const SpSpectrum *sp_spectrum,
+                      const char *resume_path, int snapshot_interval, int sim_threads,
+                      int preconv, AdaptEngineType engine_type, const FastSimInput *fast) {
+    float *const *sim_ff = fast ? fast->ff_signal : ff_signal;
+    float *const *sim_fb = fast ? fast->fb_signal : fb_signal;
+    const int sim_samples = fast ? fast->total_samples : total_samples;
+    const int sim_rate = fast ? fast->sample_rate : sample_rate;
+    
+    // 初始化时域仿真器
+    if (time_sim_init(&g_time_sim, (const float *const *)sim_ff,
+                      (const float *const *)sim_fb, sim_samples,
+                      fast ? fast->sp_ir : sp_ir, fast ? fast->sp_length : sp_length,
+                      fast ? fast->sp_delay : sp_delay) != 0) {
         log_printf("Error: Failed to initialize time domain simulator\n");
         return -1;
     }
+    time_sim_set_threads(&g_time_sim, sim_threads);
+    if (preconv && time_sim_enable_preconv(&g_time_sim, NULL) != 0) {
+        log_printf("Error: Failed to pre-convolve reference signals\n");
+        time_sim_free(&g_time_sim);
+        return -1;
+    }
     
     log_printf("\n");
     
-    // ========== 4. 系统初始化 ==========
-    system_init();
+    // 系统初始化
+    system_init(&g_system_state, params, sp_spectrum);
+    
+    log_printf("\n");
+    
+    SnapshotCounters counters = {0, 0, sim_rate, params->iteration_time_ms};
+    
+    // 从快照恢复（覆盖system_init的结果、仿真器游标和已滤波的FB）
+    // 快照中的SystemState包含生成快照时的运行时参数，恢复后沿用
+    if (resume_path) {
+        if (snapshot_load(resume_path, &g_system_state, &g_time_sim, &counters) != 0) {
+            log_printf("Error: Failed to resume from snapshot %s\n", resume_path);
+            time_sim_free(&g_time_sim);
+            return -1;
+        }
+        if (g_system_state.zoom.num_bins != g_analysis_bins.num_bins ||
+            g_system_state.zoom.decimation != g_analysis_bins.decimation) {
+            log_printf("Error: Snapshot was taken with a different analysis band (%d bins), "
+                       "rerun with the same --zoom / --bins\n", g_system_state.zoom.num_bins);
+            time_sim_free(&g_time_sim);
+            return -1;
+        }
+        if (counters.sample_rate != sample_rate ||
+            counters.iteration_time_ms != g_system_state.params.iteration_time_ms) {
+            log_printf("Warning: Snapshot timing (%d Hz, %.1f ms) differs from current run\n",
+                       counters.sample_rate, counters.iteration_time_ms);
+        }
+        counters.sample_rate = sample_rate;
+        counters.iteration_time_ms = g_system_state.params.iteration_time_ms;
+        log_printf("Resuming at iteration %d\n\n", counters.iteration);
+    }
+    
+    AdaptEngine engine;
+    if (adapt_engine_create(&engine, engine_type, &g_system_state.params, &g_time_sim) != 0) {
+        log_printf("Error: Failed to create adaptation engine\n");
+        time_sim_free(&g_time_sim);
+        return -1;
+    }
+    
+    SweepResult result;
+    FeedforwardFilter applied_filters[ANC_NUM_REF];
+    int adapt_status = run_adaptation(&g_system_state, &g_time_sim, &engine, snapshot_interval,
+                                      &counters, &result, BAND_RESULT_PATH, fast ? sim_rate : 0,
+                                      applied_filters);
+    adapt_engine_destroy(&engine);
+    if (adapt_status != 0) {
+        time_sim_free(&g_time_sim);
+        return -1;
+    }
+    
+    float audio_s = (float)sim_samples / sim_rate;
+    log_printf("\n==============================================\n");
+    log_printf("  Adaptation Loop Completed (%s engine%s)\n", engine.name,
+               fast ? ", fast simulation" : "");
+    log_printf("  Total iterations: %d\n", counters.iteration);
+    log_printf("  Parameter updates applied: %d\n", counters.updates_applied);
+    log_printf("  Final attenuation: %.2f dB (converged at %.1f ms)\n",
+               result.final_attenuation_db, result.convergence_ms);
+    log_printf("  Adaptation CPU: %.1f ms for %.2f s of audio (%.1f ms per second, %.1fx realtime)\n",
+               result.adapt_cpu_ms, audio_s, result.adapt_cpu_ms / audio_s,
+               result.adapt_cpu_ms > 0.0f ? audio_s * 1000.0f / result.adapt_cpu_ms : 0.0f);
+    if (g_system_state.params.scheduler.max_idle_rounds > 0) {
+        log_printf("  Scheduler: adapted %d of %d rounds\n",
+                   g_system_state.sched.adapted_rounds, g_system_state.sched.rounds);
+    }
+    log_printf("==============================================\n\n");
+    
+    // 全速率校验：最后一次应用的参数从头渲染整段原始信号（未应用过更新时即不加控制）
+    TimeDomainSimulator *out_sim = &g_time_sim;
+    if (fast) {
+        if (time_sim_init_shared(&g_verify_sim, (const float *const *)ff_signal,
+                                 (const float *const *)fb_signal, total_samples,
+                                 sp_ir, sp_length, sp_delay) != 0) {
+            log_printf("Error: Failed to initialize full-rate verification simulator\n");
+            time_sim_free(&g_time_sim);
+            return -1;
+        }
+        time_sim_set_threads(&g_verify_sim, sim_threads);
+        if (preconv && time_sim_enable_preconv(&g_verify_sim, NULL) != 0) {
+            log_printf("Error: Failed to pre-convolve reference signals\n");
+            time_sim_free(&g_verify_sim);
+            time_sim_free(&g_time_sim);
+            return -1;
+        }
+        
+        double render_start_ms = monotonic_ms();
+        if (counters.updates_applied > 0) {
+            time_sim_process(&g_verify_sim, applied_filters, total_samples);
+        }
+        double render_ms = monotonic_ms() - render_start_ms;
+        
+        // 最后一轮时长内两种仿真的降噪量对比
+        int tail = (int)(g_system_state.params.iteration_time_ms * sample_rate / 1000.0f);
+        int fast_tail = (int)(g_system_state.params.iteration_time_ms * sim_rate / 1000.0f);
+        if (tail > total_samples) tail = total_samples;
+        if (fast_tail > sim_samples) fast_tail = sim_samples;
+        log_printf("Full-rate verification (%d Hz, final parameters from start, %.1f ms):\n",
+                   sample_rate, render_ms);
+        log_printf("  Last %.1f ms: %.2f dB at %d Hz vs %.2f dB at full rate\n",
+                   g_system_state.params.iteration_time_ms,
+                   block_attenuation_db(&g_time_sim, sim_samples - fast_tail, fast_tail), sim_rate,
+                   block_attenuation_db(&g_verify_sim, total_samples - tail, tail));
+        log_printf("  Whole signal: %.2f dB\n\n", block_attenuation_db(&g_verify_sim, 0, total_samples));
+        out_sim = &g_verify_sim;
+    }
+    
+    // 保存输出WAV文件
+    log_printf("Saving output WAV file...\n");
+    
+    // 输出通道: 各原始参考麦，随后各降噪后的误差麦
+    float *output_channels[ANC_NUM_REF + ANC_NUM_ERR];
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        output_channels[r] = (float *)out_sim->original_ff[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        output_channels[ANC_NUM_REF + e] = out_sim->simulated_fb[e];
+    }
+    
+    wav_write(WAV_OUTPUT_PATH, output_channels, ANC_NUM_REF + ANC_NUM_ERR,
+              total_samples, sample_rate);
     
     log_printf("\n");
+    
+    if (fast) {
+        time_sim_free(&g_verify_sim);
+    }
+    time_sim_free(&g_time_sim);
+    return 0;
+}
+
+// ============ 降速率快速仿真输入 ============
+// 参考麦/误差麦重采样到DSP_SAMPLE_RATE；次级路径连同前导延迟一起重采样，乘以 fs/fs_dsp 保持
+// 卷积增益（每个抽头代表的时间变长），再按同一门限重新裁剪首尾
+static int fast_sim_prepare(FastSimInput *fast, float *const ff_signal[], float *const fb_signal[],
+                            int total_samples, int sample_rate, const float *sp_ir, int sp_length,
+                            int sp_trim, float sp_trim_db) {
+    memset(fast, 0, sizeof(FastSimInput));
+    fast->sample_rate = DSP_SAMPLE_RATE;
+    fast->total_samples = resample_length(total_samples, sample_rate, DSP_SAMPLE_RATE);
+    
+    int status = 0;
+    for (int r = 0; r < ANC_NUM_REF && status == 0; r++) {
+        fast->ff_signal[r] = (float *)malloc(fast->total_samples * sizeof(float));
+        if (!fast->ff_signal[r] ||
+            resample_signal(ff_signal[r], total_samples, sample_rate, DSP_SAMPLE_RATE,
+                            fast->ff_signal[r]) != 0) {
+            status = -1;
+        }
+    }
+    for (int e = 0; e < ANC_NUM_ERR && status == 0; e++) {
+        fast->fb_signal[e] = (float *)malloc(fast->total_samples * sizeof(float));
+        if (!fast->fb_signal[e] ||
+            resample_signal(fb_signal[e], total_samples, sample_rate, DSP_SAMPLE_RATE,
+                            fast->fb_signal[e]) != 0) {
+            status = -1;
+        }
+    }
+    
+    float *ir = NULL;
+    int ir_length = resample_length(sp_length, sample_rate, DSP_SAMPLE_RATE);
+    if (status == 0) {
+        ir = (float *)malloc(ir_length * sizeof(float));
+        if (!ir || resample_signal(sp_ir, sp_length, sample_rate, DSP_SAMPLE_RATE, ir) != 0) {
+            status = -1;
+        }
+    }
+    if (status != 0) {
+        log_printf("Error: Failed to prepare fast simulation input\n");
+        free(ir);
+        fast_sim_free(fast);
+        return -1;
+    }
+    
+    const float gain = (float)sample_rate / DSP_SAMPLE_RATE;
+    for (int k = 0; k < ir_length; k++) {
+        ir[k] *= gain;
+    }
+    FIRCompaction compaction = {ir_length, 0, ir_length, 0, -INFINITY};
+    if (sp_trim) {
+        fir_compact(ir, ir_length, sp_trim_db, &compaction);
+    }
+    if (compaction.length > SP_IR_LENGTH) {
+        compaction.length = SP_IR_LENGTH;
+    }
+    fast->sp_delay = compaction.delay;
+    fast->sp_length = compaction.length;
+    memcpy(fast->sp_ir, ir + compaction.delay, compaction.length * sizeof(float));
+    free(ir);
+    
+    log_printf("Fast simulation: %d Hz -> %d Hz (%d -> %d samples), secondary path %d delay + %d taps\n",
+               sample_rate, DSP_SAMPLE_RATE, total_samples, fast->total_samples,
+               fast->sp_delay, fast->sp_length);
+    return 0;
+}
+
+static void fast_sim_free(FastSimInput *fast) {
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        free(fast->ff_signal[r]);
+        fast->ff_signal[r] = NULL;
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        free(fast->fb_signal[e]);
+        fast->fb_signal[e] = NULL;
+    }
+}
+
+// ============ 单调时钟 (ms) ============
+static double monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1.0e6;
+}
+
+static void sleep_ms(double ms) {
+    if (ms <= 0.0) return;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ms / 1000.0);
+    ts.tv_nsec = (long)((ms - ts.tv_sec * 1000.0) * 1.0e6);
+    nanosleep(&ts, NULL);
+}
+
+// ============ 流式生产者：按实时节拍把输入写入共享内存（采集端替身） ============
+static int run_producer(float *const ff_signal[], float *const fb_signal[], int total_samples,
+                        int sample_rate, const char *ring_name) {
+    const int channels = ANC_NUM_REF + ANC_NUM_ERR;
+    const int frame_samples = (sample_rate * PROCESS_INTERVAL_MS) / 1000;
+    
+    ShmRing ring;
+    if (shm_ring_create(&ring, ring_name, channels, sample_rate, STREAM_RING_FRAMES) != 0) {
+        return -1;
+    }
+    float *frames = (float *)malloc((size_t)frame_samples * channels * sizeof(float));
+    if (!frames) {
+        log_printf("Error: Failed to allocate stream frame\n");
+        shm_ring_destroy(&ring);
+        return -1;
+    }
+    
+    if (sample_rate != REALTIME_SAMPLE_RATE) {
+        log_printf("Warning: Input is %d Hz, stream paced at input rate instead of %d Hz\n",
+                   sample_rate, REALTIME_SAMPLE_RATE);
+    }
+    log_printf("Producing %.2f s into %s (%d-sample blocks, %d channels, paced at %d Hz)\n",
+               (float)total_samples / sample_rate, ring_name, frame_samples, channels, sample_rate);
+    logger_flush();
+    
+    const double start_ms = monotonic_ms();
+    for (int pos = 0; pos < total_samples; pos += frame_samples) {
+        int n = total_samples - pos < frame_samples ? total_samples - pos : frame_samples;
+        for (int i = 0; i < n; i++) {
+            float *frame = &frames[(size_t)i * channels];
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                frame[r] = ff_signal[r][pos + i];
+            }
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                frame[ANC_NUM_REF + e] = fb_signal[e][pos + i];
+            }
+        }
+        // 块内最后一个样本"采集到"的时刻才发布，按绝对时刻计算避免误差累积
+        sleep_ms(start_ms + (pos + n) * 1000.0 / sample_rate - monotonic_ms());
+        shm_ring_write(&ring, frames, n);
+    }
+    shm_ring_close_writer(&ring);
+    
+    unsigned long long dropped = (unsigned long long)atomic_load(&ring.header->dropped);
+    log_printf("Producer finished in %.2f s, %llu samples dropped (ring full)\n",
+               (monotonic_ms() - start_ms) / 1000.0, dropped);
+    
+    // 删除名字不影响消费者已建立的映射
+    free(frames);
+    shm_ring_destroy(&ring);
+    return 0;
+}
+
+// 状态名（超时报告用）
+static const char *process_state_name(ProcessState state) {
+    static const char *names[] = {
+        "SIGNAL_PROCESS", "CAL_MU", "CAL_FF_RESPONSE", "CAL_TARGET_FF",
+        "STABLE_CHECK", "CAL_FF_INIT_LOSS", "UPDATE_EQ_PARAMS", "UPDATE_FILTER_COEFFS",
+        "ADAPT_IDLE"
+    };
+    return (unsigned)state < sizeof(names) / sizeof(names[0]) ? names[state] : "UNKNOWN";
+}
+
+// ============ 流式消费者：数据到达即逐帧处理，报告超过帧间隔的处理 ============
+// 实时输入的误差麦已包含实际次级路径的作用，不做时域仿真，新参数只记录生效时刻
+static int run_stream(const AncParams *params, const SpSpectrum *sp_spectrum,
+                      const char *ring_name) {
+    ShmRing ring;
+    log_printf("Waiting for stream %s...\n", ring_name);
+    logger_flush();
+    const double connect_deadline = monotonic_ms() + STREAM_CONNECT_TIMEOUT_MS;
+    while (shm_ring_open(&ring, ring_name) != 0) {
+        if (monotonic_ms() > connect_deadline) {
+            log_printf("Error: Stream %s not available after %d ms\n",
+                       ring_name, STREAM_CONNECT_TIMEOUT_MS);
+            return -1;
+        }
+        sleep_ms(STREAM_POLL_MS);
+    }
+    
+    const int channels = (int)ring.header->num_channels;
+    const int sample_rate = (int)ring.header->sample_rate;
+    const int frame_samples = (sample_rate * PROCESS_INTERVAL_MS) / 1000;
+    if (channels != ANC_NUM_REF + ANC_NUM_ERR) {
+        log_printf("Error: Stream has %d channels, expected %d\n",
+                   channels, ANC_NUM_REF + ANC_NUM_ERR);
+        shm_ring_destroy(&ring);
+        return -1;
+    }
+    log_printf("Connected: %d channels at %d Hz, %d-sample frames\n\n",
+               channels, sample_rate, frame_samples);
+    
+    float *frames = (float *)malloc((size_t)frame_samples * channels * sizeof(float));
+    float *signal_buf = (float *)malloc((size_t)frame_samples * channels * sizeof(float));
+    float *spk_frame = (float *)calloc(frame_samples, sizeof(float));   // 无扬声器参考
+    if (!frames || !signal_buf || !spk_frame) {
+        log_printf("Error: Failed to allocate stream frame\n");
+        free(frames);
+        free(signal_buf);
+        free(spk_frame);
+        shm_ring_destroy(&ring);
+        return -1;
+    }
+    float *ff_frame[ANC_NUM_REF];
+    float *fb_frame[ANC_NUM_ERR];
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        ff_frame[r] = &signal_buf[(size_t)r * frame_samples];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        fb_frame[e] = &signal_buf[(size_t)(ANC_NUM_REF + e) * frame_samples];
+    }
+    
+    SystemState *state = &g_system_state;
+    system_init(state, params, sp_spectrum);
+    log_printf("\n");
+    
+    long long samples_done = 0;
+    int num_frames = 0;
+    int overruns = 0;
+    int updates = 0;
+    int max_backlog = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+    
+    for (;;) {
+        int backlog = shm_ring_available(&ring);
+        int n = shm_ring_read(&ring, frames, frame_samples);
+        if (n == 0) {
+            if (!shm_ring_is_closed(&ring)) {
+                sleep_ms(STREAM_POLL_MS);
+                continue;
+            }
+            // 生产者已结束：逐帧取完剩余数据，末尾不足一帧的部分单独处理
+            // （读失败与检查结束标志之间生产者可能又写入了整帧，每次至多读一帧）
+            backlog = shm_ring_available(&ring);
+            n = shm_ring_read(&ring, frames, backlog < frame_samples ? backlog : frame_samples);
+            if (n == 0) break;
+        }
+        if (backlog > max_backlog) max_backlog = backlog;
+        
+        for (int i = 0; i < n; i++) {
+            const float *frame = &frames[(size_t)i * channels];
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                ff_frame[r][i] = frame[r];
+            }
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                fb_frame[e][i] = frame[ANC_NUM_REF + e];
+            }
+        }
+        
+        ProcessState stage = state->state;
+        double t0 = monotonic_ms();
+        process_audio_frame(state, ff_frame, fb_frame, spk_frame, n);
+        double elapsed = monotonic_ms() - t0;
+        
+        float stream_time_ms = (float)(samples_done * 1000.0 / sample_rate);
+        samples_done += n;
+        num_frames++;
+        total_ms += elapsed;
+        if (elapsed > max_ms) max_ms = elapsed;
+        if (elapsed > PROCESS_INTERVAL_MS) {
+            overruns++;
+            log_printf("Overrun: frame %d at %.1f ms (%s) took %.2f ms > %d ms\n",
+                       num_frames - 1, stream_time_ms, process_state_name(stage),
+                       elapsed, PROCESS_INTERVAL_MS);
+        }
+        
+        if (state->state == SIGNAL_PROCESS && any_update_accepted(state)) {
+            updates++;
+            log_printf("Parameters updated at %.1f ms\n", stream_time_ms);
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                state->ff_ch[r].eq_update.update_accepted = 0;
+            }
+        }
+    }
+    
+    unsigned long long dropped = (unsigned long long)atomic_load(&ring.header->dropped);
+    log_printf("\n==============================================\n");
+    log_printf("  Stream Finished\n");
+    log_printf("  Frames: %d (%.2f s), parameter updates: %d\n",
+               num_frames, (double)samples_done / sample_rate, updates);
+    log_printf("  Processing: mean %.3f ms, max %.3f ms (budget %d ms)\n",
+               num_frames > 0 ? total_ms / num_frames : 0.0, max_ms, PROCESS_INTERVAL_MS);
+    log_printf("  Overruns: %d, max backlog %.1f ms, producer dropped %llu samples\n",
+               overruns, max_backlog * 1000.0 / sample_rate, dropped);
+    if (state->params.scheduler.max_idle_rounds > 0) {
+        log_printf("  Scheduler: adapted %d of %d rounds\n",
+                   state->sched.adapted_rounds, state->sched.rounds);
+    }
+    log_printf("==============================================\n");
+    
+    free(frames);
+    free(signal_buf);
+    free(spk_frame);
+    shm_ring_destroy(&ring);
+    return 0;
+}
+
+// ============ 分段并行仿真自检 ============
+// 各极端EQ参数下整段输入分别串行和按num_threads分段滤波，比较模拟误差麦信号:
+//   相对误差 = ||FB_并行 - FB_串行|| / ||FB_原始 - FB_串行||（相对抗噪声能量）
+// 每组参数只设第0级，其余级为0dB（直通），总增益为1
+static int run_sim_check(float *const ff_signal[], float *const fb_signal[], int total_samples,
+                         const float *sp_ir, int sp_length, int sp_delay, int num_threads,
+                         int preconv) {
+    static const BiquadParam cases[] = {
+        {BIQUAD_PEAKING, MAX_GAIN_DB, MAX_Q, MIN_FC},
+        {BIQUAD_PEAKING, MIN_GAIN_DB, MAX_Q, MIN_FC},
+        {BIQUAD_PEAKING, MAX_GAIN_DB, MAX_Q, MAX_FC},
+        {BIQUAD_LOWSHELF, MAX_GAIN_DB, MIN_Q, MIN_FC},
+        {BIQUAD_HIGHSHELF, MIN_GAIN_DB, MIN_Q, MAX_FC},
+    };
+    const int num_cases = (int)(sizeof(cases) / sizeof(cases[0]));
+    
+    TimeDomainSimulator sim;
+    memset(&sim, 0, sizeof(sim));
+    if (time_sim_init_shared(&sim, (const float *const *)ff_signal, (const float *const *)fb_signal,
+                             total_samples, sp_ir, sp_length, sp_delay) != 0 ||
+        (preconv && time_sim_enable_preconv(&sim, NULL) != 0)) {
+        log_printf("Error: Failed to initialize time domain simulator\n");
+        time_sim_free(&sim);
+        return -1;
+    }
+    
+    float *serial[ANC_NUM_ERR] = {NULL};
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        serial[e] = (float *)malloc(total_samples * sizeof(float));
+        if (!serial[e]) {
+            log_printf("Error: Failed to allocate simulation check buffers\n");
+            for (int j = 0; j < e; j++) {
+                free(serial[j]);
+            }
+            time_sim_free(&sim);
+            return -1;
+        }
+    }
+    
+    if (total_samples < 2 * SIM_SEGMENT_MIN_LENGTH) {
+        log_printf("Warning: Input too short to segment (%d samples), check is trivial\n",
+                   total_samples);
+    }
+    log_printf("Simulation check: %d threads vs serial, %s, tolerance %.1e\n",
+               num_threads, preconv ? "pre-convolved" : "direct", SIM_CHECK_TOLERANCE);
+    
+    int failures = 0;
+    for (int c = 0; c < num_cases; c++) {
+        FeedforwardFilter filters[ANC_NUM_REF];
+        memset(filters, 0, sizeof(filters));
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            for (int i = 0; i < NUM_BIQUADS; i++) {
+                BiquadParam param = {BIQUAD_PEAKING, 0.0f, 1.0f, 1000.0f};
+                if (i == 0) {
+                    param = cases[c];
+                }
+                eq_to_biquad_coeffs(&param, REALTIME_SAMPLE_RATE, &filters[r].coeffs[i]);
+            }
+            filters[r].total_gain = 1.0f;
+        }
+        
+        time_sim_set_threads(&sim, 1);
+        time_sim_process(&sim, filters, total_samples);
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            memcpy(serial[e], sim.simulated_fb[e], total_samples * sizeof(float));
+        }
+        time_sim_set_threads(&sim, num_threads);
+        time_sim_process(&sim, filters, total_samples);
+        
+        double diff = 0.0, anti = 0.0;
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            for (int n = 0; n < total_samples; n++) {
+                double d = (double)sim.simulated_fb[e][n] - serial[e][n];
+                double a = (double)fb_signal[e][n] - serial[e][n];
+                diff += d * d;
+                anti += a * a;
+            }
+        }
+        double rel = anti > 0.0 ? sqrt(diff / anti) : sqrt(diff);
+        int pass = rel <= SIM_CHECK_TOLERANCE;
+        if (!pass) failures++;
+        log_printf("  type=%d fc=%.0f Hz Q=%.1f gain=%+.0f dB: relative error %.3e %s\n",
+                   cases[c].type, cases[c].fc, cases[c].q, cases[c].gain_dB, rel,
+                   pass ? "PASS" : "FAIL");
+    }
+    
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        free(serial[e]);
+    }
+    time_sim_free(&sim);
+    
+    log_printf("Simulation check: %s (%d/%d cases failed)\n",
+               failures ? "FAILED" : "PASSED", failures, num_cases);
+    return failures ? -1 : 0;
+}
+
+// ============ 逐帧处理基准 ============
+// 对输入的前num_frames帧（不足时循环）计时process_audio_frame，热/冷缓存各跑一遍，
+// 每遍从system_init开始，状态机走过的帧序列相同
+static int run_frame_bench(const AncParams *params, const SpSpectrum *sp_spectrum,
+                           float *const ff_signal[], float *const fb_signal[],
+                           int total_samples, int sample_rate, int num_frames) {
+    const int frame_samples = (sample_rate * PROCESS_INTERVAL_MS) / 1000;
+    if (total_samples < frame_samples) {
+        log_printf("Error: Input shorter than one frame\n");
+        return -1;
+    }
+    const int input_frames = total_samples / frame_samples;
+    
+    float *spk_frame = (float *)calloc(frame_samples, sizeof(float));
+    unsigned char *evict = (unsigned char *)malloc(BENCH_EVICT_BYTES);
+    if (!spk_frame || !evict) {
+        log_printf("Error: Failed to allocate benchmark buffers\n");
+        free(spk_frame);
+        free(evict);
+        return -1;
+    }
+    memset(evict, 1, BENCH_EVICT_BYTES);
+    
+    SystemState *state = &g_system_state;
+    const size_t hot_bytes = offsetof(SystemState, ff_avg);
+    log_printf("State layout: %zu bytes, per-frame region %zu bytes (%zu cache lines, "
+               "%zu pages)\n", sizeof(SystemState), hot_bytes, (hot_bytes + 63) / 64,
+               (hot_bytes + 4095) / 4096);
+    log_printf("Benchmarking %d frames of %d samples (%d distinct input frames)\n\n",
+               num_frames, frame_samples, input_frames);
+    logger_flush();
+    
+    for (int cold = 0; cold <= 1; cold++) {
+        system_init(state, params, sp_spectrum);
+        
+        double signal_ms = 0.0, fft_ms = 0.0, max_ms = 0.0, total_ms = 0.0;
+        int signal_frames = 0, fft_frames = 0;
+        unsigned sink = 0;
+        for (int f = 0; f < num_frames; f++) {
+            const size_t pos = (size_t)(f % input_frames) * frame_samples;
+            float *ff_frame[ANC_NUM_REF];
+            float *fb_frame[ANC_NUM_ERR];
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                ff_frame[r] = &ff_signal[r][pos];
+            }
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                fb_frame[e] = &fb_signal[e][pos];
+            }
+            
+            if (cold) {
+                // 每行读一个字节即可把整行换入，逐出之前的状态
+                for (size_t i = 0; i < BENCH_EVICT_BYTES; i += 64) {
+                    sink += evict[i];
+                }
+            }
+            
+            ProcessState stage = state->state;
+            int fft_before = state->fft_count;
+            double t0 = monotonic_ms();
+            process_audio_frame(state, ff_frame, fb_frame, spk_frame, frame_samples);
+            double elapsed = monotonic_ms() - t0;
+            total_ms += elapsed;
+            
+            // 每帧路径（SIGNAL_PROCESS）单独统计，每轮一次的状态只计入总平均
+            if (stage != SIGNAL_PROCESS) continue;
+            signal_frames++;
+            signal_ms += elapsed;
+            if (elapsed > max_ms) max_ms = elapsed;
+            if (state->fft_count != fft_before || state->state != SIGNAL_PROCESS) {
+                fft_frames++;
+                fft_ms += elapsed;
+            }
+        }
+        evict[0] = (unsigned char)sink;   // 防止扫描被优化掉
+        
+        int copy_frames = signal_frames - fft_frames;
+        log_printf("%s cache: %d per-frame calls, mean %.2f us, max %.2f us | "
+                   "FFT hop %d x %.2f us, buffer-only %d x %.2f us\n",
+                   cold ? "Cold" : "Warm", signal_frames,
+                   signal_frames > 0 ? signal_ms * 1000.0 / signal_frames : 0.0, max_ms * 1000.0,
+                   fft_frames, fft_frames > 0 ? fft_ms * 1000.0 / fft_frames : 0.0,
+                   copy_frames, copy_frames > 0 ? (signal_ms - fft_ms) * 1000.0 / copy_frames : 0.0);
+        log_printf("%s cache: all %d frames mean %.2f us, adaptation states %d x %.2f us\n",
+                   cold ? "Cold" : "Warm", num_frames, total_ms * 1000.0 / num_frames,
+                   num_frames - signal_frames, num_frames > signal_frames ?
+                   (total_ms - signal_ms) * 1000.0 / (num_frames - signal_frames) : 0.0);
+    }
+    
+    free(spk_frame);
+    free(evict);
+    return 0;
+}
+
+// ============ 扫参评估：单个配置完整运行一次自适应 ============
+static int sweep_evaluate(const AncParams *params, SweepResult *result, void *ctx) {
+    const SweepInput *input = (const SweepInput *)ctx;
+    
+    // 每个配置独立的状态和仿真器（结构体较大，放在堆上）
+    SystemState *state = (SystemState *)anc_aligned_alloc(sizeof(SystemState));
+    TimeDomainSimulator *sim = (TimeDomainSimulator *)malloc(sizeof(TimeDomainSimulator));
+    if (!state || !sim) {
+        anc_aligned_free(state);
+        free(sim);
+        return -1;
+    }
+    memset(sim, 0, sizeof(TimeDomainSimulator));
+    
+    int status = -1;
+    if (time_sim_init_shared(sim, input->ff_signal, input->fb_signal, input->total_samples,
+                             input->sp_ir, input->sp_length, input->sp_delay) == 0 &&
+        (!input->preconv_ff[0] || time_sim_enable_preconv(sim, input->preconv_ff) == 0)) {
+        system_init(state, params, input->sp_spectrum);
+        SnapshotCounters counters = {0, 0, input->sample_rate, params->iteration_time_ms};
+        AdaptEngine engine;
+        if (adapt_engine_create(&engine, input->engine, params, sim) == 0) {
+            status = run_adaptation(state, sim, &engine, 0, &counters, result, NULL, 0, NULL);
+            adapt_engine_destroy(&engine);
+        }
+    }
+    
+    time_sim_free(sim);
+    free(sim);
+    anc_aligned_free(state);
+    return status;
+}
+
+// ============ 一段误差麦信号的降噪量 ============
+// 10*log10(Σ原始误差麦能量 / Σ降噪后误差麦能量)，对全部误差麦求和
+static float block_attenuation_db(const TimeDomainSimulator *sim, int start, int num_samples) {
+    double original_energy = 1e-20;
+    double residual_energy = 1e-20;
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        const float *orig = &sim->original_fb[e][start];
+        const float *res = &sim->simulated_fb[e][start];
+        for (int i = 0; i < num_samples; i++) {
+            original_energy += (double)orig[i] * orig[i];
+            residual_energy += (double)res[i] * res[i];
+        }
+    }
+    return (float)(10.0 * log10(original_energy / residual_energy));
+}
+
+// ============ 分频带降噪量表：每轮一行，每个频带一列 ============
+static void write_band_csv(const char *path, const BandAnalyzer *bands, const float *band_db,
+                           const int *band_frames, const float *attenuation_db,
+                           const float *start_time_ms, int rows, int first_iteration) {
+    FILE *csv = fopen(path, "w");
+    if (!csv) {
+        log_printf("Warning: Cannot create band analysis file: %s\n", path);
+        return;
+    }
+    
+    fprintf(csv, "iteration,start_ms,frames,broadband_db");
+    for (int b = 0; b < bands->num_bands; b++) {
+        fprintf(csv, ",%.4gHz", bands->center_hz[b]);
+    }
+    fprintf(csv, "\n");
+    for (int i = 0; i < rows; i++) {
+        fprintf(csv, "%d,%.1f,%d,%.2f", first_iteration + i, start_time_ms[i], band_frames[i],
+                attenuation_db[i]);
+        for (int b = 0; b < bands->num_bands; b++) {
+            fprintf(csv, ",%.2f", band_db[(size_t)i * bands->num_bands + b]);
+        }
+        fprintf(csv, "\n");
+    }
+    fclose(csv);
+    log_printf("Band attenuation (%d iterations x %d bands): %s\n", rows, bands->num_bands, path);
+}
+
+// ============ EQ引擎：整块送入DSP状态机 ============
+// 从仿真器当前位置取target_samples个样本，一次调用process_audio_block，返回样本数，frame_count为状态机步数
+static int run_dsp_frames(SystemState *state, TimeDomainSimulator *sim, int target_samples,
+                          int sample_rate, int *frame_count) {
+    // 整轮信号一次取出，块处理接口内按帧推进状态机（扬声器通道为零）
+    float *ff_block[ANC_NUM_REF];
+    float *fb_block[ANC_NUM_ERR];
+    int ok = 1;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        ff_block[r] = (float *)malloc(target_samples * sizeof(float));
+        ok = ok && ff_block[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        fb_block[e] = (float *)malloc(target_samples * sizeof(float));
+        ok = ok && fb_block[e];
+    }
+    
+    int got_samples = 0;
+    *frame_count = 0;
+    if (ok) {
+        got_samples = time_sim_get_signals(sim, ff_block, fb_block, target_samples);
+        if (got_samples > 0) {
+            *frame_count = process_audio_block(state, ff_block, fb_block, NULL, got_samples,
+                                               sample_rate);
+        }
+    } else {
+        log_printf("Error: Failed to allocate DSP input block (%d samples)\n", target_samples);
+    }
+    
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        free(ff_block[r]);
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        free(fb_block[e]);
+    }
+    return got_samples > 0 ? got_samples : 0;
+}
+
+// ============ 仿真器采样率下的前馈滤波器 ============
+// DSP给出的系数按REALTIME_SAMPLE_RATE设计；filter_rate非0时（降速率仿真）按同一组EQ参数在该采样率下
+// 重新设计，fc限制在FAST_SIM_MAX_FC_RATIO倍采样率以下（更高的级在该采样率下无法实现）
+static void design_sim_filters(const SystemState *state, int filter_rate,
+                               FeedforwardFilter filters[ANC_NUM_REF]) {
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        filters[r] = state->ff_ch[r].ff_filter;
+        if (filter_rate <= 0) {
+            continue;
+        }
+        const float max_fc = FAST_SIM_MAX_FC_RATIO * filter_rate;
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            BiquadParam param = state->ff_ch[r].eq_update.params[i];
+            if (param.fc > max_fc) {
+                param.fc = max_fc;
+            }
+            eq_to_biquad_coeffs(&param, (float)filter_rate, &filters[r].coeffs[i]);
+        }
+    }
+}
+
+// ============ 自适应主循环 ============
+// filter_rate: 0=仿真器与DSP系数同为全速率，否则为降速率仿真的采样率（见design_sim_filters）
+// applied_filters: 非NULL时输出最后一次应用到仿真器的全速率滤波器（ANC_NUM_REF个）
+// 返回0=成功, -1=内存不足（未开始迭代）
+static int run_adaptation(SystemState *state, TimeDomainSimulator *sim, const AdaptEngine *engine,
+                          int snapshot_interval, SnapshotCounters *counters, SweepResult *result,
+                          const char *band_csv_path, int filter_rate,
+                          FeedforwardFilter applied_filters[]) {
     log_printf("==============================================\n");
     log_printf("  Starting Iterative Adaptation Loop\n");
     log_printf("==============================================\n\n");
     
-    // ========== 5. 主迭代循环 ==========
-    // 
     // 【正确的FFT时序】（按用户说明）:
     // - 累积0-100ms @ 32kHz = 3200样本
     // - 第1次FFT: 使用0-100ms数据（取前2048样本 = 0-64ms）
@@ -200,21 +1401,56 @@ int main(void) {
     // 注意：当前config.h中FFT_HOP_SIZE=512(16ms)需要改为800(25ms)
     //      或者在这里直接按325ms一轮计算
     
-    int iteration = 0;
-    int max_iterations = 100;
+    const int total_samples = sim->total_samples;
+    const int sample_rate_actual = counters->sample_rate;
+    int iteration = counters->iteration;
+    int updates_applied = counters->updates_applied;
+    int max_iterations = state->params.max_iterations;
     
-    // 每轮迭代时间：325ms (用户指定)
-    float iteration_time_ms = 325.0f;
+    // 每轮迭代时间（默认325ms）
+    float iteration_time_ms = state->params.iteration_time_ms;
     int iteration_samples = (int)(iteration_time_ms * sample_rate_actual / 1000.0f);
     
+    // 自适应计算耗时（EQ引擎: DSP处理 + 重滤波；其余引擎: 闭环处理），不含降噪量统计
+    double adapt_cpu_ms = 0.0;
+    
+    // 每轮降噪量及起始时刻，用于计算收敛时间
+    int history_len = 0;
+    int history_cap = max_iterations > iteration ? max_iterations - iteration : 1;
+    float *attenuation_db = (float *)malloc(history_cap * sizeof(float));
+    float *start_time_ms = (float *)malloc(history_cap * sizeof(float));
+    
+    // 分频带降噪量（每轮一行），与仿真同步逐轮分析
+    // 降采样后的Nyquist频率须高于最高分析频带（降速率仿真时不做分频带分析）
+    const int use_bands = sample_rate_actual >= 2.0f * BAND_HIGH_HZ * BAND_DECIMATION;
+    BandAnalyzer *bands = NULL;
+    if (use_bands) {
+        bands = (BandAnalyzer *)malloc(sizeof(BandAnalyzer));
+    }
+    float *band_db = NULL;
+    int *band_frames = (int *)malloc(history_cap * sizeof(int));
+    if (bands) {
+        band_analyzer_init(bands, &g_fft_plan, sample_rate_actual);
+        band_db = (float *)malloc((size_t)history_cap * bands->num_bands * sizeof(float));
+    }
+    if (!attenuation_db || !start_time_ms || !band_frames || (use_bands && !band_db)) {
+        log_printf("Error: Failed to allocate adaptation history (%d rounds)\n", history_cap);
+        free(attenuation_db);
+        free(start_time_ms);
+        free(bands);
+        free(band_db);
+        free(band_frames);
+        return -1;
+    }
+    
     log_printf("Iteration Timing:\n");
     log_printf("  Each iteration processes: %.1f ms (%d samples @ %d Hz)\n", 
                iteration_time_ms, iteration_samples, sample_rate_actual);
     log_printf("  Sequence: 0-%.1fms DSP -> Filter %.1fms-end -> Next from %.1fms\n\n",
                iteration_time_ms, iteration_time_ms, iteration_time_ms);
     
-    while (g_time_sim.current_sample < total_samples && iteration < max_iterations) {
-        int iteration_start_sample = g_time_sim.current_sample;
+    while (sim->current_sample < total_samples && iteration < max_iterations) {
+        int iteration_start_sample = sim->current_sample;
         float iteration_start_time_ms = (float)iteration_start_sample * 1000.0f / sample_rate_actual;
         float iteration_end_time_ms = iteration_start_time_ms + iteration_time_ms;
         
@@ -225,12 +1461,17 @@ int main(void) {
         log_printf("╚══════════════════════════════════════════════════════════════╝\n");
         log_printf("\n");
         
-        // 5.1 处理这一轮的所有帧 (0-325ms的数据)
-        log_printf("[Phase 1] DSP Processing (%.1f-%.1f ms)\n", 
-                   iteration_start_time_ms, iteration_end_time_ms);
-        log_printf("  - Accumulating 100ms\n");
-        log_printf("  - Then 10x FFT with 75%% overlap\n");
-        log_printf("  - Calculate parameters\n\n");
+        // 1. 处理这一轮的所有帧 (0-325ms的数据)
+        if (engine->process) {
+            log_printf("[Phase 1] %s closed loop (%.1f-%.1f ms)\n", engine->name,
+                       iteration_start_time_ms, iteration_end_time_ms);
+        } else {
+            log_printf("[Phase 1] DSP Processing (%.1f-%.1f ms)\n", 
+                       iteration_start_time_ms, iteration_end_time_ms);
+            log_printf("  - Accumulating 100ms\n");
+            log_printf("  - Then %dx FFT with 75%% overlap\n", state->params.num_fft_average);
+            log_printf("  - Calculate parameters\n\n");
+        }
         
         int samples_processed = 0;
         int target_samples = iteration_samples;
@@ -239,38 +1480,18 @@ int main(void) {
         }
         
         int frame_count_this_iteration = 0;
-        
-        // 逐帧处理
-        while (samples_processed < target_samples) {
-            int samples_per_frame = (sample_rate_actual * PROCESS_INTERVAL_MS) / 1000;
-            int remaining = target_samples - samples_processed;
-            if (samples_per_frame > remaining) {
-                samples_per_frame = remaining;
+        double phase_start_ms = monotonic_ms();
+        if (engine->process) {
+            // 引擎闭环：逐样本输出并更新控制器，本轮降噪后信号直接写入仿真器
+            samples_processed = engine->process(engine->ctx, sim, target_samples);
+            if (samples_processed < 0) {
+                samples_processed = 0;
             }
-            
-            float *ff_frame = (float *)malloc(samples_per_frame * sizeof(float));
-            float *fb_frame = (float *)malloc(samples_per_frame * sizeof(float));
-            float *spk_frame = (float *)calloc(samples_per_frame, sizeof(float));
-            
-            int got_samples = time_sim_get_signals(&g_time_sim, ff_frame, fb_frame, samples_per_frame);
-            
-            if (got_samples <= 0) {
-                free(ff_frame);
-                free(fb_frame);
-                free(spk_frame);
-                break;
-            }
-            
-            // 处理音频帧 (DSP算法：降采样、FFT、参数计算)
-            process_audio_frame(ff_frame, fb_frame, spk_frame, got_samples);
-            
-            samples_processed += got_samples;
-            frame_count_this_iteration++;
-            
-            free(ff_frame);
-            free(fb_frame);
-            free(spk_frame);
+        } else {
+            samples_processed = run_dsp_frames(state, sim, target_samples, sample_rate_actual,
+                                               &frame_count_this_iteration);
         }
+        adapt_cpu_ms += monotonic_ms() - phase_start_ms;
         
         if (samples_processed == 0) {
             log_printf("  No more samples, ending\n");
@@ -278,19 +1499,46 @@ int main(void) {
         }
         
         float actual_processed_time = (float)samples_processed * 1000.0f / sample_rate_actual;
+        float attenuation = block_attenuation_db(sim, iteration_start_sample, samples_processed);
         log_printf("  ✓ Processed: %.1f ms (%d samples, %d frames)\n", 
                    actual_processed_time, samples_processed, frame_count_this_iteration);
-        log_printf("  ✓ DSP State: %s\n", 
-                   g_system_state.state == SIGNAL_PROCESS ? "Parameters Updated" : "Processing");
+        log_printf("  ✓ Attenuation: %.2f dB\n", attenuation);
+        if (!engine->process) {
+            log_printf("  ✓ DSP State: %s\n", 
+                       state->state == SIGNAL_PROCESS ? "Parameters Updated" : "Processing");
+        }
         
-        // 5.2 如果完成了参数计算，进行时域滤波
-        if (g_system_state.state == SIGNAL_PROCESS && 
-            g_system_state.eq_update.update_accepted) {
+        if (history_len < history_cap) {
+            attenuation_db[history_len] = attenuation;
+            start_time_ms[history_len] = iteration_start_time_ms;
+            if (bands && band_db && band_frames) {
+                // 本轮范围内的降噪后信号已定型（下面的重滤波只改写当前位置之后）
+                float *row = &band_db[(size_t)history_len * bands->num_bands];
+                band_analyzer_feed(bands, sim->original_fb, (const float *const *)sim->simulated_fb,
+                                   iteration_start_sample, samples_processed);
+                band_frames[history_len] = band_analyzer_end_block(bands, row);
+                if (band_frames[history_len] > 0) {
+                    int lo = 0, hi = 0;
+                    for (int b = 1; b < bands->num_bands; b++) {
+                        if (row[b] < row[lo]) lo = b;
+                        if (row[b] > row[hi]) hi = b;
+                    }
+                    log_printf("  ✓ Bands: %.2f dB @ %.4g Hz (min) ~ %.2f dB @ %.4g Hz (max)\n",
+                               row[lo], bands->center_hz[lo], row[hi], bands->center_hz[hi]);
+                }
+            }
+            history_len++;
+        }
+        
+        // 2. 如果完成了参数计算，进行时域滤波（闭环引擎在Phase 1中已逐样本更新，每轮计一次更新）
+        if (engine->process) {
+            updates_applied++;
+        } else if (state->state == SIGNAL_PROCESS && any_update_accepted(state)) {
             
             log_printf("\n[Phase 2] Time Domain Filtering\n");
             
             // 计算剩余样本数 (从当前位置到结束)
-            int filter_start_sample = g_time_sim.current_sample;
+            int filter_start_sample = sim->current_sample;
             int remaining_samples = total_samples - filter_start_sample;
             
             if (remaining_samples > 0) {
@@ -303,124 +1551,154 @@ int main(void) {
                 log_printf("  Applying new Biquad parameters...\n");
                 
                 // 对所有剩余信号进行时域滤波
-                time_sim_process(&g_time_sim,
-                                g_system_state.ff_filter.coeffs,
-                                g_system_state.ff_filter.total_gain,
-                                remaining_samples);
+                FeedforwardFilter filters[ANC_NUM_REF];
+                design_sim_filters(state, filter_rate, filters);
+                if (applied_filters) {
+                    for (int r = 0; r < ANC_NUM_REF; r++) {
+                        applied_filters[r] = state->ff_ch[r].ff_filter;
+                    }
+                }
+                double filter_start_ms = monotonic_ms();
+                time_sim_process(sim, filters, remaining_samples);
+                adapt_cpu_ms += monotonic_ms() - filter_start_ms;
                 
                 log_printf("  ✓ Filtering complete\n");
                 log_printf("\n");
                 log_printf("  Next iteration will use:\n");
                 log_printf("    FF: Original signal from %.1f ms\n", filter_start_time);
                 log_printf("    FB: Filtered signal from %.1f ms\n", filter_start_time);
+                updates_applied++;
             } else {
                 log_printf("  No remaining samples to filter\n");
             }
             
-            g_system_state.eq_update.update_accepted = 0;
-        } else {
-            log_printf("\n[Phase 2] Skipped (parameters not updated)\n");
-        }
-        
-        iteration++;
-        
-        // 每5次迭代刷新日志
-        if (iteration % 5 == 0) {
-            logger_flush();
-        }
-    }
-    
-    log_printf("\n==============================================\n");
-    log_printf("  Adaptation Loop Completed\n");
-    log_printf("  Total iterations: %d\n", iteration);
-    log_printf("==============================================\n\n");
-    
-    // ========== 6. 保存输出WAV文件 ==========
-    log_printf("Saving output WAV file...\n");
-    
-    float *output_channels[2];
-    output_channels[0] = g_time_sim.original_ff;  // 原始参考麦
-    output_channels[1] = g_time_sim.simulated_fb; // 降噪后的误差麦
-    
-    wav_write(WAV_OUTPUT_PATH, output_channels, 2, total_samples, sample_rate_actual);
-    
-    log_printf("\n");
-    
-    // ========== 7. 清理资源 ==========
-    time_sim_free(&g_time_sim);
-    
-    if (use_wav_input) {
-        wav_free(&wav_data);
-    } else {
-        free(ff_signal);
-        free(fb_signal);
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                state->ff_ch[r].eq_update.update_accepted = 0;
+            }
+        } else {
+            log_printf("\n[Phase 2] Skipped (parameters not updated)\n");
+        }
+        
+        iteration++;
+        
+        // 定期保存快照（保存的是下一轮开始前的状态）
+        if (snapshot_interval > 0 && iteration % snapshot_interval == 0) {
+            char snapshot_path[256];
+            SnapshotCounters snap_counters = {iteration, updates_applied,
+                                              sample_rate_actual, iteration_time_ms};
+            snprintf(snapshot_path, sizeof(snapshot_path), SNAPSHOT_PATH_FORMAT, iteration);
+            snapshot_save(snapshot_path, state, sim, &snap_counters);
+        }
+        
+        // 每5次迭代刷新日志
+        if (iteration % 5 == 0) {
+            logger_flush();
+        }
     }
     
-    logger_close();
-    
-    log_printf("\n==============================================\n");
-    log_printf("  System finished successfully\n");
-    log_printf("  Log file: %s\n", LOG_OUTPUT_PATH);
-    log_printf("  Output WAV: %s\n", WAV_OUTPUT_PATH);
-    log_printf("==============================================\n");
+    counters->iteration = iteration;
+    counters->updates_applied = updates_applied;
+    
+    // 最终降噪量取最后一轮；收敛时间为此后各轮均落在最终值±容差内的最早一轮起始时刻
+    memset(result, 0, sizeof(SweepResult));
+    result->iterations = iteration;
+    result->updates_applied = updates_applied;
+    result->adapt_cpu_ms = (float)adapt_cpu_ms;
+    if (history_len > 0) {
+        float final_db = attenuation_db[history_len - 1];
+        int converged = history_len - 1;
+        while (converged > 0 &&
+               fabsf(attenuation_db[converged - 1] - final_db) <= CONVERGENCE_TOL_DB) {
+            converged--;
+        }
+        result->final_attenuation_db = final_db;
+        result->convergence_ms = start_time_ms[converged];
+        
+        if (bands && band_db && band_frames) {
+            result->num_bands = bands->num_bands;
+            memcpy(result->band_attenuation_db, &band_db[(size_t)(history_len - 1) * bands->num_bands],
+                   bands->num_bands * sizeof(float));
+            if (band_csv_path) {
+                write_band_csv(band_csv_path, bands, band_db, band_frames, attenuation_db,
+                               start_time_ms, history_len, iteration - history_len);
+            }
+        }
+    }
     
+    free(attenuation_db);
+    free(start_time_ms);
+    free(bands);
+    free(band_db);
+    free(band_frames);
     return 0;
 }
 
 // ============ 系统初始化 ============
-void system_init(void) {
-    memset(&g_system_state, 0, sizeof(SystemState));
+void system_init(SystemState *state, const AncParams *params, const SpSpectrum *sp) {
+    memset(state, 0, sizeof(SystemState));
+    state->params = *params;
     
     // 初始化状态
-    g_system_state.state = SIGNAL_PROCESS;
-    g_system_state.current_preset_index = 0;  // 使用第一套预制参数
+    state->state = SIGNAL_PROCESS;
+    state->current_preset_index = 0;  // 使用第一套预制参数
+    zoom_init(&state->zoom, &g_analysis_bins);
+    
+    // 次级路径频响由加载的冲击响应算得，各(误差麦, 扬声器)对共用同一冲击响应
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            state->secondary_path[e][r] = sp->response;
+        }
+    }
     
-    // 加载预制次级路径
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        g_system_state.secondary_path[i].real = secondary_path[g_system_state.current_preset_index][i * 2];
-        g_system_state.secondary_path[i].imag = secondary_path[g_system_state.current_preset_index][i * 2 + 1];
+    // 各扬声器到全部误差麦的Σ|S_er(ω)|²，供calculate_mu使用（|S|²已随频响预计算）
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        float *sp_power = state->ff_ch[r].sp_power;
+        memcpy(sp_power, sp->power, sizeof(sp->power));
+        for (int e = 1; e < ANC_NUM_ERR; e++) {
+            for (int i = 0; i < SPECTRUM_LENGTH; i++) {
+                sp_power[i] += sp->power[i];
+            }
+        }
     }
     
     // 加载预制EQ参数并转换为滤波器系数
-    EQPreset *preset = (EQPreset *)&eq_presets[g_system_state.current_preset_index];
-    
-    // 初始化EQ更新状态
-    for (int i = 0; i < NUM_BIQUADS; i++) {
-        g_system_state.eq_update.params[i] = preset->biquads[i];
-        eq_to_biquad_coeffs(&g_system_state.eq_update.params[i], REALTIME_SAMPLE_RATE, 
-                            &g_system_state.ff_filter.coeffs[i]);
+    EQPreset *preset = (EQPreset *)&eq_presets[state->current_preset_index];
+    
+    // 初始化各通道EQ更新状态
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        FFChannel *ch = &state->ff_ch[r];
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            ch->eq_update.params[i] = preset->biquads[i];
+            eq_to_biquad_coeffs(&ch->eq_update.params[i], REALTIME_SAMPLE_RATE, 
+                                &ch->ff_filter.coeffs[i]);
+        }
+        ch->eq_update.total_gain_dB = preset->total_gain_dB;
+        ch->ff_filter.total_gain = powf(10.0f, preset->total_gain_dB / 20.0f);
+        ch->eq_update.init_loss = 0.0f;
+        ch->eq_update.current_loss = 0.0f;
+        ch->eq_update.update_accepted = 0;
     }
-    g_system_state.eq_update.total_gain_dB = preset->total_gain_dB;
-    g_system_state.ff_filter.total_gain = powf(10.0f, preset->total_gain_dB / 20.0f);
-    g_system_state.eq_update.init_loss = 0.0f;
-    g_system_state.eq_update.current_loss = 0.0f;
-    g_system_state.eq_update.update_accepted = 0;
     
     // 初始化稳定性检测
-    memset(g_system_state.prev_target_ff, 0, sizeof(g_system_state.prev_target_ff));
-    g_system_state.prev_smoothness = 1.0f;  // 初始值设为较小的数
-    g_system_state.target_valid = 1;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        stability_init(&state->ff_ch[r].stability, &g_analysis_bins, params->stable_check_freq_low,
+                       params->stable_check_freq_high, &params->stability);
+    }
+    state->target_valid = 1;
     
-    // 初始化Blackman窗
-    init_blackman_window();
+    // 初始化优化器评估网格
+    eval_grid_init(&state->eval_grid, &g_analysis_bins, EVAL_GRID_MODE, params->eval_grid_freq_low,
+                   params->eval_grid_freq_high, params->eval_grid_num_points);
     
-    log_printf("System initialized with preset %d\n", g_system_state.current_preset_index);
-}
-
-// ============ 初始化Blackman窗 ============
-void init_blackman_window(void) {
-    const float a0 = 0.42f;
-    const float a1 = 0.5f;
-    const float a2 = 0.08f;
+    // 事件驱动调度：在评估网格频段内汇总
+    scheduler_init(&state->sched, &g_analysis_bins, params->eval_grid_freq_low,
+                   params->eval_grid_freq_high);
     
-    for (int i = 0; i < FFT_LENGTH; i++) {
-        blackman_window[i] = a0 - a1 * cosf(2.0f * M_PI * i / (FFT_LENGTH - 1)) 
-                                + a2 * cosf(4.0f * M_PI * i / (FFT_LENGTH - 1));
-    }
+    log_printf("System initialized with preset %d\n", state->current_preset_index);
 }
 
 // ============ 抗混叠降采样 ============
-void anti_alias_decimate(float *input, int input_len, float *output, int output_len) {
+void anti_alias_decimate(const float *input, int input_len, float *output, int output_len) {
     // 简化版：直接降采样（实际应用需要先低通滤波）
     // 降采样比例约为 375000/32000 ≈ 11.71875
     float ratio = (float)input_len / (float)output_len;
@@ -433,278 +1711,214 @@ void anti_alias_decimate(float *input, int input_len, float *output, int output_
     }
 }
 
-// ============ 应用窗函数 ============
-void apply_window(float *buffer, float *windowed, int length) {
-    for (int i = 0; i < length; i++) {
-        windowed[i] = buffer[i] * blackman_window[i];
-    }
-}
-
-// ============ 执行FFT（简化版，实际使用FFT库如FFTW或CMSIS-DSP） ============
-void perform_fft(float *input, Complex *output, int length) {
-    // 这里仅为示意，实际需要调用优化的FFT库
-    // 例如: arm_rfft_fast_f32() 或 fftwf_execute()
-    
-    // 伪代码示意:
-    // 1. 将实数输入转换为复数
-    // 2. 执行FFT
-    // 3. 提取正频率部分
-    
-    for (int k = 0; k < FFT_HALF_LENGTH; k++) {
-        output[k].real = 0.0f;
-        output[k].imag = 0.0f;
-        
-        for (int n = 0; n < length; n++) {
-            float angle = -2.0f * M_PI * k * n / length;
-            output[k].real += input[n] * cosf(angle);
-            output[k].imag += input[n] * sinf(angle);
-        }
-    }
-}
-
 // ============ 累积FFT结果 ============
-void accumulate_fft_results(Complex *fft_result, FreqResponse *accum) {
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        accum->bins[i].real += fft_result[i].real;
-        accum->bins[i].imag += fft_result[i].imag;
-    }
+void accumulate_fft_results(FreqResponse *fft_result, FreqResponse *accum) {
+    spectrum_accumulate(accum, fft_result);
 }
 
 // ============ 平均FFT结果 ============
 void average_fft_results(FFTAccumulator *accum, FreqResponse *ff_avg, FreqResponse *fb_avg, 
-                         FreqResponse *spk_avg, Complex *pp_average) {
+                         FreqResponse *spk_avg, FreqResponse pp_average[][ANC_NUM_REF]) {
     float scale = 1.0f / accum->accum_count;
     
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        ff_avg->bins[i] = complex_scale(accum->ff_accum.bins[i], scale);
-        fb_avg->bins[i] = complex_scale(accum->fb_accum.bins[i], scale);
-        spk_avg->bins[i] = complex_scale(accum->spk_accum.bins[i], scale);
-        
-        // 平均主路径传函
-        pp_average[i] = complex_scale(accum->pp_accum[i], scale);
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        spectrum_scale(&ff_avg[r], &accum->ff_accum[r], scale);
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        spectrum_scale(&fb_avg[e], &accum->fb_accum[e], scale);
+    }
+    spectrum_scale(spk_avg, &accum->spk_accum, scale);
+    
+    // 平均主路径传函
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            spectrum_scale(&pp_average[e][r], &accum->pp_accum[e][r], scale);
+        }
     }
 }
 
 // ============ 计算步长μ ============
 void calculate_mu(SystemState *state) {
-    const float mu_min = 0.0001f;
-    const float mu_max = 0.1f;
     const float regularization = 1e-6f;
     
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        // 基于功率归一化的步长计算
-        float ff_power = state->ff_avg.bins[i].real * state->ff_avg.bins[i].real + 
-                         state->ff_avg.bins[i].imag * state->ff_avg.bins[i].imag;
+    // 基于功率归一化的步长计算，Σ_e|S_er(ω)|²已在加载次级路径时预计算
+    // μ_r = μ_base / (Σ_e|S_er(ω)|² * P_ff_r(ω) + ε)，并限制在[mu_min, mu_max]
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        spectrum_calc_mu(state->ff_ch[r].mu, &state->ff_avg[r], state->ff_ch[r].sp_power,
+                         state->params.mu_min, state->params.mu_max, regularization);
+    }
+}
+
+#if ANC_NUM_REF > 1
+// ============ 多参考联合更新 ============
+// 逐频点求使 Σ_hop Σ_e |E_e - Σ_r S_er·X_r·ΔW_r|² 最小的ΔW（单参考时即PP/S），正规方程:
+//   A[r][q] = Σ_e conj(S_er)·S_eq · XX[r][q]，b[r] = Σ_e conj(S_er) · XE[r][e]
+// 以 JOINT_SOLVE_REG·trace(A)/R 对角加载后部分选主元消元，W_target_r = W_r + μ_r·ΔW_r
+static void solve_joint_update(SystemState *state) {
+    const FFTAccumulator *acc = &state->fft_accum;
+    int singular_bins = 0;
+    
+    for (int k = 0; k < g_analysis_bins.num_bins; k++) {
+        double a_re[ANC_NUM_REF][ANC_NUM_REF + 1];   // 增广矩阵 [A | b]
+        double a_im[ANC_NUM_REF][ANC_NUM_REF + 1];
+        double trace = 0.0;
+        
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            for (int q = 0; q <= ANC_NUM_REF; q++) {
+                a_re[r][q] = 0.0;
+                a_im[r][q] = 0.0;
+            }
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                const double sr_re = state->secondary_path[e][r].re[k];
+                const double sr_im = -state->secondary_path[e][r].im[k];   // conj(S_er)
+                for (int q = 0; q < ANC_NUM_REF; q++) {
+                    const double sq_re = state->secondary_path[e][q].re[k];
+                    const double sq_im = state->secondary_path[e][q].im[k];
+                    const double g_re = sr_re * sq_re - sr_im * sq_im;
+                    const double g_im = sr_re * sq_im + sr_im * sq_re;
+                    const double x_re = acc->xx_accum[r][q].re[k];
+                    const double x_im = acc->xx_accum[r][q].im[k];
+                    a_re[r][q] += g_re * x_re - g_im * x_im;
+                    a_im[r][q] += g_re * x_im + g_im * x_re;
+                }
+                const double c_re = acc->xe_accum[r][e].re[k];
+                const double c_im = acc->xe_accum[r][e].im[k];
+                a_re[r][ANC_NUM_REF] += sr_re * c_re - sr_im * c_im;
+                a_im[r][ANC_NUM_REF] += sr_re * c_im + sr_im * c_re;
+            }
+            trace += a_re[r][r];
+        }
         
-        float sec_path_mag = complex_mag(state->secondary_path[i]);
+        double delta_re[ANC_NUM_REF] = {0.0};
+        double delta_im[ANC_NUM_REF] = {0.0};
+        int ok = trace > 1e-30;
+        if (ok) {
+            const double load = JOINT_SOLVE_REG * trace / ANC_NUM_REF;
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                a_re[r][r] += load;
+            }
+        }
+        
+        // 前向消元（部分选主元）
+        for (int c = 0; c < ANC_NUM_REF && ok; c++) {
+            int pivot = c;
+            double best = a_re[c][c] * a_re[c][c] + a_im[c][c] * a_im[c][c];
+            for (int r = c + 1; r < ANC_NUM_REF; r++) {
+                double mag = a_re[r][c] * a_re[r][c] + a_im[r][c] * a_im[r][c];
+                if (mag > best) {
+                    best = mag;
+                    pivot = r;
+                }
+            }
+            if (best <= 1e-60) {
+                ok = 0;
+                break;
+            }
+            if (pivot != c) {
+                for (int q = 0; q <= ANC_NUM_REF; q++) {
+                    double t_re = a_re[c][q], t_im = a_im[c][q];
+                    a_re[c][q] = a_re[pivot][q];
+                    a_im[c][q] = a_im[pivot][q];
+                    a_re[pivot][q] = t_re;
+                    a_im[pivot][q] = t_im;
+                }
+            }
+            for (int r = c + 1; r < ANC_NUM_REF; r++) {
+                // f = a[r][c] / a[c][c]
+                const double f_re = (a_re[r][c] * a_re[c][c] + a_im[r][c] * a_im[c][c]) / best;
+                const double f_im = (a_im[r][c] * a_re[c][c] - a_re[r][c] * a_im[c][c]) / best;
+                for (int q = c; q <= ANC_NUM_REF; q++) {
+                    a_re[r][q] -= f_re * a_re[c][q] - f_im * a_im[c][q];
+                    a_im[r][q] -= f_re * a_im[c][q] + f_im * a_re[c][q];
+                }
+            }
+        }
         
-        // μ = μ_base / (|S(ω)|² * P_ff(ω) + ε)
-        state->mu[i] = mu_max / (sec_path_mag * sec_path_mag * ff_power + regularization);
+        // 回代
+        for (int r = ANC_NUM_REF - 1; r >= 0 && ok; r--) {
+            double s_re = a_re[r][ANC_NUM_REF];
+            double s_im = a_im[r][ANC_NUM_REF];
+            for (int q = r + 1; q < ANC_NUM_REF; q++) {
+                s_re -= a_re[r][q] * delta_re[q] - a_im[r][q] * delta_im[q];
+                s_im -= a_re[r][q] * delta_im[q] + a_im[r][q] * delta_re[q];
+            }
+            const double d = a_re[r][r] * a_re[r][r] + a_im[r][r] * a_im[r][r];
+            delta_re[r] = (s_re * a_re[r][r] + s_im * a_im[r][r]) / d;
+            delta_im[r] = (s_im * a_re[r][r] - s_re * a_im[r][r]) / d;
+        }
+        if (!ok) {
+            singular_bins++;
+        }
         
-        // 限制步长范围
-        if (state->mu[i] < mu_min) state->mu[i] = mu_min;
-        if (state->mu[i] > mu_max) state->mu[i] = mu_max;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            FFChannel *ch = &state->ff_ch[r];
+            ch->target_ff.re[k] = ch->current_ff.re[k] + ch->mu[k] * (float)delta_re[r];
+            ch->target_ff.im[k] = ch->current_ff.im[k] + ch->mu[k] * (float)delta_im[r];
+        }
     }
+    
+    log_printf("Joint %dx%d update solved per bin (%d singular bins left unchanged)\n",
+               ANC_NUM_REF, ANC_NUM_ERR, singular_bins);
 }
+#endif
 
 // ============ 计算目标前馈响应 ============
 void calculate_target_ff(SystemState *state) {
     // 新算法：目标频响 = 当前生效的滤波器系数频响 + 步长 * PP_AVERAGE / (SP + ε)
     // 其中:
-    //   - 当前FF频响: 已经在 calculate_ff_response() 中计算并存储在 state->current_ff
-    //   - 步长: state->mu[i]
-    //   - PP_AVERAGE: state->pp_average[i] (主路径传函 = 误差麦FFT / 参考麦FFT)
-    //   - SP: state->secondary_path[i] (预制次级路径频响)
+    //   - 当前FF频响: 已经在 calculate_ff_response() 中计算并存储在 ff_ch[r].current_ff
+    //   - 步长: ff_ch[r].mu[i]
+    //   - PP_AVERAGE: state->pp_average[e][r] (主路径传函 = 误差麦e FFT / 参考麦r FFT)
+    //   - SP: state->secondary_path[e][r] (由次级路径冲击响应算得的频响)
     //   - ε: SP_EPSILON 防止分母为0
+    // MIMO: 每个误差麦单独给出目标pair_target[e][r]（PP_er把误差麦e的全部残差归于参考麦r）
+    //   单参考: 通道的目标取各误差麦目标的平均
+    //   多参考: 各参考的残差贡献相互耦合，各自按pair_target更新会重复抵消同一残差，
+    //           改为逐频点联合求解（见solve_joint_update），pair_target仅用于按误差麦统计loss
     
     log_printf("=== Calculating Target FF Response ===\n");
     log_printf("Formula: W_target = W_current + mu * PP_AVERAGE / (SP + epsilon)\n");
     
     // 打印几个示例频点的值
     int sample_bins[] = {10, 100, 500};  // 示例频点
-    for (int j = 0; j < 3; j++) {
-        int i = sample_bins[j];
-        if (i < FFT_HALF_LENGTH) {
-            float freq = (float)i * DSP_SAMPLE_RATE / FFT_LENGTH;
-            log_printf("  Bin %d (%.1f Hz): PP_mag=%.4f, SP_mag=%.4f, mu=%.6f\n",
-                   i, freq,
-                   complex_mag(state->pp_average[i]),
-                   complex_mag(state->secondary_path[i]),
-                   state->mu[i]);
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            for (int j = 0; j < 3; j++) {
+                int i = sample_bins[j];
+                if (i < g_analysis_bins.num_bins) {
+                    float freq = g_analysis_bins.freq[i];
+                    log_printf("  [E%d,R%d] Bin %d (%.1f Hz): PP_mag=%.4f, SP_mag=%.4f, mu=%.6f\n",
+                           e, r, i, freq,
+                           complex_mag(spectrum_get(&state->pp_average[e][r], i)),
+                           complex_mag(spectrum_get(&state->secondary_path[e][r], i)),
+                           state->ff_ch[r].mu[i]);
+                }
+            }
         }
     }
     
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        // 当前FF滤波器频响
-        Complex current_ff = state->current_ff[i];
-        
-        // 主路径传函
-        Complex pp = state->pp_average[i];
+    // 目标频响 = 当前频响 + 步长 * PP_AVERAGE / SP
+    // SP幅度低于SP_EPSILON时原先按原相位补到SP_EPSILON，但其平方仍低于complex_div的
+    // 分母门限，结果恒为0，因此向量化内核直接按分母门限置零，无需atan2f
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        FFChannel *ch = &state->ff_ch[r];
         
-        // 次级路径（添加小量防止分母为0）
-        Complex sp = state->secondary_path[i];
-        float sp_mag = complex_mag(sp);
-        
-        // 如果SP幅度太小，添加保护
-        if (sp_mag < SP_EPSILON) {
-            // 按原角度添加最小幅度
-            float phase = atan2f(sp.imag, sp.real);
-            sp.real = SP_EPSILON * cosf(phase);
-            sp.imag = SP_EPSILON * sinf(phase);
+        spectrum_clear(&ch->target_ff);
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            spectrum_calc_target(&state->pair_target[e][r], &ch->current_ff,
+                                 &state->pp_average[e][r], &state->secondary_path[e][r], ch->mu);
+            spectrum_accumulate(&ch->target_ff, &state->pair_target[e][r]);
         }
         
-        // 计算 PP_AVERAGE / (SP + ε)
-        Complex pp_over_sp = complex_div(pp, sp);
-        
-        // 应用步长: mu * (PP_AVERAGE / SP)
-        Complex update = complex_scale(pp_over_sp, state->mu[i]);
-        
-        // 目标频响 = 当前频响 + 步长 * PP_AVERAGE / SP
-        state->target_ff[i] = complex_add(current_ff, update);
-    }
-    
-    log_printf("Target FF response calculated successfully\n");
-}
-
-// ============ 计算平滑度指标（二阶差分的均方） ============
-float calculate_smoothness(float *H_db, int length) {
-    if (length < 3) return 0.0f;
-    
-    float sum = 0.0f;
-    int count = 0;
-    
-    // 计算二阶差分: d²H/df² ≈ H[i+2] - 2*H[i+1] + H[i]
-    for (int i = 0; i < length - 2; i++) {
-        float d2 = H_db[i + 2] - 2.0f * H_db[i + 1] + H_db[i];
-        sum += d2 * d2;
-        count++;
-    }
-    
-    return (count > 0) ? (sum / count) : 0.0f;
-}
-
-// ============ 稳定性检测：检查目标频响是否异常 ============
-int check_target_stability(SystemState *state) {
-    const float eps = 1e-8f;
-    
-    log_printf("\n=== Target Response Stability Check ===\n");
-    
-    // 确定检测频段的频点索引范围
-    int bin_low = (int)(STABLE_CHECK_FREQ_LOW * FFT_LENGTH / DSP_SAMPLE_RATE);
-    int bin_high = (int)(STABLE_CHECK_FREQ_HIGH * FFT_LENGTH / DSP_SAMPLE_RATE);
-    
-    if (bin_low < 0) bin_low = 0;
-    if (bin_high >= FFT_HALF_LENGTH) bin_high = FFT_HALF_LENGTH - 1;
-    
-    int band_len = bin_high - bin_low + 1;
-    
-    if (band_len < 3) {
-        log_printf("Band too narrow for stability check\n");
-        return 1;  // 默认通过
-    }
-    
-    // 分配临时数组存储dB值
-    float *H_curr_db = (float *)malloc(band_len * sizeof(float));
-    float *H_prev_db = (float *)malloc(band_len * sizeof(float));
-    
-    // 转换为dB
-    for (int i = 0; i < band_len; i++) {
-        int bin = bin_low + i;
-        float mag_curr = complex_mag(state->target_ff[bin]);
-        float mag_prev = complex_mag(state->prev_target_ff[bin]);
-        
-        H_curr_db[i] = 20.0f * log10f(mag_curr + eps);
-        H_prev_db[i] = 20.0f * log10f(mag_prev + eps);
-    }
-    
-    // ========== 检测1: 平滑度 ==========
-    float smooth_curr = calculate_smoothness(H_curr_db, band_len);
-    
-    log_printf("Check 1 - Smoothness:\n");
-    log_printf("  Current smoothness: %.4f\n", smooth_curr);
-    log_printf("  Previous smoothness: %.4f\n", state->prev_smoothness);
-    log_printf("  Threshold (%.1fx prev): %.4f\n", SMOOTH_ALPHA, SMOOTH_ALPHA * state->prev_smoothness);
-    
-    if (smooth_curr > SMOOTH_ALPHA * state->prev_smoothness && state->prev_smoothness > eps) {
-        log_printf("  Result: FAIL (too rough)\n");
-        free(H_curr_db);
-        free(H_prev_db);
-        return 0;
-    }
-    log_printf("  Result: PASS\n");
-    
-    // ========== 检测2: 局部尖峰 ==========
-    int spike_count = 0;
-    for (int i = 0; i < band_len; i++) {
-        float delta = fabsf(H_curr_db[i] - H_prev_db[i]);
-        if (delta > SPIKE_DELTA_DB) {
-            spike_count++;
-        }
-    }
-    
-    float spike_ratio = (float)spike_count / band_len;
-    
-    log_printf("Check 2 - Local Spikes:\n");
-    log_printf("  Points with >%.1f dB change: %d/%d (%.1f%%)\n", 
-           SPIKE_DELTA_DB, spike_count, band_len, spike_ratio * 100.0f);
-    log_printf("  Threshold: %.1f%%\n", SPIKE_RATIO_THR * 100.0f);
-    
-    if (spike_ratio > SPIKE_RATIO_THR) {
-        log_printf("  Result: FAIL (too many spikes)\n");
-        free(H_curr_db);
-        free(H_prev_db);
-        return 0;
-    }
-    log_printf("  Result: PASS\n");
-    
-    // ========== 检测3: 绝对幅度界限 ==========
-    float min_db = H_curr_db[0];
-    float max_db = H_curr_db[0];
-    
-    for (int i = 1; i < band_len; i++) {
-        if (H_curr_db[i] < min_db) min_db = H_curr_db[i];
-        if (H_curr_db[i] > max_db) max_db = H_curr_db[i];
-    }
-    
-    log_printf("Check 3 - Absolute Bounds:\n");
-    log_printf("  Response range: [%.2f, %.2f] dB\n", min_db, max_db);
-    log_printf("  Allowed range: [%.2f, %.2f] dB\n", RESPONSE_LOW_DB, RESPONSE_HIGH_DB);
-    
-    if (min_db < RESPONSE_LOW_DB || max_db > RESPONSE_HIGH_DB) {
-        log_printf("  Result: FAIL (out of bounds)\n");
-        free(H_curr_db);
-        free(H_prev_db);
-        return 0;
-    }
-    log_printf("  Result: PASS\n");
-    
-    // ========== 检测4: 整体偏移 ==========
-    float mean_delta = 0.0f;
-    for (int i = 0; i < band_len; i++) {
-        mean_delta += (H_curr_db[i] - H_prev_db[i]);
-    }
-    mean_delta /= band_len;
-    
-    log_printf("Check 4 - Global Shift:\n");
-    log_printf("  Mean shift: %.2f dB\n", mean_delta);
-    log_printf("  Threshold: %.2f dB\n", MEAN_SHIFT_THR_DB);
-    
-    if (fabsf(mean_delta) > MEAN_SHIFT_THR_DB) {
-        log_printf("  Result: FAIL (too much shift)\n");
-        free(H_curr_db);
-        free(H_prev_db);
-        return 0;
+        // 平均后的目标使 Σ_e |W_target - pair_target[e]|² 最小（W域等权最小二乘）
+        spectrum_scale(&ch->target_ff, &ch->target_ff, 1.0f / ANC_NUM_ERR);
     }
-    log_printf("  Result: PASS\n");
-    
-    // 所有检测通过，更新平滑度基准
-    state->prev_smoothness = smooth_curr;
     
-    log_printf("\n=== Stability Check: PASSED ===\n");
+#if ANC_NUM_REF > 1
+    solve_joint_update(state);
+#endif
     
-    free(H_curr_db);
-    free(H_prev_db);
-    return 1;
+    log_printf("Target FF response calculated successfully\n");
 }
 
 // ============ 旧算法（已废弃） ============
@@ -728,79 +1942,118 @@ void calculate_target_ff_old(SystemState *state) {
 }
 */
 
-// ============ 计算前馈滤波器频响 ============
-void calculate_ff_response(SystemState *state) {
-    // 从当前Biquad系数计算频率响应
+// ============ 计算前馈滤波器在单个频点的频响 ============
+static Complex ff_response_at_bin(const FeedforwardFilter *filter, int k) {
     // H(z) = (b0 + b1*z^-1 + b2*z^-2) / (a0 + a1*z^-1 + a2*z^-2)
+    // z^-1 = e^(-jω)，ω = 2πf_k/fs，取自分析频点表，各级共用
+    Complex z_inv = {g_analysis_bins.z_re[k], g_analysis_bins.z_im[k]};
+    Complex z_inv2 = complex_mul(z_inv, z_inv);
+    
+    Complex H = {1.0f, 0.0f};  // 初始化为1
     
-    for (int k = 0; k < FFT_HALF_LENGTH; k++) {
-        float omega = 2.0f * M_PI * k / FFT_LENGTH;
+    // 级联所有Biquad（级数为编译期常量，完全展开）
+    ANC_UNROLL(NUM_BIQUADS)
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        const BiquadCoeffs *c = &filter->coeffs[stage];
         
-        Complex H = {1.0f, 0.0f};  // 初始化为1
+        // 分子: b0 + b1*z^-1 + b2*z^-2
+        Complex num = {c->b0, 0.0f};
+        num = complex_add(num, complex_scale(z_inv, c->b1));
+        num = complex_add(num, complex_scale(z_inv2, c->b2));
         
-        // 级联所有Biquad
-        for (int stage = 0; stage < NUM_BIQUADS; stage++) {
-            BiquadCoeffs *c = &state->ff_filter.coeffs[stage];
-            
-            // z^-1 = e^(-jω)
-            Complex z_inv = {cosf(omega), -sinf(omega)};
-            Complex z_inv2 = complex_mul(z_inv, z_inv);
-            
-            // 分子: b0 + b1*z^-1 + b2*z^-2
-            Complex num = {c->b0, 0.0f};
-            num = complex_add(num, complex_scale(z_inv, c->b1));
-            num = complex_add(num, complex_scale(z_inv2, c->b2));
-            
-            // 分母: 1 + a1*z^-1 + a2*z^-2 (a0已归一化为1)
-            Complex den = {1.0f, 0.0f};
-            den = complex_add(den, complex_scale(z_inv, c->a1));
-            den = complex_add(den, complex_scale(z_inv2, c->a2));
-            
-            // H_stage = num / den
-            Complex H_stage = complex_div(num, den);
-            
-            // 级联
-            H = complex_mul(H, H_stage);
-        }
+        // 分母: 1 + a1*z^-1 + a2*z^-2 (a0已归一化为1)
+        Complex den = {1.0f, 0.0f};
+        den = complex_add(den, complex_scale(z_inv, c->a1));
+        den = complex_add(den, complex_scale(z_inv2, c->a2));
         
-        // 应用总增益
-        state->current_ff[k] = complex_scale(H, state->ff_filter.total_gain);
+        // H_stage = num / den
+        Complex H_stage = complex_div(num, den);
+        
+        // 级联
+        H = complex_mul(H, H_stage);
+    }
+    
+    // 应用总增益
+    return complex_scale(H, filter->total_gain);
+}
+
+// ============ 计算前馈滤波器频响 ============
+void calculate_ff_response(FFChannel *ch) {
+    // 从当前Biquad系数计算全部分析频点的频率响应
+    for (int k = 0; k < g_analysis_bins.num_bins; k++) {
+        spectrum_set(&ch->current_ff, k, ff_response_at_bin(&ch->ff_filter, k));
     }
 }
 
 // ============ 计算初始FF响应与目标的loss ============
 void calculate_ff_init_loss(SystemState *state) {
-    // 计算当前FF滤波器参数产生的频响
-    calculate_ff_response(state);
+    log_printf("=== Initial FF Loss Calculation ===\n");
     
-    // 计算当前FF响应与目标响应的拟合误差
-    state->eq_update.init_loss = calculate_loss(state);
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        FFChannel *ch = &state->ff_ch[r];
+        
+        // 计算当前FF滤波器参数产生的频响
+        calculate_ff_response(ch);
+        
+        // 计算当前FF响应与目标响应的拟合误差，同时初始化current_loss
+        ch->eq_update.init_loss = calculate_ff_loss(ch);
+        ch->eq_update.current_loss = ch->eq_update.init_loss;
+        
+        log_printf("Initial Loss FF%d (current FF vs target): %.6f\n", r, ch->eq_update.init_loss);
+    }
     
-    log_printf("=== Initial FF Loss Calculation ===\n");
-    log_printf("Initial Loss (current FF vs target): %.6f\n", state->eq_update.init_loss);
+    // 按误差麦汇总
+    float total_loss = calculate_loss(state);
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        log_printf("Initial Loss FB%d (error mic): %.6f\n", e, state->err_loss[e]);
+    }
+    log_printf("Initial Loss (all error mics): %.6f\n", total_loss);
     log_printf("This will be used as baseline for parameter updates\n");
-    
-    // 同时初始化current_loss
-    state->eq_update.current_loss = state->eq_update.init_loss;
 }
 
-// ============ 计算损失函数 ============
+// ============ 计算损失函数（按误差麦汇总） ============
 float calculate_loss(SystemState *state) {
-    // Loss = Σ |W_target(ω) - W_current(ω)|²
-    float loss = 0.0f;
-    
-    for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-        Complex diff = complex_sub(state->target_ff[i], state->current_ff[i]);
-        float mag_squared = diff.real * diff.real + diff.imag * diff.imag;
-        loss += mag_squared;
+    // 误差麦e的loss: L_e = (1/R) Σ_r Σ|W_target_er(ω) - W_current_r(ω)|² / N
+    // 总loss为各误差麦loss的平均；单参考时通道的目标取各误差麦目标的平均，
+    // 总loss = calculate_ff_loss + 常数项；多参考时目标来自联合求解，此处仅作按误差麦的统计
+    float total_loss = 0.0f;
+    
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        float loss = 0.0f;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            loss += spectrum_loss(&state->pair_target[e][r], &state->ff_ch[r].current_ff);
+        }
+        
+        // 归一化
+        state->err_loss[e] = loss / (g_analysis_bins.num_bins * ANC_NUM_REF);
+        total_loss += state->err_loss[e];
     }
     
+    return total_loss / ANC_NUM_ERR;
+}
+
+// ============ 计算单个前馈通道的损失函数 ============
+float calculate_ff_loss(const FFChannel *ch) {
+    // Loss = Σ |W_target(ω) - W_current(ω)|²（补零区差值为0）
+    float loss = spectrum_loss(&ch->target_ff, &ch->current_ff);
+    
     // 归一化
-    loss /= FFT_HALF_LENGTH;
+    loss /= g_analysis_bins.num_bins;
     
     return loss;
 }
 
+// ============ 计算评估网格上的加权损失函数 ============
+float calculate_loss_grid(const EvalGrid *grid) {
+    // Loss = Σ w_i * |W_target(ω_i) - W_current(ω_i)|² / Σ w_i
+    // 目标频响已由eval_grid_load_target()收集到网格紧凑数组
+    float loss = spectrum_weighted_loss(grid->target_re, grid->target_im,
+                                        grid->resp_re, grid->resp_im,
+                                        grid->weights, grid->padded_bins);
+    
+    return loss / grid->weight_sum;
+}
+
 // ============ 参数限幅函数 ============
 float clamp_value(float value, float min_val, float max_val) {
     if (value < min_val) return min_val;
@@ -809,10 +2062,13 @@ float clamp_value(float value, float min_val, float max_val) {
 }
 
 // ============ 更新单个Biquad的单个参数（梯度下降） ============
-int update_single_param(SystemState *state, int biquad_idx, int param_type) {
+int update_single_param(FFChannel *ch, EvalGrid *grid, const AncParams *params,
+                        int biquad_idx, int param_type) {
     // param_type: 0=gain, 1=Q, 2=fc
-    BiquadParam *param = &state->eq_update.params[biquad_idx];
-    float original_loss = state->eq_update.current_loss;
+    // 内循环只在评估网格上计算频响和loss，学习率和步长上限取运行时参数
+    // 试探只重算本级频响，其余各级之积在进入时缓存一次
+    BiquadParam *param = &ch->eq_update.params[biquad_idx];
+    BiquadCoeffs *coeffs = &ch->ff_filter.coeffs[biquad_idx];
     
     // 保存原始参数
     float original_value;
@@ -823,8 +2079,8 @@ int update_single_param(SystemState *state, int biquad_idx, int param_type) {
         case 0: // Gain
             original_value = param->gain_dB;
             epsilon = EPSILON_GAIN;
-            learning_rate = LEARNING_RATE_GAIN;
-            max_delta = MAX_DELTA_GAIN;
+            learning_rate = params->learning_rate_gain;
+            max_delta = params->max_delta_gain;
             min_val = MIN_GAIN_DB;
             max_val = MAX_GAIN_DB;
             param_name = "Gain";
@@ -832,8 +2088,8 @@ int update_single_param(SystemState *state, int biquad_idx, int param_type) {
         case 1: // Q
             original_value = param->q;
             epsilon = EPSILON_Q;
-            learning_rate = LEARNING_RATE_Q;
-            max_delta = MAX_DELTA_Q;
+            learning_rate = params->learning_rate_q;
+            max_delta = params->max_delta_q;
             min_val = MIN_Q;
             max_val = MAX_Q;
             param_name = "Q";
@@ -841,8 +2097,8 @@ int update_single_param(SystemState *state, int biquad_idx, int param_type) {
         case 2: // fc
             original_value = param->fc;
             epsilon = EPSILON_FC;
-            learning_rate = LEARNING_RATE_FC;
-            max_delta = MAX_DELTA_FC;
+            learning_rate = params->learning_rate_fc;
+            max_delta = params->max_delta_fc;
             min_val = MIN_FC;
             max_val = MAX_FC;
             param_name = "fc";
@@ -851,14 +2107,18 @@ int update_single_param(SystemState *state, int biquad_idx, int param_type) {
             return 0;
     }
     
+    // 基准loss与试探loss使用同一乘法顺序
+    eval_grid_begin_stage(grid, biquad_idx, ch->ff_filter.total_gain);
+    float original_loss = calculate_loss_grid(grid);
+    
     // 计算梯度（数值微分）
     float *param_ptr = (param_type == 0) ? &param->gain_dB : 
                        (param_type == 1) ? &param->q : &param->fc;
     
     *param_ptr += epsilon;
-    eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, &state->ff_filter.coeffs[biquad_idx]);
-    calculate_ff_response(state);
-    float loss_plus = calculate_loss(state);
+    eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, coeffs);
+    eval_grid_trial_stage(grid, coeffs, ch->ff_filter.total_gain);
+    float loss_plus = calculate_loss_grid(grid);
     
     float gradient = (loss_plus - original_loss) / epsilon;
     
@@ -875,116 +2135,234 @@ int update_single_param(SystemState *state, int biquad_idx, int param_type) {
     *param_ptr = new_value;
     
     // 重新计算loss
-    eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, &state->ff_filter.coeffs[biquad_idx]);
-    calculate_ff_response(state);
-    float new_loss = calculate_loss(state);
+    eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, coeffs);
+    eval_grid_trial_stage(grid, coeffs, ch->ff_filter.total_gain);
+    float new_loss = calculate_loss_grid(grid);
     
     // 判断是否接受更新
     if (new_loss < original_loss) {
         // 接受更新
-        state->eq_update.current_loss = new_loss;
+        eval_grid_commit_stage(grid, biquad_idx);
+        ch->eq_update.grid_loss = new_loss;
         log_printf("  Biquad[%d] %s: %.4f->%.4f, loss: %.6f->%.6f (ACCEPT)\n",
                biquad_idx, param_name, original_value, new_value, original_loss, new_loss);
         return 1;
     } else {
         // 拒绝更新，恢复原值
         *param_ptr = original_value;
-        eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, &state->ff_filter.coeffs[biquad_idx]);
-        calculate_ff_response(state);
+        eq_to_biquad_coeffs(param, REALTIME_SAMPLE_RATE, coeffs);
         log_printf("  Biquad[%d] %s: %.4f (no change, loss would increase)\n",
                biquad_idx, param_name, original_value);
         return 0;
     }
 }
 
-// ============ 更新EQ参数（依次梯度下降） ============
-void update_eq_params(SystemState *state) {
+// ============ 直接拟合初值 ============
+// 在网格上直接拟合EQ参数（网格外频点加权约束），全频点loss低于当前参数时作为本轮梯度下降的起点
+// 调用前网格须已装载目标和当前滤波器；返回时网格缓存与通道当前滤波器一致
+// 拟合被拒后缓存当时的目标：目标的均方变化不足被拒拟合loss的EQ_FIT_REFIT_CHANGE倍时，
+// 重新拟合的结果与上次相近，当前参数又只会更好，直接跳过
+static void seed_from_direct_fit(FFChannel *ch, EvalGrid *grid, const AncParams *params, int ch_idx) {
+    if (ch->fit_rejected_loss > 0.0f) {
+        float target_change = spectrum_loss(&ch->target_ff, &ch->fit_rejected_target) /
+                              g_analysis_bins.num_bins;
+        if (target_change < EQ_FIT_REFIT_CHANGE * ch->fit_rejected_loss) {
+            log_printf("Direct fit FF%d: target moved %.6f since rejected fit (loss %.6f), skipping\n",
+                       ch_idx, target_change, ch->fit_rejected_loss);
+            return;
+        }
+    }
+    
+    BiquadParam fit_params[NUM_BIQUADS];
+    float fit_gain_dB;
+    if (eq_fit_grid(grid, &g_analysis_bins, &ch->target_ff, params->eq_fit_oob_weight,
+                    params->eq_fit_iterations, fit_params, &fit_gain_dB) != 0) {
+        log_printf("Direct fit FF%d: failed, keeping current parameters\n", ch_idx);
+        return;
+    }
+    
+    FeedforwardFilter fit_filter = ch->ff_filter;
+    for (int i = 0; i < NUM_BIQUADS; i++) {
+        eq_to_biquad_coeffs(&fit_params[i], REALTIME_SAMPLE_RATE, &fit_filter.coeffs[i]);
+    }
+    fit_filter.total_gain = powf(10.0f, fit_gain_dB / 20.0f);
+    
+    eval_grid_load_filter(grid, &fit_filter);
+    eval_grid_begin_stage(grid, -1, fit_filter.total_gain);
+    float fit_loss = calculate_loss_grid(grid);
+    
+    // 网格外的分析频点已按eq_fit_oob_weight加入拟合，是否采用仍以全频点loss为准（与本轮最终校验一致）
+    FeedforwardFilter saved_filter = ch->ff_filter;
+    FreqResponse saved_response = ch->current_ff;
+    memcpy(ch->ff_filter.coeffs, fit_filter.coeffs, sizeof(fit_filter.coeffs));
+    ch->ff_filter.total_gain = fit_filter.total_gain;
+    calculate_ff_response(ch);
+    float fit_full_loss = calculate_ff_loss(ch);
+    
+    if (fit_full_loss < ch->eq_update.current_loss) {
+        log_printf("Direct fit FF%d: loss %.6f -> %.6f, grid loss %.6f -> %.6f (SEED)\n", ch_idx,
+                   ch->eq_update.current_loss, fit_full_loss, ch->eq_update.grid_loss, fit_loss);
+        memcpy(ch->eq_update.params, fit_params, sizeof(fit_params));
+        ch->eq_update.total_gain_dB = fit_gain_dB;
+        ch->eq_update.grid_loss = fit_loss;
+        ch->eq_update.current_loss = fit_full_loss;
+        ch->fit_rejected_loss = 0.0f;
+    } else {
+        log_printf("Direct fit FF%d: loss %.6f >= current %.6f (grid %.6f), keeping current parameters\n",
+                   ch_idx, fit_full_loss, ch->eq_update.current_loss, fit_loss);
+        ch->ff_filter = saved_filter;
+        ch->current_ff = saved_response;
+        eval_grid_load_filter(grid, &ch->ff_filter);
+        ch->fit_rejected_target = ch->target_ff;
+        ch->fit_rejected_loss = fit_full_loss;
+    }
+}
+
+// ============ 更新单个前馈通道的EQ参数（依次梯度下降） ============
+static void update_channel_eq_params(FFChannel *ch, EvalGrid *grid, const AncParams *params,
+                                     int ch_idx) {
     // 计算当前损失
-    calculate_ff_response(state);
-    state->eq_update.current_loss = calculate_loss(state);
+    calculate_ff_response(ch);
+    ch->eq_update.current_loss = calculate_ff_loss(ch);
     
-    log_printf("\n=== EQ Parameter Update (Sequential Gradient Descent) ===\n");
-    log_printf("Initial Loss (baseline): %.6f\n", state->eq_update.init_loss);
-    log_printf("Current Loss: %.6f\n", state->eq_update.current_loss);
+    log_printf("\n=== EQ Parameter Update FF%d (Sequential Gradient Descent) ===\n", ch_idx);
+    log_printf("Initial Loss (baseline): %.6f\n", ch->eq_update.init_loss);
+    log_printf("Current Loss: %.6f\n", ch->eq_update.current_loss);
     
     // 判断当前参数是否已经足够接近目标
-    float loss_threshold = state->eq_update.init_loss * LOSS_IMPROVEMENT_FACTOR;
+    float loss_threshold = ch->eq_update.init_loss * params->loss_improvement_factor;
     
-    if (state->eq_update.current_loss <= loss_threshold) {
+    if (ch->eq_update.current_loss <= loss_threshold) {
         log_printf("Current loss already good (< %.6f), skipping parameter update\n", loss_threshold);
-        state->eq_update.update_accepted = 1;
+        ch->eq_update.update_accepted = 1;
         return;
     }
     
     log_printf("Attempting sequential gradient descent update (DSP-friendly)...\n");
-    log_printf("Strategy: Update Gain, Q, fc for each Biquad sequentially\n\n");
+    log_printf("Strategy: Update Gain, Q, fc for each Biquad sequentially\n");
+    
+    // 保存本轮起点参数，全频点校验失败时恢复
+    BiquadParam saved_params[NUM_BIQUADS];
+    memcpy(saved_params, ch->eq_update.params, sizeof(saved_params));
+    float saved_total_gain_dB = ch->eq_update.total_gain_dB;
+    
+    // 内循环在评估网格上进行，各级频响缓存一次，此后只重算被试探的一级
+    eval_grid_load_target(grid, &ch->target_ff);
+    eval_grid_load_filter(grid, &ch->ff_filter);
+    eval_grid_begin_stage(grid, -1, ch->ff_filter.total_gain);
+    ch->eq_update.grid_loss = calculate_loss_grid(grid);
+    log_printf("Grid Loss (%d bins): %.6f\n\n", grid->num_bins, ch->eq_update.grid_loss);
+    
+    if (params->eq_fit_iterations > 0) {
+        seed_from_direct_fit(ch, grid, params, ch_idx);
+    }
     
     int total_accepted = 0;
     
     // ========== 依次优化每个Biquad的每个参数 ==========
     for (int i = 0; i < NUM_BIQUADS; i++) {
-        log_printf("Biquad[%d] (type=%d):\n", i, state->eq_update.params[i].type);
+        log_printf("Biquad[%d] (type=%d):\n", i, ch->eq_update.params[i].type);
         
         // 先优化Gain
-        if (update_single_param(state, i, 0)) total_accepted++;
+        if (update_single_param(ch, grid, params, i, 0)) total_accepted++;
         
         // 再优化Q
-        if (update_single_param(state, i, 1)) total_accepted++;
+        if (update_single_param(ch, grid, params, i, 1)) total_accepted++;
         
         // 最后优化fc
-        if (update_single_param(state, i, 2)) total_accepted++;
+        if (update_single_param(ch, grid, params, i, 2)) total_accepted++;
     }
     
     // ========== 优化总增益 ==========
     log_printf("\nTotal Gain:\n");
-    float original_total_gain = state->eq_update.total_gain_dB;
-    float original_loss = state->eq_update.current_loss;
+    float original_total_gain = ch->eq_update.total_gain_dB;
+    eval_grid_begin_stage(grid, -1, ch->ff_filter.total_gain);
+    float original_loss = calculate_loss_grid(grid);
     
     // 计算梯度
-    state->eq_update.total_gain_dB += EPSILON_TOTAL_GAIN;
-    state->ff_filter.total_gain = powf(10.0f, state->eq_update.total_gain_dB / 20.0f);
-    calculate_ff_response(state);
-    float loss_plus = calculate_loss(state);
+    ch->eq_update.total_gain_dB += EPSILON_TOTAL_GAIN;
+    ch->ff_filter.total_gain = powf(10.0f, ch->eq_update.total_gain_dB / 20.0f);
+    eval_grid_trial_gain(grid, ch->ff_filter.total_gain);
+    float loss_plus = calculate_loss_grid(grid);
     
     float gradient = (loss_plus - original_loss) / EPSILON_TOTAL_GAIN;
     
     // 恢复并更新
-    state->eq_update.total_gain_dB = original_total_gain;
-    float delta = -LEARNING_RATE_TOTAL_GAIN * gradient;
-    delta = clamp_value(delta, -MAX_DELTA_TOTAL_GAIN, MAX_DELTA_TOTAL_GAIN);
+    ch->eq_update.total_gain_dB = original_total_gain;
+    float delta = -params->learning_rate_total_gain * gradient;
+    delta = clamp_value(delta, -params->max_delta_total_gain, params->max_delta_total_gain);
     
     float new_total_gain = original_total_gain + delta;
     new_total_gain = clamp_value(new_total_gain, MIN_TOTAL_GAIN_DB, MAX_TOTAL_GAIN_DB);
     
-    state->eq_update.total_gain_dB = new_total_gain;
-    state->ff_filter.total_gain = powf(10.0f, new_total_gain / 20.0f);
-    calculate_ff_response(state);
-    float new_loss = calculate_loss(state);
+    ch->eq_update.total_gain_dB = new_total_gain;
+    ch->ff_filter.total_gain = powf(10.0f, new_total_gain / 20.0f);
+    eval_grid_trial_gain(grid, ch->ff_filter.total_gain);
+    float new_loss = calculate_loss_grid(grid);
     
     if (new_loss < original_loss) {
-        state->eq_update.current_loss = new_loss;
+        ch->eq_update.grid_loss = new_loss;
         log_printf("  Total Gain: %.2f->%.2f dB, loss: %.6f->%.6f (ACCEPT)\n",
                original_total_gain, new_total_gain, original_loss, new_loss);
         total_accepted++;
     } else {
-        state->eq_update.total_gain_dB = original_total_gain;
-        state->ff_filter.total_gain = powf(10.0f, original_total_gain / 20.0f);
-        calculate_ff_response(state);
+        ch->eq_update.total_gain_dB = original_total_gain;
+        ch->ff_filter.total_gain = powf(10.0f, original_total_gain / 20.0f);
         log_printf("  Total Gain: %.2f dB (no change, loss would increase)\n", original_total_gain);
     }
     
+    // ========== 全频点校验 ==========
+    // 网格loss只用于内循环，是否接受仍以全频点loss与init_loss比较为准
+    calculate_ff_response(ch);
+    ch->eq_update.current_loss = calculate_ff_loss(ch);
+    
     // ========== 最终判断 ==========
     log_printf("\n--- Update Summary ---\n");
     log_printf("Parameters accepted: %d / %d\n", total_accepted, NUM_BIQUADS * 3 + 1);
-    log_printf("Final loss: %.6f\n", state->eq_update.current_loss);
+    log_printf("Final grid loss: %.6f\n", ch->eq_update.grid_loss);
+    log_printf("Final loss (full grid): %.6f\n", ch->eq_update.current_loss);
     
-    if (state->eq_update.current_loss < state->eq_update.init_loss) {
-        state->eq_update.update_accepted = 1;
+    if (ch->eq_update.current_loss < ch->eq_update.init_loss) {
+        ch->eq_update.update_accepted = 1;
         log_printf("Overall: ACCEPTED (final loss < init loss)\n");
     } else {
-        state->eq_update.update_accepted = 0;
-        log_printf("Overall: REJECTED (final loss >= init loss)\n");
+        ch->eq_update.update_accepted = 0;
+        log_printf("Overall: REJECTED (final loss >= init loss), restoring parameters\n");
+        
+        // 恢复本轮起点参数
+        memcpy(ch->eq_update.params, saved_params, sizeof(saved_params));
+        ch->eq_update.total_gain_dB = saved_total_gain_dB;
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            eq_to_biquad_coeffs(&ch->eq_update.params[i], REALTIME_SAMPLE_RATE,
+                                &ch->ff_filter.coeffs[i]);
+        }
+        ch->ff_filter.total_gain = powf(10.0f, saved_total_gain_dB / 20.0f);
+        calculate_ff_response(ch);
+        ch->eq_update.current_loss = ch->eq_update.init_loss;
+    }
+}
+
+// ============ 更新EQ参数（逐通道） ============
+void update_eq_params(SystemState *state) {
+    // 通道间loss可分，依次优化各通道并复用同一评估网格
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        update_channel_eq_params(&state->ff_ch[r], &state->eval_grid, &state->params, r);
+    }
+    
+    // 按误差麦汇总最终loss
+    float total_loss = calculate_loss(state);
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        log_printf("Final Loss FB%d (error mic): %.6f\n", e, state->err_loss[e]);
+    }
+    log_printf("Final Loss (all error mics): %.6f\n", total_loss);
+}
+
+// ============ 是否有通道接受了本轮更新 ============
+int any_update_accepted(const SystemState *state) {
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        if (state->ff_ch[r].eq_update.update_accepted) return 1;
     }
+    return 0;
 }
 
 // ============ EQ参数转Biquad系数 ============
@@ -1039,183 +2417,376 @@ void update_filter_coeffs(SystemState *state) {
     
     log_printf("Updating filter coefficients to %d Hz sample rate...\n", REALTIME_SAMPLE_RATE);
     
-    for (int i = 0; i < NUM_BIQUADS; i++) {
-        // 使用当前优化后的参数
-        eq_to_biquad_coeffs(&state->eq_update.params[i], REALTIME_SAMPLE_RATE, 
-                            &state->ff_filter.coeffs[i]);
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        FFChannel *ch = &state->ff_ch[r];
+        
+        for (int i = 0; i < NUM_BIQUADS; i++) {
+            // 使用当前优化后的参数
+            eq_to_biquad_coeffs(&ch->eq_update.params[i], REALTIME_SAMPLE_RATE, 
+                                &ch->ff_filter.coeffs[i]);
+            
+            log_printf("  FF%d Biquad[%d]: type=%d, gain=%.2f dB, Q=%.3f, fc=%.1f Hz\n",
+                   r, i, ch->eq_update.params[i].type,
+                   ch->eq_update.params[i].gain_dB,
+                   ch->eq_update.params[i].q,
+                   ch->eq_update.params[i].fc);
+        }
         
-        log_printf("  Biquad[%d]: type=%d, gain=%.2f dB, Q=%.3f, fc=%.1f Hz\n",
-               i, state->eq_update.params[i].type,
-               state->eq_update.params[i].gain_dB,
-               state->eq_update.params[i].q,
-               state->eq_update.params[i].fc);
+        // 更新总增益
+        ch->ff_filter.total_gain = powf(10.0f, ch->eq_update.total_gain_dB / 20.0f);
+        log_printf("  FF%d Total Gain: %.2f dB (linear: %.4f)\n", 
+               r, ch->eq_update.total_gain_dB, ch->ff_filter.total_gain);
     }
     
-    // 更新总增益
-    state->ff_filter.total_gain = powf(10.0f, state->eq_update.total_gain_dB / 20.0f);
-    log_printf("  Total Gain: %.2f dB (linear: %.4f)\n", 
-           state->eq_update.total_gain_dB, state->ff_filter.total_gain);
-    
     log_printf("Filter coefficients updated successfully\n");
 }
 
+// ============ 每hop谱分析（通道并行） ============
+// 任务c处理通道c（FF×R, FB×E, SPK）：必要时加窗FFT，再累加到该通道的累积器
+// 各任务只写自己通道的结果和累积器，无需加锁
+typedef struct {
+    TimeBuffer *const *buffers;
+    FreqResponse *results;                  // [NUM_CHANNELS]
+    FreqResponse *accums[NUM_CHANNELS];
+    FreqResponse *pp_accum;                 // [ANC_NUM_ERR][ANC_NUM_REF]
+    FFTAccumulator *accum;
+    int transform;                          // 1=任务内做全频带FFT，0=结果已由批量/细化/稀疏分析给出
+} HopJobs;
+
+static void hop_channel_job(void *arg, int c) {
+    HopJobs *jobs = (HopJobs *)arg;
+    if (jobs->transform) {
+        fft_real(&g_fft_plan, jobs->buffers[c]->data, dsp_blackman_window, &jobs->results[c]);
+    }
+    accumulate_fft_results(&jobs->results[c], jobs->accums[c]);
+}
+
+// 任务k处理 (e, r) = (k / R, k % R): PP[e][r] += FB_e / FF_r
+static void hop_pp_job(void *arg, int k) {
+    HopJobs *jobs = (HopJobs *)arg;
+    const int e = k / ANC_NUM_REF;
+    const int r = k % ANC_NUM_REF;
+    spectrum_div_accumulate(&jobs->pp_accum[e * ANC_NUM_REF + r],
+                            &jobs->results[ANC_NUM_REF + e], &jobs->results[r]);
+}
+
+#if ANC_NUM_REF > 1
+// 频谱共轭乘累加（前count个频点）: acc += conj(a) · b
+static void cross_accumulate(FreqResponse *acc, const FreqResponse *a, const FreqResponse *b,
+                             int count) {
+    for (int k = 0; k < count; k++) {
+        acc->re[k] += a->re[k] * b->re[k] + a->im[k] * b->im[k];
+        acc->im[k] += a->re[k] * b->im[k] - a->im[k] * b->re[k];
+    }
+}
+
+// 任务r累积参考麦r与全部参考麦/误差麦的互谱（联合求解用）
+static void hop_cross_job(void *arg, int r) {
+    HopJobs *jobs = (HopJobs *)arg;
+    const int count = g_analysis_bins.num_bins;
+    for (int q = 0; q < ANC_NUM_REF; q++) {
+        cross_accumulate(&jobs->accum->xx_accum[r][q], &jobs->results[r], &jobs->results[q], count);
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        cross_accumulate(&jobs->accum->xe_accum[r][e], &jobs->results[r],
+                         &jobs->results[ANC_NUM_REF + e], count);
+    }
+}
+#endif
+
+// 各通道时域缓冲，顺序与批量FFT一致: FF×R, FB×E, SPK
+static void channel_buffers(SystemState *state, TimeBuffer *buffers[NUM_CHANNELS]) {
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        buffers[r] = &state->ff_buffer[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        buffers[ANC_NUM_REF + e] = &state->fb_buffer[e];
+    }
+    buffers[NUM_CHANNELS - 1] = &state->spk_buffer;
+}
+
+static void process_frame_step(SystemState *state, TimeBuffer *const buffers[NUM_CHANNELS]);
+
 // ============ 处理音频帧 ============
-void process_audio_frame(float *ff_in, float *fb_in, float *spk_in, int frame_len) {
-    // 1. 抗混叠降采样到32kHz
-    float ff_decimated[SAMPLES_PER_INTERVAL];
-    float fb_decimated[SAMPLES_PER_INTERVAL];
-    float spk_decimated[SAMPLES_PER_INTERVAL];
-    
-    anti_alias_decimate(ff_in, frame_len, ff_decimated, SAMPLES_PER_INTERVAL);
-    anti_alias_decimate(fb_in, frame_len, fb_decimated, SAMPLES_PER_INTERVAL);
-    anti_alias_decimate(spk_in, frame_len, spk_decimated, SAMPLES_PER_INTERVAL);
-    
-    // 2. 将数据填入buffer
-    TimeBuffer *ff_buf = &g_system_state.ff_buffer;
-    TimeBuffer *fb_buf = &g_system_state.fb_buffer;
-    TimeBuffer *spk_buf = &g_system_state.spk_buffer;
-    
-    for (int i = 0; i < SAMPLES_PER_INTERVAL; i++) {
-        ff_buf->data[ff_buf->write_index] = ff_decimated[i];
-        fb_buf->data[fb_buf->write_index] = fb_decimated[i];
-        spk_buf->data[spk_buf->write_index] = spk_decimated[i];
+void process_audio_frame(SystemState *state, float *const ff_in[], float *const fb_in[],
+                         const float *spk_in, int frame_len) {
+    // 1. 抗混叠降采样到32kHz，并将数据填入buffer
+    const float *inputs[NUM_CHANNELS];
+    TimeBuffer *buffers[NUM_CHANNELS];
+    channel_buffers(state, buffers);
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        inputs[r] = ff_in[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        inputs[ANC_NUM_REF + e] = fb_in[e];
+    }
+    inputs[NUM_CHANNELS - 1] = spk_in;
+    
+    for (int c = 0; c < NUM_CHANNELS; c++) {
+        float decimated[SAMPLES_PER_INTERVAL];
+        TimeBuffer *buf = buffers[c];
+        
+        anti_alias_decimate(inputs[c], frame_len, decimated, SAMPLES_PER_INTERVAL);
+        
+        // 2. 将数据填入buffer
+        for (int i = 0; i < SAMPLES_PER_INTERVAL; i++) {
+            buf->data[buf->write_index] = decimated[i];
+            buf->write_index = (buf->write_index + 1) % FFT_LENGTH;
+        }
+        buf->sample_count += SAMPLES_PER_INTERVAL;
+    }
+    
+    // 3. 状态机处理
+    process_frame_step(state, buffers);
+}
+
+// ============ 块处理 ============
+int process_audio_block(SystemState *state, float *const ff_in[], float *const fb_in[],
+                        const float *spk_in, int num_samples, int sample_rate) {
+    const float *inputs[NUM_CHANNELS];
+    TimeBuffer *buffers[NUM_CHANNELS];
+    channel_buffers(state, buffers);
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        inputs[r] = ff_in[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        inputs[ANC_NUM_REF + e] = fb_in[e];
+    }
+    inputs[NUM_CHANNELS - 1] = spk_in;
+    
+    // 本块可产生的降采样样本: k*fs_in/DSP_SAMPLE_RATE < input_end
+    const long long input_start = state->block_input_pos;
+    const long long input_end = input_start + num_samples;
+    const long long output_end = (input_end * DSP_SAMPLE_RATE + sample_rate - 1) / sample_rate;
+    int steps = 0;
+    
+    while (state->block_output_pos < output_end) {
+        // 填满当前帧（或用完本块）后再推进状态机，帧内样本连续写入各通道缓冲
+        long long n = SAMPLES_PER_INTERVAL - state->block_pending;
+        if (n > output_end - state->block_output_pos) {
+            n = output_end - state->block_output_pos;
+        }
+        
+        for (int c = 0; c < NUM_CHANNELS; c++) {
+            TimeBuffer *buf = buffers[c];
+            const float *in = inputs[c];
+            int w = buf->write_index;
+            for (long long k = state->block_output_pos; k < state->block_output_pos + n; k++) {
+                buf->data[w] = in ? in[k * sample_rate / DSP_SAMPLE_RATE - input_start] : 0.0f;
+                w = (w + 1) % FFT_LENGTH;
+            }
+            buf->write_index = w;
+            buf->sample_count += (int)n;
+        }
+        state->block_output_pos += n;
+        state->block_pending += (int)n;
         
-        ff_buf->write_index = (ff_buf->write_index + 1) % FFT_LENGTH;
-        fb_buf->write_index = (fb_buf->write_index + 1) % FFT_LENGTH;
-        spk_buf->write_index = (spk_buf->write_index + 1) % FFT_LENGTH;
+        if (state->block_pending == SAMPLES_PER_INTERVAL) {
+            state->block_pending = 0;
+            process_frame_step(state, buffers);
+            steps++;
+        }
+    }
+    
+    state->block_input_pos = input_end;
+    return steps;
+}
+
+// ============ 状态机单步 ============
+// 本帧的SAMPLES_PER_INTERVAL个降采样样本已写入各通道缓冲
+static void process_frame_step(SystemState *state, TimeBuffer *const buffers[NUM_CHANNELS]) {
+    // 细化分析：新样本移频、降采样为基带序列
+    if (g_analysis_bins.mode == ANALYSIS_ZOOM) {
+        zoom_feed(&state->zoom, &g_analysis_bins, (const TimeBuffer *const *)buffers,
+                  SAMPLES_PER_INTERVAL);
     }
     
-    ff_buf->sample_count += SAMPLES_PER_INTERVAL;
-    fb_buf->sample_count += SAMPLES_PER_INTERVAL;
-    spk_buf->sample_count += SAMPLES_PER_INTERVAL;
+    TimeBuffer *ff_buf = &state->ff_buffer[0];
+    const int sched_on = state->params.scheduler.max_idle_rounds > 0;
     
     // 3. 状态机处理
-    switch (g_system_state.state) {
+    switch (state->state) {
         case SIGNAL_PROCESS:
             // 检查是否累积了足够的样本开始FFT
-            if (g_system_state.frame_count == 0 && ff_buf->sample_count >= FFT_LENGTH) {
+            if (state->frame_count == 0 && ff_buf->sample_count >= FFT_LENGTH) {
                 // 第一次FFT
-                g_system_state.fft_count = 0;
-                memset(&g_system_state.fft_accum, 0, sizeof(FFTAccumulator));
+                state->fft_count = 0;
+                memset(&state->fft_accum, 0, sizeof(FFTAccumulator));
+                if (sched_on) {
+                    scheduler_begin_round(&state->sched);
+                }
             }
             
             // 每个hop执行一次FFT（75% overlap）
-            if (ff_buf->sample_count >= FFT_HOP_SIZE && g_system_state.fft_count < NUM_FFT_AVERAGE) {
-                // 执行FFT
-                float windowed[FFT_LENGTH];
-                Complex fft_result[FFT_HALF_LENGTH];
-                Complex ff_fft[FFT_HALF_LENGTH];
-                Complex fb_fft[FFT_HALF_LENGTH];
-                
-                // FF通道 (参考麦 Srr)
-                apply_window(ff_buf->data, windowed, FFT_LENGTH);
-                perform_fft(windowed, ff_fft, FFT_LENGTH);
-                accumulate_fft_results(ff_fft, &g_system_state.fft_accum.ff_accum);
-                
-                // FB通道 (误差麦 Sre)
-                apply_window(fb_buf->data, windowed, FFT_LENGTH);
-                perform_fft(windowed, fb_fft, FFT_LENGTH);
-                accumulate_fft_results(fb_fft, &g_system_state.fft_accum.fb_accum);
+            // 细化分析的hop节拍相同，基带样本攒满ZOOM_FFT_LENGTH之前的hop直接跳过
+            if (ff_buf->sample_count >= FFT_HOP_SIZE && state->fft_count < state->params.num_fft_average) {
+                FreqResponse fft_results[NUM_CHANNELS];
+                FreqResponse *fft_outputs[NUM_CHANNELS];
+                for (int c = 0; c < NUM_CHANNELS; c++) {
+                    fft_outputs[c] = &fft_results[c];
+                }
                 
-                // SPK通道
-                apply_window(spk_buf->data, windowed, FFT_LENGTH);
-                perform_fft(windowed, fft_result, FFT_LENGTH);
-                accumulate_fft_results(fft_result, &g_system_state.fft_accum.spk_accum);
+                HopJobs jobs;
+                jobs.buffers = buffers;
+                jobs.results = fft_results;
+                for (int r = 0; r < ANC_NUM_REF; r++) {
+                    jobs.accums[r] = &state->fft_accum.ff_accum[r];
+                }
+                for (int e = 0; e < ANC_NUM_ERR; e++) {
+                    jobs.accums[ANC_NUM_REF + e] = &state->fft_accum.fb_accum[e];
+                }
+                jobs.accums[NUM_CHANNELS - 1] = &state->fft_accum.spk_accum;
+                jobs.pp_accum = &state->fft_accum.pp_accum[0][0];
+                jobs.accum = &state->fft_accum;
+                jobs.transform = 0;
                 
-                // 计算主路径传函: PP = Sre/Srr = FB/FF (误差麦/参考麦)
-                for (int i = 0; i < FFT_HALF_LENGTH; i++) {
-                    Complex pp = complex_div(fb_fft[i], ff_fft[i]);
-                    // 累积主路径传函
-                    g_system_state.fft_accum.pp_accum[i].real += pp.real;
-                    g_system_state.fft_accum.pp_accum[i].imag += pp.imag;
+                int transformed = 1;
+                if (g_analysis_bins.mode == ANALYSIS_ZOOM) {
+                    transformed = zoom_transform(&state->zoom, &g_analysis_bins, fft_outputs);
+                } else if (g_analysis_bins.mode == ANALYSIS_SPARSE) {
+                    // 只算选定频点，结果与全频带FFT的对应频点一致
+                    sparse_transform(&g_analysis_bins, (const TimeBuffer *const *)buffers,
+                                     fft_outputs);
+                } else if (g_dsp_pool) {
+                    // 各通道在线程池上各自加窗FFT（与批量FFT逐通道结果相同）
+                    jobs.transform = 1;
+                } else {
+                    // 全部通道一次批量FFT（加窗在装载时完成）
+                    const float *fft_inputs[NUM_CHANNELS];
+                    for (int c = 0; c < NUM_CHANNELS; c++) {
+                        fft_inputs[c] = buffers[c]->data;
+                    }
+                    fft_real_batch(&g_fft_plan, fft_inputs, dsp_blackman_window, fft_outputs,
+                                   NUM_CHANNELS);
                 }
                 
-                g_system_state.fft_accum.accum_count++;
-                g_system_state.fft_count++;
+                if (transformed) {
+                    FreqResponse *ff_fft = &fft_results[0];            // 参考麦 Srr
+                    FreqResponse *fb_fft = &fft_results[ANC_NUM_REF];  // 误差麦 Sre
+                    
+                    // 各通道FFT与累积；dispatch返回即屏障，全部通道结果就绪
+                    thread_pool_dispatch(g_dsp_pool, NUM_CHANNELS, hop_channel_job, &jobs);
+                    
+                    // 计算并累积主路径传函: PP[e][r] = Sre/Srr = FB_e/FF_r (误差麦/参考麦)
+                    thread_pool_dispatch(g_dsp_pool, ANC_NUM_ERR * ANC_NUM_REF, hop_pp_job, &jobs);
+#if ANC_NUM_REF > 1
+                    thread_pool_dispatch(g_dsp_pool, ANC_NUM_REF, hop_cross_job, &jobs);
+#endif
+                    
+                    // 调度器的功率谱/互谱（仅在启用时累积）
+                    if (sched_on) {
+                        scheduler_accumulate(&state->sched, ff_fft, fb_fft);
+                    }
+                    
+                    state->fft_accum.accum_count++;
+                    state->fft_count++;
+                }
                 
                 // 移动buffer指针（hop）
-                ff_buf->sample_count -= FFT_HOP_SIZE;
-                fb_buf->sample_count -= FFT_HOP_SIZE;
-                spk_buf->sample_count -= FFT_HOP_SIZE;
+                for (int c = 0; c < NUM_CHANNELS; c++) {
+                    buffers[c]->sample_count -= FFT_HOP_SIZE;
+                }
             }
             
             // 完成10次FFT平均
-            if (g_system_state.fft_count >= NUM_FFT_AVERAGE) {
-                average_fft_results(&g_system_state.fft_accum, 
-                                    &g_system_state.ff_avg, 
-                                    &g_system_state.fb_avg, 
-                                    &g_system_state.spk_avg,
-                                    g_system_state.pp_average);
+            if (state->fft_count >= state->params.num_fft_average) {
+                average_fft_results(&state->fft_accum, 
+                                    state->ff_avg, 
+                                    state->fb_avg, 
+                                    &state->spk_avg,
+                                    state->pp_average);
                 
-                g_system_state.state = CAL_MU;
+                // 噪声场、相干度和残差都没有明显变化时跳过本轮优化
+                if (scheduler_should_adapt(&state->sched, &state->params.scheduler)) {
+                    state->state = CAL_MU;
+                } else {
+                    state->state = ADAPT_IDLE;
+                }
             }
             
-            g_system_state.frame_count++;
+            state->frame_count++;
             break;
             
         case CAL_MU:
             // 计算各频点步长
-            calculate_mu(&g_system_state);
-            g_system_state.state = CAL_FF_RESPONSE;
+            calculate_mu(state);
+            state->state = CAL_FF_RESPONSE;
             break;
             
         case CAL_FF_RESPONSE:
             // 计算当前前馈滤波器频响（必须先于CAL_TARGET_FF）
-            calculate_ff_response(&g_system_state);
-            g_system_state.state = CAL_TARGET_FF;
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                calculate_ff_response(&state->ff_ch[r]);
+            }
+            state->state = CAL_TARGET_FF;
             break;
             
         case CAL_TARGET_FF:
             // 计算目标前馈响应（使用已计算的current_ff）
-            calculate_target_ff(&g_system_state);
-            g_system_state.state = STABLE_CHECK;
+            calculate_target_ff(state);
+            state->state = STABLE_CHECK;
             break;
             
         case STABLE_CHECK:
-            // 检测目标频响是否稳定/异常
-            g_system_state.target_valid = check_target_stability(&g_system_state);
+            // 检测目标频响是否稳定/异常，任一通道异常则整体跳过
+            // 全部通道通过后才把本次目标的dB曲线采纳为下次检测的参考，
+            // 被跳过的一轮不改动任何通道的参考
+            state->target_valid = 1;
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                if (!stability_check(&state->ff_ch[r].stability, &state->ff_ch[r].target_ff)) {
+                    state->target_valid = 0;
+                }
+            }
             
-            if (g_system_state.target_valid) {
-                // 通过稳定性检测，保存当前目标作为下次检测的参考
-                memcpy(g_system_state.prev_target_ff, g_system_state.target_ff, 
-                       sizeof(g_system_state.target_ff));
-                
+            if (state->target_valid) {
+                for (int r = 0; r < ANC_NUM_REF; r++) {
+                    stability_commit(&state->ff_ch[r].stability);
+                }
                 // 继续下一步
-                g_system_state.state = CAL_FF_INIT_LOSS;
+                state->state = CAL_FF_INIT_LOSS;
             } else {
                 // 未通过检测，跳过本次更新，直接重置状态
                 log_printf("WARNING: Target response failed stability check, skipping update\n");
-                g_system_state.state = SIGNAL_PROCESS;
-                g_system_state.frame_count = 0;
-                g_system_state.fft_count = 0;
+                scheduler_end_adapt(&state->sched, 0);
+                state->state = SIGNAL_PROCESS;
+                state->frame_count = 0;
+                state->fft_count = 0;
             }
             break;
             
         case CAL_FF_INIT_LOSS:
             // 计算初始loss(当前FF参数与目标的拟合误差)
             // 这个loss作为后续梯度下降更新的基准阈值
-            calculate_ff_init_loss(&g_system_state);
-            g_system_state.state = UPDATE_EQ_PARAMS;
+            calculate_ff_init_loss(state);
+            state->state = UPDATE_EQ_PARAMS;
             break;
             
         case UPDATE_EQ_PARAMS:
             // 更新EQ参数
-            update_eq_params(&g_system_state);
-            g_system_state.state = UPDATE_FILTER_COEFFS;
+            update_eq_params(state);
+            state->state = UPDATE_FILTER_COEFFS;
             break;
             
         case UPDATE_FILTER_COEFFS:
             // 更新滤波器系数到375kHz
-            update_filter_coeffs(&g_system_state);
+            update_filter_coeffs(state);
+            scheduler_end_adapt(&state->sched, any_update_accepted(state));
             
             // 完成一轮自适应，重置状态
-            g_system_state.state = SIGNAL_PROCESS;
-            g_system_state.frame_count = 0;
-            g_system_state.fft_count = 0;
+            state->state = SIGNAL_PROCESS;
+            state->frame_count = 0;
+            state->fft_count = 0;
+            break;
+            
+        case ADAPT_IDLE:
+            // 跳过本轮优化，重置状态
+            state->state = SIGNAL_PROCESS;
+            state->frame_count = 0;
+            state->fft_count = 0;
             break;
             
         default:
-            g_system_state.state = SIGNAL_PROCESS;
+            state->state = SIGNAL_PROCESS;
             break;
     }
 }
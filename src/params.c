@@ -0,0 +1,189 @@
+#include "../inc/params.h"
+#include "../inc/coeffs.h"
+#include "../inc/logger.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PARAM_F(field, lo, hi)  {#field, PARAM_FLOAT, offsetof(AncParams, field), lo, hi}
+#define PARAM_I(field, lo, hi)  {#field, PARAM_INT, offsetof(AncParams, field), lo, hi}
+#define PARAM_STABILITY(field, lo, hi) \
+    {#field, PARAM_FLOAT, offsetof(AncParams, stability) + offsetof(StabilityThresholds, field), lo, hi}
+#define PARAM_SCHED(name, type, field, lo, hi) \
+    {name, type, offsetof(AncParams, scheduler) + offsetof(SchedulerThresholds, field), lo, hi}
+#define PARAM_FXLMS(name, type, field, lo, hi) \
+    {name, type, offsetof(AncParams, fxlms) + offsetof(FxlmsParams, field), lo, hi}
+#define PARAM_FDAF(name, type, field, lo, hi) \
+    {name, type, offsetof(AncParams, fdaf) + offsetof(FdafParams, field), lo, hi}
+
+// 可调参数表
+static const AncParamDesc g_param_table[] = {
+    PARAM_F(learning_rate_gain, 0.0, 100.0),
+    PARAM_F(learning_rate_q, 0.0, 100.0),
+    PARAM_F(learning_rate_fc, 0.0, 10000.0),
+    PARAM_F(learning_rate_total_gain, 0.0, 100.0),
+    PARAM_F(max_delta_gain, 0.0, 40.0),
+    PARAM_F(max_delta_q, 0.0, 10.0),
+    PARAM_F(max_delta_fc, 0.0, 20000.0),
+    PARAM_F(max_delta_total_gain, 0.0, 20.0),
+    PARAM_F(loss_improvement_factor, 0.0, 1.0),
+    PARAM_I(eq_fit_iterations, 0, 100),
+    PARAM_F(eq_fit_oob_weight, 0.0, 100.0),
+    PARAM_F(mu_min, 0.0, 1.0),
+    PARAM_F(mu_max, 0.0, 1.0),
+    PARAM_F(eval_grid_freq_low, 1.0, DSP_SAMPLE_RATE / 2),
+    PARAM_F(eval_grid_freq_high, 1.0, DSP_SAMPLE_RATE / 2),
+    PARAM_I(eval_grid_num_points, 2, FFT_HALF_LENGTH),
+    PARAM_F(stable_check_freq_low, 0.0, DSP_SAMPLE_RATE / 2),
+    PARAM_F(stable_check_freq_high, 0.0, DSP_SAMPLE_RATE / 2),
+    PARAM_STABILITY(smooth_alpha, 0.0, 1e9),
+    PARAM_STABILITY(spike_delta_db, 0.0, 1000.0),
+    PARAM_STABILITY(spike_ratio_thr, 0.0, 1.0),
+    PARAM_STABILITY(response_low_db, -1000.0, 1000.0),
+    PARAM_STABILITY(response_high_db, -1000.0, 1000.0),
+    PARAM_STABILITY(mean_shift_thr_db, 0.0, 1000.0),
+    PARAM_SCHED("sched_max_idle_rounds", PARAM_INT, max_idle_rounds, 0, 100000),
+    PARAM_SCHED("sched_change_db", PARAM_FLOAT, change_db, 0.0, 100.0),
+    PARAM_SCHED("sched_residual_rise_db", PARAM_FLOAT, residual_rise_db, 0.0, 100.0),
+    PARAM_SCHED("sched_coherence_delta", PARAM_FLOAT, coherence_delta, 0.0, 1.0),
+    PARAM_SCHED("sched_converge_db", PARAM_FLOAT, converge_db, 0.0, 100.0),
+    PARAM_FXLMS("fxlms_taps", PARAM_INT, num_taps, 1, FXLMS_MAX_TAPS),
+    PARAM_FXLMS("fxlms_mu", PARAM_FLOAT, mu, 0.0, 2.0),
+    PARAM_FXLMS("fxlms_epsilon", PARAM_FLOAT, epsilon, 0.0, 1.0),
+    PARAM_FDAF("fdaf_block_size", PARAM_INT, block_size, 2, FFT_LENGTH / 2),
+    PARAM_FDAF("fdaf_partitions", PARAM_INT, num_partitions, 1, FDAF_MAX_PARTITIONS),
+    PARAM_FDAF("fdaf_mu", PARAM_FLOAT, mu, 0.0, 2.0),
+    PARAM_FDAF("fdaf_power_alpha", PARAM_FLOAT, power_alpha, 0.0, 1.0),
+    PARAM_FDAF("fdaf_epsilon", PARAM_FLOAT, epsilon, 0.0, 1.0),
+    PARAM_I(num_fft_average, 1, 1000),
+    PARAM_F(iteration_time_ms, 10.0, 100000.0),
+    PARAM_I(max_iterations, 1, 100000),
+};
+
+#define NUM_PARAMS ((int)(sizeof(g_param_table) / sizeof(g_param_table[0])))
+
+// ============ 默认参数 ============
+void anc_params_default(AncParams *params) {
+    memset(params, 0, sizeof(AncParams));
+
+    params->learning_rate_gain = LEARNING_RATE_GAIN;
+    params->learning_rate_q = LEARNING_RATE_Q;
+    params->learning_rate_fc = LEARNING_RATE_FC;
+    params->learning_rate_total_gain = LEARNING_RATE_TOTAL_GAIN;
+
+    params->max_delta_gain = MAX_DELTA_GAIN;
+    params->max_delta_q = MAX_DELTA_Q;
+    params->max_delta_fc = MAX_DELTA_FC;
+    params->max_delta_total_gain = MAX_DELTA_TOTAL_GAIN;
+
+    params->loss_improvement_factor = LOSS_IMPROVEMENT_FACTOR;
+    params->eq_fit_iterations = EQ_FIT_ITERATIONS;
+    params->eq_fit_oob_weight = EQ_FIT_OOB_WEIGHT;
+    params->mu_min = MU_MIN;
+    params->mu_max = MU_MAX;
+
+    params->eval_grid_freq_low = EVAL_GRID_FREQ_LOW;
+    params->eval_grid_freq_high = EVAL_GRID_FREQ_HIGH;
+    params->eval_grid_num_points = EVAL_GRID_NUM_POINTS;
+
+    params->stable_check_freq_low = STABLE_CHECK_FREQ_LOW;
+    params->stable_check_freq_high = STABLE_CHECK_FREQ_HIGH;
+    params->stability.smooth_alpha = SMOOTH_ALPHA;
+    params->stability.spike_delta_db = SPIKE_DELTA_DB;
+    params->stability.spike_ratio_thr = SPIKE_RATIO_THR;
+    params->stability.response_low_db = RESPONSE_LOW_DB;
+    params->stability.response_high_db = RESPONSE_HIGH_DB;
+    params->stability.mean_shift_thr_db = MEAN_SHIFT_THR_DB;
+
+    params->scheduler.max_idle_rounds = SCHED_MAX_IDLE_ROUNDS;
+    params->scheduler.change_db = SCHED_CHANGE_DB;
+    params->scheduler.residual_rise_db = SCHED_RESIDUAL_RISE_DB;
+    params->scheduler.coherence_delta = SCHED_COHERENCE_DELTA;
+    params->scheduler.converge_db = SCHED_CONVERGE_DB;
+
+    params->fxlms.num_taps = FXLMS_TAPS;
+    params->fxlms.mu = FXLMS_MU;
+    params->fxlms.epsilon = FXLMS_EPSILON;
+
+    params->fdaf.block_size = FDAF_BLOCK_SIZE;
+    params->fdaf.num_partitions = FDAF_PARTITIONS;
+    params->fdaf.mu = FDAF_MU;
+    params->fdaf.power_alpha = FDAF_POWER_ALPHA;
+    params->fdaf.epsilon = FDAF_EPSILON;
+
+    params->num_fft_average = NUM_FFT_AVERAGE;
+    params->iteration_time_ms = ITERATION_TIME_MS;
+    params->max_iterations = MAX_ITERATIONS;
+}
+
+// ============ 查找参数 ============
+const AncParamDesc *anc_params_find(const char *name) {
+    for (int i = 0; i < NUM_PARAMS; i++) {
+        if (strcmp(g_param_table[i].name, name) == 0) {
+            return &g_param_table[i];
+        }
+    }
+    return NULL;
+}
+
+const AncParamDesc *anc_params_table(int *count) {
+    *count = NUM_PARAMS;
+    return g_param_table;
+}
+
+// ============ 读写参数 ============
+double anc_params_get(const AncParams *params, const AncParamDesc *desc) {
+    const char *base = (const char *)params + desc->offset;
+    if (desc->type == PARAM_INT) {
+        return *(const int *)base;
+    }
+    return *(const float *)base;
+}
+
+int anc_params_set(AncParams *params, const AncParamDesc *desc, double value) {
+    if (value < desc->min_val || value > desc->max_val) {
+        return -1;
+    }
+
+    char *base = (char *)params + desc->offset;
+    if (desc->type == PARAM_INT) {
+        *(int *)base = (int)(value + (value >= 0 ? 0.5 : -0.5));
+    } else {
+        *(float *)base = (float)value;
+    }
+    return 0;
+}
+
+// ============ 解析 name=value ============
+int anc_params_parse(AncParams *params, const char *assignment) {
+    const char *eq = strchr(assignment, '=');
+    if (!eq || eq == assignment) {
+        log_printf("Error: Expected name=value, got: %s\n", assignment);
+        return -1;
+    }
+
+    char name[64];
+    size_t len = (size_t)(eq - assignment);
+    if (len >= sizeof(name)) len = sizeof(name) - 1;
+    memcpy(name, assignment, len);
+    name[len] = '\0';
+
+    const AncParamDesc *desc = anc_params_find(name);
+    if (!desc) {
+        log_printf("Error: Unknown parameter: %s\n", name);
+        return -1;
+    }
+
+    char *end;
+    double value = strtod(eq + 1, &end);
+    if (end == eq + 1 || *end != '\0') {
+        log_printf("Error: Invalid value for %s: %s\n", name, eq + 1);
+        return -1;
+    }
+
+    if (anc_params_set(params, desc, value) != 0) {
+        log_printf("Error: %s=%g out of range [%g, %g]\n", name, value, desc->min_val, desc->max_val);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "../inc/resample.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static long long gcd_ll(long long a, long long b) {
+    while (b != 0) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// ============ 输出长度 ============
+int resample_length(int in_len, int in_rate, int out_rate) {
+    if (in_len <= 0 || in_rate <= 0 || out_rate <= 0) {
+        return 0;
+    }
+    return (int)(((long long)in_len * out_rate + in_rate - 1) / in_rate);
+}
+
+// ============ 重采样 ============
+int resample_signal(const float *in, int in_len, int in_rate, int out_rate, float *out) {
+    if (in_rate <= 0 || out_rate <= 0) {
+        log_printf("Error: Invalid resampling rates %d -> %d Hz\n", in_rate, out_rate);
+        return -1;
+    }
+    const long long g = gcd_ll(in_rate, out_rate);
+    const int L = (int)(out_rate / g);
+    const int M = (int)(in_rate / g);
+    if (L > RESAMPLE_MAX_PHASES) {
+        log_printf("Error: Resampling %d -> %d Hz needs %d phases (max %d)\n",
+                   in_rate, out_rate, L, RESAMPLE_MAX_PHASES);
+        return -1;
+    }
+
+    // 截止频率（周期/输入样本）与半宽（输入样本）
+    const double cutoff = RESAMPLE_CUTOFF * 0.5 * (out_rate < in_rate ? (double)L / M : 1.0);
+    const int K = (int)ceil(RESAMPLE_ZERO_CROSSINGS / (2.0 * cutoff));
+    const int taps = 2 * K;
+
+    // 相位表: 相位p对应 t = n0 + p/L，抽头j作用于输入 n0 - K + 1 + j
+    float *table = (float *)malloc((size_t)L * taps * sizeof(float));
+    if (!table) {
+        log_printf("Error: Failed to allocate resampling table (%d x %d)\n", L, taps);
+        return -1;
+    }
+    for (int p = 0; p < L; p++) {
+        float *h = &table[(size_t)p * taps];
+        double sum = 0.0;
+        for (int j = 0; j < taps; j++) {
+            double d = (double)(j - K + 1) - (double)p / L;
+            double x = 2.0 * cutoff * d;
+            double sinc = fabs(x) < 1e-12 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+            double w = fabs(d) >= K ? 0.0
+                     : 0.42 + 0.5 * cos(M_PI * d / K) + 0.08 * cos(2.0 * M_PI * d / K);
+            double v = 2.0 * cutoff * sinc * w;
+            h[j] = (float)v;
+            sum += v;
+        }
+        for (int j = 0; j < taps; j++) {
+            h[j] = (float)(h[j] / sum);
+        }
+    }
+
+    const int out_len = resample_length(in_len, in_rate, out_rate);
+    for (int k = 0; k < out_len; k++) {
+        const long long pos = (long long)k * M;
+        const int n0 = (int)(pos / L);
+        const float *h = &table[(size_t)(pos % L) * taps];
+        const int first = n0 - K + 1;
+
+        // 只累加落在信号范围内的抽头
+        int j_lo = first < 0 ? -first : 0;
+        int j_hi = in_len - first < taps ? in_len - first : taps;
+        double acc = 0.0;
+        for (int j = j_lo; j < j_hi; j++) {
+            acc += (double)h[j] * in[first + j];
+        }
+        out[k] = (float)acc;
+    }
+
+    free(table);
+    return 0;
+}
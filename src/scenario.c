@@ -0,0 +1,477 @@
+#include "../inc/scenario.h"
+#include "../inc/fir_filter.h"
+#include "../inc/thread_pool.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SCENARIO_USE_SSE 1
+#else
+#define SCENARIO_USE_SSE 0
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define SCENARIO_LINE_MAX       1024
+#define SCENARIO_TONE_BLOCK     256     // 单频合成块长：块内查表旋转，块首按双精度重新定相（无累积误差）
+#define SCENARIO_CHUNK          4096    // 主路径卷积的输出块长（栈上缓冲）
+#define SCENARIO_JOB_LENGTH     65536   // 每个线程池任务的输出样本数
+#define SCENARIO_CROSSFADE_MS   10.0    // 主路径变化时新旧路径的线性交叉淡化时长
+#define SCENARIO_PAIR_DELAY_MS  0.05    // MIMO各(误差麦, 参考麦)对的主路径延迟依次错开量
+#define SCENARIO_IR_TAIL        6.9     // 参数化主路径截断在包络衰减到-60 dB处（ln(1000)个时间常数）
+
+// ============ 默认场景 ============
+void scenario_default(ScenarioSpec *spec) {
+    memset(spec, 0, sizeof(ScenarioSpec));
+    spec->seed = 1;
+    spec->duration_s = 10.0f;
+    spec->sample_rate = REALTIME_SAMPLE_RATE;
+    spec->broadband_rms = 0.001f;
+    spec->broadband_cutoff_hz = 2000.0f;
+    spec->num_tones = 1;
+    spec->tones[0].freq_hz = 1000.0f;
+    spec->tones[0].amplitude = 0.001f;
+    spec->primary_delay_ms = 0.3f;
+    spec->primary_gain = 0.8f;
+    spec->primary_decay_ms = 0.1f;
+    spec->primary_resonance_hz = 800.0f;
+    spec->num_changes = 1;
+    spec->changes[0].time_s = 6.0f;
+    spec->changes[0].gain_scale = 0.7f;
+    spec->changes[0].delay_ms = 0.05f;
+    spec->sensor_noise_rms = 1e-5f;
+}
+
+// ============ 解析配置文件 ============
+int scenario_load_spec(const char *filename, ScenarioSpec *spec) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        log_printf("Error: Cannot open scenario spec: %s\n", filename);
+        return -1;
+    }
+
+    scenario_default(spec);
+    const float nyquist = 0.5f * spec->sample_rate;
+    int tones_given = 0;
+    int changes_given = 0;
+
+    char line[SCENARIO_LINE_MAX];
+    int line_no = 0;
+    int result = 0;
+
+    while (result == 0 && fgets(line, sizeof(line), file)) {
+        line_no++;
+
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char *key = strtok(line, " \t\r\n");
+        if (!key) continue;
+
+        if (strcmp(key, "primary_ir") == 0) {
+            char *path = strtok(NULL, " \t\r\n");
+            if (!path || strlen(path) >= sizeof(spec->primary_ir_path)) {
+                log_printf("Error: %s:%d: primary_ir needs a file path\n", filename, line_no);
+                result = -1;
+            } else {
+                strcpy(spec->primary_ir_path, path);
+            }
+            continue;
+        }
+
+        // 多读一个，值个数超出时整行报错
+        double v[5];
+        int nv = 0;
+        char *value;
+        while (nv < 5 && (value = strtok(NULL, " \t\r\n")) != NULL) {
+            v[nv++] = strtod(value, NULL);
+        }
+
+        if (strcmp(key, "seed") == 0 && nv == 1) {
+            spec->seed = (unsigned int)v[0];
+        } else if (strcmp(key, "duration") == 0 && nv == 1 && v[0] > 0.0) {
+            spec->duration_s = (float)v[0];
+        } else if (strcmp(key, "broadband") == 0 && nv >= 1 && nv <= 2 && v[0] >= 0.0 &&
+                   (nv < 2 || (v[1] >= 0.0 && v[1] < nyquist))) {
+            spec->broadband_rms = (float)v[0];
+            spec->broadband_cutoff_hz = nv == 2 ? (float)v[1] : 0.0f;
+        } else if (strcmp(key, "tone") == 0 && nv == 2 && v[0] > 0.0 && v[0] < nyquist) {
+            if (!tones_given) {
+                spec->num_tones = 0;
+                tones_given = 1;
+            }
+            if (spec->num_tones >= SCENARIO_MAX_TONES) {
+                log_printf("Error: %s:%d: too many tones (max %d)\n",
+                           filename, line_no, SCENARIO_MAX_TONES);
+                result = -1;
+            } else {
+                spec->tones[spec->num_tones].freq_hz = (float)v[0];
+                spec->tones[spec->num_tones].amplitude = (float)v[1];
+                spec->num_tones++;
+            }
+        } else if (strcmp(key, "primary") == 0 && nv == 4 && v[0] >= 0.0 && v[2] > 0.0 &&
+                   v[3] >= 0.0 && v[3] < nyquist) {
+            spec->primary_delay_ms = (float)v[0];
+            spec->primary_gain = (float)v[1];
+            spec->primary_decay_ms = (float)v[2];
+            spec->primary_resonance_hz = (float)v[3];
+        } else if (strcmp(key, "change") == 0 && nv == 3 && v[0] > 0.0 && v[2] >= 0.0) {
+            if (!changes_given) {
+                spec->num_changes = 0;
+                changes_given = 1;
+            }
+            if (spec->num_changes >= SCENARIO_MAX_CHANGES) {
+                log_printf("Error: %s:%d: too many path changes (max %d)\n",
+                           filename, line_no, SCENARIO_MAX_CHANGES);
+                result = -1;
+            } else if (spec->num_changes > 0 &&
+                       v[0] <= spec->changes[spec->num_changes - 1].time_s) {
+                log_printf("Error: %s:%d: path changes must be in increasing time order\n",
+                           filename, line_no);
+                result = -1;
+            } else {
+                spec->changes[spec->num_changes].time_s = (float)v[0];
+                spec->changes[spec->num_changes].gain_scale = (float)v[1];
+                spec->changes[spec->num_changes].delay_ms = (float)v[2];
+                spec->num_changes++;
+            }
+        } else if (strcmp(key, "sensor_noise") == 0 && nv == 1 && v[0] >= 0.0) {
+            spec->sensor_noise_rms = (float)v[0];
+        } else if (strcmp(key, "static") == 0 && nv == 0) {
+            // 显式关闭默认的主路径变化
+            spec->num_changes = 0;
+            changes_given = 1;
+        } else {
+            log_printf("Error: %s:%d: invalid scenario line \"%s\"\n", filename, line_no, key);
+            result = -1;
+        }
+    }
+    fclose(file);
+
+    if (result == 0 && (double)spec->duration_s * spec->sample_rate > 0x3FFFFFFF) {
+        log_printf("Error: Scenario duration %.1f s is too long\n", spec->duration_s);
+        result = -1;
+    }
+    return result;
+}
+
+// ============ 合成内核 ============
+// splitmix32：由种子和流序号派生互不相关的随机状态
+static uint32_t derive_seed(uint32_t seed, uint32_t stream) {
+    uint32_t z = seed + 0x9E3779B9u * (stream + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+    return z ? z : 1;
+}
+
+// 近似高斯白噪声：4个[-1,1)均匀分布之和，单位方差
+// 4路xorshift32按通道并行，SSE与标量路径逐位一致
+static void synth_noise(float *out, int n, float rms, uint32_t seed, uint32_t stream) {
+    if (rms <= 0.0f) {
+        memset(out, 0, n * sizeof(float));
+        return;
+    }
+
+    uint32_t lanes[4];
+    for (int l = 0; l < 4; l++) {
+        lanes[l] = derive_seed(seed, stream * 4 + l);
+    }
+    const float scale = rms * 0.8660254f / 8388608.0f;    // sqrt(3/4) / 2^23
+    int i = 0;
+
+#if SCENARIO_USE_SSE
+    __m128i s = _mm_loadu_si128((const __m128i *)lanes);
+    const __m128i half = _mm_set1_epi32(1 << 23);
+    const __m128 vscale = _mm_set1_ps(scale);
+    for (; i + 4 <= n; i += 4) {
+        __m128i acc = _mm_setzero_si128();
+        for (int j = 0; j < 4; j++) {
+            s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+            s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+            s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+            acc = _mm_add_epi32(acc, _mm_sub_epi32(_mm_srli_epi32(s, 8), half));
+        }
+        _mm_storeu_ps(&out[i], _mm_mul_ps(_mm_cvtepi32_ps(acc), vscale));
+    }
+    _mm_storeu_si128((__m128i *)lanes, s);
+#endif
+
+    for (; i < n; i += 4) {
+        int32_t acc[4] = {0, 0, 0, 0};
+        for (int j = 0; j < 4; j++) {
+            for (int l = 0; l < 4; l++) {
+                uint32_t x = lanes[l];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                lanes[l] = x;
+                acc[l] += (int32_t)(x >> 8) - (1 << 23);
+            }
+        }
+        for (int l = 0; l < 4 && i + l < n; l++) {
+            out[i + l] = (float)acc[l] * scale;
+        }
+    }
+}
+
+// 一阶低通，输出按白噪声输入的方差比补偿，保持RMS不变
+static void lowpass_keep_rms(float *x, int n, float cutoff_hz, int sample_rate) {
+    double a = 1.0 - exp(-2.0 * M_PI * cutoff_hz / sample_rate);
+    const float alpha = (float)a;
+    const float gain = (float)sqrt((2.0 - a) / a);
+    float y = 0.0f;
+    for (int i = 0; i < n; i++) {
+        y += alpha * (x[i] - y);
+        x[i] = y * gain;
+    }
+}
+
+// out[i] += a * x[i]
+static void axpy(float *out, const float *x, float a, int n) {
+    int i = 0;
+#if SCENARIO_USE_SSE
+    const __m128 va = _mm_set1_ps(a);
+    for (; i + 4 <= n; i += 4) {
+        __m128 y = _mm_add_ps(_mm_loadu_ps(&out[i]), _mm_mul_ps(va, _mm_loadu_ps(&x[i])));
+        _mm_storeu_ps(&out[i], y);
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] += a * x[i];
+    }
+}
+
+// 叠加单频: sin(φ + ωk) = sinφ·cos(ωk) + cosφ·sin(ωk)，块内ωk查表，块首φ按双精度计算
+static void add_tone(float *out, int n, double freq_hz, float amplitude, double phase,
+                     int sample_rate) {
+    float sin_tab[SCENARIO_TONE_BLOCK];
+    float cos_tab[SCENARIO_TONE_BLOCK];
+    const double w = 2.0 * M_PI * freq_hz / sample_rate;
+    for (int k = 0; k < SCENARIO_TONE_BLOCK; k++) {
+        sin_tab[k] = (float)sin(w * k);
+        cos_tab[k] = (float)cos(w * k);
+    }
+
+    for (int b = 0; b < n; b += SCENARIO_TONE_BLOCK) {
+        int len = n - b < SCENARIO_TONE_BLOCK ? n - b : SCENARIO_TONE_BLOCK;
+        double ph = fmod(phase + w * b, 2.0 * M_PI);
+        axpy(&out[b], cos_tab, amplitude * (float)sin(ph), len);
+        axpy(&out[b], sin_tab, amplitude * (float)cos(ph), len);
+    }
+}
+
+// ============ 主路径 ============
+// 一段时间内一个(误差麦, 参考麦)对的主路径：共享的单位增益形状 + 各自的增益和延迟
+typedef struct {
+    const float *shape;
+    int length;
+    float gain;
+    int delay;
+} PrimaryPath;
+
+// out[i] += gain * Σ_k shape[k] * x[pos + i - delay - k]（x[<0]视为0）
+// 按抽头逐个axpy，内层对输出连续，便于向量化
+static void convolve_add(const PrimaryPath *path, const float *x, int pos, float *out, int count) {
+    for (int k = 0; k < path->length; k++) {
+        int base = pos - path->delay - k;
+        int i0 = base < 0 ? -base : 0;
+        if (i0 >= count) break;     // 后续抽头更早，同样全部落在信号起点之前
+        axpy(&out[i0], &x[base + i0], path->gain * path->shape[k], count - i0);
+    }
+}
+
+// 主路径卷积任务：每个任务负责一个误差麦的一段输出
+typedef struct {
+    const float *const *ff;
+    float **fb;
+    int num_samples;
+    int jobs_per_mic;
+    int num_segments;                                   // 初始路径 + 变化次数
+    int segment_start[SCENARIO_MAX_CHANGES + 1];        // 各段起始样本
+    int crossfade;                                      // 交叉淡化样本数
+    PrimaryPath paths[SCENARIO_MAX_CHANGES + 1][ANC_NUM_ERR][ANC_NUM_REF];
+} PrimaryJobs;
+
+static void primary_job(void *arg, int job_index) {
+    const PrimaryJobs *jobs = (const PrimaryJobs *)arg;
+    const int e = job_index / jobs->jobs_per_mic;
+    const int start = (job_index % jobs->jobs_per_mic) * SCENARIO_JOB_LENGTH;
+    const int end = start + SCENARIO_JOB_LENGTH < jobs->num_samples ?
+                    start + SCENARIO_JOB_LENGTH : jobs->num_samples;
+    float cur[SCENARIO_CHUNK];
+    float prev[SCENARIO_CHUNK];
+
+    int seg = 0;
+    for (int pos = start; pos < end; ) {
+        while (seg + 1 < jobs->num_segments && jobs->segment_start[seg + 1] <= pos) seg++;
+
+        // 块不跨越段边界和淡化结束点
+        int limit = end;
+        if (seg + 1 < jobs->num_segments && jobs->segment_start[seg + 1] < limit) {
+            limit = jobs->segment_start[seg + 1];
+        }
+        int fade_end = seg > 0 ? jobs->segment_start[seg] + jobs->crossfade : 0;
+        int fading = pos < fade_end;
+        if (fading && fade_end < limit) limit = fade_end;
+        int count = limit - pos < SCENARIO_CHUNK ? limit - pos : SCENARIO_CHUNK;
+
+        memset(cur, 0, count * sizeof(float));
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            convolve_add(&jobs->paths[seg][e][r], jobs->ff[r], pos, cur, count);
+        }
+        if (fading) {
+            // 从旧路径线性过渡到新路径
+            memset(prev, 0, count * sizeof(float));
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                convolve_add(&jobs->paths[seg - 1][e][r], jobs->ff[r], pos, prev, count);
+            }
+            const int offset = pos - jobs->segment_start[seg];
+            const float inv_fade = 1.0f / jobs->crossfade;
+            for (int i = 0; i < count; i++) {
+                float w = (offset + i) * inv_fade;
+                cur[i] = prev[i] + w * (cur[i] - prev[i]);
+            }
+        }
+
+        float *out = &jobs->fb[e][pos];
+        for (int i = 0; i < count; i++) {
+            out[i] += cur[i];
+        }
+        pos += count;
+    }
+}
+
+// 主路径形状：文件加载或参数化生成（指数衰减谐振，直流增益归一化为1）
+// 返回形状长度，base_delay输出传播延迟（样本），-1表示失败
+static int build_primary_shape(const ScenarioSpec *spec, float *shape, int *base_delay) {
+    if (spec->primary_ir_path[0]) {
+        *base_delay = 0;
+        int length = fir_load_coeffs(spec->primary_ir_path, shape, MAX_FIR_LENGTH);
+        if (length <= 0) {
+            log_printf("Error: Cannot load primary path IR: %s\n", spec->primary_ir_path);
+            return -1;
+        }
+        return length;
+    }
+
+    const double fs = spec->sample_rate;
+    const double tau = spec->primary_decay_ms * fs / 1000.0;
+    const double w = 2.0 * M_PI * spec->primary_resonance_hz / fs;
+    int length = (int)ceil(tau * SCENARIO_IR_TAIL);
+    if (length < 1) length = 1;
+    if (length > MAX_FIR_LENGTH) length = MAX_FIR_LENGTH;
+
+    double norm = 0.0;
+    for (int k = 0; k < length; k++) {
+        norm += exp(-k / tau);
+    }
+    for (int k = 0; k < length; k++) {
+        shape[k] = (float)(exp(-k / tau) * cos(w * k) / norm);
+    }
+    *base_delay = (int)lround(spec->primary_delay_ms * fs / 1000.0);
+    return length;
+}
+
+// ============ 合成场景 ============
+int scenario_generate(const ScenarioSpec *spec, float *ff[], float *fb[], int num_threads) {
+    const int fs = spec->sample_rate;
+    const int n = (int)lround((double)spec->duration_s * fs);
+    if (n <= 0) {
+        log_printf("Error: Scenario has no samples\n");
+        return -1;
+    }
+
+    int ok = 1;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        ff[r] = (float *)malloc(n * sizeof(float));
+        ok = ok && ff[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        fb[e] = (float *)malloc(n * sizeof(float));
+        ok = ok && fb[e];
+    }
+    float *shape = (float *)malloc(MAX_FIR_LENGTH * sizeof(float));
+    PrimaryJobs *jobs = (PrimaryJobs *)malloc(sizeof(PrimaryJobs));
+    int base_delay = 0;
+    int shape_length = (ok && shape && jobs) ? build_primary_shape(spec, shape, &base_delay) : -1;
+    if (shape_length <= 0) {
+        if (!ok || !shape || !jobs) log_printf("Error: Failed to allocate scenario signals\n");
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free(ff[r]);
+            ff[r] = NULL;
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            free(fb[e]);
+            fb[e] = NULL;
+        }
+        free(shape);
+        free(jobs);
+        return -1;
+    }
+
+    // 参考麦：各通道独立宽带噪声 + 单频（初相由种子决定）
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        synth_noise(ff[r], n, spec->broadband_rms, spec->seed, r);
+        if (spec->broadband_cutoff_hz > 0.0f && spec->broadband_rms > 0.0f) {
+            lowpass_keep_rms(ff[r], n, spec->broadband_cutoff_hz, fs);
+        }
+        for (int t = 0; t < spec->num_tones; t++) {
+            uint32_t h = derive_seed(spec->seed, 0x10000u + r * SCENARIO_MAX_TONES + t);
+            double phase = 2.0 * M_PI * (h / 4294967296.0);
+            add_tone(ff[r], n, spec->tones[t].freq_hz, spec->tones[t].amplitude, phase, fs);
+        }
+    }
+
+    // 误差麦：非相干传感器噪声 + Σ参考麦经主路径（各段路径相对初始路径变化增益和延迟）
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        synth_noise(fb[e], n, spec->sensor_noise_rms, spec->seed, ANC_NUM_REF + e);
+    }
+
+    const float base_gain = spec->primary_ir_path[0] ? 1.0f : spec->primary_gain;
+    jobs->ff = (const float *const *)ff;
+    jobs->fb = fb;
+    jobs->num_samples = n;
+    jobs->jobs_per_mic = (n + SCENARIO_JOB_LENGTH - 1) / SCENARIO_JOB_LENGTH;
+    jobs->num_segments = spec->num_changes + 1;
+    jobs->crossfade = (int)lround(SCENARIO_CROSSFADE_MS * fs / 1000.0);
+    if (jobs->crossfade < 1) jobs->crossfade = 1;
+    for (int s = 0; s < jobs->num_segments; s++) {
+        const ScenarioChange *change = s > 0 ? &spec->changes[s - 1] : NULL;
+        jobs->segment_start[s] = change ? (int)lround((double)change->time_s * fs) : 0;
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                double extra_ms = (change ? change->delay_ms : 0.0) + SCENARIO_PAIR_DELAY_MS * (e + r);
+                PrimaryPath *path = &jobs->paths[s][e][r];
+                path->shape = shape;
+                path->length = shape_length;
+                path->gain = base_gain * (change ? change->gain_scale : 1.0f);
+                path->delay = base_delay + (int)lround(extra_ms * fs / 1000.0);
+            }
+        }
+    }
+    thread_pool_run(num_threads, ANC_NUM_ERR * jobs->jobs_per_mic, primary_job, jobs);
+
+    log_printf("Scenario: %.2f s at %d Hz, seed %u\n", (float)n / fs, fs, spec->seed);
+    log_printf("  Broadband: %.3g rms (%s), %d tones, sensor noise %.3g rms\n",
+               spec->broadband_rms, spec->broadband_cutoff_hz > 0.0f ? "low-passed" : "white",
+               spec->num_tones, spec->sensor_noise_rms);
+    log_printf("  Primary path: %s, %d taps + %d delay, %d changes\n",
+               spec->primary_ir_path[0] ? spec->primary_ir_path : "parametric",
+               shape_length, base_delay, spec->num_changes);
+    for (int c = 0; c < spec->num_changes; c++) {
+        log_printf("    at %.2f s: gain x%.2f, delay +%.3f ms\n", spec->changes[c].time_s,
+                   spec->changes[c].gain_scale, spec->changes[c].delay_ms);
+    }
+
+    free(shape);
+    free(jobs);
+    return n;
+}
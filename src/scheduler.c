@@ -0,0 +1,173 @@
+#include "../inc/scheduler.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <string.h>
+
+// ============ 初始化 ============
+void scheduler_init(AdaptScheduler *sched, const AnalysisBins *bins, float freq_low, float freq_high) {
+    memset(sched, 0, sizeof(AdaptScheduler));
+    sched->num_bands = SCHED_NUM_BANDS;
+    memset(sched->band_of, SCHED_BAND_NONE, sizeof(sched->band_of));
+
+    // 频带边界 freq_low * (freq_high/freq_low)^(b/B)，频段外和DC不参与
+    const float log_span = logf(freq_high / freq_low);
+    for (int k = 0; k < bins->num_bins; k++) {
+        float freq = bins->freq[k];
+        if (freq <= 0.0f || freq < freq_low || freq > freq_high || log_span <= 0.0f) {
+            continue;
+        }
+        int band = (int)(SCHED_NUM_BANDS * logf(freq / freq_low) / log_span);
+        if (band > SCHED_NUM_BANDS - 1) band = SCHED_NUM_BANDS - 1;
+        sched->band_of[k] = (unsigned char)band;
+        if (sched->bin_high == 0) sched->bin_low = k;
+        sched->bin_high = k + 1;
+    }
+}
+
+// ============ 逐hop累积 ============
+void scheduler_begin_round(AdaptScheduler *sched) {
+    sched->hops = 0;
+    memset(sched->ref_power, 0, sizeof(sched->ref_power));
+    memset(sched->err_power, 0, sizeof(sched->err_power));
+    memset(sched->cross_re, 0, sizeof(sched->cross_re));
+    memset(sched->cross_im, 0, sizeof(sched->cross_im));
+}
+
+void scheduler_accumulate(AdaptScheduler *sched, const FreqResponse *ff, const FreqResponse *fb) {
+    const int lo = sched->bin_low, hi = sched->bin_high;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        float *power = sched->ref_power[r];
+        for (int k = lo; k < hi; k++) {
+            power[k] += ff[r].re[k] * ff[r].re[k] + ff[r].im[k] * ff[r].im[k];
+        }
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        float *power = sched->err_power[e];
+        for (int k = lo; k < hi; k++) {
+            power[k] += fb[e].re[k] * fb[e].re[k] + fb[e].im[k] * fb[e].im[k];
+        }
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            float *cross_re = sched->cross_re[e][r];
+            float *cross_im = sched->cross_im[e][r];
+            for (int k = lo; k < hi; k++) {
+                cross_re[k] += fb[e].re[k] * ff[r].re[k] + fb[e].im[k] * ff[r].im[k];
+                cross_im[k] += fb[e].im[k] * ff[r].re[k] - fb[e].re[k] * ff[r].im[k];
+            }
+        }
+    }
+    sched->hops++;
+}
+
+// ============ 频带汇总 ============
+// 能量: 10*log10(频带内Σ功率 / hop数)
+// 相干度: 频带内各频点 |Σ互谱|² / (Σ参考功率 · Σ误差功率) 的平均
+static void summarize(AdaptScheduler *sched, int *band_bins) {
+    float ref_sum[ANC_NUM_REF][SCHED_NUM_BANDS] = {{0}};
+    float err_sum[ANC_NUM_ERR][SCHED_NUM_BANDS] = {{0}};
+    float coh_sum[ANC_NUM_ERR][ANC_NUM_REF][SCHED_NUM_BANDS] = {{{0}}};
+    memset(band_bins, 0, SCHED_NUM_BANDS * sizeof(int));
+
+    for (int k = sched->bin_low; k < sched->bin_high; k++) {
+        int b = sched->band_of[k];
+        if (b == SCHED_BAND_NONE) continue;
+        band_bins[b]++;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            ref_sum[r][b] += sched->ref_power[r][k];
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            err_sum[e][b] += sched->err_power[e][k];
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                float cr = sched->cross_re[e][r][k];
+                float ci = sched->cross_im[e][r][k];
+                float den = sched->ref_power[r][k] * sched->err_power[e][k];
+                coh_sum[e][r][b] += den > 1e-30f ? (cr * cr + ci * ci) / den : 0.0f;
+            }
+        }
+    }
+
+    const float hops = sched->hops > 0 ? (float)sched->hops : 1.0f;
+    float err_total = 0.0f;
+    for (int b = 0; b < SCHED_NUM_BANDS; b++) {
+        const float count = band_bins[b] > 0 ? (float)band_bins[b] : 1.0f;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            sched->ref_db[r][b] = 10.0f * log10f(ref_sum[r][b] / hops + 1e-20f);
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            sched->err_db[e][b] = 10.0f * log10f(err_sum[e][b] / hops + 1e-20f);
+            err_total += err_sum[e][b];
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                sched->coherence[e][r][b] = coh_sum[e][r][b] / count;
+            }
+        }
+    }
+    sched->err_total_db = 10.0f * log10f(err_total / hops + 1e-20f);
+}
+
+// ============ 调度判定 ============
+int scheduler_should_adapt(AdaptScheduler *sched, const SchedulerThresholds *thr) {
+    if (thr->max_idle_rounds <= 0) {
+        return 1;
+    }
+
+    int band_bins[SCHED_NUM_BANDS];
+    summarize(sched, band_bins);
+    sched->rounds++;
+
+    // 与基准比较：各频带取最大变化
+    float change = 0.0f, coherence = 0.0f, rise = -INFINITY;
+    for (int b = 0; b < SCHED_NUM_BANDS && sched->has_base; b++) {
+        if (band_bins[b] == 0) continue;
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            change = fmaxf(change, fabsf(sched->ref_db[r][b] - sched->base_ref_db[r][b]));
+        }
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            rise = fmaxf(rise, sched->err_db[e][b] - sched->base_err_db[e][b]);
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                coherence = fmaxf(coherence,
+                                  fabsf(sched->coherence[e][r][b] - sched->base_coherence[e][r][b]));
+            }
+        }
+    }
+
+    const char *reason = NULL;
+    if (!sched->has_base) {
+        reason = "no baseline";
+    } else if (sched->last_updated &&
+               sched->base_err_total_db - sched->err_total_db > thr->converge_db) {
+        reason = "still converging";
+    } else if (sched->idle_rounds >= thr->max_idle_rounds) {
+        reason = "max idle interval";
+    } else if (change > thr->change_db) {
+        reason = "noise field change";
+    } else if (coherence > thr->coherence_delta) {
+        reason = "coherence change";
+    } else if (rise > thr->residual_rise_db) {
+        reason = "residual rise";
+    }
+
+    if (!reason) {
+        sched->idle_rounds++;
+        log_printf("Scheduler: idle %d/%d (noise %.2f dB, coherence %.3f, residual %+.2f dB)\n",
+                   sched->idle_rounds, thr->max_idle_rounds, change, coherence, rise);
+        return 0;
+    }
+
+    if (sched->has_base) {
+        log_printf("Scheduler: adapt, %s (noise %.2f dB, coherence %.3f, residual %+.2f dB)\n",
+                   reason, change, coherence, rise);
+    } else {
+        log_printf("Scheduler: adapt, %s\n", reason);
+    }
+    memcpy(sched->base_ref_db, sched->ref_db, sizeof(sched->ref_db));
+    memcpy(sched->base_err_db, sched->err_db, sizeof(sched->err_db));
+    memcpy(sched->base_coherence, sched->coherence, sizeof(sched->coherence));
+    sched->base_err_total_db = sched->err_total_db;
+    sched->has_base = 1;
+    sched->idle_rounds = 0;
+    sched->adapted_rounds++;
+    return 1;
+}
+
+void scheduler_end_adapt(AdaptScheduler *sched, int updated) {
+    sched->last_updated = updated;
+}
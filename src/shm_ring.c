@@ -0,0 +1,202 @@
+#include "../inc/shm_ring.h"
+#include "../inc/logger.h"
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+// ============ 不支持POSIX共享内存的平台 ============
+int shm_ring_create(ShmRing *ring, const char *name, int num_channels, int sample_rate,
+                    int capacity) {
+    memset(ring, 0, sizeof(ShmRing));
+    log_printf("Error: Shared-memory streaming is not supported on this platform\n");
+    return -1;
+}
+
+int shm_ring_open(ShmRing *ring, const char *name) {
+    memset(ring, 0, sizeof(ShmRing));
+    log_printf("Error: Shared-memory streaming is not supported on this platform\n");
+    return -1;
+}
+
+void shm_ring_destroy(ShmRing *ring) {
+    memset(ring, 0, sizeof(ShmRing));
+}
+
+#else
+
+// ============ 创建 ============
+int shm_ring_create(ShmRing *ring, const char *name, int num_channels, int sample_rate,
+                    int capacity) {
+    memset(ring, 0, sizeof(ShmRing));
+    if (num_channels <= 0 || capacity <= 0) return -1;
+
+    uint32_t frames = 1;
+    while (frames < (uint32_t)capacity) frames <<= 1;
+
+    size_t map_size = sizeof(ShmRingHeader) + (size_t)frames * num_channels * sizeof(float);
+
+    shm_unlink(name);   // 清除上次异常退出遗留的同名对象
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        log_printf("Error: Cannot create shared memory %s\n", name);
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)map_size) != 0) {
+        log_printf("Error: Cannot size shared memory %s\n", name);
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    void *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        log_printf("Error: Cannot map shared memory %s\n", name);
+        shm_unlink(name);
+        return -1;
+    }
+
+    ShmRingHeader *header = (ShmRingHeader *)base;
+    header->version = SHM_RING_VERSION;
+    header->num_channels = (uint32_t)num_channels;
+    header->sample_rate = (uint32_t)sample_rate;
+    header->capacity = frames;
+    atomic_init(&header->write_pos, 0);
+    atomic_init(&header->read_pos, 0);
+    atomic_init(&header->closed, 0);
+    atomic_init(&header->dropped, 0);
+    // magic最后发布，消费者看到magic即可使用其余字段
+    atomic_thread_fence(memory_order_release);
+    header->magic = SHM_RING_MAGIC;
+
+    ring->header = header;
+    ring->data = (float *)((char *)base + sizeof(ShmRingHeader));
+    ring->map_size = map_size;
+    ring->owner = 1;
+    snprintf(ring->name, sizeof(ring->name), "%s", name);
+    return 0;
+}
+
+// ============ 连接 ============
+int shm_ring_open(ShmRing *ring, const char *name) {
+    memset(ring, 0, sizeof(ShmRing));
+
+    int fd = shm_open(name, O_RDWR, 0600);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmRingHeader)) {
+        close(fd);
+        return -1;
+    }
+    size_t map_size = (size_t)st.st_size;
+    void *base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return -1;
+
+    ShmRingHeader *header = (ShmRingHeader *)base;
+    if (header->magic != SHM_RING_MAGIC) {
+        // 生产者尚未完成初始化
+        munmap(base, map_size);
+        return -1;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    if (header->version != SHM_RING_VERSION ||
+        sizeof(ShmRingHeader) + (size_t)header->capacity * header->num_channels * sizeof(float)
+            > map_size) {
+        log_printf("Error: Shared memory %s has an incompatible layout\n", name);
+        munmap(base, map_size);
+        return -1;
+    }
+
+    ring->header = header;
+    ring->data = (float *)((char *)base + sizeof(ShmRingHeader));
+    ring->map_size = map_size;
+    ring->owner = 0;
+    snprintf(ring->name, sizeof(ring->name), "%s", name);
+    return 0;
+}
+
+// ============ 销毁 ============
+void shm_ring_destroy(ShmRing *ring) {
+    if (ring->header) {
+        munmap(ring->header, ring->map_size);
+        if (ring->owner) shm_unlink(ring->name);
+    }
+    memset(ring, 0, sizeof(ShmRing));
+}
+
+#endif
+
+// ============ 读写（仅使用原子操作，与平台无关） ============
+// 环形区内第pos帧起的num_frames帧可能跨越末尾，分两段拷贝
+static void copy_frames(const ShmRing *ring, uint64_t pos, float *dst, const float *src,
+                        int num_frames) {
+    const uint32_t channels = ring->header->num_channels;
+    const uint32_t capacity = ring->header->capacity;
+    uint32_t start = (uint32_t)(pos & (capacity - 1));
+    uint32_t first = capacity - start;
+    if (first > (uint32_t)num_frames) first = (uint32_t)num_frames;
+    uint32_t second = (uint32_t)num_frames - first;
+
+    if (dst) {
+        // 读：环形区 -> dst
+        memcpy(dst, ring->data + (size_t)start * channels, (size_t)first * channels * sizeof(float));
+        memcpy(dst + (size_t)first * channels, ring->data, (size_t)second * channels * sizeof(float));
+    } else {
+        // 写：src -> 环形区
+        memcpy(ring->data + (size_t)start * channels, src, (size_t)first * channels * sizeof(float));
+        memcpy(ring->data, src + (size_t)first * channels, (size_t)second * channels * sizeof(float));
+    }
+}
+
+int shm_ring_write(ShmRing *ring, const float *frames, int num_frames) {
+    ShmRingHeader *header = ring->header;
+    uint64_t write_pos = atomic_load_explicit(&header->write_pos, memory_order_relaxed);
+    uint64_t read_pos = atomic_load_explicit(&header->read_pos, memory_order_acquire);
+    if (num_frames <= 0) return 0;
+    if (write_pos - read_pos + (uint64_t)num_frames > header->capacity) {
+        // 采集端不能等待：消费者跟不上时整块丢弃并计数
+        atomic_fetch_add_explicit(&header->dropped, (uint64_t)num_frames, memory_order_relaxed);
+        return 0;
+    }
+    copy_frames(ring, write_pos, NULL, frames, num_frames);
+    atomic_store_explicit(&header->write_pos, write_pos + (uint64_t)num_frames,
+                          memory_order_release);
+    return num_frames;
+}
+
+int shm_ring_read(ShmRing *ring, float *frames, int num_frames) {
+    ShmRingHeader *header = ring->header;
+    uint64_t read_pos = atomic_load_explicit(&header->read_pos, memory_order_relaxed);
+    uint64_t write_pos = atomic_load_explicit(&header->write_pos, memory_order_acquire);
+    if (num_frames <= 0 || write_pos - read_pos < (uint64_t)num_frames) {
+        return 0;
+    }
+    copy_frames(ring, read_pos, frames, NULL, num_frames);
+    atomic_store_explicit(&header->read_pos, read_pos + (uint64_t)num_frames,
+                          memory_order_release);
+    return num_frames;
+}
+
+int shm_ring_available(const ShmRing *ring) {
+    ShmRingHeader *header = ring->header;
+    uint64_t write_pos = atomic_load_explicit(&header->write_pos, memory_order_acquire);
+    uint64_t read_pos = atomic_load_explicit(&header->read_pos, memory_order_relaxed);
+    return (int)(write_pos - read_pos);
+}
+
+void shm_ring_close_writer(ShmRing *ring) {
+    atomic_store_explicit(&ring->header->closed, 1, memory_order_release);
+}
+
+int shm_ring_is_closed(const ShmRing *ring) {
+    return (int)atomic_load_explicit(&ring->header->closed, memory_order_acquire);
+}
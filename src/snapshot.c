@@ -0,0 +1,241 @@
+#include "../inc/snapshot.h"
+#include "../inc/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 原始输入信号哈希（恢复时确认快照与当前输入对应）
+static uint64_t hash_input(const TimeDomainSimulator *sim) {
+    uint64_t hash = ANC_FNV_OFFSET_BASIS;
+    hash = anc_fnv1a(hash, &sim->total_samples, sizeof(sim->total_samples));
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        hash = anc_fnv1a(hash, sim->original_ff[r], (size_t)sim->total_samples * sizeof(float));
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        hash = anc_fnv1a(hash, sim->original_fb[e], (size_t)sim->total_samples * sizeof(float));
+    }
+    return hash;
+}
+
+static uint64_t align_up(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) & ~(uint64_t)(SNAPSHOT_ALIGN - 1);
+}
+
+// 写入补零直到指定偏移
+static int pad_to(FILE *file, uint64_t offset) {
+    static const uint8_t zeros[SNAPSHOT_ALIGN] = {0};
+    long pos = ftell(file);
+    if (pos < 0 || (uint64_t)pos > offset) return -1;
+    size_t gap = (size_t)(offset - (uint64_t)pos);
+    return fwrite(zeros, 1, gap, file) == gap ? 0 : -1;
+}
+
+// ============ 保存快照 ============
+int snapshot_save(const char *filename, const SystemState *state,
+                  const TimeDomainSimulator *sim, const SnapshotCounters *counters) {
+    SnapshotSimState *sim_state = (SnapshotSimState *)calloc(1, sizeof(SnapshotSimState));
+    if (!sim_state) {
+        log_printf("Error: Failed to allocate snapshot buffer\n");
+        return -1;
+    }
+    sim_state->total_samples = sim->total_samples;
+    sim_state->current_sample = sim->current_sample;
+    sim_state->num_ref = ANC_NUM_REF;
+    sim_state->num_err = ANC_NUM_ERR;
+    memcpy(sim_state->biquad_states, sim->biquad_states, sizeof(sim_state->biquad_states));
+    sim_state->fir_length = sim->secondary_path_fir[0][0].length;
+    sim_state->fir_delay = sim->secondary_path_fir[0][0].delay;
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            sim_state->fir_write_index[e][r] = sim->secondary_path_fir[e][r].write_index;
+            memcpy(sim_state->fir_buffer[e][r], sim->secondary_path_fir[e][r].buffer,
+                   sizeof(sim_state->fir_buffer[e][r]));
+        }
+    }
+
+    // 段数据和布局（SIM_OUTPUT段由各误差麦依次写入）
+    const void *data[SNAPSHOT_NUM_SECTIONS] = {
+        counters, state, sim_state, NULL
+    };
+    SnapshotSection sections[SNAPSHOT_NUM_SECTIONS] = {
+        {SNAPSHOT_SECTION_COUNTERS, 0, 0, sizeof(SnapshotCounters)},
+        {SNAPSHOT_SECTION_SYSTEM_STATE, 0, 0, sizeof(SystemState)},
+        {SNAPSHOT_SECTION_SIM_STATE, 0, 0, sizeof(SnapshotSimState)},
+        {SNAPSHOT_SECTION_SIM_OUTPUT, 0, 0,
+         (uint64_t)ANC_NUM_ERR * sim->total_samples * sizeof(float)}
+    };
+
+    uint64_t offset = sizeof(SnapshotHeader) + sizeof(sections);
+    for (int i = 0; i < SNAPSHOT_NUM_SECTIONS; i++) {
+        offset = align_up(offset);
+        sections[i].offset = offset;
+        offset += sections[i].size;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.header_size = sizeof(SnapshotHeader);
+    header.num_sections = SNAPSHOT_NUM_SECTIONS;
+    header.file_size = offset;
+    header.input_hash = hash_input(sim);
+
+    FILE *file = fopen(filename, "wb");
+    if (!file) {
+        log_printf("Error: Cannot create snapshot file: %s\n", filename);
+        free(sim_state);
+        return -1;
+    }
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(sections, sizeof(sections), 1, file) == 1;
+    for (int i = 0; ok && i < SNAPSHOT_NUM_SECTIONS; i++) {
+        ok = pad_to(file, sections[i].offset) == 0;
+        if (!ok) break;
+        if (data[i]) {
+            ok = fwrite(data[i], 1, (size_t)sections[i].size, file) == sections[i].size;
+        } else {
+            for (int e = 0; ok && e < ANC_NUM_ERR; e++) {
+                ok = fwrite(sim->simulated_fb[e], sizeof(float), (size_t)sim->total_samples, file)
+                     == (size_t)sim->total_samples;
+            }
+        }
+    }
+
+    fclose(file);
+    free(sim_state);
+
+    if (!ok) {
+        log_printf("Error: Failed to write snapshot: %s\n", filename);
+        return -1;
+    }
+
+    log_printf("Snapshot saved: %s (iteration %d, sample %d, %.1f KB)\n",
+               filename, counters->iteration, sim->current_sample, header.file_size / 1024.0f);
+    return 0;
+}
+
+// 读取指定段（校验长度）；out为NULL时只定位到段起始
+static int read_section(FILE *file, const SnapshotSection *sections, uint32_t num_sections,
+                        uint32_t id, void *out, uint64_t expected_size) {
+    for (uint32_t i = 0; i < num_sections; i++) {
+        if (sections[i].id != id) continue;
+        if (sections[i].size != expected_size) {
+            log_printf("Error: Snapshot section %u size %llu, expected %llu (layout mismatch)\n",
+                       id, (unsigned long long)sections[i].size,
+                       (unsigned long long)expected_size);
+            return -1;
+        }
+        if (fseek(file, (long)sections[i].offset, SEEK_SET) != 0 ||
+            (out && fread(out, 1, (size_t)expected_size, file) != expected_size)) {
+            log_printf("Error: Failed to read snapshot section %u\n", id);
+            return -1;
+        }
+        return 0;
+    }
+    log_printf("Error: Snapshot section %u missing\n", id);
+    return -1;
+}
+
+// 从当前位置依次读取各误差麦的simulated_fb
+static int read_sim_output(FILE *file, TimeDomainSimulator *sim) {
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        if (fread(sim->simulated_fb[e], sizeof(float), (size_t)sim->total_samples, file)
+            != (size_t)sim->total_samples) {
+            log_printf("Error: Failed to read snapshot section %u\n", SNAPSHOT_SECTION_SIM_OUTPUT);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ============ 加载快照 ============
+int snapshot_load(const char *filename, SystemState *state,
+                  TimeDomainSimulator *sim, SnapshotCounters *counters) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        log_printf("Error: Cannot open snapshot file: %s\n", filename);
+        return -1;
+    }
+
+    SnapshotHeader header;
+    SnapshotSection sections[SNAPSHOT_NUM_SECTIONS];
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        log_printf("Error: Not a valid snapshot file: %s\n", filename);
+        fclose(file);
+        return -1;
+    }
+    if (header.version != SNAPSHOT_VERSION || header.header_size != sizeof(SnapshotHeader) ||
+        header.num_sections > SNAPSHOT_NUM_SECTIONS) {
+        log_printf("Error: Unsupported snapshot version %u (expected %d)\n",
+                   header.version, SNAPSHOT_VERSION);
+        fclose(file);
+        return -1;
+    }
+    if (fread(sections, sizeof(SnapshotSection), header.num_sections, file) != header.num_sections) {
+        log_printf("Error: Failed to read snapshot section table\n");
+        fclose(file);
+        return -1;
+    }
+
+    // 校验输入一致
+    if (header.input_hash != hash_input(sim)) {
+        log_printf("Error: Snapshot was taken from a different input signal\n");
+        fclose(file);
+        return -1;
+    }
+
+    // 先读入临时缓冲，全部校验通过后再覆盖引擎状态
+    SystemState *state_tmp = (SystemState *)malloc(sizeof(SystemState));
+    SnapshotSimState *sim_tmp = (SnapshotSimState *)malloc(sizeof(SnapshotSimState));
+    SnapshotCounters counters_tmp;
+    int result = -1;
+
+    if (state_tmp && sim_tmp &&
+        read_section(file, sections, header.num_sections, SNAPSHOT_SECTION_COUNTERS,
+                     &counters_tmp, sizeof(SnapshotCounters)) == 0 &&
+        read_section(file, sections, header.num_sections, SNAPSHOT_SECTION_SYSTEM_STATE,
+                     state_tmp, sizeof(SystemState)) == 0 &&
+        read_section(file, sections, header.num_sections, SNAPSHOT_SECTION_SIM_STATE,
+                     sim_tmp, sizeof(SnapshotSimState)) == 0) {
+
+        if (sim_tmp->total_samples != sim->total_samples ||
+            sim_tmp->num_ref != ANC_NUM_REF || sim_tmp->num_err != ANC_NUM_ERR ||
+            sim_tmp->fir_length != sim->secondary_path_fir[0][0].length ||
+            sim_tmp->fir_delay != sim->secondary_path_fir[0][0].delay) {
+            log_printf("Error: Snapshot simulator layout mismatch "
+                       "(samples %d/%d, channels %dx%d/%dx%d, FIR %d+%d/%d+%d)\n",
+                       sim_tmp->total_samples, sim->total_samples,
+                       sim_tmp->num_ref, sim_tmp->num_err, ANC_NUM_REF, ANC_NUM_ERR,
+                       sim_tmp->fir_delay, sim_tmp->fir_length,
+                       sim->secondary_path_fir[0][0].delay, sim->secondary_path_fir[0][0].length);
+        } else if (read_section(file, sections, header.num_sections, SNAPSHOT_SECTION_SIM_OUTPUT,
+                                NULL, (uint64_t)ANC_NUM_ERR * sim->total_samples * sizeof(float)) == 0 &&
+                   read_sim_output(file, sim) == 0) {
+            memcpy(state, state_tmp, sizeof(SystemState));
+            *counters = counters_tmp;
+            sim->current_sample = sim_tmp->current_sample;
+            memcpy(sim->biquad_states, sim_tmp->biquad_states, sizeof(sim->biquad_states));
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                for (int r = 0; r < ANC_NUM_REF; r++) {
+                    sim->secondary_path_fir[e][r].write_index = sim_tmp->fir_write_index[e][r];
+                    memcpy(sim->secondary_path_fir[e][r].buffer, sim_tmp->fir_buffer[e][r],
+                           sizeof(sim->secondary_path_fir[e][r].buffer));
+                }
+            }
+            result = 0;
+        }
+    }
+
+    free(state_tmp);
+    free(sim_tmp);
+    fclose(file);
+
+    if (result == 0) {
+        log_printf("Snapshot loaded: %s (iteration %d, sample %d)\n",
+                   filename, counters->iteration, sim->current_sample);
+    }
+    return result;
+}
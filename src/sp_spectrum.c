@@ -0,0 +1,127 @@
+#include "../inc/sp_spectrum.h"
+#include "../inc/coeffs.h"
+#include "../inc/spectrum.h"
+#include "../inc/logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SP_CACHE_MAGIC      "ANCSPEC"
+#define SP_CACHE_VERSION    1
+
+// 缓存文件头，其后依次为response.re、response.im、power（各SPECTRUM_LENGTH个float）
+typedef struct {
+    char magic[8];              // "ANCSPEC\0"
+    uint32_t version;           // SP_CACHE_VERSION
+    uint32_t spectrum_length;   // SPECTRUM_LENGTH
+    uint64_t key;               // 缓存键（文件名已含键，这里再校验一次）
+} SpCacheHeader;
+
+// ============ 缓存键 ============
+uint64_t sp_spectrum_key(const float *ir, int length, int sample_rate, const AnalysisBins *bins) {
+    int32_t dims[4] = {length, sample_rate, DSP_SAMPLE_RATE, FFT_LENGTH};
+    uint64_t hash = anc_fnv1a(ANC_FNV_OFFSET_BASIS, dims, sizeof(dims));
+    hash = anc_fnv1a(hash, &bins->num_bins, sizeof(bins->num_bins));
+    hash = anc_fnv1a(hash, bins->freq, (size_t)bins->num_bins * sizeof(float));
+    return anc_fnv1a(hash, ir, (size_t)length * sizeof(float));
+}
+
+// ============ 由冲击响应计算频响 ============
+void sp_spectrum_compute(const float *ir, int length, int sample_rate, const AnalysisBins *bins,
+                         SpSpectrum *sp) {
+    memset(sp, 0, sizeof(SpSpectrum));
+    sp->key = sp_spectrum_key(ir, length, sample_rate, bins);
+    
+    for (int k = 0; k < bins->num_bins; k++) {
+        // S(f) = Σ h[n] e^(-j2πfn/fs)，旋转因子用双精度递推
+        double w = -2.0 * M_PI * bins->freq[k] / sample_rate;
+        double step_re = cos(w), step_im = sin(w);
+        double rot_re = 1.0, rot_im = 0.0;
+        double acc_re = 0.0, acc_im = 0.0;
+        
+        for (int n = 0; n < length; n++) {
+            acc_re += ir[n] * rot_re;
+            acc_im += ir[n] * rot_im;
+            double next_re = rot_re * step_re - rot_im * step_im;
+            rot_im = rot_re * step_im + rot_im * step_re;
+            rot_re = next_re;
+        }
+        sp->response.re[k] = (float)acc_re;
+        sp->response.im[k] = (float)acc_im;
+    }
+    
+    spectrum_power(sp->power, &sp->response);
+}
+
+// 缓存文件路径
+static void cache_path(char *path, size_t size, uint64_t key) {
+    snprintf(path, size, SP_SPECTRUM_CACHE_FORMAT, (unsigned long long)key);
+}
+
+static int read_cache(const char *path, uint64_t key, SpSpectrum *sp) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    
+    SpCacheHeader header;
+    int ok = fread(&header, sizeof(header), 1, file) == 1 &&
+             memcmp(header.magic, SP_CACHE_MAGIC, sizeof(header.magic)) == 0 &&
+             header.version == SP_CACHE_VERSION &&
+             header.spectrum_length == SPECTRUM_LENGTH &&
+             header.key == key &&
+             fread(sp->response.re, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH &&
+             fread(sp->response.im, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH &&
+             fread(sp->power, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH;
+    fclose(file);
+    
+    if (!ok) {
+        log_printf("Warning: Ignoring invalid secondary path cache: %s\n", path);
+        return -1;
+    }
+    sp->key = key;
+    return 0;
+}
+
+static void write_cache(const char *path, const SpSpectrum *sp) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        log_printf("Warning: Cannot write secondary path cache: %s\n", path);
+        return;
+    }
+    
+    SpCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SP_CACHE_MAGIC, sizeof(header.magic));
+    header.version = SP_CACHE_VERSION;
+    header.spectrum_length = SPECTRUM_LENGTH;
+    header.key = sp->key;
+    
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(sp->response.re, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH &&
+             fwrite(sp->response.im, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH &&
+             fwrite(sp->power, sizeof(float), SPECTRUM_LENGTH, file) == SPECTRUM_LENGTH;
+    if (fclose(file) != 0 || !ok) {
+        log_printf("Warning: Failed to write secondary path cache: %s\n", path);
+        remove(path);
+    }
+}
+
+// ============ 加载（缓存优先） ============
+int sp_spectrum_load(const float *ir, int length, int sample_rate, const AnalysisBins *bins,
+                     SpSpectrum *sp) {
+    uint64_t key = sp_spectrum_key(ir, length, sample_rate, bins);
+    char path[256];
+    cache_path(path, sizeof(path), key);
+    
+    if (read_cache(path, key, sp) == 0) {
+        log_printf("Secondary path spectrum loaded from cache: %s\n", path);
+        return 1;
+    }
+    
+    sp_spectrum_compute(ir, length, sample_rate, bins, sp);
+    write_cache(path, sp);
+    log_printf("Secondary path spectrum computed from %d-tap IR (%d Hz -> %d bins @ %.2f Hz), cached: %s\n",
+               length, sample_rate, bins->num_bins, bins->bin_spacing, path);
+    return 0;
+}
@@ -0,0 +1,257 @@
+#include "../inc/spectrum.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SPECTRUM_USE_SSE 1
+#else
+#define SPECTRUM_USE_SSE 0
+#endif
+
+// complex_div的分母门限
+#define SPECTRUM_DIV_MIN_DENOM  1e-10f
+
+#if SPECTRUM_USE_SSE
+// 4路水平求和
+static inline float hsum_ps(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+// 带门限的复数除法 num / den，|den|² <= 门限的通道结果为0
+static inline void div_ps(__m128 nr, __m128 ni, __m128 dr, __m128 di,
+                          __m128 *out_r, __m128 *out_i) {
+    const __m128 min_denom = _mm_set1_ps(SPECTRUM_DIV_MIN_DENOM);
+    __m128 denom = _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di));
+    __m128 valid = _mm_cmpgt_ps(denom, min_denom);
+    __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(denom, min_denom));
+    __m128 r = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(nr, dr), _mm_mul_ps(ni, di)), inv);
+    __m128 i = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(ni, dr), _mm_mul_ps(nr, di)), inv);
+    *out_r = _mm_and_ps(r, valid);
+    *out_i = _mm_and_ps(i, valid);
+}
+#endif
+
+// ============ 清零 ============
+void spectrum_clear(FreqResponse *x) {
+    memset(x, 0, sizeof(FreqResponse));
+}
+
+// ============ 累加 ============
+void spectrum_accumulate(FreqResponse *acc, const FreqResponse *x) {
+#if SPECTRUM_USE_SSE
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        _mm_store_ps(&acc->re[k], _mm_add_ps(_mm_load_ps(&acc->re[k]), _mm_load_ps(&x->re[k])));
+        _mm_store_ps(&acc->im[k], _mm_add_ps(_mm_load_ps(&acc->im[k]), _mm_load_ps(&x->im[k])));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        acc->re[k] += x->re[k];
+        acc->im[k] += x->im[k];
+    }
+#endif
+}
+
+// ============ 缩放 ============
+void spectrum_scale(FreqResponse *dst, const FreqResponse *src, float scale) {
+#if SPECTRUM_USE_SSE
+    __m128 s = _mm_set1_ps(scale);
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        _mm_store_ps(&dst->re[k], _mm_mul_ps(_mm_load_ps(&src->re[k]), s));
+        _mm_store_ps(&dst->im[k], _mm_mul_ps(_mm_load_ps(&src->im[k]), s));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        dst->re[k] = src->re[k] * scale;
+        dst->im[k] = src->im[k] * scale;
+    }
+#endif
+}
+
+// ============ 除法累加 ============
+void spectrum_div_accumulate(FreqResponse *acc, const FreqResponse *num, const FreqResponse *den) {
+#if SPECTRUM_USE_SSE
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        __m128 qr, qi;
+        div_ps(_mm_load_ps(&num->re[k]), _mm_load_ps(&num->im[k]),
+               _mm_load_ps(&den->re[k]), _mm_load_ps(&den->im[k]), &qr, &qi);
+        _mm_store_ps(&acc->re[k], _mm_add_ps(_mm_load_ps(&acc->re[k]), qr));
+        _mm_store_ps(&acc->im[k], _mm_add_ps(_mm_load_ps(&acc->im[k]), qi));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        Complex q = complex_div(spectrum_get(num, k), spectrum_get(den, k));
+        acc->re[k] += q.real;
+        acc->im[k] += q.imag;
+    }
+#endif
+}
+
+// ============ 复数乘累加（区间） ============
+void spectrum_mul_accumulate(FreqResponse *acc, const FreqResponse *a, const FreqResponse *b,
+                             int count) {
+    int k = 0;
+#if SPECTRUM_USE_SSE
+    for (; k < count; k += 4) {
+        __m128 ar = _mm_load_ps(&a->re[k]), ai = _mm_load_ps(&a->im[k]);
+        __m128 br = _mm_load_ps(&b->re[k]), bi = _mm_load_ps(&b->im[k]);
+        __m128 pr = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        __m128 pi = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_store_ps(&acc->re[k], _mm_add_ps(_mm_load_ps(&acc->re[k]), pr));
+        _mm_store_ps(&acc->im[k], _mm_add_ps(_mm_load_ps(&acc->im[k]), pi));
+    }
+#else
+    for (; k < count; k++) {
+        acc->re[k] += a->re[k] * b->re[k] - a->im[k] * b->im[k];
+        acc->im[k] += a->re[k] * b->im[k] + a->im[k] * b->re[k];
+    }
+#endif
+}
+
+// ============ 加权共轭乘累加（区间） ============
+void spectrum_conj_mul_accumulate(FreqResponse *acc, const FreqResponse *a, const FreqResponse *b,
+                                  const float *weight, int count) {
+    int k = 0;
+#if SPECTRUM_USE_SSE
+    for (; k < count; k += 4) {
+        __m128 ar = _mm_load_ps(&a->re[k]), ai = _mm_load_ps(&a->im[k]);
+        __m128 br = _mm_load_ps(&b->re[k]), bi = _mm_load_ps(&b->im[k]);
+        __m128 w = _mm_load_ps(&weight[k]);
+        __m128 pr = _mm_add_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        __m128 pi = _mm_sub_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        _mm_store_ps(&acc->re[k], _mm_add_ps(_mm_load_ps(&acc->re[k]), _mm_mul_ps(w, pr)));
+        _mm_store_ps(&acc->im[k], _mm_add_ps(_mm_load_ps(&acc->im[k]), _mm_mul_ps(w, pi)));
+    }
+#else
+    for (; k < count; k++) {
+        acc->re[k] += weight[k] * (a->re[k] * b->re[k] + a->im[k] * b->im[k]);
+        acc->im[k] += weight[k] * (a->re[k] * b->im[k] - a->im[k] * b->re[k]);
+    }
+#endif
+}
+
+// ============ 功率谱 ============
+void spectrum_power(float *power, const FreqResponse *x) {
+#if SPECTRUM_USE_SSE
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        __m128 r = _mm_load_ps(&x->re[k]);
+        __m128 i = _mm_load_ps(&x->im[k]);
+        _mm_store_ps(&power[k], _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(i, i)));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        power[k] = x->re[k] * x->re[k] + x->im[k] * x->im[k];
+    }
+#endif
+}
+
+// ============ 幅度谱（区间） ============
+void spectrum_magnitude(float *mag, const FreqResponse *x, int start, int count) {
+    int i = 0;
+#if SPECTRUM_USE_SSE
+    // 区间起点任意，使用非对齐访问
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_loadu_ps(&x->re[start + i]);
+        __m128 im = _mm_loadu_ps(&x->im[start + i]);
+        _mm_storeu_ps(&mag[i], _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(im, im))));
+    }
+#endif
+    for (; i < count; i++) {
+        mag[i] = complex_mag(spectrum_get(x, start + i));
+    }
+}
+
+// ============ 步长计算 ============
+void spectrum_calc_mu(float *mu, const FreqResponse *ff, const float *sp_power,
+                      float mu_min, float mu_max, float regularization) {
+#if SPECTRUM_USE_SSE
+    __m128 vmin = _mm_set1_ps(mu_min);
+    __m128 vmax = _mm_set1_ps(mu_max);
+    __m128 vreg = _mm_set1_ps(regularization);
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        __m128 r = _mm_load_ps(&ff->re[k]);
+        __m128 i = _mm_load_ps(&ff->im[k]);
+        __m128 ff_power = _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(i, i));
+        __m128 denom = _mm_add_ps(_mm_mul_ps(_mm_load_ps(&sp_power[k]), ff_power), vreg);
+        __m128 m = _mm_div_ps(vmax, denom);
+        _mm_store_ps(&mu[k], _mm_min_ps(_mm_max_ps(m, vmin), vmax));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        float ff_power = ff->re[k] * ff->re[k] + ff->im[k] * ff->im[k];
+        float m = mu_max / (sp_power[k] * ff_power + regularization);
+        if (m < mu_min) m = mu_min;
+        if (m > mu_max) m = mu_max;
+        mu[k] = m;
+    }
+#endif
+}
+
+// ============ 目标频响 ============
+void spectrum_calc_target(FreqResponse *target, const FreqResponse *current,
+                          const FreqResponse *pp, const FreqResponse *sp, const float *mu) {
+#if SPECTRUM_USE_SSE
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        __m128 qr, qi;
+        div_ps(_mm_load_ps(&pp->re[k]), _mm_load_ps(&pp->im[k]),
+               _mm_load_ps(&sp->re[k]), _mm_load_ps(&sp->im[k]), &qr, &qi);
+        __m128 m = _mm_load_ps(&mu[k]);
+        _mm_store_ps(&target->re[k], _mm_add_ps(_mm_load_ps(&current->re[k]), _mm_mul_ps(qr, m)));
+        _mm_store_ps(&target->im[k], _mm_add_ps(_mm_load_ps(&current->im[k]), _mm_mul_ps(qi, m)));
+    }
+#else
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        Complex q = complex_div(spectrum_get(pp, k), spectrum_get(sp, k));
+        target->re[k] = current->re[k] + mu[k] * q.real;
+        target->im[k] = current->im[k] + mu[k] * q.imag;
+    }
+#endif
+}
+
+// ============ 全频点误差能量 ============
+float spectrum_loss(const FreqResponse *a, const FreqResponse *b) {
+#if SPECTRUM_USE_SSE
+    __m128 acc = _mm_setzero_ps();
+    for (int k = 0; k < SPECTRUM_LENGTH; k += 4) {
+        __m128 dr = _mm_sub_ps(_mm_load_ps(&a->re[k]), _mm_load_ps(&b->re[k]));
+        __m128 di = _mm_sub_ps(_mm_load_ps(&a->im[k]), _mm_load_ps(&b->im[k]));
+        acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di)));
+    }
+    return hsum_ps(acc);
+#else
+    float loss = 0.0f;
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        float dr = a->re[k] - b->re[k];
+        float di = a->im[k] - b->im[k];
+        loss += dr * dr + di * di;
+    }
+    return loss;
+#endif
+}
+
+// ============ 加权误差能量 ============
+float spectrum_weighted_loss(const float *a_re, const float *a_im,
+                             const float *b_re, const float *b_im,
+                             const float *weights, int length) {
+#if SPECTRUM_USE_SSE
+    __m128 acc = _mm_setzero_ps();
+    for (int k = 0; k < length; k += 4) {
+        __m128 dr = _mm_sub_ps(_mm_load_ps(&a_re[k]), _mm_load_ps(&b_re[k]));
+        __m128 di = _mm_sub_ps(_mm_load_ps(&a_im[k]), _mm_load_ps(&b_im[k]));
+        __m128 e = _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(di, di));
+        acc = _mm_add_ps(acc, _mm_mul_ps(e, _mm_load_ps(&weights[k])));
+    }
+    return hsum_ps(acc);
+#else
+    float loss = 0.0f;
+    for (int k = 0; k < length; k++) {
+        float dr = a_re[k] - b_re[k];
+        float di = a_im[k] - b_im[k];
+        loss += weights[k] * (dr * dr + di * di);
+    }
+    return loss;
+#endif
+}
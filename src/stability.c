@@ -0,0 +1,284 @@
+#include "../inc/stability.h"
+#include "../inc/logger.h"
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define STABILITY_USE_SSE 1
+#else
+#define STABILITY_USE_SSE 0
+#endif
+
+#define STABILITY_CHUNK         16             // 融合遍历的块长（频点）
+#define STABILITY_EPS_POWER     1e-16f         // 对应原20*log10(|H| + 1e-8)中的1e-8
+#define STABILITY_DB_PER_LOG2   3.0102999566f  // 10*log10(2)，功率dB = 该值 * log2(P)
+#define STABILITY_EPS           1e-8f
+
+// log2(m), m∈[1,2) 的4阶多项式近似（t = m - 1），最大误差约0.0006 dB
+#define LOG2_C1  1.43854537f
+#define LOG2_C2 -0.67807154f
+#define LOG2_C3  0.32361048f
+#define LOG2_C4 -0.08427316f
+
+// ============ 指标描述表 ============
+// accumulate: 累积频段内[start, end)的数据（可访问整个curr_db/prev_db，便于跨块差分）
+// early_fail: 遍历中途能否确定失败（单调指标），NULL表示只能在遍历结束后判定
+// judge:      遍历结束后判定并输出日志，1=通过
+typedef struct {
+    const char *name;
+    int cost;  // 相对代价，判定按升序进行
+    void (*accumulate)(const StabilityChecker *chk, StabilityMetricAcc *acc, int start, int end);
+    int (*early_fail)(const StabilityChecker *chk, const StabilityMetricAcc *acc);
+    int (*judge)(const StabilityChecker *chk, const StabilityMetricAcc *acc);
+} StabilityMetric;
+
+// ---------- 绝对幅度界限 ----------
+static void bounds_accumulate(const StabilityChecker *chk, StabilityMetricAcc *acc, int start, int end) {
+    for (int i = start; i < end; i++) {
+        float db = chk->curr_db[i];
+        if (db < acc->min_val) acc->min_val = db;
+        if (db > acc->max_val) acc->max_val = db;
+    }
+}
+
+static int bounds_early_fail(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    return acc->min_val < chk->thr.response_low_db || acc->max_val > chk->thr.response_high_db;
+}
+
+static int bounds_judge(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    log_printf("  Response range: [%.2f, %.2f] dB\n", acc->min_val, acc->max_val);
+    log_printf("  Allowed range: [%.2f, %.2f] dB\n", chk->thr.response_low_db, chk->thr.response_high_db);
+    if (bounds_early_fail(chk, acc)) {
+        log_printf("  Result: FAIL (out of bounds)\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ---------- 局部尖峰 ----------
+static void spikes_accumulate(const StabilityChecker *chk, StabilityMetricAcc *acc, int start, int end) {
+    int count = 0;
+    for (int i = start; i < end; i++) {
+        count += fabsf(chk->curr_db[i] - chk->prev_db[i]) > chk->thr.spike_delta_db;
+    }
+    acc->count += count;
+}
+
+static int spikes_early_fail(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    return (float)acc->count / chk->band_len > chk->thr.spike_ratio_thr;
+}
+
+static int spikes_judge(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    float spike_ratio = (float)acc->count / chk->band_len;
+    log_printf("  Points with >%.1f dB change: %d/%d (%.1f%%)\n",
+               chk->thr.spike_delta_db, acc->count, chk->band_len, spike_ratio * 100.0f);
+    log_printf("  Threshold: %.1f%%\n", chk->thr.spike_ratio_thr * 100.0f);
+    if (spike_ratio > chk->thr.spike_ratio_thr) {
+        log_printf("  Result: FAIL (too many spikes)\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ---------- 整体偏移 ----------
+static void shift_accumulate(const StabilityChecker *chk, StabilityMetricAcc *acc, int start, int end) {
+    float sum = 0.0f;
+    for (int i = start; i < end; i++) {
+        sum += chk->curr_db[i] - chk->prev_db[i];
+    }
+    acc->sum += sum;
+}
+
+static int shift_judge(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    float mean_delta = acc->sum / chk->band_len;
+    log_printf("  Mean shift: %.2f dB\n", mean_delta);
+    log_printf("  Threshold: %.2f dB\n", chk->thr.mean_shift_thr_db);
+    if (fabsf(mean_delta) > chk->thr.mean_shift_thr_db) {
+        log_printf("  Result: FAIL (too much shift)\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ---------- 平滑度 ----------
+// 二阶差分 d²H ≈ H[i] - 2*H[i-1] + H[i-2]，i从2开始，跨块时读取前一块的数据
+static void smooth_accumulate(const StabilityChecker *chk, StabilityMetricAcc *acc, int start, int end) {
+    float sum = 0.0f;
+    int i = (start < 2) ? 2 : start;
+    for (; i < end; i++) {
+        float d2 = chk->curr_db[i] - 2.0f * chk->curr_db[i - 1] + chk->curr_db[i - 2];
+        sum += d2 * d2;
+    }
+    acc->sum += sum;
+}
+
+static float smooth_threshold(const StabilityChecker *chk) {
+    return chk->thr.smooth_alpha * chk->prev_smoothness;
+}
+
+static int smooth_early_fail(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    // 二阶差分平方和单调递增，除以最终项数即为下界
+    return chk->prev_smoothness > STABILITY_EPS &&
+           acc->sum / (chk->band_len - 2) > smooth_threshold(chk);
+}
+
+static int smooth_judge(const StabilityChecker *chk, const StabilityMetricAcc *acc) {
+    float smooth_curr = acc->sum / (chk->band_len - 2);
+    log_printf("  Current smoothness: %.4f\n", smooth_curr);
+    log_printf("  Previous smoothness: %.4f\n", chk->prev_smoothness);
+    log_printf("  Threshold (%.1fx prev): %.4f\n", chk->thr.smooth_alpha, smooth_threshold(chk));
+    if (smooth_curr > smooth_threshold(chk) && chk->prev_smoothness > STABILITY_EPS) {
+        log_printf("  Result: FAIL (too rough)\n");
+        return 0;
+    }
+    return 1;
+}
+
+// 指标表（下标与StabilityMetricId一致）
+static const StabilityMetric g_metrics[STABILITY_NUM_METRICS] = {
+    [STABILITY_METRIC_BOUNDS]     = {"Absolute Bounds", 1, bounds_accumulate, bounds_early_fail, bounds_judge},
+    [STABILITY_METRIC_SPIKES]     = {"Local Spikes",    2, spikes_accumulate, spikes_early_fail, spikes_judge},
+    [STABILITY_METRIC_SHIFT]      = {"Global Shift",    2, shift_accumulate,  NULL,              shift_judge},
+    [STABILITY_METRIC_SMOOTHNESS] = {"Smoothness",      3, smooth_accumulate, smooth_early_fail, smooth_judge},
+};
+
+// ============ 快速功率dB ============
+static inline float fast_power_db(float power) {
+    union { float f; uint32_t i; } u = {power + STABILITY_EPS_POWER};
+    float e = (float)((int)(u.i >> 23) - 127);
+    u.i = (u.i & 0x007FFFFFu) | 0x3F800000u;
+    float t = u.f - 1.0f;
+    float log2_m = t * (LOG2_C1 + t * (LOG2_C2 + t * (LOG2_C3 + t * LOG2_C4)));
+    return STABILITY_DB_PER_LOG2 * (e + log2_m);
+}
+
+// 频段内[start, end)的目标频响转换为dB: 10*log10(|H|² + eps²)
+static void convert_db(StabilityChecker *chk, const FreqResponse *target, int start, int end) {
+    const float *re = &target->re[chk->bin_low];
+    const float *im = &target->im[chk->bin_low];
+    int i = start;
+#if STABILITY_USE_SSE
+    const __m128 eps = _mm_set1_ps(STABILITY_EPS_POWER);
+    const __m128i mant_mask = _mm_set1_epi32(0x007FFFFF);
+    const __m128i one_bits = _mm_set1_epi32(0x3F800000);
+    const __m128i bias = _mm_set1_epi32(127);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= end; i += 4) {
+        __m128 r = _mm_loadu_ps(&re[i]);
+        __m128 m = _mm_loadu_ps(&im[i]);
+        __m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m)), eps);
+        __m128i bits = _mm_castps_si128(p);
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), bias));
+        __m128 t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mant_mask), one_bits)), one);
+        __m128 poly = _mm_add_ps(_mm_set1_ps(LOG2_C3), _mm_mul_ps(t, _mm_set1_ps(LOG2_C4)));
+        poly = _mm_add_ps(_mm_set1_ps(LOG2_C2), _mm_mul_ps(t, poly));
+        poly = _mm_add_ps(_mm_set1_ps(LOG2_C1), _mm_mul_ps(t, poly));
+        __m128 log2_p = _mm_add_ps(e, _mm_mul_ps(t, poly));
+        _mm_storeu_ps(&chk->curr_db[i], _mm_mul_ps(log2_p, _mm_set1_ps(STABILITY_DB_PER_LOG2)));
+    }
+#endif
+    for (; i < end; i++) {
+        chk->curr_db[i] = fast_power_db(re[i] * re[i] + im[i] * im[i]);
+    }
+}
+
+// ============ 初始化 ============
+void stability_init(StabilityChecker *chk, const AnalysisBins *bins, float freq_low,
+                    float freq_high, const StabilityThresholds *thr) {
+    memset(chk, 0, sizeof(StabilityChecker));
+    chk->thr = *thr;
+    chk->prev_smoothness = 1.0f;  // 初始值设为较小的数
+
+    // 确定检测频段的频点索引范围（与分析频段取交集）
+    int bin_low, bin_high;
+    analysis_bins_range(bins, freq_low, freq_high, &bin_low, &bin_high);
+    chk->bin_low = bin_low;
+    chk->band_len = bin_high - bin_low + 1;
+
+    // 上一次目标初始为0，对应静音电平
+    float silence_db = fast_power_db(0.0f);
+    for (int i = 0; i < SPECTRUM_LENGTH; i++) {
+        chk->prev_db[i] = silence_db;
+    }
+
+    // 按代价升序排列判定顺序（插入排序，代价相同时保持表中顺序）
+    for (int m = 0; m < STABILITY_NUM_METRICS; m++) {
+        int j = m;
+        while (j > 0 && g_metrics[chk->order[j - 1]].cost > g_metrics[m].cost) {
+            chk->order[j] = chk->order[j - 1];
+            j--;
+        }
+        chk->order[j] = m;
+    }
+}
+
+// ============ 稳定性检测 ============
+int stability_check(StabilityChecker *chk, const FreqResponse *target) {
+    log_printf("\n=== Target Response Stability Check ===\n");
+
+    if (chk->band_len < 3) {
+        log_printf("Band too narrow for stability check\n");
+        return 1;  // 默认通过
+    }
+
+    for (int m = 0; m < STABILITY_NUM_METRICS; m++) {
+        chk->acc[m].sum = 0.0f;
+        chk->acc[m].count = 0;
+        chk->acc[m].min_val = INFINITY;
+        chk->acc[m].max_val = -INFINITY;
+    }
+
+    // ========== 融合遍历：dB转换 + 全部指标累积，每块后尝试提前判定 ==========
+    int failed = -1;
+    int processed = 0;
+
+    while (processed < chk->band_len && failed < 0) {
+        int end = processed + STABILITY_CHUNK;
+        if (end > chk->band_len) end = chk->band_len;
+
+        convert_db(chk, target, processed, end);
+        for (int m = 0; m < STABILITY_NUM_METRICS; m++) {
+            g_metrics[m].accumulate(chk, &chk->acc[m], processed, end);
+        }
+        processed = end;
+
+        for (int j = 0; j < STABILITY_NUM_METRICS; j++) {
+            int m = chk->order[j];
+            if (g_metrics[m].early_fail && g_metrics[m].early_fail(chk, &chk->acc[m])) {
+                failed = m;
+                break;
+            }
+        }
+    }
+
+    if (failed >= 0) {
+        log_printf("Check - %s (early exit after %d/%d bins):\n",
+                   g_metrics[failed].name, processed, chk->band_len);
+        g_metrics[failed].judge(chk, &chk->acc[failed]);
+        return 0;
+    }
+
+    // ========== 按代价顺序判定 ==========
+    for (int j = 0; j < STABILITY_NUM_METRICS; j++) {
+        int m = chk->order[j];
+        log_printf("Check %d - %s:\n", j + 1, g_metrics[m].name);
+        if (!g_metrics[m].judge(chk, &chk->acc[m])) {
+            return 0;
+        }
+        log_printf("  Result: PASS\n");
+    }
+
+    log_printf("\n=== Stability Check: PASSED ===\n");
+    return 1;
+}
+
+// ============ 采纳通过的检测 ============
+void stability_commit(StabilityChecker *chk) {
+    if (chk->band_len < 3) {
+        return;
+    }
+    chk->prev_smoothness = chk->acc[STABILITY_METRIC_SMOOTHNESS].sum / (chk->band_len - 2);
+    memcpy(chk->prev_db, chk->curr_db, chk->band_len * sizeof(float));
+}
@@ -0,0 +1,297 @@
+#include "../inc/sweep.h"
+#include "../inc/thread_pool.h"
+#include "../inc/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SWEEP_LINE_MAX 1024
+
+// ============ 解析配置文件 ============
+int sweep_load_spec(const char *filename, SweepSpec *spec) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        log_printf("Error: Cannot open sweep spec: %s\n", filename);
+        return -1;
+    }
+
+    memset(spec, 0, sizeof(SweepSpec));
+    spec->mode = SWEEP_GRID;
+    spec->num_samples = 32;
+    spec->seed = 1;
+
+    char line[SWEEP_LINE_MAX];
+    int line_no = 0;
+    int result = 0;
+
+    while (result == 0 && fgets(line, sizeof(line), file)) {
+        line_no++;
+
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char *key = strtok(line, " \t\r\n");
+        if (!key) continue;
+
+        if (strcmp(key, "mode") == 0) {
+            char *mode = strtok(NULL, " \t\r\n");
+            if (mode && strcmp(mode, "grid") == 0) {
+                spec->mode = SWEEP_GRID;
+            } else if (mode && strcmp(mode, "random") == 0) {
+                spec->mode = SWEEP_RANDOM;
+            } else {
+                log_printf("Error: %s:%d: mode must be grid or random\n", filename, line_no);
+                result = -1;
+            }
+        } else if (strcmp(key, "samples") == 0) {
+            char *value = strtok(NULL, " \t\r\n");
+            spec->num_samples = value ? atoi(value) : 0;
+        } else if (strcmp(key, "seed") == 0) {
+            char *value = strtok(NULL, " \t\r\n");
+            spec->seed = value ? (unsigned int)strtoul(value, NULL, 10) : 1;
+        } else {
+            const AncParamDesc *desc = anc_params_find(key);
+            if (!desc) {
+                log_printf("Error: %s:%d: unknown parameter %s\n", filename, line_no, key);
+                result = -1;
+                break;
+            }
+            if (spec->num_params >= SWEEP_MAX_PARAMS) {
+                log_printf("Error: %s:%d: too many parameters (max %d)\n",
+                           filename, line_no, SWEEP_MAX_PARAMS);
+                result = -1;
+                break;
+            }
+
+            int p = spec->num_params++;
+            spec->params[p] = desc;
+            char *value;
+            while ((value = strtok(NULL, " \t\r\n")) != NULL) {
+                if (spec->num_values[p] >= SWEEP_MAX_VALUES) {
+                    log_printf("Error: %s:%d: too many values (max %d)\n",
+                               filename, line_no, SWEEP_MAX_VALUES);
+                    result = -1;
+                    break;
+                }
+                spec->values[p][spec->num_values[p]++] = strtod(value, NULL);
+            }
+            if (spec->num_values[p] == 0) {
+                log_printf("Error: %s:%d: no values for %s\n", filename, line_no, key);
+                result = -1;
+            }
+            for (int v = 0; v < spec->num_values[p]; v++) {
+                if (spec->values[p][v] < desc->min_val || spec->values[p][v] > desc->max_val) {
+                    log_printf("Error: %s:%d: %s=%g out of range [%g, %g]\n", filename, line_no,
+                               key, spec->values[p][v], desc->min_val, desc->max_val);
+                    result = -1;
+                    break;
+                }
+            }
+        }
+    }
+    fclose(file);
+
+    if (result != 0) return -1;
+
+    if (spec->num_params == 0) {
+        log_printf("Error: Sweep spec %s has no parameters\n", filename);
+        return -1;
+    }
+
+    if (spec->mode == SWEEP_RANDOM) {
+        for (int p = 0; p < spec->num_params; p++) {
+            if (spec->num_values[p] != 2) {
+                log_printf("Error: Random sweep needs \"%s min max\"\n", spec->params[p]->name);
+                return -1;
+            }
+        }
+        if (spec->num_samples <= 0 || spec->num_samples > SWEEP_MAX_CONFIGS) {
+            log_printf("Error: Random sweep samples must be 1 - %d\n", SWEEP_MAX_CONFIGS);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// xorshift32，保证相同种子在各平台得到相同的配置
+static unsigned int next_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// 生成全部配置，返回配置数（超出上限返回-1）
+static int build_configs(const SweepSpec *spec, const AncParams *base, AncParams *configs) {
+    if (spec->mode == SWEEP_RANDOM) {
+        unsigned int rng = spec->seed ? spec->seed : 1;
+        for (int c = 0; c < spec->num_samples; c++) {
+            configs[c] = *base;
+            for (int p = 0; p < spec->num_params; p++) {
+                double lo = spec->values[p][0];
+                double hi = spec->values[p][1];
+                double u = (next_random(&rng) >> 8) / 16777216.0;
+                anc_params_set(&configs[c], spec->params[p], lo + u * (hi - lo));
+            }
+        }
+        return spec->num_samples;
+    }
+
+    long total = 1;
+    for (int p = 0; p < spec->num_params; p++) {
+        total *= spec->num_values[p];
+        if (total > SWEEP_MAX_CONFIGS) return -1;
+    }
+
+    // 笛卡尔积：配置序号按混合进制展开为各参数的取值下标
+    for (int c = 0; c < total; c++) {
+        configs[c] = *base;
+        int rest = c;
+        for (int p = spec->num_params - 1; p >= 0; p--) {
+            int idx = rest % spec->num_values[p];
+            rest /= spec->num_values[p];
+            anc_params_set(&configs[c], spec->params[p], spec->values[p][idx]);
+        }
+    }
+    return (int)total;
+}
+
+// 线程池任务上下文
+typedef struct {
+    const AncParams *configs;
+    SweepResult *results;
+    SweepEvalFn eval;
+    void *ctx;
+} SweepJobs;
+
+static void sweep_job(void *arg, int job_index) {
+    SweepJobs *jobs = (SweepJobs *)arg;
+    SweepResult *result = &jobs->results[job_index];
+
+    logger_set_thread_quiet(1);
+    memset(result, 0, sizeof(SweepResult));
+    result->status = jobs->eval(&jobs->configs[job_index], result, jobs->ctx);
+    logger_set_thread_quiet(0);
+}
+
+// 排名比较：失败的排在最后，降噪量降序，收敛时间升序
+static const SweepResult *g_sort_results;
+
+static int compare_rank(const void *a, const void *b) {
+    const SweepResult *ra = &g_sort_results[*(const int *)a];
+    const SweepResult *rb = &g_sort_results[*(const int *)b];
+    if (ra->status != rb->status) return ra->status == 0 ? -1 : 1;
+    if (ra->final_attenuation_db != rb->final_attenuation_db) {
+        return ra->final_attenuation_db > rb->final_attenuation_db ? -1 : 1;
+    }
+    if (ra->convergence_ms != rb->convergence_ms) {
+        return ra->convergence_ms < rb->convergence_ms ? -1 : 1;
+    }
+    return *(const int *)a - *(const int *)b;
+}
+
+// ============ 执行扫参 ============
+int sweep_run(const SweepSpec *spec, const AncParams *base, SweepEvalFn eval, void *ctx,
+              int num_threads, const char *csv_path) {
+    AncParams *configs = (AncParams *)malloc(SWEEP_MAX_CONFIGS * sizeof(AncParams));
+    if (!configs) {
+        log_printf("Error: Failed to allocate sweep configs\n");
+        return -1;
+    }
+
+    int num_configs = build_configs(spec, base, configs);
+    if (num_configs <= 0) {
+        log_printf("Error: Sweep grid exceeds %d configurations\n", SWEEP_MAX_CONFIGS);
+        free(configs);
+        return -1;
+    }
+
+    SweepResult *results = (SweepResult *)calloc(num_configs, sizeof(SweepResult));
+    int *rank = (int *)malloc(num_configs * sizeof(int));
+    if (!results || !rank) {
+        log_printf("Error: Failed to allocate sweep results\n");
+        free(configs);
+        free(results);
+        free(rank);
+        return -1;
+    }
+
+    log_printf("=== Parameter Sweep ===\n");
+    log_printf("Mode: %s, %d configurations, %d parameters, %d threads\n",
+               spec->mode == SWEEP_GRID ? "grid" : "random",
+               num_configs, spec->num_params, num_threads);
+    logger_flush();
+
+    time_t start = time(NULL);
+    SweepJobs jobs = {configs, results, eval, ctx};
+    thread_pool_run(num_threads, num_configs, sweep_job, &jobs);
+    log_printf("Sweep finished in %.0f s\n\n", difftime(time(NULL), start));
+
+    for (int c = 0; c < num_configs; c++) {
+        rank[c] = c;
+    }
+    g_sort_results = results;
+    qsort(rank, num_configs, sizeof(int), compare_rank);
+
+    // 排名表
+    FILE *csv = fopen(csv_path, "w");
+    if (!csv) {
+        log_printf("Warning: Cannot create sweep result file: %s\n", csv_path);
+    } else {
+        fprintf(csv, "rank,config");
+        for (int p = 0; p < spec->num_params; p++) {
+            fprintf(csv, ",%s", spec->params[p]->name);
+        }
+        fprintf(csv, ",final_attenuation_db,convergence_ms,iterations,updates_applied,status");
+        float center_hz[BAND_MAX_BANDS];
+        int num_bands = band_layout(center_hz);
+        for (int b = 0; b < num_bands; b++) {
+            fprintf(csv, ",%.4gHz", center_hz[b]);
+        }
+        fprintf(csv, "\n");
+
+        for (int i = 0; i < num_configs; i++) {
+            int c = rank[i];
+            fprintf(csv, "%d,%d", i + 1, c);
+            for (int p = 0; p < spec->num_params; p++) {
+                fprintf(csv, ",%g", anc_params_get(&configs[c], spec->params[p]));
+            }
+            fprintf(csv, ",%.3f,%.1f,%d,%d,%s",
+                    results[c].final_attenuation_db, results[c].convergence_ms,
+                    results[c].iterations, results[c].updates_applied,
+                    results[c].status == 0 ? "ok" : "failed");
+            // 最后一轮各频带降噪量（失败的配置留空）
+            for (int b = 0; b < num_bands; b++) {
+                if (b < results[c].num_bands) {
+                    fprintf(csv, ",%.2f", results[c].band_attenuation_db[b]);
+                } else {
+                    fprintf(csv, ",");
+                }
+            }
+            fprintf(csv, "\n");
+        }
+        fclose(csv);
+    }
+
+    // 日志只列出前10名
+    log_printf("Top configurations (full table: %s):\n", csv_path);
+    for (int i = 0; i < num_configs && i < 10; i++) {
+        int c = rank[i];
+        log_printf("  #%d config %d: %.2f dB, converged %.0f ms, %d updates |",
+                   i + 1, c, results[c].final_attenuation_db,
+                   results[c].convergence_ms, results[c].updates_applied);
+        for (int p = 0; p < spec->num_params; p++) {
+            log_printf(" %s=%g", spec->params[p]->name, anc_params_get(&configs[c], spec->params[p]));
+        }
+        log_printf("%s\n", results[c].status == 0 ? "" : " (failed)");
+    }
+
+    free(configs);
+    free(results);
+    free(rank);
+    return 0;
+}
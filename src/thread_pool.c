@@ -0,0 +1,202 @@
+#include "../inc/thread_pool.h"
+#include "../inc/logger.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define THREAD_POOL_MAX_THREADS 64
+
+// 一批任务的共享状态
+typedef struct {
+    pthread_mutex_t lock;
+    int next_job;
+    int num_jobs;
+    ThreadPoolJobFn fn;
+    void *ctx;
+} JobQueue;
+
+// 领取下一个任务序号，全部领完返回-1
+static int take_job(JobQueue *queue) {
+    pthread_mutex_lock(&queue->lock);
+    int job = queue->next_job < queue->num_jobs ? queue->next_job++ : -1;
+    pthread_mutex_unlock(&queue->lock);
+    return job;
+}
+
+static void *worker_main(void *arg) {
+    JobQueue *queue = (JobQueue *)arg;
+    int job;
+    while ((job = take_job(queue)) >= 0) {
+        queue->fn(queue->ctx, job);
+    }
+    return NULL;
+}
+
+// ============ 并行执行任务 ============
+int thread_pool_run(int num_threads, int num_jobs, ThreadPoolJobFn fn, void *ctx) {
+    JobQueue queue;
+    queue.next_job = 0;
+    queue.num_jobs = num_jobs;
+    queue.fn = fn;
+    queue.ctx = ctx;
+    pthread_mutex_init(&queue.lock, NULL);
+
+    if (num_threads > num_jobs) num_threads = num_jobs;
+    if (num_threads > THREAD_POOL_MAX_THREADS) num_threads = THREAD_POOL_MAX_THREADS;
+
+    // 调用线程自身也参与执行，额外创建num_threads-1个线程
+    pthread_t threads[THREAD_POOL_MAX_THREADS];
+    int created = 0;
+    int result = 0;
+    for (int i = 1; i < num_threads; i++) {
+        if (pthread_create(&threads[created], NULL, worker_main, &queue) != 0) {
+            log_printf("Warning: Failed to create worker thread %d, continuing with %d\n",
+                       i, created + 1);
+            result = -1;
+            break;
+        }
+        created++;
+    }
+
+    worker_main(&queue);
+
+    for (int i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&queue.lock);
+    return result;
+}
+
+// ============ 常驻线程池 ============
+struct ThreadPool {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;       // 新一批任务或退出
+    pthread_cond_t done_cond;       // 本批任务全部完成
+    pthread_t threads[THREAD_POOL_MAX_THREADS];
+    int num_workers;
+    unsigned generation;            // 批次号，工作线程据此判断是否有新任务
+    int shutdown;
+
+    // 当前批次（lock保护）
+    ThreadPoolJobFn fn;
+    void *ctx;
+    int next_job;
+    int num_jobs;
+    int pending;                    // 尚未完成的任务数
+};
+
+// 领取并执行当前批次的任务，直到领完（调用时持有lock，返回时仍持有）
+static void pool_drain(ThreadPool *pool) {
+    while (pool->next_job < pool->num_jobs) {
+        int job = pool->next_job++;
+        pthread_mutex_unlock(&pool->lock);
+        pool->fn(pool->ctx, job);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+}
+
+static void *pool_worker_main(void *arg) {
+    ThreadPool *pool = (ThreadPool *)arg;
+    pthread_mutex_lock(&pool->lock);
+    unsigned seen = pool->generation;
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        pool_drain(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ThreadPool *thread_pool_create(int num_threads) {
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    if (num_threads > THREAD_POOL_MAX_THREADS) num_threads = THREAD_POOL_MAX_THREADS;
+    for (int i = 1; i < num_threads; i++) {
+        if (pthread_create(&pool->threads[pool->num_workers], NULL, pool_worker_main, pool) != 0) {
+            log_printf("Warning: Failed to create worker thread %d, continuing with %d\n",
+                       i, pool->num_workers + 1);
+            break;
+        }
+        pool->num_workers++;
+    }
+    return pool;
+}
+
+void thread_pool_dispatch(ThreadPool *pool, int num_jobs, ThreadPoolJobFn fn, void *ctx) {
+    if (!pool || pool->num_workers == 0 || num_jobs <= 1) {
+        for (int i = 0; i < num_jobs; i++) {
+            fn(ctx, i);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->next_job = 0;
+    pool->num_jobs = num_jobs;
+    pool->pending = num_jobs;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    pool_drain(pool);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int thread_pool_size(const ThreadPool *pool) {
+    return pool ? pool->num_workers + 1 : 1;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (!pool) {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+// ============ CPU核数 ============
+int thread_pool_num_cpus(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
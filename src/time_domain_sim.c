@@ -1,50 +1,109 @@
 #include "../inc/time_domain_sim.h"
+#include "../inc/coeffs.h"
+#include "../inc/thread_pool.h"
 #include "../inc/logger.h"
 #include <stdlib.h>
 #include <string.h>
 
+// 分配模拟误差麦缓冲并初始化滤波器状态（原始信号已就位）
+static int time_sim_setup(TimeDomainSimulator *sim,
+                          int num_samples,
+                          const float *sp_ir,
+                          int sp_length,
+                          int sp_delay) {
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        sim->simulated_fb[e] = (float *)malloc(num_samples * sizeof(float));
+        if (!sim->simulated_fb[e]) {
+            log_printf("Error: Failed to allocate memory for time domain simulator\n");
+            return -1;
+        }
+        
+        // 初始化模拟信号为原始误差麦(未降噪)
+        memcpy(sim->simulated_fb[e], sim->original_fb[e], num_samples * sizeof(float));
+    }
+    
+    // 初始化Biquad状态
+    memset(sim->biquad_states, 0, sizeof(sim->biquad_states));
+    
+    // 初始化次级路径FIR（每对独立状态）
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            fir_init_delayed(&sim->secondary_path_fir[e][r], sp_ir, sp_length, sp_delay);
+        }
+    }
+    
+    sim->enabled = 1;
+    sim->num_threads = 1;
+    memset(sim->preconv_ff, 0, sizeof(sim->preconv_ff));
+    sim->owns_preconv = 0;
+    
+    log_printf("Time domain simulator initialized: %d samples, %d ref x %d err\n",
+               num_samples, ANC_NUM_REF, ANC_NUM_ERR);
+    return 0;
+}
+
 // 初始化时域仿真器
 int time_sim_init(TimeDomainSimulator *sim,
-                  const float *ff_signal,
-                  const float *fb_signal,
+                  const float *const ff_signals[],
+                  const float *const fb_signals[],
                   int num_samples,
                   const float *sp_ir,
-                  int sp_length) {
+                  int sp_length,
+                  int sp_delay) {
     
     sim->total_samples = num_samples;
     sim->current_sample = 0;
-    
-    // 分配内存
-    sim->original_ff = (float *)malloc(num_samples * sizeof(float));
-    sim->original_fb = (float *)malloc(num_samples * sizeof(float));
-    sim->simulated_fb = (float *)malloc(num_samples * sizeof(float));
-    
-    if (!sim->original_ff || !sim->original_fb || !sim->simulated_fb) {
-        log_printf("Error: Failed to allocate memory for time domain simulator\n");
-        return -1;
+    sim->owns_input = 1;
+    
+    // 分配内存并复制原始信号
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        float *copy = (float *)malloc(num_samples * sizeof(float));
+        if (!copy) {
+            log_printf("Error: Failed to allocate memory for time domain simulator\n");
+            return -1;
+        }
+        memcpy(copy, ff_signals[r], num_samples * sizeof(float));
+        sim->original_ff[r] = copy;
     }
     
-    // 复制原始信号
-    memcpy(sim->original_ff, ff_signal, num_samples * sizeof(float));
-    memcpy(sim->original_fb, fb_signal, num_samples * sizeof(float));
-    
-    // 初始化模拟信号为原始误差麦(未降噪)
-    memcpy(sim->simulated_fb, fb_signal, num_samples * sizeof(float));
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        float *copy = (float *)malloc(num_samples * sizeof(float));
+        if (!copy) {
+            log_printf("Error: Failed to allocate memory for time domain simulator\n");
+            return -1;
+        }
+        memcpy(copy, fb_signals[e], num_samples * sizeof(float));
+        sim->original_fb[e] = copy;
+    }
     
-    // 初始化Biquad状态
-    memset(sim->biquad_states, 0, sizeof(sim->biquad_states));
+    return time_sim_setup(sim, num_samples, sp_ir, sp_length, sp_delay);
+}
+
+// 初始化时域仿真器（共享原始信号）
+int time_sim_init_shared(TimeDomainSimulator *sim,
+                         const float *const ff_signals[],
+                         const float *const fb_signals[],
+                         int num_samples,
+                         const float *sp_ir,
+                         int sp_length,
+                         int sp_delay) {
     
-    // 初始化次级路径FIR
-    fir_init(&sim->secondary_path_fir, sp_ir, sp_length);
+    sim->total_samples = num_samples;
+    sim->current_sample = 0;
+    sim->owns_input = 0;
     
-    sim->enabled = 1;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        sim->original_ff[r] = ff_signals[r];
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        sim->original_fb[e] = fb_signals[e];
+    }
     
-    log_printf("Time domain simulator initialized: %d samples\n", num_samples);
-    return 0;
+    return time_sim_setup(sim, num_samples, sp_ir, sp_length, sp_delay);
 }
 
 // 单样本Biquad滤波
-float biquad_process_sample(float input, BiquadCoeffs *coeffs, BiquadTimeDomainState *state) {
+float biquad_process_sample(float input, const BiquadCoeffs *coeffs, BiquadTimeDomainState *state) {
     // Direct Form II Transposed
     // y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
     
@@ -56,10 +115,314 @@ float biquad_process_sample(float input, BiquadCoeffs *coeffs, BiquadTimeDomainS
     return output;
 }
 
+// Biquad级联处理一段信号并乘总增益（与逐级调用biquad_process_sample相同的DF2T结构）
+// 级数为编译期常量：系数和状态载入局部数组，逐样本的级循环完全展开，状态全程留在寄存器中；
+// 级内运算用double：375kHz下低频高Q的极点贴近单位圆，float舍入噪声会放大到抗噪声的百分之几
+static void biquad_cascade_block(const FeedforwardFilter *filter, BiquadTimeDomainState *states,
+                                 const float *input, float *output, int num_samples) {
+    double b0[NUM_BIQUADS], b1[NUM_BIQUADS], b2[NUM_BIQUADS];
+    double a1[NUM_BIQUADS], a2[NUM_BIQUADS];
+    double s1[NUM_BIQUADS], s2[NUM_BIQUADS];
+    
+    ANC_UNROLL(NUM_BIQUADS)
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        b0[stage] = filter->coeffs[stage].b0;
+        b1[stage] = filter->coeffs[stage].b1;
+        b2[stage] = filter->coeffs[stage].b2;
+        a1[stage] = filter->coeffs[stage].a1;
+        a2[stage] = filter->coeffs[stage].a2;
+        s1[stage] = states[stage].x1;
+        s2[stage] = states[stage].x2;
+    }
+    
+    const double gain = filter->total_gain;
+    for (int i = 0; i < num_samples; i++) {
+        double x = input[i];
+        ANC_UNROLL(NUM_BIQUADS)
+        for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+            // Direct Form II Transposed
+            double y = b0[stage] * x + s1[stage];
+            s1[stage] = b1[stage] * x - a1[stage] * y + s2[stage];
+            s2[stage] = b2[stage] * x - a2[stage] * y;
+            x = y;
+        }
+        output[i] = (float)(x * gain);
+    }
+    
+    ANC_UNROLL(NUM_BIQUADS)
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        states[stage].x1 = (float)s1[stage];
+        states[stage].x2 = (float)s2[stage];
+    }
+}
+
+// Biquad级联的零输入响应（乘总增益）累加到output，状态从states出发并写回
+static void biquad_cascade_zero_input_add(const FeedforwardFilter *filter,
+                                          BiquadTimeDomainState *states,
+                                          float *output, int num_samples) {
+    double b0[NUM_BIQUADS], b1[NUM_BIQUADS], b2[NUM_BIQUADS];
+    double a1[NUM_BIQUADS], a2[NUM_BIQUADS];
+    double s1[NUM_BIQUADS], s2[NUM_BIQUADS];
+    
+    ANC_UNROLL(NUM_BIQUADS)
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        b0[stage] = filter->coeffs[stage].b0;
+        b1[stage] = filter->coeffs[stage].b1;
+        b2[stage] = filter->coeffs[stage].b2;
+        a1[stage] = filter->coeffs[stage].a1;
+        a2[stage] = filter->coeffs[stage].a2;
+        s1[stage] = states[stage].x1;
+        s2[stage] = states[stage].x2;
+    }
+    
+    // 首级输入为0；之后各级输入为上一级输出，b系数项照常参与
+    const double gain = filter->total_gain;
+    for (int i = 0; i < num_samples; i++) {
+        double x = 0.0;
+        ANC_UNROLL(NUM_BIQUADS)
+        for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+            double y = b0[stage] * x + s1[stage];
+            s1[stage] = b1[stage] * x - a1[stage] * y + s2[stage];
+            s2[stage] = b2[stage] * x - a2[stage] * y;
+            x = y;
+        }
+        output[i] += (float)(x * gain);
+    }
+    
+    ANC_UNROLL(NUM_BIQUADS)
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        states[stage].x1 = (float)s1[stage];
+        states[stage].x2 = (float)s2[stage];
+    }
+}
+
+// 滤波器状态清零（Biquad和全部次级路径FIR）
+static void time_sim_reset_filters(TimeDomainSimulator *sim) {
+    memset(sim->biquad_states, 0, sizeof(sim->biquad_states));
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            fir_reset(&sim->secondary_path_fir[e][r]);
+        }
+    }
+}
+
+// ============ 分段并行滤波 ============
+// Biquad级联是线性的：块k从零状态滤波得到零状态输出和末尾状态z_k，再加上从真实起始状态s_k出发的
+// 零输入响应即为串行结果。起始状态按块递推 s_{k+1} = Φ^L·s_k + z_k，Φ为级联零输入时的单样本
+// 状态转移矩阵（2×NUM_BIQUADS维），Φ^L由重复平方求得，与极点半径无关，块间状态精确衔接。
+// 依次为: 零状态级联（并行）→ 递推起始状态（串行，每块一次矩阵向量乘）→ 零输入修正（并行）
+//        → 次级路径FIR与相减（并行，FIR历史取自整段驱动信号）
+#define CASCADE_STATE_DIM (2 * NUM_BIQUADS)
+
+typedef struct {
+    TimeDomainSimulator *sim;
+    const FeedforwardFilter *filters;
+    int start;              // 本次滤波起点（滤波器状态在此清零）
+    int end;
+    int chunk_len;
+    int num_chunks;
+    float *drive[ANC_NUM_REF];      // 整段扬声器驱动信号（预卷积模式下即抗噪声），下标相对start
+    BiquadTimeDomainState zero_end[ANC_NUM_REF][SIM_MAX_THREADS][NUM_BIQUADS];  // 各块零状态末尾状态
+    BiquadTimeDomainState init[ANC_NUM_REF][SIM_MAX_THREADS][NUM_BIQUADS];      // 各块真实起始状态
+    int *failed;            // 各块失败标志
+} SegmentJobs;
+
+static void segment_bounds(const SegmentJobs *jobs, int k, int *c0, int *c1) {
+    *c0 = jobs->start + k * jobs->chunk_len;
+    *c1 = (k == jobs->num_chunks - 1) ? jobs->end : *c0 + jobs->chunk_len;
+}
+
+// 第1步：块k从零状态滤波，记录末尾状态
+static void segment_cascade_job(void *arg, int k) {
+    SegmentJobs *jobs = (SegmentJobs *)arg;
+    TimeDomainSimulator *sim = jobs->sim;
+    int c0, c1;
+    segment_bounds(jobs, k, &c0, &c1);
+    const FIRFilter *sp_fir = &sim->secondary_path_fir[0][0];
+    
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        float *drive = &jobs->drive[r][c0 - jobs->start];
+        
+        if (sim->preconv_ff[0]) {
+            // 预卷积模式：W * (S * FF) 即抗噪声，各误差麦共用同一次级路径
+            memcpy(drive, &sim->preconv_ff[r][c0], (c1 - c0) * sizeof(float));
+            
+            // 滤波器从本段起点清零开始：起点后SP长度内的样本改用截断的参考麦重新卷积
+            int head_end = jobs->start + sp_fir->delay + sp_fir->length;
+            if (head_end > c1) head_end = c1;
+            if (c0 < head_end) {
+                fir_convolve(sp_fir->coeffs, sp_fir->length, &sim->original_ff[r][jobs->start],
+                             c0 - jobs->start - sp_fir->delay, drive, head_end - c0);
+            }
+            memset(jobs->zero_end[r][k], 0, sizeof(jobs->zero_end[r][k]));
+            biquad_cascade_block(&jobs->filters[r], jobs->zero_end[r][k], drive, drive, c1 - c0);
+        } else {
+            // 1. Biquad级联滤波(10级)  2. 应用总增益
+            memset(jobs->zero_end[r][k], 0, sizeof(jobs->zero_end[r][k]));
+            biquad_cascade_block(&jobs->filters[r], jobs->zero_end[r][k],
+                                 &sim->original_ff[r][c0], drive, c1 - c0);
+        }
+    }
+}
+
+// 级联零输入时的单样本状态转移（双精度），状态排列为 [x1_0, x2_0, x1_1, x2_1, ...]
+static void cascade_zero_input_step(const FeedforwardFilter *filter, double *s) {
+    double x = 0.0;
+    for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+        const BiquadCoeffs *c = &filter->coeffs[stage];
+        double y = c->b0 * x + s[2 * stage];
+        s[2 * stage] = c->b1 * x - c->a1 * y + s[2 * stage + 1];
+        s[2 * stage + 1] = c->b2 * x - c->a2 * y;
+        x = y;
+    }
+}
+
+static void matrix_multiply(double out[CASCADE_STATE_DIM][CASCADE_STATE_DIM],
+                            double a[CASCADE_STATE_DIM][CASCADE_STATE_DIM],
+                            double b[CASCADE_STATE_DIM][CASCADE_STATE_DIM]) {
+    double tmp[CASCADE_STATE_DIM][CASCADE_STATE_DIM];
+    for (int i = 0; i < CASCADE_STATE_DIM; i++) {
+        for (int j = 0; j < CASCADE_STATE_DIM; j++) {
+            double acc = 0.0;
+            for (int m = 0; m < CASCADE_STATE_DIM; m++) {
+                acc += a[i][m] * b[m][j];
+            }
+            tmp[i][j] = acc;
+        }
+    }
+    memcpy(out, tmp, sizeof(tmp));
+}
+
+// 第2步（串行）：由各块零状态末尾状态递推各块真实起始状态
+static void segment_propagate_states(SegmentJobs *jobs, int r) {
+    double step[CASCADE_STATE_DIM][CASCADE_STATE_DIM];
+    double power[CASCADE_STATE_DIM][CASCADE_STATE_DIM];
+    
+    // Φ的第c列 = 单位状态e_c经过一个零输入样本后的状态
+    for (int c = 0; c < CASCADE_STATE_DIM; c++) {
+        double s[CASCADE_STATE_DIM] = {0.0};
+        s[c] = 1.0;
+        cascade_zero_input_step(&jobs->filters[r], s);
+        for (int i = 0; i < CASCADE_STATE_DIM; i++) {
+            step[i][c] = s[i];
+        }
+    }
+    
+    // Φ^chunk_len（除末块外各块等长）
+    memset(power, 0, sizeof(power));
+    for (int i = 0; i < CASCADE_STATE_DIM; i++) {
+        power[i][i] = 1.0;
+    }
+    for (int n = jobs->chunk_len; n > 0; n >>= 1) {
+        if (n & 1) {
+            matrix_multiply(power, power, step);
+        }
+        matrix_multiply(step, step, step);
+    }
+    
+    double s[CASCADE_STATE_DIM] = {0.0};
+    memset(jobs->init[r][0], 0, sizeof(jobs->init[r][0]));
+    for (int k = 1; k < jobs->num_chunks; k++) {
+        double next[CASCADE_STATE_DIM];
+        for (int i = 0; i < CASCADE_STATE_DIM; i++) {
+            double acc = 0.0;
+            for (int m = 0; m < CASCADE_STATE_DIM; m++) {
+                acc += power[i][m] * s[m];
+            }
+            const BiquadTimeDomainState *z = &jobs->zero_end[r][k - 1][i / 2];
+            next[i] = acc + ((i & 1) ? z->x2 : z->x1);
+        }
+        memcpy(s, next, sizeof(s));
+        for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+            jobs->init[r][k][stage].x1 = (float)s[2 * stage];
+            jobs->init[r][k][stage].x2 = (float)s[2 * stage + 1];
+        }
+    }
+}
+
+// 第3步：块k叠加从真实起始状态出发的零输入响应，末块留下与串行滤波相同的末尾状态（快照保存）
+static void segment_correct_job(void *arg, int k) {
+    SegmentJobs *jobs = (SegmentJobs *)arg;
+    int c0, c1;
+    segment_bounds(jobs, k, &c0, &c1);
+    
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        BiquadTimeDomainState states[NUM_BIQUADS];
+        memcpy(states, jobs->init[r][k], sizeof(states));
+        if (k > 0) {
+            biquad_cascade_zero_input_add(&jobs->filters[r], states,
+                                          &jobs->drive[r][c0 - jobs->start], c1 - c0);
+        }
+        if (k == jobs->num_chunks - 1 && !jobs->sim->preconv_ff[0]) {
+            for (int stage = 0; stage < NUM_BIQUADS; stage++) {
+                jobs->sim->biquad_states[r][stage].x1 = states[stage].x1 + jobs->zero_end[r][k][stage].x1;
+                jobs->sim->biquad_states[r][stage].x2 = states[stage].x2 + jobs->zero_end[r][k][stage].x2;
+            }
+        }
+    }
+}
+
+// 第4步：块k经次级路径FIR得到抗噪声，与误差麦相减（各块写入simulated_fb的不同区间，互不重叠）
+static void segment_fir_job(void *arg, int k) {
+    SegmentJobs *jobs = (SegmentJobs *)arg;
+    TimeDomainSimulator *sim = jobs->sim;
+    int c0, c1;
+    segment_bounds(jobs, k, &c0, &c1);
+    int preconv = sim->preconv_ff[0] != NULL;
+    
+    float *anti = preconv ? NULL : (float *)malloc((c1 - c0) * sizeof(float));
+    if (!preconv && !anti) {
+        jobs->failed[k] = 1;
+        return;
+    }
+    
+    // 模拟的误差麦信号从原始误差麦开始，逐路减去各扬声器的抗噪声
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        memcpy(&sim->simulated_fb[e][c0], &sim->original_fb[e][c0], (c1 - c0) * sizeof(float));
+    }
+    
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        const float *drive = jobs->drive[r];
+        
+        if (preconv) {
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                float *fb = &sim->simulated_fb[e][c0];
+                for (int i = 0; i < c1 - c0; i++) {
+                    fb[i] -= drive[c0 - jobs->start + i];
+                }
+            }
+            continue;
+        }
+        
+        // 3. 次级路径FIR滤波(模拟扬声器到误差麦的传递)，与误差麦相减(主动降噪)
+        for (int e = 0; e < ANC_NUM_ERR; e++) {
+            const FIRFilter *fir = &sim->secondary_path_fir[e][r];
+            float *fb = &sim->simulated_fb[e][c0];
+            
+            fir_convolve(fir->coeffs, fir->length, drive, c0 - jobs->start - fir->delay, anti, c1 - c0);
+            for (int i = 0; i < c1 - c0; i++) {
+                fb[i] -= anti[i];
+            }
+        }
+        
+        // 最后一块留下与串行滤波相同的FIR历史（快照保存）
+        if (k == jobs->num_chunks - 1) {
+            int total = c1 - jobs->start;
+            const FIRFilter *fir = &sim->secondary_path_fir[0][r];
+            int fir_span = fir->delay + fir->length;
+            int tail = total < fir_span ? total : fir_span;
+            for (int e = 0; e < ANC_NUM_ERR; e++) {
+                fir_set_history(&sim->secondary_path_fir[e][r], &drive[total - tail], total);
+            }
+        }
+    }
+    
+    free(anti);
+}
+
 // 时域滤波一段信号
 void time_sim_process(TimeDomainSimulator *sim,
-                      BiquadCoeffs *coeffs,
-                      float total_gain,
+                      const FeedforwardFilter *filters,
                       int num_samples) {
     
     if (!sim->enabled) return;
@@ -77,45 +440,67 @@ void time_sim_process(TimeDomainSimulator *sim,
         return;
     }
     
+    // 分块数：每块不短于SIM_SEGMENT_MIN_LENGTH，至多每线程一块
+    int num_chunks = num_samples / SIM_SEGMENT_MIN_LENGTH;
+    if (num_chunks > sim->num_threads) num_chunks = sim->num_threads;
+    if (num_chunks < 1) num_chunks = 1;
+    
     log_printf("\n=== Time Domain Simulation ===\n");
     log_printf("Processing samples [%d, %d) (%d samples)\n", 
                start_idx, start_idx + num_samples, num_samples);
     log_printf("Progress: %.1f%% of total signal\n", 
                (float)start_idx / sim->total_samples * 100.0f);
+    if (num_chunks > 1) {
+        log_printf("Segmented: %d chunks on %d threads\n", num_chunks, num_chunks);
+    }
     
-    // 注意：这里需要重置滤波器状态，因为每次参数更新后是全新的滤波器
-    // 重置Biquad状态
-    memset(sim->biquad_states, 0, sizeof(sim->biquad_states));
+    int failed[SIM_MAX_THREADS] = {0};
     
-    // 重置FIR状态
-    fir_reset(&sim->secondary_path_fir);
+    // 预卷积模式不经过流式滤波器，不留末尾状态
+    if (sim->preconv_ff[0]) {
+        time_sim_reset_filters(sim);
+    }
     
-    // 逐样本处理
-    for (int i = 0; i < num_samples; i++) {
-        int idx = start_idx + i;
-        
-        // 1. 读取原始参考麦信号
-        float ff_sample = sim->original_ff[idx];
+    // 注意：每次参数更新后是全新的滤波器，Biquad和FIR状态均从本段起点清零开始
+    SegmentJobs *jobs = (SegmentJobs *)calloc(1, sizeof(SegmentJobs));
+    int alloc_failed = !jobs;
+    for (int r = 0; r < ANC_NUM_REF && jobs; r++) {
+        jobs->drive[r] = (float *)malloc(num_samples * sizeof(float));
+        if (!jobs->drive[r]) alloc_failed = 1;
+    }
+    
+    if (!alloc_failed) {
+        jobs->sim = sim;
+        jobs->filters = filters;
+        jobs->start = start_idx;
+        jobs->end = start_idx + num_samples;
+        jobs->chunk_len = num_samples / num_chunks;
+        jobs->num_chunks = num_chunks;
+        jobs->failed = failed;
         
-        // 2. Biquad级联滤波(10级)
-        float filtered = ff_sample;
-        for (int stage = 0; stage < NUM_BIQUADS; stage++) {
-            filtered = biquad_process_sample(filtered, &coeffs[stage], 
-                                             &sim->biquad_states[stage]);
+        thread_pool_run(num_chunks, num_chunks, segment_cascade_job, jobs);
+        if (num_chunks > 1) {
+            for (int r = 0; r < ANC_NUM_REF; r++) {
+                segment_propagate_states(jobs, r);
+            }
         }
+        thread_pool_run(num_chunks, num_chunks, segment_correct_job, jobs);
+        thread_pool_run(num_chunks, num_chunks, segment_fir_job, jobs);
         
-        // 3. 应用总增益
-        filtered *= total_gain;
-        
-        // 4. 次级路径FIR滤波(模拟扬声器到误差麦的传递)
-        float anti_noise = fir_process(&sim->secondary_path_fir, filtered);
-        
-        // 5. 与原始误差麦相减(主动降噪)
-        float original_error = sim->original_fb[idx];
-        float simulated_error = original_error - anti_noise;
-        
-        // 6. 更新模拟的误差麦信号
-        sim->simulated_fb[idx] = simulated_error;
+        for (int k = 0; k < num_chunks; k++) {
+            if (failed[k]) alloc_failed = 1;
+        }
+    }
+    
+    if (jobs) {
+        for (int r = 0; r < ANC_NUM_REF; r++) {
+            free(jobs->drive[r]);
+        }
+        free(jobs);
+    }
+    if (alloc_failed) {
+        log_printf("Error: Failed to allocate time domain drive buffer\n");
+        return;
     }
     
     // 注意：这里不更新current_sample，因为下一轮DSP还是从current_sample开始读取
@@ -123,10 +508,76 @@ void time_sim_process(TimeDomainSimulator *sim,
     log_printf("Time domain simulation completed: %d samples processed\n", num_samples);
 }
 
+// 设置分段并行线程数
+void time_sim_set_threads(TimeDomainSimulator *sim, int num_threads) {
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > SIM_MAX_THREADS) num_threads = SIM_MAX_THREADS;
+    sim->num_threads = num_threads;
+}
+
+// 预卷积分块任务
+typedef struct {
+    const float *ff;
+    const float *sp;
+    int sp_length;
+    int sp_delay;
+    int num_samples;
+    int chunk_len;
+    float *out;
+} PreconvJobs;
+
+static void preconv_job(void *arg, int k) {
+    PreconvJobs *jobs = (PreconvJobs *)arg;
+    int c0 = k * jobs->chunk_len;
+    int c1 = c0 + jobs->chunk_len < jobs->num_samples ? c0 + jobs->chunk_len : jobs->num_samples;
+    fir_convolve(jobs->sp, jobs->sp_length, jobs->ff, c0 - jobs->sp_delay, &jobs->out[c0], c1 - c0);
+}
+
+// 计算预卷积参考
+float *time_sim_preconvolve(const float *ff_signal, int num_samples,
+                            const float *sp_ir, int sp_length, int sp_delay, int num_threads) {
+    float *out = (float *)malloc(num_samples * sizeof(float));
+    if (!out) {
+        log_printf("Error: Failed to allocate pre-convolved reference\n");
+        return NULL;
+    }
+    
+    // 分块数多于线程数，尾部负载更均衡
+    PreconvJobs jobs = {ff_signal, sp_ir, sp_length, sp_delay, num_samples,
+                        SIM_SEGMENT_MIN_LENGTH, out};
+    int num_chunks = (num_samples + jobs.chunk_len - 1) / jobs.chunk_len;
+    thread_pool_run(num_threads, num_chunks, preconv_job, &jobs);
+    return out;
+}
+
+// 启用预卷积模式
+int time_sim_enable_preconv(TimeDomainSimulator *sim, const float *const shared[]) {
+    const FIRFilter *fir = &sim->secondary_path_fir[0][0];
+    
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        if (shared) {
+            sim->preconv_ff[r] = shared[r];
+            continue;
+        }
+        float *buf = time_sim_preconvolve(sim->original_ff[r], sim->total_samples,
+                                          fir->coeffs, fir->length, fir->delay, sim->num_threads);
+        if (!buf) {
+            return -1;
+        }
+        sim->preconv_ff[r] = buf;
+        sim->owns_preconv = 1;
+    }
+    
+    log_printf("Pre-convolved reference %s: %d ref x %d samples, SP %d taps + %d delay\n",
+               shared ? "shared" : "computed", ANC_NUM_REF, sim->total_samples,
+               fir->length, fir->delay);
+    return 0;
+}
+
 // 获取当前时刻的信号
 int time_sim_get_signals(TimeDomainSimulator *sim,
-                         float *ff_out,
-                         float *fb_out,
+                         float *const ff_out[],
+                         float *const fb_out[],
                          int num_samples) {
     
     if (!sim->enabled) return 0;
@@ -145,10 +596,14 @@ int time_sim_get_signals(TimeDomainSimulator *sim,
     // 复制信号
     // FF: 始终使用原始信号
     // FB: 使用模拟降噪后的信号（如果已经滤波过）
-    memcpy(ff_out, &sim->original_ff[sim->current_sample], 
-           num_samples * sizeof(float));
-    memcpy(fb_out, &sim->simulated_fb[sim->current_sample], 
-           num_samples * sizeof(float));
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        memcpy(ff_out[r], &sim->original_ff[r][sim->current_sample],
+               num_samples * sizeof(float));
+    }
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        memcpy(fb_out[e], &sim->simulated_fb[e][sim->current_sample],
+               num_samples * sizeof(float));
+    }
     
     // 移动指针（这些样本已经被DSP读取）
     sim->current_sample += num_samples;
@@ -158,18 +613,21 @@ int time_sim_get_signals(TimeDomainSimulator *sim,
 
 // 释放资源
 void time_sim_free(TimeDomainSimulator *sim) {
-    if (sim->original_ff) {
-        free(sim->original_ff);
-        sim->original_ff = NULL;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        if (sim->owns_input) free((void *)sim->original_ff[r]);
+        sim->original_ff[r] = NULL;
     }
-    if (sim->original_fb) {
-        free(sim->original_fb);
-        sim->original_fb = NULL;
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        if (sim->owns_input) free((void *)sim->original_fb[e]);
+        free(sim->simulated_fb[e]);
+        sim->original_fb[e] = NULL;
+        sim->simulated_fb[e] = NULL;
     }
-    if (sim->simulated_fb) {
-        free(sim->simulated_fb);
-        sim->simulated_fb = NULL;
+    for (int r = 0; r < ANC_NUM_REF; r++) {
+        if (sim->owns_preconv) free((void *)sim->preconv_ff[r]);
+        sim->preconv_ff[r] = NULL;
     }
+    sim->owns_preconv = 0;
     sim->enabled = 0;
 }
 
@@ -177,16 +635,14 @@ void time_sim_free(TimeDomainSimulator *sim) {
 void time_sim_reset(TimeDomainSimulator *sim) {
     sim->current_sample = 0;
     
-    // 重置Biquad状态
-    memset(sim->biquad_states, 0, sizeof(sim->biquad_states));
-    
-    // 重置FIR状态
-    fir_reset(&sim->secondary_path_fir);
+    time_sim_reset_filters(sim);
     
     // 恢复模拟信号为原始误差麦
-    if (sim->simulated_fb && sim->original_fb) {
-        memcpy(sim->simulated_fb, sim->original_fb, 
-               sim->total_samples * sizeof(float));
+    for (int e = 0; e < ANC_NUM_ERR; e++) {
+        if (sim->simulated_fb[e] && sim->original_fb[e]) {
+            memcpy(sim->simulated_fb[e], sim->original_fb[e],
+                   sim->total_samples * sizeof(float));
+        }
     }
     
     log_printf("Time domain simulator reset\n");
@@ -0,0 +1,112 @@
+/*
+ * DSP静态表生成器
+ * 按config.h中的编译期尺寸生成 src/dsp_tables.c:
+ *   - Blackman窗
+ *   - 实数FFT位反转表和各级旋转因子
+ *   - 各频点频率和 e^(-j2πk/N)（z^-1在频点k的取值，同时是实数FFT拆分旋转因子）
+ *
+ * 用法（修改FFT_LENGTH或DSP_SAMPLE_RATE后重新生成）:
+ *   gcc -Iinc tools/gen_tables.c -o gen_tables -lm
+ *   gen_tables > src/dsp_tables.c
+ */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "config.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define VALUES_PER_LINE 8
+
+// 以C初始化列表格式输出float数组
+static void emit_float_array(const char *decl, const double *values, int count) {
+    printf("%s = {\n", decl);
+    for (int i = 0; i < count; i++) {
+        // 舍去三角函数在零点附近的舍入残差，整数值补小数点
+        double v = fabs(values[i]) < 1e-12 ? 0.0 : values[i];
+        char text[32];
+        snprintf(text, sizeof(text), "%.9g", v);
+        if (!strpbrk(text, ".e")) strcat(text, ".0");
+        if (i % VALUES_PER_LINE == 0) printf("    ");
+        printf("%sf,", text);
+        printf((i % VALUES_PER_LINE == VALUES_PER_LINE - 1 || i == count - 1) ? "\n" : " ");
+    }
+    printf("};\n\n");
+}
+
+int main(void) {
+    static double values[FFT_LENGTH + SPECTRUM_LENGTH];
+    static double values_im[FFT_LENGTH + SPECTRUM_LENGTH];
+    const int half = FFT_LENGTH / 2;
+
+    printf("// 由 tools/gen_tables.c 生成，请勿手工修改\n");
+    printf("#include \"../inc/dsp_tables.h\"\n\n");
+    printf("#if FFT_LENGTH != %d || DSP_SAMPLE_RATE != %d || SPECTRUM_LENGTH != %d\n",
+           FFT_LENGTH, DSP_SAMPLE_RATE, SPECTRUM_LENGTH);
+    printf("#error \"dsp_tables.c is stale: rerun tools/gen_tables\"\n");
+    printf("#endif\n\n");
+
+    // Blackman窗
+    for (int i = 0; i < FFT_LENGTH; i++) {
+        values[i] = 0.42 - 0.5 * cos(2.0 * M_PI * i / (FFT_LENGTH - 1))
+                         + 0.08 * cos(4.0 * M_PI * i / (FFT_LENGTH - 1));
+    }
+    printf("// Blackman窗\n");
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_blackman_window[FFT_LENGTH]", values, FFT_LENGTH);
+
+    // 位反转表（N/2点复数FFT）
+    int bits = 0;
+    while ((1 << bits) < half) bits++;
+    printf("// 位反转置换表（N/2点复数FFT）\n");
+    printf("const uint16_t dsp_fft_bitrev[FFT_LENGTH / 2] = {\n");
+    for (int i = 0; i < half; i++) {
+        int rev = 0;
+        for (int b = 0; b < bits; b++) {
+            if (i & (1 << b)) rev |= 1 << (bits - 1 - b);
+        }
+        if (i % 16 == 0) printf("    ");
+        printf("%d,", rev);
+        printf((i % 16 == 15 || i == half - 1) ? "\n" : " ");
+    }
+    printf("};\n\n");
+
+    // 各级旋转因子：长度为len的级 e^(-j2πj/len), j < len/2，依次拼接
+    int offset = 0;
+    for (int len = 2; len <= half; len <<= 1) {
+        for (int j = 0; j < len / 2; j++) {
+            values[offset + j] = cos(-2.0 * M_PI * j / len);
+            values_im[offset + j] = sin(-2.0 * M_PI * j / len);
+        }
+        offset += len / 2;
+    }
+    values[offset] = values_im[offset] = 0.0;   // 末尾补一个0（总数N/2-1）
+    printf("// 各级蝶形旋转因子（第s级hl个，依次拼接）\n");
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_fft_stage_tw_re[FFT_LENGTH / 2]", values, half);
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_fft_stage_tw_im[FFT_LENGTH / 2]", values_im, half);
+
+    // 各频点频率
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        values[k] = k < FFT_HALF_LENGTH ? (double)k * DSP_SAMPLE_RATE / FFT_LENGTH : 0.0;
+    }
+    printf("// 各频点频率 (Hz)，补零区为0\n");
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_bin_freq[SPECTRUM_LENGTH]", values, SPECTRUM_LENGTH);
+
+    // e^(-j2πk/N)
+    for (int k = 0; k < SPECTRUM_LENGTH; k++) {
+        values[k] = k < FFT_HALF_LENGTH ? cos(-2.0 * M_PI * k / FFT_LENGTH) : 0.0;
+        values_im[k] = k < FFT_HALF_LENGTH ? sin(-2.0 * M_PI * k / FFT_LENGTH) : 0.0;
+    }
+    printf("// e^(-j2πk/N)，补零区为0\n");
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_bin_twiddle_re[SPECTRUM_LENGTH]", values, SPECTRUM_LENGTH);
+    printf("ANC_ALIGN(64) ");
+    emit_float_array("const float dsp_bin_twiddle_im[SPECTRUM_LENGTH]", values_im, SPECTRUM_LENGTH);
+
+    return 0;
+}